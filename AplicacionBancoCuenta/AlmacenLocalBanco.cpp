@@ -0,0 +1,453 @@
+/**
+ * @file AlmacenLocalBanco.cpp
+ * @brief Implementación del almacén local de personas con índices en disco
+ */
+#include "AlmacenLocalBanco.h"
+#include "Persona.h"
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <vector>
+#include <cstring>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+	const char FIRMA_DATOS[8] = { 'B', 'A', 'N', 'C', 'O', 'D', 'A', 'T' };
+	constexpr uint32_t TAMANO_MAXIMO_DOCUMENTO = 16 * 1024 * 1024;  // Límite de BSON
+
+	std::string leerTexto(const bsoncxx::document::view& doc, const char* campo) {
+		auto elemento = doc[campo];
+		if (elemento && elemento.type() == bsoncxx::type::k_utf8) {
+			return std::string(elemento.get_string().value);
+		}
+		return "";
+	}
+
+	std::vector<std::string> numerosCuenta(const bsoncxx::document::view& doc) {
+		std::vector<std::string> numeros;
+		auto cuentas = doc["cuentas"];
+		if (!cuentas || cuentas.type() != bsoncxx::type::k_array) {
+			return numeros;
+		}
+		for (const auto& cuenta : cuentas.get_array().value) {
+			if (cuenta.type() == bsoncxx::type::k_document) {
+				std::string numero = leerTexto(cuenta.get_document().value, "numeroCuenta");
+				if (!numero.empty()) {
+					numeros.push_back(std::move(numero));
+				}
+			}
+		}
+		return numeros;
+	}
+
+	/**
+	 * @brief Copia el documento de persona quitando el saldo de cada cuenta
+	 *
+	 * Los movimientos de saldo no pasan por el almacén: guardar el saldo dejaría una
+	 * cifra vieja que el modo sin conexión podría tomar por vigente.
+	 */
+	bsoncxx::document::value sinSaldos(const bsoncxx::document::view& doc) {
+		using bsoncxx::builder::basic::kvp;
+		bsoncxx::builder::basic::document resultado;
+		for (const auto& elemento : doc) {
+			if (elemento.key() != "cuentas" || elemento.type() != bsoncxx::type::k_array) {
+				resultado.append(kvp(elemento.key(), elemento.get_value()));
+				continue;
+			}
+			bsoncxx::builder::basic::array cuentas;
+			for (const auto& cuenta : elemento.get_array().value) {
+				if (cuenta.type() != bsoncxx::type::k_document) {
+					cuentas.append(cuenta.get_value());
+					continue;
+				}
+				bsoncxx::builder::basic::document copia;
+				for (const auto& campo : cuenta.get_document().value) {
+					if (campo.key() != "saldo") {
+						copia.append(kvp(campo.key(), campo.get_value()));
+					}
+				}
+				cuentas.append(copia.extract());
+			}
+			resultado.append(kvp("cuentas", cuentas));
+		}
+		return resultado.extract();
+	}
+
+	bool posicionar(std::FILE* archivo, uint64_t desplazamiento, int origen = SEEK_SET) {
+#ifdef _WIN32
+		return _fseeki64(archivo, static_cast<long long>(desplazamiento), origen) == 0;
+#else
+		return fseeko(archivo, static_cast<off_t>(desplazamiento), origen) == 0;
+#endif
+	}
+
+	uint64_t posicionActual(std::FILE* archivo) {
+#ifdef _WIN32
+		return static_cast<uint64_t>(_ftelli64(archivo));
+#else
+		return static_cast<uint64_t>(ftello(archivo));
+#endif
+	}
+
+	bool forzarADisco(std::FILE* archivo) {
+		if (std::fflush(archivo) != 0) {
+			return false;
+		}
+#ifdef _WIN32
+		return _commit(_fileno(archivo)) == 0;
+#else
+		return fsync(fileno(archivo)) == 0;
+#endif
+	}
+
+	/**
+	 * @brief Ordena los pares por clave y conserva el último de cada clave repetida
+	 */
+	void ordenarSinRepetidos(std::vector<std::pair<std::string, uint64_t>>& pares) {
+		std::stable_sort(pares.begin(), pares.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+		std::vector<std::pair<std::string, uint64_t>> unicos;
+		unicos.reserve(pares.size());
+		for (size_t i = 0; i < pares.size(); ++i) {
+			if (i + 1 < pares.size() && pares[i + 1].first == pares[i].first) {
+				continue;
+			}
+			unicos.push_back(std::move(pares[i]));
+		}
+		pares = std::move(unicos);
+	}
+}
+
+AlmacenLocalBanco::AlmacenLocalBanco()
+	: datos(nullptr), idObservador(0), repositorioSeguido(nullptr), contadorInicial(0), escriturasSeguidas(0) {}
+
+AlmacenLocalBanco::~AlmacenLocalBanco() {
+	// Al destruirse durante la salida el repositorio puede ya no existir: sin cerrar()
+	// explícito el contador queda en 0 y el próximo arranque reconstruye
+	repositorioSeguido = nullptr;
+	cerrar();
+}
+
+bool AlmacenLocalBanco::abrirDatos(const std::string& ruta) {
+	datos = std::fopen(ruta.c_str(), "r+b");
+	if (!datos) {
+		datos = std::fopen(ruta.c_str(), "w+b");
+	}
+	if (!datos) {
+		std::cerr << "Error: No se pudo abrir el archivo de datos " << ruta << std::endl;
+		return false;
+	}
+
+	char firma[sizeof(FIRMA_DATOS)];
+	posicionar(datos, 0);
+	if (std::fread(firma, 1, sizeof(firma), datos) == sizeof(firma)) {
+		if (std::memcmp(firma, FIRMA_DATOS, sizeof(firma)) != 0) {
+			std::cerr << "Error: Formato de datos no reconocido en " << ruta << std::endl;
+			std::fclose(datos);
+			datos = nullptr;
+			return false;
+		}
+		return true;
+	}
+
+	// Archivo nuevo (o sin cabecera completa): se escribe la firma
+	posicionar(datos, 0);
+	if (std::fwrite(FIRMA_DATOS, 1, sizeof(FIRMA_DATOS), datos) != sizeof(FIRMA_DATOS) || !forzarADisco(datos)) {
+		std::cerr << "Error: No se pudo inicializar " << ruta << std::endl;
+		std::fclose(datos);
+		datos = nullptr;
+		return false;
+	}
+	return true;
+}
+
+bool AlmacenLocalBanco::abrir(const std::string& directorioAlmacen) {
+	cerrar();
+
+	std::error_code error;
+	std::filesystem::create_directories(directorioAlmacen, error);
+	directorio = directorioAlmacen;
+	std::filesystem::path base(directorio);
+
+	std::lock_guard<std::mutex> lock(mutexDatos);
+	return abrirDatos((base / "personas.dat").string()) &&
+		indiceCedulas.abrir((base / "cedulas.idx").string()) &&
+		indiceCuentas.abrir((base / "cuentas.idx").string());
+}
+
+void AlmacenLocalBanco::cerrar() {
+	if (idObservador != 0) {
+		IRepositorioBanco::eliminarObservadorPersonas(idObservador);
+		idObservador = 0;
+	}
+	if (repositorioSeguido) {
+		// Una escritura que no pasó por el observador (otro proceso, una restauración)
+		// descuadra la suma y el próximo arranque reconstruye el almacén
+		uint64_t contadorFinal = 0;
+		try {
+			contadorFinal = repositorioSeguido->obtenerContadorCambiosPersonas();
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Error al leer el contador de cambios de personas: " << e.what() << std::endl;
+		}
+		registrarContador(contadorFinal == contadorInicial + escriturasSeguidas.load() ? contadorFinal : 0);
+		repositorioSeguido = nullptr;
+	}
+	std::lock_guard<std::mutex> lock(mutexDatos);
+	indiceCedulas.cerrar();
+	indiceCuentas.cerrar();
+	if (datos) {
+		std::fclose(datos);
+		datos = nullptr;
+	}
+}
+
+std::optional<uint64_t> AlmacenLocalBanco::agregarDocumento(std::FILE* destino, const bsoncxx::document::view& documento) {
+	if (!posicionar(destino, 0, SEEK_END)) {
+		return std::nullopt;
+	}
+	uint64_t desplazamiento = posicionActual(destino);
+	if (std::fwrite(documento.data(), 1, documento.length(), destino) != documento.length()) {
+		return std::nullopt;
+	}
+	return desplazamiento;
+}
+
+std::optional<bsoncxx::document::value> AlmacenLocalBanco::leerDocumento(uint64_t desplazamiento) {
+	std::lock_guard<std::mutex> lock(mutexDatos);
+	if (!datos || !posicionar(datos, desplazamiento)) {
+		return std::nullopt;
+	}
+
+	// Un documento BSON comienza con su longitud total (int32 little-endian)
+	uint8_t prefijo[4];
+	if (std::fread(prefijo, 1, sizeof(prefijo), datos) != sizeof(prefijo)) {
+		return std::nullopt;
+	}
+	uint32_t longitud = static_cast<uint32_t>(prefijo[0]) | (static_cast<uint32_t>(prefijo[1]) << 8) |
+		(static_cast<uint32_t>(prefijo[2]) << 16) | (static_cast<uint32_t>(prefijo[3]) << 24);
+	if (longitud < 5 || longitud > TAMANO_MAXIMO_DOCUMENTO) {
+		return std::nullopt;
+	}
+
+	std::vector<uint8_t> bytes(longitud);
+	std::memcpy(bytes.data(), prefijo, sizeof(prefijo));
+	if (std::fread(bytes.data() + sizeof(prefijo), 1, longitud - sizeof(prefijo), datos) != longitud - sizeof(prefijo)) {
+		return std::nullopt;
+	}
+	return bsoncxx::document::value(bsoncxx::document::view(bytes.data(), longitud));
+}
+
+uint64_t AlmacenLocalBanco::leerContadorRegistrado() const {
+	std::string ruta = (std::filesystem::path(directorio) / "contador.txt").string();
+	std::FILE* archivo = std::fopen(ruta.c_str(), "r");
+	if (!archivo) {
+		return 0;
+	}
+	unsigned long long contador = 0;
+	if (std::fscanf(archivo, "%llu", &contador) != 1) {
+		contador = 0;
+	}
+	std::fclose(archivo);
+	return static_cast<uint64_t>(contador);
+}
+
+bool AlmacenLocalBanco::registrarContador(uint64_t contador) const {
+	std::string ruta = (std::filesystem::path(directorio) / "contador.txt").string();
+	std::FILE* archivo = std::fopen(ruta.c_str(), "w");
+	if (!archivo) {
+		std::cerr << "Error: No se pudo escribir " << ruta << std::endl;
+		return false;
+	}
+	bool escrito = std::fprintf(archivo, "%llu\n", static_cast<unsigned long long>(contador)) > 0 && forzarADisco(archivo);
+	std::fclose(archivo);
+	return escrito;
+}
+
+bool AlmacenLocalBanco::vacio() {
+	return indiceCedulas.totalClaves() == 0;
+}
+
+bool AlmacenLocalBanco::guardarPersona(const bsoncxx::document::view& documento) {
+	std::string cedula = leerTexto(documento, "cedula");
+	if (cedula.empty()) {
+		std::cerr << "Error: El documento de persona no tiene cédula" << std::endl;
+		return false;
+	}
+
+	auto guardado = sinSaldos(documento);
+	std::lock_guard<std::mutex> lock(mutexDatos);
+	if (!datos) {
+		return false;
+	}
+	auto desplazamiento = agregarDocumento(datos, guardado.view());
+	if (!desplazamiento || !forzarADisco(datos)) {
+		std::cerr << "Error: No se pudo guardar la persona " << cedula << " en el almacén local" << std::endl;
+		return false;
+	}
+
+	// Los datos ya son duraderos: recién ahora se apuntan desde los índices
+	bool indexado = indiceCedulas.insertar(cedula, *desplazamiento);
+	for (const auto& numero : numerosCuenta(documento)) {
+		indexado = indiceCuentas.insertar(numero, *desplazamiento) && indexado;
+	}
+	return indiceCedulas.confirmar() && indiceCuentas.confirmar() && indexado;
+}
+
+bool AlmacenLocalBanco::reconstruirDesde(IRepositorioBanco& repositorio) {
+	std::vector<bsoncxx::document::value> documentos;
+	try {
+		documentos = repositorio.mostrarTodasPersonas();
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al leer las personas para el almacén local: " << e.what() << std::endl;
+		return false;
+	}
+
+	std::filesystem::path base(directorio);
+	std::string rutaDatos = (base / "personas.dat").string();
+	std::string rutaTemporal = rutaDatos + ".tmp";
+	std::FILE* nuevo = std::fopen(rutaTemporal.c_str(), "wb");
+	if (!nuevo) {
+		std::cerr << "Error: No se pudo crear " << rutaTemporal << std::endl;
+		return false;
+	}
+
+	std::vector<std::pair<std::string, uint64_t>> cedulas;
+	std::vector<std::pair<std::string, uint64_t>> cuentas;
+	bool escrito = std::fwrite(FIRMA_DATOS, 1, sizeof(FIRMA_DATOS), nuevo) == sizeof(FIRMA_DATOS);
+	for (const auto& documento : documentos) {
+		if (!escrito) {
+			break;
+		}
+		std::string cedula = leerTexto(documento.view(), "cedula");
+		if (cedula.empty()) {
+			continue;
+		}
+		auto guardado = sinSaldos(documento.view());
+		auto vista = guardado.view();
+		auto desplazamiento = agregarDocumento(nuevo, vista);
+		escrito = desplazamiento.has_value();
+		if (escrito) {
+			cedulas.emplace_back(std::move(cedula), *desplazamiento);
+			for (auto& numero : numerosCuenta(vista)) {
+				cuentas.emplace_back(std::move(numero), *desplazamiento);
+			}
+		}
+	}
+	escrito = escrito && forzarADisco(nuevo);
+	std::fclose(nuevo);
+	if (!escrito) {
+		std::cerr << "Error: No se pudo escribir " << rutaTemporal << std::endl;
+		std::remove(rutaTemporal.c_str());
+		return false;
+	}
+
+	ordenarSinRepetidos(cedulas);
+	ordenarSinRepetidos(cuentas);
+
+	std::lock_guard<std::mutex> lock(mutexDatos);
+	if (datos) {
+		std::fclose(datos);
+		datos = nullptr;
+	}
+	std::error_code error;
+	std::filesystem::rename(rutaTemporal, rutaDatos, error);
+	if (error) {
+		std::cerr << "Error: No se pudo reemplazar " << rutaDatos << ": " << error.message() << std::endl;
+	}
+	return abrirDatos(rutaDatos) && !error &&
+		indiceCedulas.construir(cedulas) &&
+		indiceCuentas.construir(cuentas);
+}
+
+void AlmacenLocalBanco::seguirEscrituras(IRepositorioBanco& repositorio) {
+	if (idObservador != 0) {
+		IRepositorioBanco::eliminarObservadorPersonas(idObservador);
+	}
+	idObservador = IRepositorioBanco::registrarObservadorPersonas([this, &repositorio](const EscrituraPersona& escritura) {
+		// Leer el documento guardado y agregar la versión nueva debe ser atómico por persona
+		std::lock_guard<std::mutex> lock(mutexEscrituras);
+		auto anterior = buscarPorCedula(escritura.persona.getCedula());
+		bsoncxx::document::view vistaAnterior = anterior ? anterior->view() : bsoncxx::document::view();
+		auto documento = escritura.documentoResultante(anterior ? &vistaAnterior : nullptr);
+		if (!documento) {
+			documento = repositorio.buscarPersonaCompletaPorCedula(escritura.persona.getCedula());
+		}
+		if (!leerTexto(documento->view(), "cedula").empty() && guardarPersona(documento->view())) {
+			escriturasSeguidas++;
+		}
+	});
+}
+
+bool AlmacenLocalBanco::sincronizarCon(IRepositorioBanco& repositorio) {
+	if (!indiceCedulas.estaAbierto()) {
+		return false;
+	}
+
+	// Se lee antes de reconstruir para que una escritura concurrente descuadre el contador
+	uint64_t contador = 0;
+	try {
+		contador = repositorio.obtenerContadorCambiosPersonas();
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al leer el contador de cambios de personas: " << e.what() << std::endl;
+	}
+	bool alDia = contador != 0 && contador == leerContadorRegistrado() && !vacio();
+
+	// Hasta el próximo cierre limpio el almacén no se da por confiable
+	registrarContador(0);
+	if (!alDia && !reconstruirDesde(repositorio)) {
+		return false;
+	}
+
+	repositorioSeguido = &repositorio;
+	contadorInicial = contador;
+	escriturasSeguidas = 0;
+	seguirEscrituras(repositorio);
+	return true;
+}
+
+std::optional<bsoncxx::document::value> AlmacenLocalBanco::buscarPorCedula(const std::string& cedula) {
+	uint64_t desplazamiento = 0;
+	if (!indiceCedulas.buscar(cedula, desplazamiento)) {
+		return std::nullopt;
+	}
+	auto documento = leerDocumento(desplazamiento);
+	if (!documento || leerTexto(documento->view(), "cedula") != cedula) {
+		return std::nullopt;
+	}
+	return documento;
+}
+
+std::optional<bsoncxx::document::value> AlmacenLocalBanco::buscarPorNumeroCuenta(const std::string& numeroCuenta) {
+	uint64_t desplazamiento = 0;
+	if (!indiceCuentas.buscar(numeroCuenta, desplazamiento)) {
+		return std::nullopt;
+	}
+	auto documento = leerDocumento(desplazamiento);
+	if (!documento) {
+		return std::nullopt;
+	}
+	auto numeros = numerosCuenta(documento->view());
+	if (std::find(numeros.begin(), numeros.end(), numeroCuenta) == numeros.end()) {
+		return std::nullopt;
+	}
+	return documento;
+}
+
+std::vector<std::string> AlmacenLocalBanco::numerosCuentaConPrefijo(const std::string& prefijo) {
+	std::vector<std::string> numeros;
+	// '~' ordena después de los dígitos: el rango cubre todas las claves con el prefijo
+	for (auto& par : indiceCuentas.rango(prefijo, prefijo + "~")) {
+		numeros.push_back(std::move(par.first));
+	}
+	return numeros;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#ifndef ALMACENLOCALBANCO_H
+#define ALMACENLOCALBANCO_H
+
+#include "IRepositorioBanco.h"
+#include "IndiceDiscoBPlus.h"
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <optional>
+#include <string>
+#include <mutex>
+#include <cstdio>
+#include <atomic>
+#include <vector>
+
+/**
+ * @class AlmacenLocalBanco
+ * @brief Copia local de las personas para operar sin conexión (p. ej. en una sucursal)
+ *
+ * Los documentos de persona se agregan al final de personas.dat; cedulas.idx y
+ * cuentas.idx son índices IndiceDiscoBPlus que llevan la cédula o el número de cuenta
+ * al desplazamiento del documento vigente. Al abrir solo se proyectan los índices, así
+ * que el arranque no depende del tamaño de la base ni de MongoDB.
+ *
+ * Cada documento se fuerza a disco antes de actualizar los índices, de modo que un
+ * índice confirmado nunca apunta a datos perdidos. Las lecturas comprueban que el
+ * documento apuntado corresponda a la clave buscada.
+ *
+ * Solo se siguen las escrituras de personas, no los movimientos de saldo, por lo que
+ * las cuentas se guardan sin el campo saldo.
+ *
+ * contador.txt guarda el contador de cambios de personas del repositorio con el que
+ * el almacén quedó al día en el último cierre limpio; 0 obliga a reconstruirlo.
+ */
+class AlmacenLocalBanco {
+private:
+    IndiceDiscoBPlus indiceCedulas;
+    IndiceDiscoBPlus indiceCuentas;
+    std::FILE* datos;
+    std::string directorio;
+    std::mutex mutexDatos;
+    std::mutex mutexEscrituras;
+    int idObservador;
+    IRepositorioBanco* repositorioSeguido;
+    uint64_t contadorInicial;
+    std::atomic<uint64_t> escriturasSeguidas;
+
+    bool abrirDatos(const std::string& ruta);
+    std::optional<bsoncxx::document::value> leerDocumento(uint64_t desplazamiento);
+    std::optional<uint64_t> agregarDocumento(std::FILE* destino, const bsoncxx::document::view& documento);
+    uint64_t leerContadorRegistrado() const;
+    bool registrarContador(uint64_t contador) const;
+
+    /**
+     * @brief Reemplaza el almacén con todas las personas del repositorio
+     *
+     * Escribe un archivo de datos nuevo sin versiones anteriores y reconstruye ambos
+     * índices con carga masiva.
+     */
+    bool reconstruirDesde(IRepositorioBanco& repositorio);
+
+    /**
+     * @brief Agrega la versión actual de una persona y la apunta desde ambos índices
+     * @param documento Documento de persona con cedula y, opcionalmente, cuentas
+     */
+    bool guardarPersona(const bsoncxx::document::view& documento);
+
+    /**
+     * @brief Aplica cada escritura de persona sobre el documento guardado
+     *
+     * Solo relee la persona del repositorio si el almacén no tiene al titular de una
+     * cuenta agregada.
+     */
+    void seguirEscrituras(IRepositorioBanco& repositorio);
+
+public:
+    AlmacenLocalBanco();
+    ~AlmacenLocalBanco();
+
+    AlmacenLocalBanco(const AlmacenLocalBanco&) = delete;
+    AlmacenLocalBanco& operator=(const AlmacenLocalBanco&) = delete;
+
+    /**
+     * @brief Abre (o crea) el almacén en el directorio indicado
+     * @return true si los datos y ambos índices quedaron listos
+     */
+    bool abrir(const std::string& directorioAlmacen);
+
+    /**
+     * @brief Deja de seguir escrituras, confirma los índices y cierra los archivos
+     *
+     * Si seguía un repositorio, registra su contador de cambios solo cuando todas las
+     * escrituras ocurridas desde sincronizarCon() pasaron por el almacén.
+     */
+    void cerrar();
+
+    /**
+     * @brief Deja el almacén al día con el repositorio y sigue sus escrituras
+     *
+     * Si el contador registrado coincide con el del repositorio solo se usan los
+     * índices ya abiertos; si no, o si el almacén está vacío, se reconstruye.
+     */
+    bool sincronizarCon(IRepositorioBanco& repositorio);
+
+    bool vacio();
+
+    std::optional<bsoncxx::document::value> buscarPorCedula(const std::string& cedula);
+    std::optional<bsoncxx::document::value> buscarPorNumeroCuenta(const std::string& numeroCuenta);
+
+    /**
+     * @brief Números de cuenta guardados que comienzan con el prefijo (p. ej. una sucursal)
+     */
+    std::vector<std::string> numerosCuentaConPrefijo(const std::string& prefijo);
+};
+
+#endif // ALMACENLOCALBANCO_H
@@ -1,5 +1,7 @@
 #include "AplicacionPrincipal.h"
 #include "Utilidades.h"
+#include "AuditoriaAsincrona.h"
+#include "MetricasLatencia.h"
 #include <iostream>
 
 // Variable global para la marquesina (compatibilidad con código existente)
@@ -30,6 +32,7 @@ bool AplicacionPrincipal::inicializarComponentes() {
     // Establecer marquesina global para compatibilidad
     marquesinaGlobal = configurador->getMarquesina();
 
+    MetricasLatencia::setVolcadoAlSalir(MetricasLatencia::ARCHIVO_METRICAS_LATENCIA);
     banco = std::make_unique<Banco>();
     sistemaMenu = std::make_unique<SistemaMenuPrincipal>(*banco);
 
@@ -55,6 +58,8 @@ void AplicacionPrincipal::ejecutarBucleMenu() {
 }
 
 void AplicacionPrincipal::limpiarRecursos() {
+    // Vaciar los registros de auditoría pendientes antes de cerrar conexiones
+    AuditoriaAsincrona::detener();
     if (configurador) {
         configurador->finalizarSistema();
     }
@@ -15,238 +15,368 @@
 #include <chrono>
 #include <queue>
 #include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
 #include "NodoArbolB.h"
+#include "InstantaneaArbol.h"
 #include "Persona.h"
+#include "RegistroPersonas.h"
 
+/**
+ * @struct ExtractorCedulaPersona
+ * @brief Extractor de clave textual: la cédula de la persona como cadena
+ */
+struct ExtractorCedulaPersona {
+	std::string operator()(const Persona* persona) const { return persona->getCedula(); }
+};
+
+/**
+ * @struct ExtractorCedulaEmpaquetada
+ * @brief Extractor de clave por defecto: la cédula empaquetada en un entero de 64 bits
+ *
+ * Usa la misma clave que RegistroPersonas: las cédulas de dígitos llevan su longitud en
+ * los bits altos, así que "0102" y "102" no chocan y, entre cédulas de 10 dígitos, el
+ * orden numérico coincide con el de las cadenas. Cualquier otro texto usa un hash FNV,
+ * que puede repetirse entre cédulas distintas: las búsquedas por cédula confirman el
+ * acierto con confirmar().
+ */
+struct ExtractorCedulaEmpaquetada {
+	/**
+	 * @brief Convierte una cédula a su clave del árbol
+	 * @param cedula Cédula en texto
+	 * @return uint64_t Clave de RegistroPersonas::claveCedula
+	 */
+	static uint64_t empaquetar(const std::string& cedula) {
+		return RegistroPersonas::claveCedula(cedula);
+	}
+
+	/**
+	 * @brief Descarta un acierto por colisión de hash
+	 * @return La persona si su cédula es la buscada; nullptr en otro caso
+	 */
+	static Persona* confirmar(Persona* persona, const std::string& cedula) {
+		return (persona && persona->getCedula() == cedula) ? persona : nullptr;
+	}
+
+	uint64_t operator()(const Persona* persona) const { return empaquetar(persona->getCedula()); }
+};
 
 /**
  * @class ArbolB
- * @brief Implementación didáctica de un Árbol B para propósitos educativos
+ * @brief Árbol B de grado mínimo configurable
+ *
+ * Cada nodo, salvo la raíz, guarda entre GRADO-1 y 2*GRADO-1 claves ordenadas. El grado
+ * es parámetro de plantilla porque fija la capacidad de los nodos, que guardan sus
+ * claves en línea; cualquier GRADO válido se compila con nodos de su tamaño. La
+ * inserción divide de forma preventiva los nodos llenos al descender y la eliminación
+ * presta o fusiona hermanos para que ningún nodo quede por debajo del mínimo, de modo
+ * que todas las hojas están a la misma profundidad.
  *
- * Esta clase implementa una versión simplificada de un Árbol B para
- * ilustrar sus principios básicos de funcionamiento. Permite buscar elementos
- * y visualizar la estructura del árbol.
+ * La clave de cada elemento se extrae una sola vez al insertarlo (ExtractorClave) y se
+ * guarda en el nodo; las búsquedas por clave hacen búsqueda binaria dentro de cada nodo
+ * y descienden por un único camino: O(log n) comparaciones de Clave. Con la clave por
+ * defecto (cédula empaquetada) cada nivel lee solo las líneas de caché de las claves del
+ * nodo y un puntero a hijo; el objeto se consulta únicamente al acertar.
  *
  * @tparam T Tipo de datos almacenados en el árbol
+ * @tparam Clave Tipo de la clave de ordenamiento (debe admitir operator<)
+ * @tparam ExtractorClave Functor que obtiene la Clave de un const T*
+ * @tparam GRADO Grado mínimo del árbol (al menos 2)
  */
-template<typename T>
+template<typename T, typename Clave = uint64_t, typename ExtractorClave = ExtractorCedulaEmpaquetada, int GRADO = 3>
 class ArbolB {
+	static_assert(GRADO >= 2, "El grado mínimo de un árbol B es 2");
+	static_assert(2 * GRADO - 1 < 256, "ArregloFijo admite como máximo 255 claves por nodo");
+
 public:
+	using Nodo = NodoArbolB<T, Clave, 2 * GRADO - 1>;
+
 	/** @brief Nodo raíz del árbol */
-	NodoArbolB<T>* raiz;
-	/** @brief Grado mínimo del árbol (determina el número de claves por nodo) */
-	int grado;
+	Nodo* raiz;
+	/** @brief Grado mínimo del árbol: cada nodo no raíz tiene entre grado-1 y 2*grado-1 claves */
+	static constexpr int grado = GRADO;
 
-	/**
-	 * @brief Busca una clave en un nodo y sus subárboles
-	 *
-	 * @param nodo Nodo actual en el que buscar
-	 * @param valor Valor a buscar
-	 * @param comparador Función para comparar elementos
-	 * @return T* Puntero al objeto encontrado o nullptr si no existe
-	 */
-	T* buscarEnNodo(NodoArbolB<T>* nodo, const std::string& valor,
-		std::function<bool(const T*, const std::string&)> comparador) {
-		if (!nodo) return nullptr;
-
-		// Buscar la clave en el nodo actual
-		for (auto& clave : nodo->claves) {
-			if (comparador(clave, valor)) {
-				return clave;
-			}
-		}
+private:
+	ExtractorClave extractor;
+	size_t totalElementos;
 
-		// Si es hoja y no se encontrO, no existe
-		if (nodo->esHoja) {
-			return nullptr;
-		}
+	int maximoClaves() const { return 2 * grado - 1; }
 
-		// Determinar subArbol donde podrIa estar la clave
-		int i = 0;
-		while (i < nodo->claves.size() && !comparador(nodo->claves[i], valor)) {
-			i++;
-		}
+	/**
+	 * @brief Primera posición del nodo cuya clave no es menor que la buscada (búsqueda binaria)
+	 */
+	static int posicionEnNodo(const Nodo* nodo, const Clave& clave) {
+		return static_cast<int>(std::lower_bound(nodo->valoresClave.begin(), nodo->valoresClave.end(), clave)
+			- nodo->valoresClave.begin());
+	}
 
-		// Buscar en el hijo correspondiente
-		return buscarEnNodo(nodo->hijos[i < nodo->hijos.size() ? i : nodo->hijos.size() - 1], valor, comparador);
+	static bool esIgual(const Nodo* nodo, int posicion, const Clave& clave) {
+		return posicion < nodo->numClaves() && !(clave < nodo->valoresClave[posicion]);
 	}
 
 	/**
-	 * @brief Inserta un elemento en el árbol B, evitando duplicados
+	 * @brief Divide el hijo lleno padre->hijos[indice] y sube su clave central al padre
 	 *
-	 * @param elemento Elemento a insertar
+	 * @param padre Nodo padre (no lleno)
+	 * @param indice Índice del hijo a dividir
 	 */
-	void insertarElemento(T* elemento) {
-		// Si la raíz está vacía, simplemente insertamos el elemento
-		if (!raiz) {
-			raiz = new NodoArbolB<T>(true);
-			raiz->claves.push_back(elemento);
-			return;
+	void dividirHijo(Nodo* padre, int indice) {
+		Nodo* hijo = padre->hijos[indice];
+		Nodo* nuevoNodo = new Nodo(hijo->esHoja);
+
+		// El hermano derecho recibe las claves grado..2*grado-2; la clave grado-1 sube
+		nuevoNodo->valoresClave.assign(std::make_move_iterator(hijo->valoresClave.begin() + grado),
+			std::make_move_iterator(hijo->valoresClave.end()));
+		nuevoNodo->claves.assign(hijo->claves.begin() + grado, hijo->claves.end());
+		if (!hijo->esHoja) {
+			nuevoNodo->hijos.assign(hijo->hijos.begin() + grado, hijo->hijos.end());
+			hijo->hijos.erase(hijo->hijos.begin() + grado, hijo->hijos.end());
 		}
 
-		// Verificar si el elemento ya existe en el árbol
-		if (auto persona = dynamic_cast<Persona*>(elemento)) {
-			// Buscar usando cédula como identificador único
-			std::function<bool(const T*, const std::string&)> comparadorCedula =
-				[](const T* p, const std::string& cedula) {
-				if (auto persona = dynamic_cast<const Persona*>(p)) {
-					return persona->getCedula() == cedula;
-				}
-				return false;
-				};
+		Clave claveCentral = std::move(hijo->valoresClave[grado - 1]);
+		T* elementoCentral = hijo->claves[grado - 1];
+		hijo->valoresClave.erase(hijo->valoresClave.begin() + (grado - 1), hijo->valoresClave.end());
+		hijo->claves.erase(hijo->claves.begin() + (grado - 1), hijo->claves.end());
 
-			if (buscarEnNodo(raiz, persona->getCedula(), comparadorCedula)) {
-				// El elemento ya existe, no lo insertamos
-				return;
-			}
-		}
+		padre->valoresClave.insert(padre->valoresClave.begin() + indice, std::move(claveCentral));
+		padre->claves.insert(padre->claves.begin() + indice, elementoCentral);
+		padre->hijos.insert(padre->hijos.begin() + indice + 1, nuevoNodo);
+	}
 
-		// Si la raíz está llena (tiene 2 claves para grado 3), dividir primero
-		if (raiz->claves.size() == 2) {
-			NodoArbolB<T>* nuevaRaiz = new NodoArbolB<T>(false);
-			nuevaRaiz->hijos.push_back(raiz);
-			dividirHijo(nuevaRaiz, 0);
-			raiz = nuevaRaiz;
+	/**
+	 * @brief Inserta en el subárbol de un nodo no lleno, dividiendo los hijos llenos al bajar
+	 */
+	void insertarNoLleno(Nodo* nodo, Clave clave, T* elemento) {
+		while (!nodo->esHoja) {
+			int i = posicionEnNodo(nodo, clave);
+			if (nodo->hijos[i]->numClaves() == maximoClaves()) {
+				dividirHijo(nodo, i);
+				if (nodo->valoresClave[i] < clave) {
+					i++;
+				}
+			}
+			nodo = nodo->hijos[i];
 		}
 
-		// Ahora insertamos en la raíz (que sabemos que no está llena)
-		insertarNoLleno(raiz, elemento);
+		int i = posicionEnNodo(nodo, clave);
+		nodo->valoresClave.insert(nodo->valoresClave.begin() + i, std::move(clave));
+		nodo->claves.insert(nodo->claves.begin() + i, elemento);
 	}
 
 	/**
-	 * @brief Divide un hijo del nodo cuando está lleno
-	 *
-	 * @param padre Nodo padre
-	 * @param indice Índice del hijo a dividir
+	 * @brief Fusiona hijos[indice], la clave separadora y hijos[indice + 1] en hijos[indice]
 	 */
-	void dividirHijo(NodoArbolB<T>* padre, int indice) {
-		// El hijo que vamos a dividir
-		NodoArbolB<T>* hijo = padre->hijos[indice];
-
-		// Para árbol B de grado 3, el hijo lleno tiene exactamente 2 claves
-		if (hijo->claves.size() != 2) {
-			return; // No debería ocurrir, pero por seguridad
+	void fusionarHijos(Nodo* nodo, int indice) {
+		Nodo* izquierdo = nodo->hijos[indice];
+		Nodo* derecho = nodo->hijos[indice + 1];
+
+		izquierdo->valoresClave.push_back(std::move(nodo->valoresClave[indice]));
+		izquierdo->claves.push_back(nodo->claves[indice]);
+		for (auto& valor : derecho->valoresClave) {
+			izquierdo->valoresClave.push_back(std::move(valor));
 		}
+		izquierdo->claves.insert(izquierdo->claves.end(), derecho->claves.begin(), derecho->claves.end());
+		izquierdo->hijos.insert(izquierdo->hijos.end(), derecho->hijos.begin(), derecho->hijos.end());
 
-		// Crear nuevo nodo para la división (hermano derecho)
-		NodoArbolB<T>* nuevoNodo = new NodoArbolB<T>(hijo->esHoja);
+		nodo->valoresClave.erase(nodo->valoresClave.begin() + indice);
+		nodo->claves.erase(nodo->claves.begin() + indice);
+		nodo->hijos.erase(nodo->hijos.begin() + indice + 1);
 
-		// En grado 3, la clave del medio (índice 1) se promueve al padre
-		T* claveCentral = hijo->claves[1];
+		derecho->hijos.clear(); // Ahora pertenecen al hermano izquierdo
+		delete derecho;
+	}
 
-		// En un árbol B de grado 3, solo hay una clave a la derecha de la central
-		// No agregamos la clave central al nuevo nodo, solo va al padre
-		if (hijo->claves.size() > 1) {
-			nuevoNodo->claves.push_back(hijo->claves[1]); // La segunda clave va al nuevo nodo
+	/**
+	 * @brief Rota una clave del hermano izquierdo hacia hijos[indice] a través del padre
+	 */
+	void prestarDeIzquierdo(Nodo* nodo, int indice) {
+		Nodo* hijo = nodo->hijos[indice];
+		Nodo* hermano = nodo->hijos[indice - 1];
+
+		hijo->valoresClave.insert(hijo->valoresClave.begin(), std::move(nodo->valoresClave[indice - 1]));
+		hijo->claves.insert(hijo->claves.begin(), nodo->claves[indice - 1]);
+		nodo->valoresClave[indice - 1] = std::move(hermano->valoresClave.back());
+		nodo->claves[indice - 1] = hermano->claves.back();
+		hermano->valoresClave.pop_back();
+		hermano->claves.pop_back();
+
+		if (!hermano->esHoja) {
+			hijo->hijos.insert(hijo->hijos.begin(), hermano->hijos.back());
+			hermano->hijos.pop_back();
 		}
+	}
 
-		// Si no es hoja, mover también los hijos correspondientes
-		if (!hijo->esHoja) {
-			nuevoNodo->hijos.push_back(hijo->hijos[1]);
-			nuevoNodo->hijos.push_back(hijo->hijos[2]);
-			// Ajustar hijos del nodo original
-			hijo->hijos.resize(1);
+	/**
+	 * @brief Rota una clave del hermano derecho hacia hijos[indice] a través del padre
+	 */
+	void prestarDeDerecho(Nodo* nodo, int indice) {
+		Nodo* hijo = nodo->hijos[indice];
+		Nodo* hermano = nodo->hijos[indice + 1];
+
+		hijo->valoresClave.push_back(std::move(nodo->valoresClave[indice]));
+		hijo->claves.push_back(nodo->claves[indice]);
+		nodo->valoresClave[indice] = std::move(hermano->valoresClave.front());
+		nodo->claves[indice] = hermano->claves.front();
+		hermano->valoresClave.erase(hermano->valoresClave.begin());
+		hermano->claves.erase(hermano->claves.begin());
+
+		if (!hermano->esHoja) {
+			hijo->hijos.push_back(hermano->hijos.front());
+			hermano->hijos.erase(hermano->hijos.begin());
 		}
-
-		// Ajustar el tamaño del hijo original (mantener solo la clave izquierda)
-		hijo->claves.resize(1);
-
-		// Insertar la clave promovida en el padre en la posición correcta
-		padre->claves.insert(padre->claves.begin() + indice, claveCentral);
-
-		// Insertar el nuevo nodo como hijo del padre
-		padre->hijos.insert(padre->hijos.begin() + indice + 1, nuevoNodo);
 	}
 
 	/**
-	 * @brief Inserta un elemento en un nodo que no está lleno
+	 * @brief Elimina una clave del subárbol de un nodo que tiene al menos grado claves (o es la raíz)
 	 *
-	 * @param nodo Nodo donde insertar
-	 * @param elemento Elemento a insertar
+	 * Antes de descender garantiza que el hijo elegido tenga al menos grado claves,
+	 * prestando de un hermano o fusionando, por lo que nunca hace falta retroceder.
 	 */
-	void insertarNoLleno(NodoArbolB<T>* nodo, T* elemento) {
-		// Verificar duplicados en el nodo actual para Personas
-		Persona* personaElemento = dynamic_cast<Persona*>(elemento);
-		if (personaElemento) {
-			for (auto& clave : nodo->claves) {
-				Persona* personaClave = dynamic_cast<Persona*>(clave);
-				if (personaClave) {
-					if (personaElemento->getCedula() == personaClave->getCedula()) {
-						return; // Duplicado encontrado, no insertamos
-					}
-				}
+	bool eliminarDeNodo(Nodo* nodo, const Clave& clave) {
+		int i = posicionEnNodo(nodo, clave);
+
+		if (esIgual(nodo, i, clave)) {
+			if (nodo->esHoja) {
+				nodo->valoresClave.erase(nodo->valoresClave.begin() + i);
+				nodo->claves.erase(nodo->claves.begin() + i);
+				return true;
 			}
-		}
 
-		// Si es una hoja, insertamos directamente
-		if (nodo->esHoja) {
-			// Encontrar la posición correcta
-			int i = static_cast<int>(nodo->claves.size()) - 1;
-			while (i >= 0 && compararElementos(elemento, nodo->claves[i])) {
-				i--;
+			Nodo* izquierdo = nodo->hijos[i];
+			Nodo* derecho = nodo->hijos[i + 1];
+			if (izquierdo->numClaves() >= grado) {
+				// Reemplazar por el predecesor y eliminarlo del subárbol izquierdo
+				Nodo* actual = izquierdo;
+				while (!actual->esHoja) actual = actual->hijos.back();
+				Clave predecesor = actual->valoresClave.back();
+				nodo->claves[i] = actual->claves.back();
+				nodo->valoresClave[i] = predecesor;
+				return eliminarDeNodo(izquierdo, predecesor);
 			}
-
-			// Insertar en la posición correcta
-			nodo->claves.insert(nodo->claves.begin() + i + 1, elemento);
-			return;
+			if (derecho->numClaves() >= grado) {
+				// Reemplazar por el sucesor y eliminarlo del subárbol derecho
+				Nodo* actual = derecho;
+				while (!actual->esHoja) actual = actual->hijos.front();
+				Clave sucesor = actual->valoresClave.front();
+				nodo->claves[i] = actual->claves.front();
+				nodo->valoresClave[i] = sucesor;
+				return eliminarDeNodo(derecho, sucesor);
+			}
+			fusionarHijos(nodo, i);
+			return eliminarDeNodo(izquierdo, clave);
 		}
 
-		// Si no es hoja, encontrar el hijo donde debería ir
-		int i = static_cast<int>(nodo->claves.size()) - 1;
-		while (i >= 0 && compararElementos(elemento, nodo->claves[i])) {
-			i--;
+		if (nodo->esHoja) {
+			return false;
 		}
-		i++;
-
-		// Verificar si ese hijo está lleno
-		if (nodo->hijos[i]->claves.size() == 2) {
-			// Dividir el hijo lleno antes de insertar
-			dividirHijo(nodo, i);
 
-			// Verificar si la clave promovida es igual al elemento a insertar
-			if (auto personaElemento = dynamic_cast<Persona*>(elemento)) {
-				if (auto personaClave = dynamic_cast<Persona*>(nodo->claves[i])) {
-					if (personaElemento->getCedula() == personaClave->getCedula()) {
-						return; // No insertar duplicado
-					}
-				}
+		if (nodo->hijos[i]->numClaves() < grado) {
+			if (i > 0 && nodo->hijos[i - 1]->numClaves() >= grado) {
+				prestarDeIzquierdo(nodo, i);
 			}
-
-			// Determinar en qué hijo insertar
-			if (compararElementos(nodo->claves[i], elemento)) {
-				i++;
+			else if (i < nodo->numClaves() && nodo->hijos[i + 1]->numClaves() >= grado) {
+				prestarDeDerecho(nodo, i);
+			}
+			else if (i < nodo->numClaves()) {
+				fusionarHijos(nodo, i);
+			}
+			else {
+				fusionarHijos(nodo, i - 1);
+				i--;
 			}
 		}
+		return eliminarDeNodo(nodo->hijos[i], clave);
+	}
 
-		// Insertar recursivamente en el hijo correspondiente
-		insertarNoLleno(nodo->hijos[i], elemento);
+	/**
+	 * @brief Secciones de una instantánea y elementos disponibles, durante cargarInstantanea
+	 */
+	struct RestauracionInstantanea {
+		const InstantaneaArbol::NodoInstantanea* registros;
+		size_t numRegistros;
+		const Clave* valores;
+		size_t numValores;
+		std::vector<std::pair<Clave, T*>> porClave; // Ordenado por clave
+		std::vector<bool> visitados;
+		size_t total;
+	};
+
+	/**
+	 * @brief Dato que debe coincidir entre la instantánea y el árbol que la carga
+	 */
+	uint64_t parametroInstantanea() const {
+		return (static_cast<uint64_t>(sizeof(Clave)) << 32) | static_cast<uint64_t>(grado);
 	}
+
 	/**
-	 * @brief Compara dos elementos para determinar su orden
+	 * @brief Rearma el subárbol del registro indicado; nullptr si la instantánea es inconsistente
 	 *
-	 * @param a Primer elemento
-	 * @param b Segundo elemento
-	 * @return true si a va antes que b
+	 * Cada registro se usa una sola vez y sus hijos siempre están después de él, por lo que
+	 * un archivo dañado no puede formar ciclos ni compartir nodos.
 	 */
-	bool compararElementos(const T* a, const T* b) {
-		// Para personas, comparamos por cédula para mantener orden único
-		if (auto personaA = dynamic_cast<const Persona*>(a)) {
-			if (auto personaB = dynamic_cast<const Persona*>(b)) {
-				return personaA->getCedula() < personaB->getCedula();
+	Nodo* restaurarNodo(RestauracionInstantanea& restauracion, uint32_t indice) const {
+		if (indice >= restauracion.numRegistros || restauracion.visitados[indice]) return nullptr;
+		restauracion.visitados[indice] = true;
+
+		const auto registro = restauracion.registros[indice];
+		bool valido = registro.numClaves >= 1 && registro.numClaves <= static_cast<uint32_t>(maximoClaves()) &&
+			registro.primeraClave <= restauracion.numValores &&
+			registro.numClaves <= restauracion.numValores - registro.primeraClave &&
+			(registro.esHoja ? registro.numHijos == 0 :
+				registro.numHijos == registro.numClaves + 1 && registro.primerHijo > indice &&
+				registro.primerHijo <= restauracion.numRegistros &&
+				registro.numHijos <= restauracion.numRegistros - registro.primerHijo);
+		if (!valido) return nullptr;
+
+		Nodo* nodo = new Nodo(registro.esHoja != 0);
+		for (uint32_t k = 0; k < registro.numClaves; ++k) {
+			const Clave& clave = restauracion.valores[registro.primeraClave + k];
+			auto posicion = std::lower_bound(restauracion.porClave.begin(), restauracion.porClave.end(), clave,
+				[](const std::pair<Clave, T*>& par, const Clave& buscada) { return par.first < buscada; });
+			bool encontrada = posicion != restauracion.porClave.end() && !(clave < posicion->first);
+			bool ordenada = k == 0 || nodo->valoresClave.back() < clave;
+			if (!encontrada || !ordenada) {
+				delete nodo;
+				return nullptr;
 			}
+			nodo->valoresClave.push_back(clave);
+			nodo->claves.push_back(posicion->second);
 		}
+		restauracion.total += registro.numClaves;
 
-		// Si no son del mismo tipo o no se pueden comparar de otra forma
-		return a < b; // Comparación por dirección de memoria
+		for (uint32_t h = 0; h < registro.numHijos; ++h) {
+			Nodo* hijo = restaurarNodo(restauracion, registro.primerHijo + h);
+			if (!hijo) {
+				delete nodo;
+				return nullptr;
+			}
+			nodo->hijos.push_back(hijo);
+		}
+		return nodo;
+	}
+
+	/**
+	 * @brief Recorre el subárbol en orden ascendente; se detiene si la visita devuelve false
+	 */
+	bool recorrerEnOrden(Nodo* nodo, const std::function<bool(T*)>& visita) const {
+		if (!nodo) return true;
+		for (int i = 0; i < nodo->numClaves(); ++i) {
+			if (!nodo->esHoja && !recorrerEnOrden(nodo->hijos[i], visita)) return false;
+			if (!visita(nodo->claves[i])) return false;
+		}
+		return nodo->esHoja || recorrerEnOrden(nodo->hijos.back(), visita);
 	}
 
 public:
 	/**
 	 * @brief Constructor del Árbol B
-	 * @param _grado Grado mínimo del árbol (determina el número de claves por nodo)
+	 * @param _extractor Functor que obtiene la clave de ordenamiento de cada elemento
 	 */
-	ArbolB(int _grado) : raiz(nullptr), grado(_grado) {
-		if (grado < 2) grado = 2; // MInimo grado 2
+	explicit ArbolB(ExtractorClave _extractor = ExtractorClave())
+		: raiz(nullptr), extractor(std::move(_extractor)), totalElementos(0) {
 	}
 
 	/**
@@ -256,9 +386,96 @@ public:
 		if (raiz) delete raiz;
 	}
 
+	ArbolB(const ArbolB&) = delete;
+	ArbolB& operator=(const ArbolB&) = delete;
+
+	/**
+	 * @brief Inserta un elemento en el árbol B, evitando claves duplicadas
+	 *
+	 * @param elemento Elemento a insertar
+	 * @return true si se insertó, false si ya existía un elemento con la misma clave
+	 */
+	bool insertarElemento(T* elemento) {
+		return insertarConClave(extractor(elemento), elemento);
+	}
+
+	/**
+	 * @brief Inserta un elemento cuya clave ya fue extraída
+	 */
+	bool insertarConClave(Clave clave, T* elemento) {
+		if (!raiz) {
+			raiz = new Nodo(true);
+			raiz->valoresClave.push_back(std::move(clave));
+			raiz->claves.push_back(elemento);
+			totalElementos = 1;
+			return true;
+		}
+
+		if (buscarClave(clave)) {
+			return false;
+		}
+
+		// Si la raíz está llena se divide primero: es el único punto donde crece la altura
+		if (raiz->numClaves() == maximoClaves()) {
+			Nodo* nuevaRaiz = new Nodo(false);
+			nuevaRaiz->hijos.push_back(raiz);
+			raiz = nuevaRaiz;
+			dividirHijo(nuevaRaiz, 0);
+		}
+
+		insertarNoLleno(raiz, std::move(clave), elemento);
+		totalElementos++;
+		return true;
+	}
+
+	/**
+	 * @brief Busca un elemento por su clave descendiendo con búsqueda binaria en cada nodo
+	 *
+	 * @param clave Clave a buscar
+	 * @return T* Puntero al objeto encontrado o nullptr si no existe
+	 */
+	T* buscarClave(const Clave& clave) const {
+		Nodo* nodo = raiz;
+		while (nodo) {
+			int i = posicionEnNodo(nodo, clave);
+			if (esIgual(nodo, i, clave)) {
+				return nodo->claves[i];
+			}
+			if (nodo->esHoja) {
+				return nullptr;
+			}
+			nodo = nodo->hijos[i];
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @brief Elimina el elemento con la clave indicada
+	 *
+	 * @param clave Clave del elemento a eliminar
+	 * @return true si se eliminó, false si no existía
+	 */
+	bool eliminarClave(const Clave& clave) {
+		if (!raiz) return false;
+
+		bool eliminado = eliminarDeNodo(raiz, clave);
+
+		// La raíz vacía se reemplaza por su único hijo: es el único punto donde baja la altura
+		if (raiz->claves.empty()) {
+			Nodo* anterior = raiz;
+			raiz = raiz->esHoja ? nullptr : raiz->hijos.front();
+			anterior->hijos.clear();
+			delete anterior;
+		}
+
+		if (eliminado) totalElementos--;
+		return eliminado;
+	}
+
 	/**
 	 * @brief Construye el árbol a partir de un vector de elementos, eliminando duplicados
 	 *
+	 * Extrae cada clave una sola vez, ordena y descarta claves repetidas antes de insertar.
 	 * @param elementos Vector de punteros a los elementos para construir el árbol
 	 */
 	void construirDesdeVector(std::vector<T*>& elementos) {
@@ -267,51 +484,140 @@ public:
 			delete raiz;
 			raiz = nullptr;
 		}
+		totalElementos = 0;
 
 		if (elementos.empty()) {
 			return;
 		}
 
-		// Eliminar duplicados antes de construir el árbol
-		std::vector<T*> elementosUnicos;
-		std::set<std::string> idVistos; // Conjunto para rastrear cédulas ya procesadas
-
+		std::vector<std::pair<Clave, T*>> pares;
+		pares.reserve(elementos.size());
 		for (T* elemento : elementos) {
-			if (auto persona = dynamic_cast<Persona*>(elemento)) {
-				// Usamos cédula como identificador único para Persona
-				std::string identificador = persona->getCedula();
-
-				// Verificar si este identificador ya ha sido procesado
-				if (idVistos.find(identificador) == idVistos.end()) {
-					idVistos.insert(identificador);
-					elementosUnicos.push_back(elemento);
-				}
-			}
-			else {
-				// Para otros tipos, usar la dirección de memoria como criterio de unicidad
-				elementosUnicos.push_back(elemento);
+			pares.emplace_back(extractor(elemento), elemento);
+		}
+
+		// stable_sort conserva el primer elemento de cada clave repetida
+		std::stable_sort(pares.begin(), pares.end(), [](const auto& a, const auto& b) {
+			return a.first < b.first;
+			});
+		pares.erase(std::unique(pares.begin(), pares.end(), [](const auto& a, const auto& b) {
+			return !(a.first < b.first) && !(b.first < a.first);
+			}), pares.end());
+
+		for (auto& par : pares) {
+			insertarConClave(std::move(par.first), par.second);
+		}
+	}
+
+	/**
+	 * @brief Guarda la estructura del árbol (nodos y claves) en una instantánea
+	 *
+	 * Los elementos no se guardan: pertenecen a quien construyó el árbol y al cargar se
+	 * vuelven a asociar por clave.
+	 * @param contadorCambios Contador de cambios de la base con el que coincide el árbol
+	 * @return true si el archivo quedó escrito
+	 */
+	bool guardarInstantanea(const std::string& ruta, uint64_t contadorCambios) const {
+		static_assert(std::is_trivially_copyable<Clave>::value, "La instantánea copia las claves byte a byte");
+		if (!raiz) return false;
+
+		// Recorrido por niveles: los hijos de cada nodo quedan contiguos
+		std::vector<InstantaneaArbol::NodoInstantanea> registros;
+		std::vector<Clave> valores;
+		std::vector<const Nodo*> orden{ raiz };
+		for (size_t i = 0; i < orden.size(); ++i) {
+			const Nodo* nodo = orden[i];
+			InstantaneaArbol::NodoInstantanea registro{};
+			registro.esHoja = nodo->esHoja ? 1 : 0;
+			registro.numClaves = static_cast<uint32_t>(nodo->numClaves());
+			registro.primeraClave = static_cast<uint32_t>(valores.size());
+			valores.insert(valores.end(), nodo->valoresClave.begin(), nodo->valoresClave.end());
+			if (!nodo->esHoja) {
+				registro.primerHijo = static_cast<uint32_t>(orden.size());
+				registro.numHijos = static_cast<uint32_t>(nodo->hijos.size());
+				orden.insert(orden.end(), nodo->hijos.begin(), nodo->hijos.end());
 			}
+			registros.push_back(registro);
 		}
 
-		// Ordenar elementos antes de insertarlos
-		std::sort(elementosUnicos.begin(), elementosUnicos.end(), [this](const T* a, const T* b) {
-			return compararElementos(a, b);
+		const InstantaneaArbol::DatosSeccion secciones[InstantaneaArbol::TOTAL_SECCIONES] = {
+			{ registros.data(), registros.size() * sizeof(registros[0]) },
+			{ valores.data(), valores.size() * sizeof(Clave) },
+			{},
+			{}
+		};
+		return InstantaneaArbol::escribir(ruta, InstantaneaArbol::TIPO_ARBOL_B, contadorCambios,
+			parametroInstantanea(), totalElementos, secciones);
+	}
+
+	/**
+	 * @brief Reemplaza el árbol por el de una instantánea sin reinsertar los elementos
+	 *
+	 * Solo se acepta si fue escrita con el mismo contador de cambios y grado, y si cada
+	 * clave guardada corresponde a uno de los elementos recibidos; en otro caso el árbol
+	 * queda como estaba.
+	 * @param elementos Elementos con los que se construyó el árbol guardado
+	 * @return true si el árbol se restauró
+	 */
+	bool cargarInstantanea(const std::string& ruta, uint64_t contadorCambios, const std::vector<T*>& elementos) {
+		InstantaneaArbol instantanea;
+		if (!instantanea.abrir(ruta, InstantaneaArbol::TIPO_ARBOL_B, contadorCambios, parametroInstantanea())) {
+			return false;
+		}
+
+		RestauracionInstantanea restauracion{};
+		restauracion.registros = instantanea.seccion<InstantaneaArbol::NodoInstantanea>(
+			InstantaneaArbol::NODOS, restauracion.numRegistros);
+		restauracion.valores = instantanea.seccion<Clave>(InstantaneaArbol::CLAVES, restauracion.numValores);
+		if (!restauracion.registros || restauracion.numRegistros == 0 || !restauracion.valores) {
+			return false;
+		}
+		restauracion.visitados.assign(restauracion.numRegistros, false);
+
+		restauracion.porClave.reserve(elementos.size());
+		for (T* elemento : elementos) {
+			restauracion.porClave.emplace_back(extractor(elemento), elemento);
+		}
+		// Igual que construirDesdeVector: ante claves repetidas se conserva el primer elemento
+		std::stable_sort(restauracion.porClave.begin(), restauracion.porClave.end(), [](const auto& a, const auto& b) {
+			return a.first < b.first;
 			});
 
-		// Construir un árbol B con elementos únicos
-		for (auto& elem : elementosUnicos) {
-			insertarElemento(elem);
+		Nodo* nuevaRaiz = restaurarNodo(restauracion, 0);
+		if (!nuevaRaiz) {
+			return false;
 		}
+		if (restauracion.total != instantanea.totalElementos()) {
+			delete nuevaRaiz;
+			return false;
+		}
+
+		if (raiz) delete raiz;
+		raiz = nuevaRaiz;
+		totalElementos = restauracion.total;
+		return true;
 	}
+
 	/**
-	 * @brief Busca un elemento en el árbol
+	 * @brief Busca el primer elemento, en orden de clave, que cumpla un criterio arbitrario
 	 *
+	 * El comparador puede no respetar el orden del árbol (por ejemplo, coincidencias
+	 * parciales de nombre), por lo que el recorrido es completo; para la clave del
+	 * árbol debe usarse buscarClave.
 	 * @param valor Valor a buscar
 	 * @param comparador Función para comparar elementos
 	 * @return T* Puntero al objeto encontrado o nullptr si no existe
 	 */
 	T* buscar(const std::string& valor, std::function<bool(const T*, const std::string&)> comparador) {
-		return buscarEnNodo(raiz, valor, comparador);
+		T* encontrado = nullptr;
+		recorrerEnOrden(raiz, [&](T* elemento) {
+			if (comparador(elemento, valor)) {
+				encontrado = elemento;
+				return false;
+			}
+			return true;
+			});
+		return encontrado;
 	}
 
 	/**
@@ -324,16 +630,16 @@ public:
 		}
 
 		// Recorrer por niveles
-		std::queue<NodoArbolB<T>*> cola;
+		std::queue<Nodo*> cola;
 		cola.push(raiz);
 
 		int nivel = 0;
 		while (!cola.empty()) {
-			int nodosEnNivel = cola.size();
+			int nodosEnNivel = static_cast<int>(cola.size());
 			std::cout << "Nivel " << nivel << ": ";
 
 			for (int i = 0; i < nodosEnNivel; i++) {
-				NodoArbolB<T>* nodoActual = cola.front();
+				Nodo* nodoActual = cola.front();
 				cola.pop();
 
 				// Mostrar claves del nodo
@@ -359,25 +665,23 @@ public:
 	}
 
 	/**
-	 * @brief Calcula la altura aproximada del árbol
-	 * @return int Altura aproximada del árbol
+	 * @brief Calcula la altura del árbol (todas las hojas están al mismo nivel)
+	 * @return int Número de niveles, 0 si está vacío
 	 */
 	int altura() const {
-		if (!raiz) return 0;
-
-		// Aproximamos la altura basada en el número de nodos
-		int nodosEstimados = 0;
-		for (auto& hijo : raiz->hijos) {
-			nodosEstimados++;
-			if (!hijo->esHoja) {
-				nodosEstimados += static_cast<int>(hijo->hijos.size());
-			}
+		int niveles = 0;
+		for (Nodo* nodo = raiz; nodo; nodo = nodo->esHoja ? nullptr : nodo->hijos.front()) {
+			niveles++;
 		}
-
-		// La altura del árbol es aproximadamente log(n)
-		return raiz->hijos.empty() ? 1 : 2 + (nodosEstimados > 0 ? 1 : 0);
+		return niveles;
 	}
 
+	/**
+	 * @brief Número de elementos almacenados
+	 */
+	size_t tamano() const {
+		return totalElementos;
+	}
 
 	/**
 	 * @brief Verifica si el árbol está vacío
@@ -406,7 +710,7 @@ public:
 		SetConsoleCP(CP_UTF8);
 
 		// Calcular la estructura completa del árbol primero para determinar posiciones
-		std::vector<std::vector<NodoArbolB<T>*>> niveles;
+		std::vector<std::vector<Nodo*>> niveles;
 		std::vector<std::vector<std::string>> valoresNodos;
 		std::vector<std::vector<int>> posicionesX;
 
@@ -414,7 +718,7 @@ public:
 		std::set<std::string> nodosVistos;
 
 		// Recorrido por niveles para almacenar todos los nodos
-		std::queue<NodoArbolB<T>*> cola;
+		std::queue<Nodo*> cola;
 		cola.push(raiz);
 
 		HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -422,11 +726,11 @@ public:
 
 		while (!cola.empty()) {
 			int nodosEnNivel = cola.size();
-			std::vector<NodoArbolB<T>*> nivelActual;
+			std::vector<Nodo*> nivelActual;
 			std::vector<std::string> valoresNivel;
 
 			for (int i = 0; i < nodosEnNivel; i++) {
-				NodoArbolB<T>* nodoActual = cola.front();
+				Nodo* nodoActual = cola.front();
 				cola.pop();
 				nivelActual.push_back(nodoActual);
 
@@ -618,72 +922,31 @@ public:
 		// Restaurar configuración de consola original si es necesario
 		// SetConsoleOutputCP(default_cp);
 	}
+
 	/**
-	 * @brief Elimina un elemento del árbol
+	 * @brief Elimina el primer elemento que cumpla un criterio
 	 *
 	 * @param valor Valor a buscar para eliminar
 	 * @param comparador Función para comparar elementos
-	 * @return true si se eliminó correctamente, false si no se encontró o hubo error
+	 * @return true si se eliminó correctamente, false si no se encontró
 	 */
 	bool eliminar(const std::string& valor, std::function<bool(const T*, const std::string&)> comparador) {
-		if (!raiz) return false;
-
-		// Buscar primero para verificar que existe
 		T* aEliminar = buscar(valor, comparador);
 		if (!aEliminar) return false;
-
-		// Para esta implementación simple, vamos a reconstruir el árbol sin el elemento
-		std::vector<T*> elementos;
-		recolectarElementos(raiz, elementos);
-
-		// Eliminar el elemento del vector (evitando duplicados)
-		int eliminados = 0;
-		auto it = std::remove_if(elementos.begin(), elementos.end(),
-			[&](T* elem) {
-				if (comparador(elem, valor)) {
-					// Solo eliminar la primera ocurrencia para evitar eliminar múltiples elementos
-					if (eliminados == 0) {
-						eliminados++;
-						return true;
-					}
-				}
-				return false;
-			});
-
-		if (it != elementos.end()) {
-			elementos.erase(it, elementos.end());
-
-			// Reconstruir árbol
-			if (raiz) delete raiz;
-			raiz = nullptr;
-
-			if (!elementos.empty()) {
-				construirDesdeVector(elementos);
-			}
-
-			return true;
-		}
-
-		return false;
+		return eliminarClave(extractor(aEliminar));
 	}
+
 	/**
-	 * @brief Recolecta todos los elementos del árbol en un vector
+	 * @brief Recolecta todos los elementos del árbol en un vector, en orden de clave
 	 *
-	 * @param nodo Nodo actual en la recursión
+	 * @param nodo Nodo desde el que se recolecta
 	 * @param elementos Vector donde se almacenarán los elementos
 	 */
-	void recolectarElementos(NodoArbolB<T>* nodo, std::vector<T*>& elementos) {
-		if (!nodo) return;
-
-		// Agregar claves del nodo actual
-		for (auto& clave : nodo->claves) {
-			elementos.push_back(clave);
-		}
-
-		// Recorrer hijos recursivamente
-		for (auto& hijo : nodo->hijos) {
-			recolectarElementos(hijo, elementos);
-		}
+	void recolectarElementos(Nodo* nodo, std::vector<T*>& elementos) {
+		recorrerEnOrden(nodo, [&](T* elemento) {
+			elementos.push_back(elemento);
+			return true;
+			});
 	}
 
 };
@@ -36,7 +36,7 @@ void ArbolBGrafico::mostrarAnimadoSFMLGrado3(ArbolB<Persona>* arbol, const std::
         return;
     }
 
-    using NodoPtr = NodoArbolB<Persona>*; // Updated to specify NodoArbolB<Persona>
+    using NodoPtr = ArbolB<Persona>::Nodo*;
     std::vector<std::vector<NodoPtr>> niveles;
     std::queue<NodoPtr> cola;
     if (arbol->raiz == nullptr) return;
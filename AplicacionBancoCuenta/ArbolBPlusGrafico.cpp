@@ -1,11 +1,42 @@
 #include "ArbolBPlusGrafico.h"
 #include "Utilidades.h"
 #include "ConexionMongo.h"
+#include "FabricaRepositorioBanco.h"
+#include "MetricasLatencia.h"
+#include "MetricasMemoria.h"
 #include <algorithm>
+#include <execution>
+#include <numeric>
 #include <iostream>
 #include <memory>
 #include <cmath>
 
+namespace {
+	/**
+	 * @brief Cantidad de grupos en que se reparte un nivel de la carga masiva
+	 *
+	 * Parte de porGrupo elementos por grupo y reduce la cantidad hasta que el reparto
+	 * equitativo deje al menos minimo elementos en cada grupo.
+	 */
+	size_t contarGrupos(size_t total, size_t porGrupo, size_t minimo) {
+		size_t grupos = (total + porGrupo - 1) / porGrupo;
+		while (grupos > 1 && total / grupos < minimo) {
+			grupos--;
+		}
+		return std::max<size_t>(grupos, 1);
+	}
+
+	/**
+	 * @brief Tramo [inicio, fin) del grupo indicado al repartir total elementos en partes casi iguales
+	 */
+	std::pair<size_t, size_t> limitesGrupo(size_t total, size_t grupos, size_t grupo) {
+		size_t base = total / grupos;
+		size_t resto = total % grupos;
+		size_t inicio = grupo * base + std::min(grupo, resto);
+		return { inicio, inicio + base + (grupo < resto ? 1 : 0) };
+	}
+}
+
 // ===== IMPLEMENTACIÓN ManejadorVisualizacion =====
 
 ManejadorVisualizacion::ManejadorVisualizacion(const sf::Vector2u& tamanoVentana)
@@ -122,27 +153,45 @@ std::string RenderizadorNodos::limitarTexto(const std::string& texto, size_t lim
 	return texto.substr(0, limite);
 }
 
+// ===== IMPLEMENTACIÓN extractores =====
+
+std::string ExtractorNombre::extraerClave(const Persona* persona) const {
+	return persona ? Utilidades::NormalizarTexto(persona->getNombres()) : "";
+}
+
+std::string ExtractorNombre::normalizarConsulta(const std::string& consulta) const {
+	return Utilidades::NormalizarTexto(consulta);
+}
+
+std::string ExtractorApellido::extraerClave(const Persona* persona) const {
+	return persona ? Utilidades::NormalizarTexto(persona->getApellidos()) : "";
+}
+
+std::string ExtractorApellido::normalizarConsulta(const std::string& consulta) const {
+	return Utilidades::NormalizarTexto(consulta);
+}
+
+std::string ExtractorFecha::extraerClave(const Persona* persona) const {
+	return persona ? normalizarConsulta(persona->getFechaNacimiento()) : "";
+}
+
+std::string ExtractorFecha::normalizarConsulta(const std::string& consulta) const {
+	// DD/MM/AAAA -> AAAA/MM/DD; cualquier otro texto (p. ej. un prefijo "1990") se deja igual
+	if (consulta.size() == 10 && consulta[2] == '/' && consulta[5] == '/') {
+		return consulta.substr(6, 4) + "/" + consulta.substr(3, 2) + "/" + consulta.substr(0, 2);
+	}
+	return consulta;
+}
+
 // ===== IMPLEMENTACIÓN ArbolBPlus =====
 
 template<typename T>
-ArbolBPlus<T>::ArbolBPlus(_BaseDatosPersona& bd)
-	: baseDatos(bd), primeraHoja(nullptr) {
-
-	// Configurar comparador para Persona por cédula
-	comparador = [](const T* a, const T* b) {
-		if (auto personaA = dynamic_cast<const Persona*>(a)) {
-			if (auto personaB = dynamic_cast<const Persona*>(b)) {
-				return personaA->getCedula() < personaB->getCedula();
-			}
-		}
-		return false;
-		};
+ArbolBPlus<T>::ArbolBPlus(IRepositorioBanco& bd)
+	: primeraHoja(nullptr), ultimaHoja(nullptr), baseDatos(bd), totalElementos(0), factorLlenado(1.0) {
 
+	// Clave por defecto: cédula
 	extractorClave = [](const T* elemento) {
-		if (auto persona = dynamic_cast<const Persona*>(elemento)) {
-			return persona->getCedula();
-		}
-		return std::string();
+		return elemento ? elemento->getCedula() : std::string();
 		};
 }
 
@@ -150,13 +199,21 @@ template<typename T>
 void ArbolBPlus<T>::cargarDesdeBaseDatos(const IExtractorCampo& extractor) {
 	try {
 		auto documentos = baseDatos.mostrarTodasPersonas();
-		std::vector<T*> personas;
+		MetricasMemoria::Instantanea antes = MetricasMemoria::tomar();
+		std::vector<std::pair<std::string, T*>> pares;
+		pares.reserve(documentos.size());
+		propios.clear();
+		poolPropios.liberarTodo();
+		propios.reserve(documentos.size());
+
+		// Las inserciones posteriores usan la misma clave que la carga
+		usarExtractor(extractor);
 
-		// Convertir documentos BSON a objetos Persona
+		// Convertir documentos BSON a objetos Persona, extrayendo su clave una sola vez
 		std::for_each(documentos.begin(), documentos.end(),
-			[&personas](const auto& doc) {
+			[this, &pares, &extractor](const auto& doc) {
 				auto view = doc.view();
-				auto persona = std::make_unique<Persona>(
+				T* persona = poolPropios.crear(
 					std::string(view["cedula"].get_string().value),
 					std::string(view["nombre"].get_string().value),
 					std::string(view["apellido"].get_string().value),
@@ -165,10 +222,20 @@ void ArbolBPlus<T>::cargarDesdeBaseDatos(const IExtractorCampo& extractor) {
 					std::string(view["direccion"].get_string().value)
 				);
 
-				personas.push_back(reinterpret_cast<T*>(persona.release()));
+				// La cédula identifica a la persona: un documento repetido se ignora
+				std::string cedula = persona->getCedula();
+				if (propios.count(cedula)) {
+					poolPropios.destruir(persona);
+					return;
+				}
+
+				std::string clave = extractor.extraerClave(persona);
+				pares.emplace_back(std::move(clave), persona);
+				propios.emplace(std::move(cedula), persona);
 			});
 
-		construir(personas);
+		construirConClaves(pares);
+		MetricasMemoria::registrarCarga("Arbol B+ (base de datos)", antes, MetricasMemoria::tomar());
 
 	}
 	catch (const std::exception& e) {
@@ -178,47 +245,85 @@ void ArbolBPlus<T>::cargarDesdeBaseDatos(const IExtractorCampo& extractor) {
 
 template<typename T>
 void ArbolBPlus<T>::construir(const std::vector<T*>& elementos) {
-	if (elementos.empty()) return;
+	propios.clear();
+	poolPropios.liberarTodo();
+
+	// Extraer cada clave una sola vez, en paralelo, a un arreglo contiguo
+	std::vector<std::pair<std::string, T*>> pares(elementos.size());
+	std::vector<size_t> indices(elementos.size());
+	std::iota(indices.begin(), indices.end(), size_t{ 0 });
+	std::for_each(std::execution::par, indices.begin(), indices.end(),
+		[this, &pares, &elementos](size_t i) {
+			pares[i].first = extractorClave(elementos[i]);
+			pares[i].second = elementos[i];
+		});
+	construirConClaves(pares);
+}
+
+template<typename T>
+void ArbolBPlus<T>::usarExtractor(const IExtractorCampo& extractor) {
+	extractorClave = [&extractor](const T* elemento) { return extractor.extraerClave(elemento); };
+}
 
-	// Ordenar elementos
-	std::vector<T*> elementosOrdenados = elementos;
-	std::sort(elementosOrdenados.begin(), elementosOrdenados.end(), comparador);
+template<typename T>
+void ArbolBPlus<T>::setFactorLlenado(double factor) {
+	factorLlenado = std::max(0.1, std::min(1.0, factor));
+}
 
-	// Construir hojas
-	auto hojas = construirHojas(elementosOrdenados);
+template<typename T>
+void ArbolBPlus<T>::construirConClaves(std::vector<std::pair<std::string, T*>>& pares) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::CONSTRUCCION_ARBOL);
+	vaciar();
+	if (pares.empty()) return;
+	totalElementos = pares.size();
 
-	if (hojas.empty()) return;
+	// Ordenar por la clave ya extraída; stable_sort conserva el orden de llegada de claves repetidas
+	std::stable_sort(std::execution::par, pares.begin(), pares.end(),
+		[](const auto& a, const auto& b) { return a.first < b.first; });
 
-	// Establecer primera hoja
-	primeraHoja = hojas[0].get();
+	// Construir y enlazar hojas
+	auto hojas = construirHojas(pares);
 
-	// Conectar hojas secuencialmente
-	for (size_t i = 0; i < hojas.size() - 1; ++i) {
-		hojas[i]->siguiente = hojas[i + 1].get();
-	}
+	if (hojas.empty()) return;
+
+	// Establecer primera y última hoja
+	primeraHoja = hojas.front().get();
+	ultimaHoja = hojas.back().get();
 
 	// Construir árbol interno
 	raiz = construirArbolInterno(hojas);
 }
 
 template<typename T>
-std::vector<std::unique_ptr<NodoHojaB<T>>> ArbolBPlus<T>::construirHojas(const std::vector<T*>& elementos) {
-	std::vector<std::unique_ptr<NodoHojaB<T>>> hojas;
-
-	auto hojaActual = std::make_unique<NodoHojaB<T>>();
-
-	std::for_each(elementos.begin(), elementos.end(),
-		[&hojas, &hojaActual](T* elemento) {
-			if (hojaActual->datos.size() >= MAX_CLAVES) {
-				hojas.push_back(std::move(hojaActual));
-				hojaActual = std::make_unique<NodoHojaB<T>>();
+std::vector<std::unique_ptr<NodoHojaB<T>>> ArbolBPlus<T>::construirHojas(std::vector<std::pair<std::string, T*>>& pares) {
+	size_t porHoja = static_cast<size_t>(std::lround(MAX_CLAVES * factorLlenado));
+	porHoja = std::max<size_t>(MIN_CLAVES_HOJA, std::min<size_t>(MAX_CLAVES, porHoja));
+	size_t numHojas = contarGrupos(pares.size(), porHoja, MIN_CLAVES_HOJA);
+
+	std::vector<std::unique_ptr<NodoHojaB<T>>> hojas(numHojas);
+	std::vector<size_t> indices(numHojas);
+	std::iota(indices.begin(), indices.end(), size_t{ 0 });
+
+	// Cada hoja toma un tramo disjunto del arreglo ordenado: se llenan en paralelo
+	std::for_each(std::execution::par, indices.begin(), indices.end(),
+		[&pares, &hojas, numHojas](size_t h) {
+			auto limites = limitesGrupo(pares.size(), numHojas, h);
+			auto hoja = std::make_unique<NodoHojaB<T>>();
+			hoja->claves.reserve(limites.second - limites.first);
+			hoja->datos.reserve(limites.second - limites.first);
+			for (size_t i = limites.first; i < limites.second; ++i) {
+				hoja->claves.push_back(std::move(pares[i].first));
+				hoja->datos.push_back(pares[i].second);
 			}
-			hojaActual->datos.push_back(elemento);
+			hojas[h] = std::move(hoja);
 		});
 
-	if (!hojaActual->datos.empty()) {
-		hojas.push_back(std::move(hojaActual));
-	}
+	// Conectar hojas en ambos sentidos
+	std::for_each(std::execution::par, indices.begin(), indices.end(),
+		[&hojas, numHojas](size_t h) {
+			hojas[h]->anterior = h > 0 ? hojas[h - 1].get() : nullptr;
+			hojas[h]->siguiente = h + 1 < numHojas ? hojas[h + 1].get() : nullptr;
+		});
 
 	return hojas;
 }
@@ -233,71 +338,697 @@ std::unique_ptr<NodoInternoB<T>> ArbolBPlus<T>::construirArbolInterno(std::vecto
 		return nodoRaiz;
 	}
 
-	// Crear nodos internos nivel por nivel
+	size_t porNodo = static_cast<size_t>(std::lround(GRADO * factorLlenado));
+	porNodo = std::max<size_t>(MIN_HIJOS, std::min<size_t>(GRADO, porNodo));
+
+	// Crear nodos internos nivel por nivel; minimos[i] es la clave mínima del subárbol nivelActual[i],
+	// que es el separador correcto en el nivel superior (no la primera clave separadora del hijo).
+	// Los nodos de un nivel toman tramos disjuntos del nivel inferior y se arman en paralelo.
 	std::vector<std::unique_ptr<NodoInternoB<T>>> nivelActual;
+	std::vector<std::string> minimos;
 
 	// Primer nivel: nodos que apuntan a hojas
-	for (size_t i = 0; i < hojas.size(); i += GRADO) {
-		auto nodoInterno = std::make_unique<NodoInternoB<T>>();
+	{
+		size_t numNodos = contarGrupos(hojas.size(), porNodo, MIN_HIJOS);
+		nivelActual.resize(numNodos);
+		minimos.resize(numNodos);
+		std::vector<size_t> indices(numNodos);
+		std::iota(indices.begin(), indices.end(), size_t{ 0 });
+		std::for_each(std::execution::par, indices.begin(), indices.end(),
+			[&hojas, &nivelActual, &minimos, numNodos](size_t n) {
+				auto limites = limitesGrupo(hojas.size(), numNodos, n);
+				auto nodoInterno = std::make_unique<NodoInternoB<T>>();
+				minimos[n] = hojas[limites.first]->claves.front();
+				for (size_t j = limites.first; j < limites.second; ++j) {
+					if (j > limites.first) {
+						nodoInterno->claves.push_back(hojas[j]->claves.front());
+					}
+					nodoInterno->hijosHoja.push_back(std::move(hojas[j]));
+				}
+				nivelActual[n] = std::move(nodoInterno);
+			});
+	}
 
-		size_t fin = std::min(i + GRADO, hojas.size());
-		for (size_t j = i; j < fin; ++j) {
-			if (j > i && !hojas[j]->datos.empty()) {
-				nodoInterno->claves.push_back(extractorClave(hojas[j]->datos[0]));
-			}
-			nodoInterno->hijosHoja.push_back(std::move(hojas[j]));
+	// Construir niveles superiores
+	while (nivelActual.size() > 1) {
+		size_t numNodos = contarGrupos(nivelActual.size(), porNodo, MIN_HIJOS);
+		std::vector<std::unique_ptr<NodoInternoB<T>>> siguienteNivel(numNodos);
+		std::vector<std::string> siguientesMinimos(numNodos);
+		std::vector<size_t> indices(numNodos);
+		std::iota(indices.begin(), indices.end(), size_t{ 0 });
+
+		std::for_each(std::execution::par, indices.begin(), indices.end(),
+			[&](size_t n) {
+				auto limites = limitesGrupo(nivelActual.size(), numNodos, n);
+				auto nodoInterno = std::make_unique<NodoInternoB<T>>();
+				siguientesMinimos[n] = minimos[limites.first];
+				for (size_t j = limites.first; j < limites.second; ++j) {
+					if (j > limites.first) {
+						nodoInterno->claves.push_back(minimos[j]);
+					}
+					nodoInterno->hijosInternos.push_back(std::move(nivelActual[j]));
+				}
+				siguienteNivel[n] = std::move(nodoInterno);
+			});
+
+		nivelActual = std::move(siguienteNivel);
+		minimos = std::move(siguientesMinimos);
+	}
+
+	return std::move(nivelActual[0]);
+}
+
+template<typename T>
+void ArbolBPlus<T>::vaciar() {
+	raiz.reset();
+	primeraHoja = nullptr;
+	ultimaHoja = nullptr;
+	totalElementos = 0;
+}
+
+template<typename T>
+void ArbolBPlus<T>::insertar(T* elemento) {
+	std::string clave = extractorClave(elemento);
+
+	// Árbol vacío: raíz con una sola hoja
+	if (!raiz || (raiz->hijosHoja.empty() && raiz->hijosInternos.empty())) {
+		raiz = std::make_unique<NodoInternoB<T>>();
+		auto hoja = std::make_unique<NodoHojaB<T>>();
+		hoja->claves.push_back(std::move(clave));
+		hoja->datos.push_back(elemento);
+		primeraHoja = ultimaHoja = hoja.get();
+		raiz->hijosHoja.push_back(std::move(hoja));
+		totalElementos = 1;
+		return;
+	}
+
+	DivisionB division;
+	if (insertarEnNodo(raiz.get(), clave, elemento, division)) {
+		// La raíz se dividió: es el único punto donde crece la altura
+		auto nuevaRaiz = std::make_unique<NodoInternoB<T>>();
+		nuevaRaiz->claves.push_back(std::move(division.separador));
+		nuevaRaiz->hijosInternos.push_back(std::move(raiz));
+		nuevaRaiz->hijosInternos.push_back(std::move(division.hermano));
+		raiz = std::move(nuevaRaiz);
+	}
+	totalElementos++;
+}
+
+template<typename T>
+bool ArbolBPlus<T>::insertarEnNodo(NodoInternoB<T>* nodo, const std::string& clave, T* elemento, DivisionB& division) {
+	// upper_bound: las claves repetidas se insertan después de las existentes
+	size_t i = static_cast<size_t>(std::upper_bound(nodo->claves.begin(), nodo->claves.end(), clave) - nodo->claves.begin());
+
+	if (!nodo->hijosHoja.empty()) {
+		NodoHojaB<T>* hoja = nodo->hijosHoja[i].get();
+		size_t posicion = static_cast<size_t>(std::upper_bound(hoja->claves.begin(), hoja->claves.end(), clave) - hoja->claves.begin());
+		hoja->claves.insert(hoja->claves.begin() + posicion, clave);
+		hoja->datos.insert(hoja->datos.begin() + posicion, elemento);
+		if (hoja->datos.size() > static_cast<size_t>(MAX_CLAVES)) {
+			dividirHoja(nodo, i);
+		}
+	}
+	else {
+		DivisionB divisionHijo;
+		if (insertarEnNodo(nodo->hijosInternos[i].get(), clave, elemento, divisionHijo)) {
+			nodo->claves.insert(nodo->claves.begin() + i, std::move(divisionHijo.separador));
+			nodo->hijosInternos.insert(nodo->hijosInternos.begin() + i + 1, std::move(divisionHijo.hermano));
 		}
+	}
 
-		nivelActual.push_back(std::move(nodoInterno));
+	size_t numHijos = nodo->hijosHoja.size() + nodo->hijosInternos.size();
+	if (numHijos <= static_cast<size_t>(GRADO)) {
+		return false;
 	}
 
-	// Construir niveles superiores
-	while (nivelActual.size() > 1) {
-		std::vector<std::unique_ptr<NodoInternoB<T>>> siguienteNivel;
+	// Dividir el nodo interno: la mitad derecha pasa al hermano y su separador sube
+	size_t mitad = (numHijos + 1) / 2;
+	division.hermano = std::make_unique<NodoInternoB<T>>();
+	division.separador = std::move(nodo->claves[mitad - 1]);
+	division.hermano->claves.assign(std::make_move_iterator(nodo->claves.begin() + mitad),
+		std::make_move_iterator(nodo->claves.end()));
+	nodo->claves.erase(nodo->claves.begin() + (mitad - 1), nodo->claves.end());
+
+	if (!nodo->hijosHoja.empty()) {
+		division.hermano->hijosHoja.assign(std::make_move_iterator(nodo->hijosHoja.begin() + mitad),
+			std::make_move_iterator(nodo->hijosHoja.end()));
+		nodo->hijosHoja.erase(nodo->hijosHoja.begin() + mitad, nodo->hijosHoja.end());
+	}
+	else {
+		division.hermano->hijosInternos.assign(std::make_move_iterator(nodo->hijosInternos.begin() + mitad),
+			std::make_move_iterator(nodo->hijosInternos.end()));
+		nodo->hijosInternos.erase(nodo->hijosInternos.begin() + mitad, nodo->hijosInternos.end());
+	}
+	return true;
+}
+
+template<typename T>
+void ArbolBPlus<T>::dividirHoja(NodoInternoB<T>* nodo, size_t indice) {
+	NodoHojaB<T>* hoja = nodo->hijosHoja[indice].get();
+	auto nueva = std::make_unique<NodoHojaB<T>>();
+
+	size_t mitad = (hoja->datos.size() + 1) / 2;
+	nueva->claves.assign(std::make_move_iterator(hoja->claves.begin() + mitad),
+		std::make_move_iterator(hoja->claves.end()));
+	nueva->datos.assign(hoja->datos.begin() + mitad, hoja->datos.end());
+	hoja->claves.erase(hoja->claves.begin() + mitad, hoja->claves.end());
+	hoja->datos.erase(hoja->datos.begin() + mitad, hoja->datos.end());
+
+	// Enlazar la hoja nueva a continuación de la dividida
+	nueva->anterior = hoja;
+	nueva->siguiente = hoja->siguiente;
+	if (hoja->siguiente) {
+		hoja->siguiente->anterior = nueva.get();
+	}
+	else {
+		ultimaHoja = nueva.get();
+	}
+	hoja->siguiente = nueva.get();
+
+	nodo->claves.insert(nodo->claves.begin() + indice, nueva->claves.front());
+	nodo->hijosHoja.insert(nodo->hijosHoja.begin() + indice + 1, std::move(nueva));
+}
 
-		for (size_t i = 0; i < nivelActual.size(); i += GRADO) {
-			auto nodoInterno = std::make_unique<NodoInternoB<T>>();
+template<typename T>
+bool ArbolBPlus<T>::eliminar(const std::string& clave, const T* elemento) {
+	if (!raiz || !eliminarEnNodo(raiz.get(), clave, elemento)) {
+		return false;
+	}
+	totalElementos--;
+
+	// Reducir la altura mientras la raíz tenga un único hijo interno
+	while (raiz->hijosHoja.empty() && raiz->hijosInternos.size() == 1) {
+		std::unique_ptr<NodoInternoB<T>> hijo = std::move(raiz->hijosInternos.front());
+		raiz = std::move(hijo);
+	}
+	if (raiz->hijosHoja.empty() && raiz->hijosInternos.empty()) {
+		vaciar();
+	}
+	return true;
+}
 
-			size_t fin = std::min(i + GRADO, nivelActual.size());
-			for (size_t j = i; j < fin; ++j) {
-				if (j > i && !nivelActual[j]->claves.empty()) {
-					nodoInterno->claves.push_back(nivelActual[j]->claves[0]);
+template<typename T>
+bool ArbolBPlus<T>::eliminarEnNodo(NodoInternoB<T>* nodo, const std::string& clave, const T* elemento) {
+	// Con claves repetidas el elemento puede estar en cualquier hijo entre ambas cotas
+	size_t desde = static_cast<size_t>(std::lower_bound(nodo->claves.begin(), nodo->claves.end(), clave) - nodo->claves.begin());
+	size_t hasta = static_cast<size_t>(std::upper_bound(nodo->claves.begin(), nodo->claves.end(), clave) - nodo->claves.begin());
+
+	for (size_t i = desde; i <= hasta; ++i) {
+		if (!nodo->hijosHoja.empty()) {
+			if (i >= nodo->hijosHoja.size()) break;
+			NodoHojaB<T>* hoja = nodo->hijosHoja[i].get();
+			auto rangoIguales = std::equal_range(hoja->claves.begin(), hoja->claves.end(), clave);
+			for (auto it = rangoIguales.first; it != rangoIguales.second; ++it) {
+				size_t posicion = static_cast<size_t>(it - hoja->claves.begin());
+				if (!elemento || hoja->datos[posicion] == elemento) {
+					hoja->claves.erase(hoja->claves.begin() + posicion);
+					hoja->datos.erase(hoja->datos.begin() + posicion);
+					rebalancearHoja(nodo, i);
+					return true;
 				}
-				nodoInterno->hijosInternos.push_back(std::move(nivelActual[j]));
 			}
+		}
+		else {
+			if (i >= nodo->hijosInternos.size()) break;
+			if (eliminarEnNodo(nodo->hijosInternos[i].get(), clave, elemento)) {
+				rebalancearInterno(nodo, i);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+template<typename T>
+void ArbolBPlus<T>::desenlazarHoja(NodoHojaB<T>* hoja) {
+	if (hoja->anterior) hoja->anterior->siguiente = hoja->siguiente;
+	else primeraHoja = hoja->siguiente;
+	if (hoja->siguiente) hoja->siguiente->anterior = hoja->anterior;
+	else ultimaHoja = hoja->anterior;
+}
+
+template<typename T>
+void ArbolBPlus<T>::rebalancearHoja(NodoInternoB<T>* nodo, size_t indice) {
+	NodoHojaB<T>* hoja = nodo->hijosHoja[indice].get();
+	if (hoja->datos.size() >= static_cast<size_t>(MIN_CLAVES_HOJA)) {
+		return;
+	}
 
-			siguienteNivel.push_back(std::move(nodoInterno));
+	NodoHojaB<T>* izquierda = indice > 0 ? nodo->hijosHoja[indice - 1].get() : nullptr;
+	NodoHojaB<T>* derecha = indice + 1 < nodo->hijosHoja.size() ? nodo->hijosHoja[indice + 1].get() : nullptr;
+
+	// Redistribuir desde un hermano con claves de sobra
+	if (izquierda && izquierda->datos.size() > static_cast<size_t>(MIN_CLAVES_HOJA)) {
+		hoja->claves.insert(hoja->claves.begin(), std::move(izquierda->claves.back()));
+		hoja->datos.insert(hoja->datos.begin(), izquierda->datos.back());
+		izquierda->claves.pop_back();
+		izquierda->datos.pop_back();
+		nodo->claves[indice - 1] = hoja->claves.front();
+		return;
+	}
+	if (derecha && derecha->datos.size() > static_cast<size_t>(MIN_CLAVES_HOJA)) {
+		hoja->claves.push_back(std::move(derecha->claves.front()));
+		hoja->datos.push_back(derecha->datos.front());
+		derecha->claves.erase(derecha->claves.begin());
+		derecha->datos.erase(derecha->datos.begin());
+		nodo->claves[indice] = derecha->claves.front();
+		return;
+	}
+
+	// Fusionar con un hermano; si no hay hermanos y la hoja quedó vacía, se retira
+	size_t indiceIzquierdo;
+	if (izquierda) indiceIzquierdo = indice - 1;
+	else if (derecha) indiceIzquierdo = indice;
+	else {
+		if (hoja->datos.empty()) {
+			desenlazarHoja(hoja);
+			nodo->hijosHoja.clear();
+			nodo->claves.clear();
 		}
+		return;
+	}
 
-		nivelActual = std::move(siguienteNivel);
+	NodoHojaB<T>* destino = nodo->hijosHoja[indiceIzquierdo].get();
+	NodoHojaB<T>* origen = nodo->hijosHoja[indiceIzquierdo + 1].get();
+	destino->claves.insert(destino->claves.end(), std::make_move_iterator(origen->claves.begin()),
+		std::make_move_iterator(origen->claves.end()));
+	destino->datos.insert(destino->datos.end(), origen->datos.begin(), origen->datos.end());
+	desenlazarHoja(origen);
+	nodo->claves.erase(nodo->claves.begin() + indiceIzquierdo);
+	nodo->hijosHoja.erase(nodo->hijosHoja.begin() + indiceIzquierdo + 1);
+}
+
+template<typename T>
+void ArbolBPlus<T>::rebalancearInterno(NodoInternoB<T>* nodo, size_t indice) {
+	auto numHijos = [](const NodoInternoB<T>* n) { return n->hijosHoja.size() + n->hijosInternos.size(); };
+
+	NodoInternoB<T>* hijo = nodo->hijosInternos[indice].get();
+	if (numHijos(hijo) >= static_cast<size_t>(MIN_HIJOS)) {
+		return;
 	}
 
-	return std::move(nivelActual[0]);
+	// Un hijo sin descendientes (su única hoja se vació) se retira junto con un separador
+	if (numHijos(hijo) == 0) {
+		nodo->hijosInternos.erase(nodo->hijosInternos.begin() + indice);
+		if (!nodo->claves.empty()) {
+			nodo->claves.erase(nodo->claves.begin() + (indice > 0 ? indice - 1 : 0));
+		}
+		return;
+	}
+
+	NodoInternoB<T>* izquierdo = indice > 0 ? nodo->hijosInternos[indice - 1].get() : nullptr;
+	NodoInternoB<T>* derecho = indice + 1 < nodo->hijosInternos.size() ? nodo->hijosInternos[indice + 1].get() : nullptr;
+	bool deHojas = !hijo->hijosHoja.empty();
+
+	// Rotar un hijo desde un hermano a través del separador del padre
+	if (izquierdo && numHijos(izquierdo) > static_cast<size_t>(MIN_HIJOS)) {
+		hijo->claves.insert(hijo->claves.begin(), std::move(nodo->claves[indice - 1]));
+		nodo->claves[indice - 1] = std::move(izquierdo->claves.back());
+		izquierdo->claves.pop_back();
+		if (deHojas) {
+			hijo->hijosHoja.insert(hijo->hijosHoja.begin(), std::move(izquierdo->hijosHoja.back()));
+			izquierdo->hijosHoja.pop_back();
+		}
+		else {
+			hijo->hijosInternos.insert(hijo->hijosInternos.begin(), std::move(izquierdo->hijosInternos.back()));
+			izquierdo->hijosInternos.pop_back();
+		}
+		return;
+	}
+	if (derecho && numHijos(derecho) > static_cast<size_t>(MIN_HIJOS)) {
+		hijo->claves.push_back(std::move(nodo->claves[indice]));
+		nodo->claves[indice] = std::move(derecho->claves.front());
+		derecho->claves.erase(derecho->claves.begin());
+		if (deHojas) {
+			hijo->hijosHoja.push_back(std::move(derecho->hijosHoja.front()));
+			derecho->hijosHoja.erase(derecho->hijosHoja.begin());
+		}
+		else {
+			hijo->hijosInternos.push_back(std::move(derecho->hijosInternos.front()));
+			derecho->hijosInternos.erase(derecho->hijosInternos.begin());
+		}
+		return;
+	}
+
+	// Fusionar con un hermano bajando el separador
+	if (!izquierdo && !derecho) {
+		return;
+	}
+	size_t indiceIzquierdo = izquierdo ? indice - 1 : indice;
+	NodoInternoB<T>* destino = nodo->hijosInternos[indiceIzquierdo].get();
+	NodoInternoB<T>* origen = nodo->hijosInternos[indiceIzquierdo + 1].get();
+
+	destino->claves.push_back(std::move(nodo->claves[indiceIzquierdo]));
+	destino->claves.insert(destino->claves.end(), std::make_move_iterator(origen->claves.begin()),
+		std::make_move_iterator(origen->claves.end()));
+	destino->hijosHoja.insert(destino->hijosHoja.end(), std::make_move_iterator(origen->hijosHoja.begin()),
+		std::make_move_iterator(origen->hijosHoja.end()));
+	destino->hijosInternos.insert(destino->hijosInternos.end(), std::make_move_iterator(origen->hijosInternos.begin()),
+		std::make_move_iterator(origen->hijosInternos.end()));
+
+	nodo->claves.erase(nodo->claves.begin() + indiceIzquierdo);
+	nodo->hijosInternos.erase(nodo->hijosInternos.begin() + indiceIzquierdo + 1);
 }
 
 template<typename T>
-T* ArbolBPlus<T>::buscar(const std::string& clave) const {
-	const NodoHojaB<T>* hoja = primeraHoja;
+void ArbolBPlus<T>::actualizar(const std::string& claveAnterior, T* elemento) {
+	eliminar(claveAnterior, elemento);
+	insertar(elemento);
+}
 
-	while (hoja) {
-		auto encontrado = std::find_if(hoja->datos.begin(), hoja->datos.end(),
-			[&clave, this](const T* elemento) {
-				return extractorClave(elemento) == clave;
-			});
+template<typename T>
+void ArbolBPlus<T>::adoptar(T* elemento) {
+	std::string cedula = elemento->getCedula();
+	auto existente = propios.find(cedula);
+	if (existente != propios.end()) {
+		eliminar(extractorClave(existente->second), existente->second);
+		poolPropios.destruir(existente->second);
+		existente->second = elemento;
+	}
+	else {
+		propios.emplace(std::move(cedula), elemento);
+	}
+	insertar(elemento);
+}
 
-		if (encontrado != hoja->datos.end()) {
-			return *encontrado;
+template<typename T>
+typename ArbolBPlus<T>::Iterador ArbolBPlus<T>::cotaInferior(const std::string& clave, bool estricto) const {
+	const NodoInternoB<T>* nodo = raiz.get();
+	if (!nodo || !primeraHoja) return end();
+
+	// Descenso: el hijo i contiene las claves en [claves[i-1], claves[i]]. Con claves repetidas
+	// que cruzan un separador, lower_bound elige el hijo más a la izquierda que puede contenerlas
+	const NodoHojaB<T>* hoja = nullptr;
+	while (!hoja) {
+		auto separador = estricto
+			? std::upper_bound(nodo->claves.begin(), nodo->claves.end(), clave)
+			: std::lower_bound(nodo->claves.begin(), nodo->claves.end(), clave);
+		size_t i = static_cast<size_t>(separador - nodo->claves.begin());
+
+		if (!nodo->hijosHoja.empty()) {
+			hoja = nodo->hijosHoja[std::min(i, nodo->hijosHoja.size() - 1)].get();
 		}
+		else {
+			nodo = nodo->hijosInternos[std::min(i, nodo->hijosInternos.size() - 1)].get();
+		}
+	}
 
-		hoja = hoja->siguiente;
+	// Búsqueda binaria dentro de la hoja; si todas sus claves son menores, el resultado
+	// es el primer elemento de la hoja siguiente
+	auto posicion = estricto
+		? std::upper_bound(hoja->claves.begin(), hoja->claves.end(), clave)
+		: std::lower_bound(hoja->claves.begin(), hoja->claves.end(), clave);
+	size_t indice = static_cast<size_t>(posicion - hoja->claves.begin());
+	if (indice >= hoja->datos.size()) {
+		return Iterador(hoja->siguiente, 0, ultimaHoja);
 	}
+	return Iterador(hoja, indice, ultimaHoja);
+}
 
+template<typename T>
+T* ArbolBPlus<T>::buscar(const std::string& clave) const {
+	Iterador posicion = cotaInferior(clave, false);
+	if (posicion != end() && posicion.clave() == clave) {
+		return *posicion;
+	}
 	return nullptr;
 }
 
+template<typename T>
+typename ArbolBPlus<T>::Rango ArbolBPlus<T>::rango(const std::string& desde, const std::string& hasta) const {
+	if (hasta < desde) return Rango{ end(), end() };
+	return Rango{ cotaInferior(desde, false), cotaInferior(hasta, true) };
+}
+
+template<typename T>
+typename ArbolBPlus<T>::Rango ArbolBPlus<T>::rangoPrefijo(const std::string& prefijo) const {
+	Iterador inicio = cotaInferior(prefijo, false);
+
+	// El final es la primera clave >= al menor texto mayor que todo texto con el prefijo:
+	// se incrementa el último carácter que no sea 0xFF y se descarta lo que sigue
+	std::string limite = prefijo;
+	while (!limite.empty() && static_cast<unsigned char>(limite.back()) == 0xFF) {
+		limite.pop_back();
+	}
+	if (limite.empty()) {
+		return Rango{ inicio, end() };
+	}
+	limite.back() = static_cast<char>(static_cast<unsigned char>(limite.back()) + 1);
+	return Rango{ inicio, cotaInferior(limite, false) };
+}
+
+// ----- Instantáneas -----
+
+template<typename T>
+struct ArbolBPlus<T>::ContextoRestauracion {
+	const InstantaneaArbol& instantanea;
+	const InstantaneaArbol::NodoInstantanea* nodos = nullptr;
+	size_t numNodos = 0;
+	const InstantaneaArbol::ClaveTexto* claves = nullptr;
+	size_t numClaves = 0;
+	std::vector<T*> elementos;
+	std::vector<bool> visitados;
+	NodoHojaB<T>* primeraHoja = nullptr;
+	NodoHojaB<T>* ultimaHoja = nullptr;
+	size_t totalDatos = 0;
+
+	explicit ContextoRestauracion(const InstantaneaArbol& origen) : instantanea(origen) {}
+
+	/**
+	 * @brief Valida el registro de un nodo antes de usarlo; cada nodo se toma una sola vez,
+	 * así un archivo dañado no puede compartir ni repetir subárboles
+	 */
+	bool tomarNodo(uint32_t indice, bool hoja) {
+		if (indice >= numNodos || visitados[indice]) return false;
+		const auto& nodo = nodos[indice];
+		if ((nodo.esHoja != 0) != hoja) return false;
+		if (nodo.primeraClave > numClaves || nodo.numClaves > numClaves - nodo.primeraClave) return false;
+		if (hoja ? nodo.numHijos != 0 :
+			nodo.numHijos > 0 && (nodo.primerHijo <= indice || nodo.primerHijo > numNodos || nodo.numHijos > numNodos - nodo.primerHijo)) {
+			return false;
+		}
+		visitados[indice] = true;
+		return true;
+	}
+};
+
+namespace {
+	// Campos de persona guardados por elemento: cédula, nombre, apellido, fecha, correo y dirección
+	constexpr size_t CAMPOS_ELEMENTO = 6;
+}
+
+template<typename T>
+bool ArbolBPlus<T>::guardarInstantanea(const std::string& ruta, uint64_t contadorCambios, const IExtractorCampo& extractor) const {
+	if (!raiz) {
+		return false;
+	}
+
+	InstantaneaArbol::TablaTextos textos;
+	std::vector<InstantaneaArbol::NodoInstantanea> nodos;
+	std::vector<InstantaneaArbol::ClaveTexto> claves;
+	std::vector<InstantaneaArbol::RefTexto> elementos;
+	std::unordered_map<const T*, uint32_t> indiceElemento;
+
+	auto registrarElemento = [&](const T* elemento) {
+		auto existente = indiceElemento.find(elemento);
+		if (existente != indiceElemento.end()) {
+			return existente->second;
+		}
+		uint32_t indice = static_cast<uint32_t>(elementos.size() / CAMPOS_ELEMENTO);
+		elementos.push_back(textos.agregar(elemento->getCedula()));
+		elementos.push_back(textos.agregar(elemento->getNombres()));
+		elementos.push_back(textos.agregar(elemento->getApellidos()));
+		elementos.push_back(textos.agregar(elemento->getFechaNacimiento()));
+		elementos.push_back(textos.agregar(elemento->getCorreo()));
+		elementos.push_back(textos.agregar(elemento->getDireccion()));
+		indiceElemento.emplace(elemento, indice);
+		return indice;
+	};
+
+	// Recorrido por niveles: los hijos de cada nodo se agregan contiguos al final de la cola
+	struct Pendiente {
+		const NodoInternoB<T>* interno;
+		const NodoHojaB<T>* hoja;
+	};
+	std::vector<Pendiente> orden{ Pendiente{ raiz.get(), nullptr } };
+	for (size_t i = 0; i < orden.size(); ++i) {
+		InstantaneaArbol::NodoInstantanea nodo{};
+		nodo.primeraClave = static_cast<uint32_t>(claves.size());
+
+		if (const NodoHojaB<T>* hoja = orden[i].hoja) {
+			nodo.esHoja = 1;
+			nodo.numClaves = static_cast<uint32_t>(hoja->claves.size());
+			for (size_t j = 0; j < hoja->claves.size(); ++j) {
+				claves.push_back({ textos.agregar(hoja->claves[j]), registrarElemento(hoja->datos[j]), 0 });
+			}
+		}
+		else {
+			const NodoInternoB<T>* interno = orden[i].interno;
+			nodo.numClaves = static_cast<uint32_t>(interno->claves.size());
+			for (const auto& clave : interno->claves) {
+				claves.push_back({ textos.agregar(clave), InstantaneaArbol::SIN_ELEMENTO, 0 });
+			}
+			nodo.primerHijo = static_cast<uint32_t>(orden.size());
+			for (const auto& hijo : interno->hijosInternos) {
+				orden.push_back(Pendiente{ hijo.get(), nullptr });
+			}
+			for (const auto& hijo : interno->hijosHoja) {
+				orden.push_back(Pendiente{ nullptr, hijo.get() });
+			}
+			nodo.numHijos = static_cast<uint32_t>(orden.size()) - nodo.primerHijo;
+		}
+		nodos.push_back(nodo);
+	}
+
+	if (textos.obtenerDatos().size() > UINT32_MAX) {
+		std::cerr << "Error: El árbol excede el tamaño admitido por la instantánea" << std::endl;
+		return false;
+	}
+
+	const InstantaneaArbol::DatosSeccion secciones[InstantaneaArbol::TOTAL_SECCIONES] = {
+		{ nodos.data(), nodos.size() * sizeof(nodos[0]) },
+		{ claves.data(), claves.size() * sizeof(claves[0]) },
+		{ textos.obtenerDatos().data(), textos.obtenerDatos().size() },
+		{ elementos.data(), elementos.size() * sizeof(elementos[0]) }
+	};
+	return InstantaneaArbol::escribir(ruta, InstantaneaArbol::TIPO_ARBOL_B_PLUS, contadorCambios,
+		InstantaneaArbol::huella(extractor.obtenerNombre()), totalElementos, secciones);
+}
+
+template<typename T>
+bool ArbolBPlus<T>::cargarInstantanea(const std::string& ruta, uint64_t contadorCambios, const IExtractorCampo& extractor) {
+	InstantaneaArbol instantanea;
+	if (!instantanea.abrir(ruta, InstantaneaArbol::TIPO_ARBOL_B_PLUS, contadorCambios,
+		InstantaneaArbol::huella(extractor.obtenerNombre()))) {
+		return false;
+	}
+
+	ContextoRestauracion contexto(instantanea);
+	contexto.nodos = instantanea.seccion<InstantaneaArbol::NodoInstantanea>(InstantaneaArbol::NODOS, contexto.numNodos);
+	contexto.claves = instantanea.seccion<InstantaneaArbol::ClaveTexto>(InstantaneaArbol::CLAVES, contexto.numClaves);
+	size_t numCampos = 0;
+	const auto* campos = instantanea.seccion<InstantaneaArbol::RefTexto>(InstantaneaArbol::ELEMENTOS, numCampos);
+	if (!contexto.nodos || contexto.numNodos == 0 || !contexto.claves || !campos || numCampos % CAMPOS_ELEMENTO != 0) {
+		return false;
+	}
+	contexto.visitados.assign(contexto.numNodos, false);
+
+	MetricasMemoria::Instantanea antes = MetricasMemoria::tomar();
+	PoolObjetos<T> nuevoPool;
+	std::unordered_map<std::string, T*> nuevos;
+	nuevos.reserve(numCampos / CAMPOS_ELEMENTO);
+	contexto.elementos.reserve(numCampos / CAMPOS_ELEMENTO);
+	std::string valores[CAMPOS_ELEMENTO];
+	for (size_t i = 0; i < numCampos; i += CAMPOS_ELEMENTO) {
+		for (size_t campo = 0; campo < CAMPOS_ELEMENTO; ++campo) {
+			if (!instantanea.leerTexto(campos[i + campo], valores[campo])) {
+				return false;
+			}
+		}
+		T* elemento = nuevoPool.crear(valores[0], valores[1], valores[2], valores[3], valores[4], valores[5]);
+		contexto.elementos.push_back(elemento);
+		if (!nuevos.emplace(valores[0], elemento).second) {
+			return false;
+		}
+	}
+
+	auto nuevaRaiz = restaurarInterno(contexto, 0);
+	if (!nuevaRaiz || contexto.totalDatos != instantanea.totalElementos()) {
+		return false;
+	}
+
+	vaciar();
+	raiz = std::move(nuevaRaiz);
+	primeraHoja = contexto.primeraHoja;
+	ultimaHoja = contexto.ultimaHoja;
+	totalElementos = contexto.totalDatos;
+	propios = std::move(nuevos);
+	poolPropios = std::move(nuevoPool);
+	usarExtractor(extractor);
+	MetricasMemoria::registrarCarga("Arbol B+ (instantanea)", antes, MetricasMemoria::tomar());
+	return true;
+}
+
+template<typename T>
+std::unique_ptr<NodoInternoB<T>> ArbolBPlus<T>::restaurarInterno(ContextoRestauracion& contexto, uint32_t indice) {
+	if (!contexto.tomarNodo(indice, false)) {
+		return nullptr;
+	}
+	const auto registro = contexto.nodos[indice];
+
+	// Solo la raíz de un árbol vacío puede no tener hijos
+	bool consistente = registro.numHijos == 0
+		? indice == 0 && registro.numClaves == 0
+		: registro.numClaves == registro.numHijos - 1;
+	if (!consistente) {
+		return nullptr;
+	}
+
+	auto nodo = std::make_unique<NodoInternoB<T>>();
+	nodo->claves.resize(registro.numClaves);
+	for (uint32_t k = 0; k < registro.numClaves; ++k) {
+		const auto& clave = contexto.claves[registro.primeraClave + k];
+		if (clave.elemento != InstantaneaArbol::SIN_ELEMENTO || !contexto.instantanea.leerTexto(clave.texto, nodo->claves[k])) {
+			return nullptr;
+		}
+	}
+
+	// Todos los hijos de un nodo son del mismo tipo; el primero decide cuál
+	bool hijosHoja = registro.numHijos > 0 && contexto.nodos[registro.primerHijo].esHoja != 0;
+	for (uint32_t h = 0; h < registro.numHijos; ++h) {
+		if (hijosHoja) {
+			auto hoja = restaurarHoja(contexto, registro.primerHijo + h);
+			if (!hoja) return nullptr;
+			nodo->hijosHoja.push_back(std::move(hoja));
+		}
+		else {
+			auto hijo = restaurarInterno(contexto, registro.primerHijo + h);
+			if (!hijo) return nullptr;
+			nodo->hijosInternos.push_back(std::move(hijo));
+		}
+	}
+	return nodo;
+}
+
+template<typename T>
+std::unique_ptr<NodoHojaB<T>> ArbolBPlus<T>::restaurarHoja(ContextoRestauracion& contexto, uint32_t indice) {
+	if (!contexto.tomarNodo(indice, true) || contexto.nodos[indice].numClaves == 0) {
+		return nullptr;
+	}
+	const auto registro = contexto.nodos[indice];
+
+	auto hoja = std::make_unique<NodoHojaB<T>>();
+	hoja->claves.resize(registro.numClaves);
+	hoja->datos.reserve(registro.numClaves);
+	for (uint32_t k = 0; k < registro.numClaves; ++k) {
+		const auto& clave = contexto.claves[registro.primeraClave + k];
+		if (clave.elemento >= contexto.elementos.size() || !contexto.instantanea.leerTexto(clave.texto, hoja->claves[k])) {
+			return nullptr;
+		}
+		// Las hojas se visitan de izquierda a derecha: las claves deben llegar ordenadas
+		const std::string* anterior = k > 0 ? &hoja->claves[k - 1]
+			: (contexto.ultimaHoja ? &contexto.ultimaHoja->claves.back() : nullptr);
+		if (anterior && hoja->claves[k] < *anterior) {
+			return nullptr;
+		}
+		hoja->datos.push_back(contexto.elementos[clave.elemento]);
+	}
+
+	hoja->anterior = contexto.ultimaHoja;
+	if (contexto.ultimaHoja) {
+		contexto.ultimaHoja->siguiente = hoja.get();
+	}
+	else {
+		contexto.primeraHoja = hoja.get();
+	}
+	contexto.ultimaHoja = hoja.get();
+	contexto.totalDatos += registro.numClaves;
+	return hoja;
+}
+
 // ===== IMPLEMENTACIÓN ArbolBPlusGrafico =====
 
-void ArbolBPlusGrafico::mostrarAnimadoSFMLGrado3(_BaseDatosPersona& baseDatos, const std::string& elementoResaltado, int selCriterio) {
+void ArbolBPlusGrafico::mostrarAnimadoSFMLGrado3(IRepositorioBanco& baseDatos, const std::string& elementoResaltado, int selCriterio) {
 	sf::RenderWindow ventana(sf::VideoMode(1400, 800),
 		"Árbol B+ Gráfico (Grado 3) - Base de Datos",
 		sf::Style::Titlebar | sf::Style::Close | sf::Style::Resize);
@@ -309,12 +1040,9 @@ void ArbolBPlusGrafico::mostrarAnimadoSFMLGrado3(_BaseDatosPersona& baseDatos, c
 		return;
 	}
 
-	// Crear extractor según criterio
-	auto extractor = crearExtractor(selCriterio);
-
-	// Crear árbol B+ y cargar datos
-	ArbolBPlus<Persona> arbol(baseDatos);
-	arbol.cargarDesdeBaseDatos(*extractor);
+	// Árbol del criterio: solo la primera apertura consulta la base de datos
+	const IExtractorCampo* extractor = nullptr;
+	ArbolBPlus<Persona>& arbol = obtenerArbolSincronizado(selCriterio, extractor);
 
 	// Crear manejadores
 	ManejadorVisualizacion manejadorVista(ventana.getSize());
@@ -355,6 +1083,76 @@ void ArbolBPlusGrafico::mostrarAnimadoSFMLGrado3(_BaseDatosPersona& baseDatos, c
 	}
 }
 
+ArbolBPlus<Persona>& ArbolBPlusGrafico::obtenerArbolSincronizado(int criterio, const IExtractorCampo*& extractor) {
+	/**
+	 * @brief Árbol de un criterio junto con el extractor que usa para sus claves
+	 */
+	struct ArbolCriterio {
+		std::unique_ptr<IExtractorCampo> extractor;
+		std::unique_ptr<ArbolBPlus<Persona>> arbol;
+		int idObservador = 0;
+		uint64_t contadorCarga = 0;        // Contador de cambios con el que se armó el árbol
+		uint64_t escriturasAplicadas = 0;  // Escrituras aplicadas por el observador desde entonces
+
+		~ArbolCriterio() {
+			if (idObservador != 0) {
+				IRepositorioBanco::eliminarObservadorPersonas(idObservador);
+			}
+		}
+	};
+	static constexpr int TOTAL_CRITERIOS = 4;
+	IRepositorioBanco& baseDatosArboles = FabricaRepositorioBanco::obtenerRepositorio();
+	static ArbolCriterio arboles[TOTAL_CRITERIOS];
+
+	if (criterio < 0 || criterio >= TOTAL_CRITERIOS) criterio = 0;
+	ArbolCriterio& entrada = arboles[criterio];
+
+	// Un cambio que no pasó por el observador (una restauración, otro proceso) deja el
+	// contador distinto de la carga más las escrituras aplicadas. Sin contador (0) se
+	// confía en el observador. El contador se lee antes de la carga para que una
+	// escritura concurrente invalide el árbol armado.
+	uint64_t contadorCambios = baseDatosArboles.obtenerContadorCambiosPersonas();
+	bool vigente = entrada.arbol &&
+		(contadorCambios == 0 || contadorCambios == entrada.contadorCarga + entrada.escriturasAplicadas);
+
+	if (!vigente) {
+		if (entrada.idObservador != 0) {
+			IRepositorioBanco::eliminarObservadorPersonas(entrada.idObservador);
+			entrada.idObservador = 0;
+		}
+		if (!entrada.extractor) {
+			entrada.extractor = crearExtractor(criterio);
+		}
+		entrada.arbol = std::make_unique<ArbolBPlus<Persona>>(baseDatosArboles);
+
+		// Mientras la base no cambie se reutiliza la instantánea del último armado
+		std::string rutaInstantanea = "arbolbplus_" + std::to_string(criterio) + ".snap";
+		bool restaurado = contadorCambios != 0 &&
+			entrada.arbol->cargarInstantanea(rutaInstantanea, contadorCambios, *entrada.extractor);
+		if (!restaurado) {
+			entrada.arbol->cargarDesdeBaseDatos(*entrada.extractor);
+			if (contadorCambios != 0) {
+				entrada.arbol->guardarInstantanea(rutaInstantanea, contadorCambios, *entrada.extractor);
+			}
+		}
+		entrada.contadorCarga = contadorCambios;
+		entrada.escriturasAplicadas = 0;
+
+		// Cada escritura de persona se aplica al árbol en lugar de recargarlo al abrir la vista
+		ArbolCriterio* sincronizada = &entrada;
+		entrada.idObservador = IRepositorioBanco::registrarObservadorPersonas([sincronizada](const EscrituraPersona& escritura) {
+			const Persona& persona = escritura.persona;
+			sincronizada->arbol->insertarOActualizar(
+				persona.getCedula(), persona.getNombres(), persona.getApellidos(),
+				persona.getFechaNacimiento(), persona.getCorreo(), persona.getDireccion());
+			sincronizada->escriturasAplicadas++;
+		});
+	}
+
+	extractor = entrada.extractor.get();
+	return *entrada.arbol;
+}
+
 std::unique_ptr<IExtractorCampo> ArbolBPlusGrafico::crearExtractor(int criterio) {
 	switch (criterio) {
 	case 0: return std::make_unique<ExtractorCedula>();
@@ -3,7 +3,9 @@
 #define ARBOLBPLUSGRAFICO_H
 
 #include "Persona.h"
-#include "_BaseDatosPersona.h"
+#include "IRepositorioBanco.h"
+#include "InstantaneaArbol.h"
+#include "PoolObjetos.h"
 #include "SFML/Graphics.hpp"
 #include "SFML/Window.hpp"
 #include "SFML/System.hpp"
@@ -11,16 +13,24 @@
 #include <string>
 #include <memory>
 #include <functional>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
 
 /**
- * @brief Nodo hoja especializado para árbol B+ que contiene datos y puntero al siguiente
+ * @brief Nodo hoja especializado para árbol B+ que contiene datos y punteros a sus vecinas
+ *
+ * claves[i] es la clave de ordenamiento ya extraída de datos[i]; las hojas forman una
+ * lista doblemente enlazada para recorrer rangos en ambos sentidos.
  */
 template<typename T>
 struct NodoHojaB {
+    std::vector<std::string> claves;
     std::vector<T*> datos;
     NodoHojaB<T>* siguiente;
+    NodoHojaB<T>* anterior;
 
-    explicit NodoHojaB() : siguiente(nullptr) {}
+    explicit NodoHojaB() : siguiente(nullptr), anterior(nullptr) {}
     ~NodoHojaB() = default;
 };
 
@@ -39,12 +49,18 @@ struct NodoInternoB {
 
 /**
  * @brief Estrategia para extraer diferentes campos de Persona
+ *
+ * extraer devuelve el texto que se muestra; extraerClave devuelve la clave con la
+ * que se ordena el árbol y normalizarConsulta lleva un texto ingresado por el
+ * usuario a ese mismo formato, para que búsquedas y rangos comparen claves iguales.
  */
 class IExtractorCampo {
 public:
     virtual ~IExtractorCampo() = default;
     virtual std::string extraer(const Persona* persona) const = 0;
     virtual std::string obtenerNombre() const = 0;
+    virtual std::string extraerClave(const Persona* persona) const { return extraer(persona); }
+    virtual std::string normalizarConsulta(const std::string& consulta) const { return consulta; }
 };
 
 /**
@@ -93,38 +109,253 @@ private:
     std::string limitarTexto(const std::string& texto, size_t limite = 3) const;
 };
 
+/**
+ * @brief Iterador bidireccional sobre las hojas enlazadas de un árbol B+
+ *
+ * Una posición es (hoja, índice); la posición final es la hoja nula. Retroceder
+ * desde el final lleva al último elemento de la última hoja.
+ */
+template<typename T>
+class IteradorHojasB {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = T*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T* const*;
+    using reference = T* const&;
+
+    IteradorHojasB() = default;
+    IteradorHojasB(const NodoHojaB<T>* hoja, size_t indice, const NodoHojaB<T>* ultimaHoja)
+        : hoja(hoja), indice(indice), ultimaHoja(ultimaHoja) {}
+
+    reference operator*() const { return hoja->datos[indice]; }
+    const std::string& clave() const { return hoja->claves[indice]; }
+
+    IteradorHojasB& operator++() {
+        if (++indice >= hoja->datos.size()) {
+            hoja = hoja->siguiente;
+            indice = 0;
+        }
+        return *this;
+    }
+
+    IteradorHojasB& operator--() {
+        if (!hoja) {
+            hoja = ultimaHoja;
+            indice = hoja->datos.size() - 1;
+        }
+        else if (indice == 0) {
+            hoja = hoja->anterior;
+            indice = hoja->datos.size() - 1;
+        }
+        else {
+            --indice;
+        }
+        return *this;
+    }
+
+    IteradorHojasB operator++(int) { IteradorHojasB copia = *this; ++(*this); return copia; }
+    IteradorHojasB operator--(int) { IteradorHojasB copia = *this; --(*this); return copia; }
+
+    bool operator==(const IteradorHojasB& otro) const { return hoja == otro.hoja && indice == otro.indice; }
+    bool operator!=(const IteradorHojasB& otro) const { return !(*this == otro); }
+
+private:
+    const NodoHojaB<T>* hoja = nullptr;
+    size_t indice = 0;
+    const NodoHojaB<T>* ultimaHoja = nullptr;
+};
+
+/**
+ * @brief Rango [inicio, fin) de un árbol B+, utilizable en un for por rango
+ */
+template<typename T>
+struct RangoHojasB {
+    IteradorHojasB<T> inicio;
+    IteradorHojasB<T> fin;
+
+    IteradorHojasB<T> begin() const { return inicio; }
+    IteradorHojasB<T> end() const { return fin; }
+    bool vacio() const { return inicio == fin; }
+};
+
 /**
  * @brief Árbol B+ especializado para grado 3 con integración a base de datos
+ *
+ * La carga masiva extrae las claves a un arreglo contiguo, lo ordena y arma cada
+ * nivel en paralelo (std::execution::par): cada hoja o nodo toma un tramo disjunto.
+ *
+ * Las claves se extraen una sola vez al construir y se guardan en las hojas; los
+ * nodos internos guardan como separador la clave mínima de cada hijo derecho. buscar
+ * y rango descienden con búsqueda binaria (O(log n)) y luego avanzan por las hojas
+ * enlazadas (O(k) para k resultados).
+ *
+ * Además de la carga masiva admite inserción y eliminación incrementales: las hojas
+ * se dividen al superar MAX_CLAVES y los nodos se redistribuyen o fusionan al quedar
+ * por debajo del mínimo, de modo que un árbol de larga vida puede seguir los cambios
+ * de la base de datos sin reconstruirse.
  */
 template<typename T>
 class ArbolBPlus {
 private:
     static constexpr int GRADO = 3;
     static constexpr int MAX_CLAVES = GRADO - 1;
+    static constexpr int MIN_CLAVES_HOJA = (MAX_CLAVES + 1) / 2;
+    static constexpr int MIN_HIJOS = (GRADO + 1) / 2;
+
+    /**
+     * @brief Resultado de dividir un nodo interno: separador y hermano derecho nuevo
+     */
+    struct DivisionB {
+        std::string separador;
+        std::unique_ptr<NodoInternoB<T>> hermano;
+    };
 
     std::unique_ptr<NodoInternoB<T>> raiz;
     NodoHojaB<T>* primeraHoja;
-    _BaseDatosPersona& baseDatos;
+    NodoHojaB<T>* ultimaHoja;
+    IRepositorioBanco& baseDatos;
+    size_t totalElementos;
+    double factorLlenado;
 
-    std::function<bool(const T*, const T*)> comparador;
     std::function<std::string(const T*)> extractorClave;
 
+    // Elementos cuya memoria pertenece al árbol (cargados de la base o insertados con
+    // insertarOActualizar), indexados por cédula; viven en poolPropios y se liberan
+    // en lote al recargar
+    PoolObjetos<T> poolPropios;
+    std::unordered_map<std::string, T*> propios;
+
 public:
-    explicit ArbolBPlus(_BaseDatosPersona& bd);
+    using Iterador = IteradorHojasB<T>;
+    using Rango = RangoHojasB<T>;
+
+    explicit ArbolBPlus(IRepositorioBanco& bd);
     ~ArbolBPlus() = default;
 
+    ArbolBPlus(const ArbolBPlus&) = delete;
+    ArbolBPlus& operator=(const ArbolBPlus&) = delete;
+
+    /**
+     * @brief Carga todas las personas de la base, ordenadas por la clave del extractor
+     *
+     * El árbol adopta el extractor para las inserciones posteriores, por lo que este
+     * debe vivir al menos tanto como el árbol.
+     */
     void cargarDesdeBaseDatos(const IExtractorCampo& extractor);
     void construir(const std::vector<T*>& elementos);
+
+    /**
+     * @brief Ordena construir e insertar por la clave del extractor, sin cargar la base
+     *
+     * Para árboles cuyos elementos pertenecen a otro (p. ej. GestorIndices); el
+     * extractor debe vivir al menos tanto como el árbol.
+     */
+    void usarExtractor(const IExtractorCampo& extractor);
+
+    /**
+     * @brief Inserta un elemento (no adoptado) en su posición; las claves repetidas quedan
+     * después de las existentes
+     */
+    void insertar(T* elemento);
+
+    /**
+     * @brief Elimina un elemento concreto; con claves repetidas se identifica por puntero
+     * @param clave Clave con la que se insertó el elemento
+     * @param elemento Elemento a eliminar, o nullptr para el primero con esa clave
+     * @return true si se eliminó, false si no estaba
+     */
+    bool eliminar(const std::string& clave, const T* elemento = nullptr);
+
+    /**
+     * @brief Reubica un elemento cuya clave pudo cambiar
+     * @param claveAnterior Clave con la que está guardado actualmente
+     * @param elemento Elemento con sus datos ya actualizados
+     */
+    void actualizar(const std::string& claveAnterior, T* elemento);
+
+    /**
+     * @brief Crea un elemento propio con los argumentos dados; si ya hay uno con la
+     * misma cédula lo reemplaza
+     */
+    template<typename... Argumentos>
+    void insertarOActualizar(Argumentos&&... argumentos) {
+        adoptar(poolPropios.crear(std::forward<Argumentos>(argumentos)...));
+    }
+
+    size_t tamano() const { return totalElementos; }
+
+    /**
+     * @brief Fracción de la capacidad que la carga masiva ocupa en hojas y nodos internos
+     *
+     * Con 1.0 (por defecto) el árbol queda lo más compacto posible; valores menores dejan
+     * espacio para inserciones posteriores sin dividir. Se limita a [0.1, 1.0].
+     */
+    void setFactorLlenado(double factor);
+
+    /**
+     * @brief Busca el primer elemento cuya clave es exactamente la indicada
+     * @return T* Elemento encontrado o nullptr
+     */
     T* buscar(const std::string& clave) const;
 
+    /**
+     * @brief Elementos con clave en [desde, hasta], en orden ascendente
+     */
+    Rango rango(const std::string& desde, const std::string& hasta) const;
+
+    /**
+     * @brief Elementos cuya clave comienza con el prefijo indicado
+     */
+    Rango rangoPrefijo(const std::string& prefijo) const;
+
+    Iterador begin() const { return Iterador(primeraHoja, 0, ultimaHoja); }
+    Iterador end() const { return Iterador(nullptr, 0, ultimaHoja); }
+
+    /**
+     * @brief Guarda la estructura actual (nodos, claves y personas) en una instantánea
+     * @param contadorCambios Contador de cambios de la base con el que coincide el árbol
+     * @param extractor Extractor con el que se construyó; su nombre queda en la cabecera
+     */
+    bool guardarInstantanea(const std::string& ruta, uint64_t contadorCambios, const IExtractorCampo& extractor) const;
+
+    /**
+     * @brief Reemplaza el árbol por el de una instantánea, sin consultar la base ni ordenar
+     *
+     * Solo se acepta si fue escrita con el mismo contador de cambios y extractor; en
+     * cualquier otro caso el árbol queda como estaba. Los elementos pasan a ser propios.
+     * @return true si el árbol se restauró
+     */
+    bool cargarInstantanea(const std::string& ruta, uint64_t contadorCambios, const IExtractorCampo& extractor);
+
     const NodoInternoB<T>* obtenerRaiz() const { return raiz.get(); }
     const NodoHojaB<T>* obtenerPrimeraHoja() const { return primeraHoja; }
 
 private:
-    //void insertarEnNodo(NodoHojaB<T>*& nodo, T* elemento);
-    //void dividirHoja(NodoHojaB<T>*& nodo);
-    std::vector<std::unique_ptr<NodoHojaB<T>>> construirHojas(const std::vector<T*>& elementos);
+    void adoptar(T* elemento);
+    void construirConClaves(std::vector<std::pair<std::string, T*>>& pares);
+    std::vector<std::unique_ptr<NodoHojaB<T>>> construirHojas(std::vector<std::pair<std::string, T*>>& pares);
     std::unique_ptr<NodoInternoB<T>> construirArbolInterno(std::vector<std::unique_ptr<NodoHojaB<T>>>& hojas);
+
+    bool insertarEnNodo(NodoInternoB<T>* nodo, const std::string& clave, T* elemento, DivisionB& division);
+    bool eliminarEnNodo(NodoInternoB<T>* nodo, const std::string& clave, const T* elemento);
+    void dividirHoja(NodoInternoB<T>* nodo, size_t indice);
+    void rebalancearHoja(NodoInternoB<T>* nodo, size_t indice);
+    void rebalancearInterno(NodoInternoB<T>* nodo, size_t indice);
+    void desenlazarHoja(NodoHojaB<T>* hoja);
+    void vaciar();
+
+    /**
+     * @brief Estado de una restauración desde instantánea (secciones y hojas enlazadas)
+     */
+    struct ContextoRestauracion;
+    std::unique_ptr<NodoInternoB<T>> restaurarInterno(ContextoRestauracion& contexto, uint32_t indice);
+    std::unique_ptr<NodoHojaB<T>> restaurarHoja(ContextoRestauracion& contexto, uint32_t indice);
+
+    /**
+     * @brief Primera posición con clave >= clave (si estricto, > clave)
+     */
+    Iterador cotaInferior(const std::string& clave, bool estricto) const;
 };
 
 /**
@@ -132,11 +363,20 @@ private:
  */
 class ArbolBPlusGrafico {
 public:
-    static void mostrarAnimadoSFMLGrado3(_BaseDatosPersona& baseDatos,
+    static void mostrarAnimadoSFMLGrado3(IRepositorioBanco& baseDatos,
         const std::string& elementoResaltado = "",
         int selCriterio = 0);
 
 private:
+    /**
+     * @brief Árbol de larga vida del criterio, sincronizado con las escrituras del repositorio
+     *
+     * La primera apertura de cada criterio restaura la instantánea del criterio si la base
+     * no cambió desde que se escribió, o carga la base y escribe una nueva; las siguientes
+     * reutilizan el árbol, que se mantiene al día con el observador de personas. Si el
+     * contador de cambios indica escrituras que el observador no vio, se vuelve a armar.
+     */
+    static ArbolBPlus<Persona>& obtenerArbolSincronizado(int criterio, const IExtractorCampo*& extractor);
     static std::unique_ptr<IExtractorCampo> crearExtractor(int criterio);
     static void manejarEventos(sf::RenderWindow& ventana, std::string& busqueda,
         bool& busquedaActiva, ArbolBPlus<Persona>& arbol,
@@ -161,6 +401,8 @@ public:
         return persona ? persona->getNombres().substr(0, 3) : "";
     }
     std::string obtenerNombre() const override { return "Nombre"; }
+    std::string extraerClave(const Persona* persona) const override;
+    std::string normalizarConsulta(const std::string& consulta) const override;
 };
 
 class ExtractorApellido : public IExtractorCampo {
@@ -169,14 +411,21 @@ public:
         return persona ? persona->getApellidos().substr(0, 3) : "";
     }
     std::string obtenerNombre() const override { return "Apellido"; }
+    std::string extraerClave(const Persona* persona) const override;
+    std::string normalizarConsulta(const std::string& consulta) const override;
 };
 
+/**
+ * @brief Ordena por fecha como AAAA/MM/DD; así un prefijo "1990" o "1990/03" es un rango
+ */
 class ExtractorFecha : public IExtractorCampo {
 public:
     std::string extraer(const Persona* persona) const override {
         return persona ? persona->getFechaNacimiento() : "";
     }
     std::string obtenerNombre() const override { return "Fecha"; }
+    std::string extraerClave(const Persona* persona) const override;
+    std::string normalizarConsulta(const std::string& consulta) const override;
 };
 
 #endif // ARBOLBPLUSGRAFICO_H
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+ * @file ArbolPrefijos.cpp
+ * @brief Implementación del árbol de prefijos comprimido para autocompletar
+ */
+#include "ArbolPrefijos.h"
+#include <algorithm>
+
+namespace {
+	/**
+	 * @brief Longitud del prefijo común entre etiqueta y clave a partir de posicion
+	 */
+	size_t prefijoComun(const std::string& etiqueta, const std::string& clave, size_t posicion) {
+		size_t comun = 0;
+		while (comun < etiqueta.size() && posicion + comun < clave.size() &&
+			etiqueta[comun] == clave[posicion + comun]) {
+			comun++;
+		}
+		return comun;
+	}
+}
+
+ArbolPrefijos::ArbolPrefijos() : raiz(std::make_unique<Nodo>()), clavesDistintas(0) {
+}
+
+ArbolPrefijos::~ArbolPrefijos() = default;
+
+void ArbolPrefijos::limpiar() {
+	raiz = std::make_unique<Nodo>();
+	clavesDistintas = 0;
+}
+
+bool ArbolPrefijos::antes(const Nodo* a, const Nodo* b) {
+	return a->total != b->total ? a->total > b->total : a->clave < b->clave;
+}
+
+size_t ArbolPrefijos::posicionHijo(const Nodo* nodo, unsigned char primero) {
+	auto posicion = std::lower_bound(nodo->hijos.begin(), nodo->hijos.end(), primero,
+		[](const std::unique_ptr<Nodo>& hijo, unsigned char byte) {
+			return static_cast<unsigned char>(hijo->etiqueta[0]) < byte;
+		});
+	return static_cast<size_t>(posicion - nodo->hijos.begin());
+}
+
+/**
+ * @brief Rehace la lista de mejores de un nodo a partir de la suya propia y la de sus hijos
+ */
+void ArbolPrefijos::recalcular(Nodo* nodo) {
+	std::vector<const Nodo*> candidatos;
+	if (nodo->total > 0) {
+		candidatos.push_back(nodo);
+	}
+	for (const auto& hijo : nodo->hijos) {
+		candidatos.insert(candidatos.end(), hijo->mejores.begin(), hijo->mejores.end());
+	}
+
+	size_t conservar = std::min(candidatos.size(), MAX_SUGERENCIAS);
+	std::partial_sort(candidatos.begin(), candidatos.begin() + conservar, candidatos.end(), antes);
+	candidatos.resize(conservar);
+	nodo->mejores = std::move(candidatos);
+}
+
+void ArbolPrefijos::insertar(const std::string& clave, size_t cantidad) {
+	if (cantidad == 0) {
+		return;
+	}
+	insertarEn(raiz.get(), clave, 0, cantidad);
+}
+
+void ArbolPrefijos::insertarEn(Nodo* nodo, const std::string& clave, size_t posicion, size_t cantidad) {
+	if (posicion == clave.size()) {
+		if (nodo->total == 0) {
+			nodo->clave = clave;
+			clavesDistintas++;
+		}
+		nodo->total += cantidad;
+		recalcular(nodo);
+		return;
+	}
+
+	unsigned char primero = static_cast<unsigned char>(clave[posicion]);
+	size_t indice = posicionHijo(nodo, primero);
+	if (indice == nodo->hijos.size() || static_cast<unsigned char>(nodo->hijos[indice]->etiqueta[0]) != primero) {
+		// Ningún hijo comparte el siguiente carácter: el resto de la clave es una hoja nueva
+		auto hoja = std::make_unique<Nodo>();
+		hoja->etiqueta = clave.substr(posicion);
+		hoja->clave = clave;
+		hoja->total = cantidad;
+		recalcular(hoja.get());
+		nodo->hijos.insert(nodo->hijos.begin() + indice, std::move(hoja));
+		clavesDistintas++;
+		recalcular(nodo);
+		return;
+	}
+
+	Nodo* hijo = nodo->hijos[indice].get();
+	size_t comun = prefijoComun(hijo->etiqueta, clave, posicion);
+	if (comun < hijo->etiqueta.size()) {
+		// La clave se separa a mitad de la arista: se intercala un nodo en el punto de corte
+		auto intermedio = std::make_unique<Nodo>();
+		intermedio->etiqueta = hijo->etiqueta.substr(0, comun);
+		std::unique_ptr<Nodo> resto = std::move(nodo->hijos[indice]);
+		resto->etiqueta.erase(0, comun);
+		intermedio->hijos.push_back(std::move(resto));
+		recalcular(intermedio.get());
+		hijo = intermedio.get();
+		nodo->hijos[indice] = std::move(intermedio);
+	}
+
+	insertarEn(hijo, clave, posicion + comun, cantidad);
+	recalcular(nodo);
+}
+
+bool ArbolPrefijos::eliminar(const std::string& clave, size_t cantidad) {
+	if (cantidad == 0) {
+		return contar(clave) > 0;
+	}
+	return eliminarEn(raiz.get(), clave, 0, cantidad);
+}
+
+bool ArbolPrefijos::eliminarEn(Nodo* nodo, const std::string& clave, size_t posicion, size_t cantidad) {
+	if (posicion == clave.size()) {
+		if (nodo->total == 0) {
+			return false;
+		}
+		nodo->total -= std::min(cantidad, nodo->total);
+		if (nodo->total == 0) {
+			nodo->clave.clear();
+			clavesDistintas--;
+		}
+		recalcular(nodo);
+		return true;
+	}
+
+	unsigned char primero = static_cast<unsigned char>(clave[posicion]);
+	size_t indice = posicionHijo(nodo, primero);
+	if (indice == nodo->hijos.size()) {
+		return false;
+	}
+	Nodo* hijo = nodo->hijos[indice].get();
+	if (static_cast<unsigned char>(hijo->etiqueta[0]) != primero ||
+		prefijoComun(hijo->etiqueta, clave, posicion) < hijo->etiqueta.size() ||
+		!eliminarEn(hijo, clave, posicion + hijo->etiqueta.size(), cantidad)) {
+		return false;
+	}
+
+	// Mantener la compresión: un hijo sin clave ni hijos sobra, y uno sin clave con un
+	// único hijo se reemplaza por ese hijo (que conserva su identidad para las listas de mejores)
+	if (hijo->total == 0 && hijo->hijos.empty()) {
+		nodo->hijos.erase(nodo->hijos.begin() + indice);
+	}
+	else if (hijo->total == 0 && hijo->hijos.size() == 1) {
+		std::unique_ptr<Nodo> nieto = std::move(hijo->hijos.front());
+		nieto->etiqueta.insert(0, hijo->etiqueta);
+		nodo->hijos[indice] = std::move(nieto);
+	}
+	recalcular(nodo);
+	return true;
+}
+
+std::vector<ArbolPrefijos::Sugerencia> ArbolPrefijos::sugerir(const std::string& prefijo, size_t limite) const {
+	const Nodo* nodo = raiz.get();
+	size_t posicion = 0;
+	while (posicion < prefijo.size()) {
+		size_t indice = posicionHijo(nodo, static_cast<unsigned char>(prefijo[posicion]));
+		if (indice == nodo->hijos.size()) {
+			return {};
+		}
+		const Nodo* hijo = nodo->hijos[indice].get();
+		size_t comun = prefijoComun(hijo->etiqueta, prefijo, posicion);
+		if (comun == 0) {
+			return {};
+		}
+		// Si el prefijo termina a mitad de la arista, todo el subárbol del hijo coincide
+		if (comun < hijo->etiqueta.size() && posicion + comun < prefijo.size()) {
+			return {};
+		}
+		nodo = hijo;
+		posicion += comun;
+	}
+
+	std::vector<Sugerencia> sugerencias;
+	size_t cantidad = std::min(limite, nodo->mejores.size());
+	sugerencias.reserve(cantidad);
+	for (size_t i = 0; i < cantidad; ++i) {
+		sugerencias.push_back(Sugerencia{ nodo->mejores[i]->clave, nodo->mejores[i]->total });
+	}
+	return sugerencias;
+}
+
+size_t ArbolPrefijos::contar(const std::string& clave) const {
+	const Nodo* nodo = raiz.get();
+	size_t posicion = 0;
+	while (posicion < clave.size()) {
+		size_t indice = posicionHijo(nodo, static_cast<unsigned char>(clave[posicion]));
+		if (indice == nodo->hijos.size()) {
+			return 0;
+		}
+		const Nodo* hijo = nodo->hijos[indice].get();
+		if (prefijoComun(hijo->etiqueta, clave, posicion) < hijo->etiqueta.size()) {
+			return 0;
+		}
+		nodo = hijo;
+		posicion += hijo->etiqueta.size();
+	}
+	return nodo->total;
+}
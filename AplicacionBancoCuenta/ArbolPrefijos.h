@@ -0,0 +1,93 @@
+#pragma once
+#ifndef ARBOLPREFIJOS_H
+#define ARBOLPREFIJOS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/**
+ * @class ArbolPrefijos
+ * @brief Árbol de prefijos comprimido (radix) con las claves más frecuentes por subárbol
+ *
+ * Cada arista guarda un tramo de texto en lugar de un solo carácter, así que la altura
+ * está acotada por la longitud de la clave y los nodos solo aparecen donde dos claves
+ * se separan. Cada clave lleva un contador (p. ej. cuántas personas se llaman así).
+ *
+ * Cada nodo conserva las MAX_SUGERENCIAS claves de mayor contador de su subárbol: como
+ * las mejores de un subárbol están entre las mejores de sus hijos, insertar o eliminar
+ * solo recalcula los nodos del camino de la clave, y sugerir() responde descendiendo
+ * por el prefijo, sin recorrer las coincidencias.
+ *
+ * No sincroniza el acceso: el dueño (GestorIndices) lo protege con su propio bloqueo.
+ */
+class ArbolPrefijos {
+public:
+    static constexpr size_t MAX_SUGERENCIAS = 10;
+
+    /**
+     * @struct Sugerencia
+     * @brief Clave que completa un prefijo y cuántas veces se insertó
+     */
+    struct Sugerencia {
+        std::string texto;
+        size_t total;
+    };
+
+private:
+    struct Nodo {
+        std::string etiqueta;                    // Tramo de la arista que llega al nodo
+        std::vector<std::unique_ptr<Nodo>> hijos; // Ordenados por el primer byte de la etiqueta
+        std::string clave;                       // Clave completa, si el nodo es terminal
+        size_t total = 0;                        // Contador de la clave; 0 si no es terminal
+        std::vector<const Nodo*> mejores;        // Terminales del subárbol de mayor contador
+    };
+
+    std::unique_ptr<Nodo> raiz;
+    size_t clavesDistintas;
+
+    static bool antes(const Nodo* a, const Nodo* b);
+    static size_t posicionHijo(const Nodo* nodo, unsigned char primero);
+    static void recalcular(Nodo* nodo);
+
+    void insertarEn(Nodo* nodo, const std::string& clave, size_t posicion, size_t cantidad);
+    bool eliminarEn(Nodo* nodo, const std::string& clave, size_t posicion, size_t cantidad);
+
+public:
+    ArbolPrefijos();
+    ~ArbolPrefijos();
+
+    ArbolPrefijos(const ArbolPrefijos&) = delete;
+    ArbolPrefijos& operator=(const ArbolPrefijos&) = delete;
+
+    /**
+     * @brief Suma cantidad al contador de la clave, creándola si no existe
+     */
+    void insertar(const std::string& clave, size_t cantidad = 1);
+
+    /**
+     * @brief Resta cantidad al contador de la clave; al llegar a 0 la clave desaparece
+     * @return true si la clave existía
+     */
+    bool eliminar(const std::string& clave, size_t cantidad = 1);
+
+    /**
+     * @brief Claves que comienzan con el prefijo, de mayor a menor contador
+     *
+     * Empates en orden alfabético. Cuesta O(longitud del prefijo + limite).
+     * @param limite Cantidad máxima de sugerencias (a lo sumo MAX_SUGERENCIAS)
+     */
+    std::vector<Sugerencia> sugerir(const std::string& prefijo, size_t limite) const;
+
+    /**
+     * @brief Contador actual de una clave (0 si no existe)
+     */
+    size_t contar(const std::string& clave) const;
+
+    size_t tamano() const { return clavesDistintas; }
+
+    void limpiar();
+};
+
+#endif // ARBOLPREFIJOS_H
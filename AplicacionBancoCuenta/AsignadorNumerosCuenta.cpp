@@ -0,0 +1,50 @@
+/**
+ * @file AsignadorNumerosCuenta.cpp
+ * @brief Implementación del asignador de secuenciales de cuenta por bloques
+ */
+#include "AsignadorNumerosCuenta.h"
+#include <iostream>
+#include <algorithm>
+
+std::map<std::string, AsignadorNumerosCuenta::BloqueSecuencial> AsignadorNumerosCuenta::bloques;
+std::mutex AsignadorNumerosCuenta::mutexBloques;
+int AsignadorNumerosCuenta::tamanoBloque = 50;
+
+AsignadorNumerosCuenta::BloqueSecuencial& AsignadorNumerosCuenta::obtenerBloque(const std::string& sucursal) {
+	std::lock_guard<std::mutex> lock(mutexBloques);
+	// std::map no invalida referencias al insertar, el bloque puede usarse fuera del bloqueo
+	return bloques[sucursal];
+}
+
+int AsignadorNumerosCuenta::siguienteSecuencial(IRepositorioBanco& repositorio, const std::string& sucursal) {
+	BloqueSecuencial& bloque = obtenerBloque(sucursal);
+	std::lock_guard<std::mutex> lock(bloque.mutex);
+
+	if (bloque.siguiente > bloque.limite) {
+		int tamano = getTamanoBloque();
+		int primero = 0;
+		if (!repositorio.reservarBloqueSecuencial(sucursal, tamano, primero)) {
+			std::cerr << "Error: No se pudo reservar un bloque de secuenciales para la sucursal " << sucursal << std::endl;
+			return -1;
+		}
+		bloque.siguiente = primero;
+		bloque.limite = primero + tamano - 1;
+	}
+
+	if (bloque.siguiente > SECUENCIAL_MAXIMO) {
+		std::cerr << "Error: La sucursal " << sucursal << " agotó sus números de cuenta." << std::endl;
+		return -1;
+	}
+
+	return bloque.siguiente++;
+}
+
+void AsignadorNumerosCuenta::setTamanoBloque(int tamano) {
+	std::lock_guard<std::mutex> lock(mutexBloques);
+	tamanoBloque = (std::max)(1, tamano);
+}
+
+int AsignadorNumerosCuenta::getTamanoBloque() {
+	std::lock_guard<std::mutex> lock(mutexBloques);
+	return tamanoBloque;
+}
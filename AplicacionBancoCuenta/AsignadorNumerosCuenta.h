@@ -0,0 +1,64 @@
+#pragma once
+#ifndef ASIGNADORNUMEROSCUENTA_H
+#define ASIGNADORNUMEROSCUENTA_H
+
+#include "IRepositorioBanco.h"
+#include <string>
+#include <map>
+#include <mutex>
+
+/**
+ * @class AsignadorNumerosCuenta
+ * @brief Asigna secuenciales de cuenta por sucursal reservando bloques (hi/lo)
+ *
+ * Aplicando SRP: solo entrega secuenciales únicos; el formato del número y el dígito
+ * verificador siguen en Persona::crearNumeroCuenta.
+ *
+ * Cada proceso reserva en el repositorio un bloque de tamanoBloque secuenciales con una
+ * sola operación atómica y los entrega localmente hasta agotarlo. Varias terminales
+ * nunca reciben el mismo secuencial; los secuenciales no usados de un bloque se pierden
+ * al cerrar el proceso, lo que deja huecos pero no duplicados.
+ */
+class AsignadorNumerosCuenta {
+private:
+    /**
+     * @struct BloqueSecuencial
+     * @brief Rango reservado [siguiente, limite] pendiente de entregar para una sucursal
+     */
+    struct BloqueSecuencial {
+        int siguiente = 1;
+        int limite = 0;  // Bloque vacío hasta la primera reserva
+        std::mutex mutex;
+    };
+
+    static std::map<std::string, BloqueSecuencial> bloques;
+    static std::mutex mutexBloques;
+    static int tamanoBloque;
+
+    static BloqueSecuencial& obtenerBloque(const std::string& sucursal);
+
+public:
+    // Mayor secuencial representable con 6 dígitos
+    static constexpr int SECUENCIAL_MAXIMO = 999999;
+
+    /**
+     * @brief Entrega el siguiente secuencial libre de la sucursal
+     * @param repositorio Repositorio donde se reservan los bloques
+     * @param sucursal Código de sucursal (210, 220, 480, 560)
+     * @return Secuencial asignado, o -1 si no se pudo reservar un bloque
+     */
+    static int siguienteSecuencial(IRepositorioBanco& repositorio, const std::string& sucursal);
+
+    /**
+     * @brief Define cuántos secuenciales se reservan por viaje al repositorio
+     * @param tamano Tamaño del bloque (mínimo 1)
+     */
+    static void setTamanoBloque(int tamano);
+
+    /**
+     * @brief Obtiene el tamaño de bloque configurado
+     */
+    static int getTamanoBloque();
+};
+
+#endif // ASIGNADORNUMEROSCUENTA_H
@@ -0,0 +1,319 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+/**
+ * @file AuditoriaAsincrona.cpp
+ * @brief Implementación del registro de auditoría con escritura diferida
+ */
+#include "AuditoriaAsincrona.h"
+#include "ConexionMongo.h"
+#include "FabricaRepositorioBanco.h"
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <mongocxx/options/insert.hpp>
+#include <iostream>
+#include <ctime>
+#include <cstdlib>
+#include <io.h>
+#include <algorithm>
+
+std::unique_ptr<AuditoriaAsincrona::Celda[]> AuditoriaAsincrona::celdas;
+std::atomic<size_t> AuditoriaAsincrona::posicionEncolar{ 0 };
+std::atomic<size_t> AuditoriaAsincrona::posicionDesencolar{ 0 };
+
+std::thread AuditoriaAsincrona::hiloEscritor;
+std::mutex AuditoriaAsincrona::mutexEscritor;
+std::condition_variable AuditoriaAsincrona::condicionEscritor;
+std::atomic<bool> AuditoriaAsincrona::enEjecucion{ false };
+std::once_flag AuditoriaAsincrona::banderaInicio;
+
+std::string AuditoriaAsincrona::archivoRegistros = "registros_operaciones.log";
+std::FILE* AuditoriaAsincrona::archivo = nullptr;
+AuditoriaAsincrona::PoliticaSincronizacion AuditoriaAsincrona::politica = AuditoriaAsincrona::INTERVALO;
+std::chrono::milliseconds AuditoriaAsincrona::intervaloVaciado{ 200 };
+std::chrono::milliseconds AuditoriaAsincrona::intervaloSincronizacion{ 1000 };
+std::chrono::steady_clock::time_point AuditoriaAsincrona::ultimaSincronizacion;
+
+std::atomic<uint64_t> AuditoriaAsincrona::totalEncolados{ 0 };
+std::atomic<uint64_t> AuditoriaAsincrona::totalRechazados{ 0 };
+std::atomic<uint64_t> AuditoriaAsincrona::totalEscritos{ 0 };
+std::atomic<uint64_t> AuditoriaAsincrona::totalFallidosMongo{ 0 };
+std::atomic<uint64_t> AuditoriaAsincrona::totalLotes{ 0 };
+std::atomic<uint64_t> AuditoriaAsincrona::ultimoVaciadoMicros{ 0 };
+std::atomic<uint64_t> AuditoriaAsincrona::vaciadoTotalMicros{ 0 };
+std::atomic<uint64_t> AuditoriaAsincrona::vaciadoMaximoMicros{ 0 };
+
+void AuditoriaAsincrona::iniciar() {
+	std::call_once(banderaInicio, []() {
+		celdas.reset(new Celda[CAPACIDAD_COLA]);
+		for (size_t i = 0; i < CAPACIDAD_COLA; ++i) {
+			celdas[i].secuencia.store(i, std::memory_order_relaxed);
+		}
+
+		archivo = std::fopen(archivoRegistros.c_str(), "a");
+		if (!archivo) {
+			std::cerr << "Error: No se pudo abrir el archivo de registros." << std::endl;
+		}
+		ultimaSincronizacion = std::chrono::steady_clock::now();
+
+		enEjecucion.store(true);
+		hiloEscritor = std::thread(&AuditoriaAsincrona::ejecutarEscritor);
+		std::atexit(&AuditoriaAsincrona::detener);
+	});
+}
+
+/**
+ * @brief Reserva una celda con CAS sobre posicionEncolar y la publica con su secuencia
+ */
+bool AuditoriaAsincrona::intentarEncolar(RegistroPendiente&& registro) {
+	size_t posicion = posicionEncolar.load(std::memory_order_relaxed);
+	for (;;) {
+		Celda& celda = celdas[posicion & (CAPACIDAD_COLA - 1)];
+		size_t secuencia = celda.secuencia.load(std::memory_order_acquire);
+		intptr_t diferencia = static_cast<intptr_t>(secuencia) - static_cast<intptr_t>(posicion);
+		if (diferencia == 0) {
+			if (posicionEncolar.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed)) {
+				celda.registro = std::move(registro);
+				celda.secuencia.store(posicion + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diferencia < 0) {
+			return false;  // Cola llena
+		}
+		else {
+			posicion = posicionEncolar.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool AuditoriaAsincrona::intentarDesencolar(RegistroPendiente& registro) {
+	size_t posicion = posicionDesencolar.load(std::memory_order_relaxed);
+	for (;;) {
+		Celda& celda = celdas[posicion & (CAPACIDAD_COLA - 1)];
+		size_t secuencia = celda.secuencia.load(std::memory_order_acquire);
+		intptr_t diferencia = static_cast<intptr_t>(secuencia) - static_cast<intptr_t>(posicion + 1);
+		if (diferencia == 0) {
+			if (posicionDesencolar.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed)) {
+				registro = std::move(celda.registro);
+				celda.secuencia.store(posicion + CAPACIDAD_COLA, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (diferencia < 0) {
+			return false;  // Cola vacía
+		}
+		else {
+			posicion = posicionDesencolar.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool AuditoriaAsincrona::encolar(const std::string& tipoOperacion, const std::string& cedula) {
+	iniciar();
+	if (!enEjecucion.load()) {
+		totalRechazados.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	RegistroPendiente registro{ tipoOperacion, cedula, std::chrono::system_clock::now() };
+
+	// Cola llena: se cede al escritor unas pocas veces antes de rechazar
+	for (int intento = 0; intento < 50; ++intento) {
+		if (intentarEncolar(std::move(registro))) {
+			uint64_t encolados = totalEncolados.fetch_add(1, std::memory_order_relaxed) + 1;
+			if (encolados % TAMANO_LOTE == 0) {
+				condicionEscritor.notify_one();
+			}
+			return true;
+		}
+		condicionEscritor.notify_one();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	totalRechazados.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
+void AuditoriaAsincrona::ejecutarEscritor() {
+	std::vector<RegistroPendiente> lote;
+	lote.reserve(TAMANO_LOTE);
+
+	for (;;) {
+		bool activo = enEjecucion.load();
+		if (activo) {
+			std::unique_lock<std::mutex> lock(mutexEscritor);
+			condicionEscritor.wait_for(lock, intervaloVaciado);
+		}
+
+		RegistroPendiente registro;
+		while (intentarDesencolar(registro)) {
+			lote.push_back(std::move(registro));
+			if (lote.size() == TAMANO_LOTE) {
+				escribirLote(lote);
+				lote.clear();
+			}
+		}
+		if (!lote.empty()) {
+			escribirLote(lote);
+			lote.clear();
+		}
+
+		// El último recorrido tras detener() ya vació lo encolado antes de la bandera
+		if (!activo) {
+			break;
+		}
+	}
+}
+
+void AuditoriaAsincrona::escribirLote(const std::vector<RegistroPendiente>& lote) {
+	auto inicio = std::chrono::steady_clock::now();
+
+	std::string bloque;
+	bloque.reserve(lote.size() * 64);
+	std::vector<bsoncxx::document::value> documentos;
+	documentos.reserve(lote.size());
+
+	for (const auto& registro : lote) {
+		std::string fechaHora = formatearFechaHora(registro.momento);
+
+		// Formato: [FECHA_HORA] TIPO_OPERACION - CEDULA
+		bloque += "[" + fechaHora + "] " + registro.tipoOperacion + " - Cedula: " + registro.cedula + "\n";
+
+		documentos.push_back(bsoncxx::builder::basic::make_document(
+			bsoncxx::builder::basic::kvp("fechaHora", fechaHora),
+			bsoncxx::builder::basic::kvp("tipoOperacion", registro.tipoOperacion),
+			bsoncxx::builder::basic::kvp("cedula", registro.cedula),
+			bsoncxx::builder::basic::kvp("timestamp", std::chrono::duration_cast<std::chrono::milliseconds>(
+				registro.momento.time_since_epoch()).count())
+		));
+	}
+
+	PoliticaSincronizacion politicaActual;
+	std::chrono::milliseconds intervaloActual;
+	{
+		std::lock_guard<std::mutex> lock(mutexEscritor);
+		politicaActual = politica;
+		intervaloActual = intervaloSincronizacion;
+	}
+
+	// 1. Archivo local: una sola escritura por lote
+	if (archivo) {
+		std::fwrite(bloque.data(), 1, bloque.size(), archivo);
+		std::fflush(archivo);
+
+		auto ahora = std::chrono::steady_clock::now();
+		if (politicaActual == POR_LOTE ||
+			(politicaActual == INTERVALO && ahora - ultimaSincronizacion >= intervaloActual)) {
+			_commit(_fileno(archivo));
+			ultimaSincronizacion = ahora;
+		}
+	}
+
+	// 2. MongoDB: un solo insert_many por lote; en modo MEMORIA solo queda el archivo
+	if (FabricaRepositorioBanco::getMotor() == MotorAlmacenamiento::MONGODB) {
+		try {
+			auto cliente = ConexionMongo::arrendarCliente();
+			auto collection = cliente["Banco"]["registros"];
+			mongocxx::options::insert opciones;
+			opciones.ordered(false);
+			auto resultado = collection.insert_many(documentos, opciones);
+			if (!resultado || resultado->inserted_count() != static_cast<std::int32_t>(documentos.size())) {
+				totalFallidosMongo.fetch_add(documentos.size(), std::memory_order_relaxed);
+				std::cerr << "Error: No se pudo insertar el lote de registros en MongoDB." << std::endl;
+			}
+		}
+		catch (const std::exception& e) {
+			totalFallidosMongo.fetch_add(documentos.size(), std::memory_order_relaxed);
+			std::cerr << "Error al escribir lote de registros: " << e.what() << std::endl;
+		}
+	}
+
+	uint64_t micros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now() - inicio).count());
+	totalEscritos.fetch_add(lote.size(), std::memory_order_relaxed);
+	totalLotes.fetch_add(1, std::memory_order_relaxed);
+	ultimoVaciadoMicros.store(micros, std::memory_order_relaxed);
+	vaciadoTotalMicros.fetch_add(micros, std::memory_order_relaxed);
+	uint64_t maximo = vaciadoMaximoMicros.load(std::memory_order_relaxed);
+	while (micros > maximo && !vaciadoMaximoMicros.compare_exchange_weak(maximo, micros, std::memory_order_relaxed)) {
+	}
+}
+
+std::string AuditoriaAsincrona::formatearFechaHora(std::chrono::system_clock::time_point momento) {
+	std::time_t tiempo = std::chrono::system_clock::to_time_t(momento);
+	std::tm tmLocal;
+	localtime_s(&tmLocal, &tiempo);
+
+	char buffer[20];
+	std::strftime(buffer, sizeof(buffer), "%d/%m/%Y %H:%M:%S", &tmLocal);
+	return buffer;
+}
+
+void AuditoriaAsincrona::detener() {
+	if (!enEjecucion.exchange(false)) {
+		return;
+	}
+
+	condicionEscritor.notify_one();
+	if (hiloEscritor.joinable()) {
+		hiloEscritor.join();
+	}
+
+	if (archivo) {
+		if (politica != NUNCA) {
+			_commit(_fileno(archivo));
+		}
+		std::fclose(archivo);
+		archivo = nullptr;
+	}
+}
+
+void AuditoriaAsincrona::setPoliticaSincronizacion(PoliticaSincronizacion nuevaPolitica, std::chrono::milliseconds intervalo) {
+	std::lock_guard<std::mutex> lock(mutexEscritor);
+	politica = nuevaPolitica;
+	intervaloSincronizacion = intervalo;
+}
+
+void AuditoriaAsincrona::setIntervaloVaciado(std::chrono::milliseconds intervalo) {
+	std::lock_guard<std::mutex> lock(mutexEscritor);
+	intervaloVaciado = (std::max)(intervalo, std::chrono::milliseconds(1));
+}
+
+void AuditoriaAsincrona::setArchivoRegistros(const std::string& ruta) {
+	std::lock_guard<std::mutex> lock(mutexEscritor);
+	archivoRegistros = ruta;
+}
+
+AuditoriaAsincrona::MetricasAuditoria AuditoriaAsincrona::obtenerMetricas() {
+	MetricasAuditoria metricas;
+	metricas.encolados = totalEncolados.load(std::memory_order_relaxed);
+	metricas.rechazados = totalRechazados.load(std::memory_order_relaxed);
+	metricas.escritos = totalEscritos.load(std::memory_order_relaxed);
+	metricas.fallidosMongo = totalFallidosMongo.load(std::memory_order_relaxed);
+	metricas.lotes = totalLotes.load(std::memory_order_relaxed);
+	size_t encolar = posicionEncolar.load(std::memory_order_relaxed);
+	size_t desencolar = posicionDesencolar.load(std::memory_order_relaxed);
+	metricas.profundidadCola = encolar >= desencolar ? encolar - desencolar : 0;
+	metricas.capacidadCola = CAPACIDAD_COLA;
+	metricas.ultimoVaciadoMicros = ultimoVaciadoMicros.load(std::memory_order_relaxed);
+	metricas.vaciadoTotalMicros = vaciadoTotalMicros.load(std::memory_order_relaxed);
+	metricas.vaciadoMaximoMicros = vaciadoMaximoMicros.load(std::memory_order_relaxed);
+	return metricas;
+}
+
+void AuditoriaAsincrona::mostrarMetricas() {
+	MetricasAuditoria metricas = obtenerMetricas();
+	double promedioMicros = metricas.lotes > 0
+		? static_cast<double>(metricas.vaciadoTotalMicros) / metricas.lotes
+		: 0.0;
+
+	std::cout << "\n=== MÉTRICAS DE AUDITORÍA ===" << std::endl;
+	std::cout << "Profundidad de la cola: " << metricas.profundidadCola << " / " << metricas.capacidadCola << std::endl;
+	std::cout << "Registros encolados: " << metricas.encolados << std::endl;
+	std::cout << "Registros rechazados (cola llena): " << metricas.rechazados << std::endl;
+	std::cout << "Registros escritos: " << metricas.escritos << " en " << metricas.lotes << " lotes" << std::endl;
+	std::cout << "Registros no insertados en MongoDB: " << metricas.fallidosMongo << std::endl;
+	std::cout << "Vaciado promedio: " << promedioMicros << " us" << std::endl;
+	std::cout << "Último vaciado: " << metricas.ultimoVaciadoMicros << " us" << std::endl;
+	std::cout << "Vaciado máximo: " << metricas.vaciadoMaximoMicros << " us" << std::endl;
+}
@@ -0,0 +1,176 @@
+#pragma once
+#ifndef AUDITORIAASINCRONA_H
+#define AUDITORIAASINCRONA_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+/**
+ * @class AuditoriaAsincrona
+ * @brief Registro de auditoría con escritura diferida (write-behind)
+ *
+ * Las operaciones solo encolan el registro en una cola acotada sin bloqueo
+ * (anillo MPMC con números de secuencia por celda). Un hilo escritor agrupa los
+ * registros pendientes y por cada lote hace una única escritura al archivo local y,
+ * con el motor MONGODB, un único insert_many en la colección registros.
+ *
+ * La política de sincronización acota cuánto puede perderse ante un corte: con
+ * POR_LOTE cada lote se fuerza a disco antes de continuar; con INTERVALO se fuerza
+ * como máximo cada intervaloSincronizacion. detener() vacía la cola antes de volver.
+ */
+class AuditoriaAsincrona {
+public:
+    /**
+     * @enum PoliticaSincronizacion
+     * @brief Cuándo se fuerza a disco el archivo de registros
+     */
+    enum PoliticaSincronizacion {
+        NUNCA = 0,      // Solo fflush; el sistema operativo decide cuándo escribir
+        POR_LOTE = 1,   // _commit tras cada lote escrito
+        INTERVALO = 2   // _commit como máximo una vez por intervaloSincronizacion
+    };
+
+    /**
+     * @struct MetricasAuditoria
+     * @brief Instantánea del estado de la cola y de los vaciados
+     */
+    struct MetricasAuditoria {
+        uint64_t encolados = 0;            // Registros aceptados por la cola
+        uint64_t rechazados = 0;           // Registros no aceptados por cola llena
+        uint64_t escritos = 0;             // Registros persistidos por el escritor
+        uint64_t fallidosMongo = 0;        // Registros cuyo insert_many falló
+        uint64_t lotes = 0;                // Lotes vaciados
+        size_t profundidadCola = 0;        // Registros pendientes en este momento
+        size_t capacidadCola = 0;
+        uint64_t ultimoVaciadoMicros = 0;  // Latencia del último lote (archivo + MongoDB)
+        uint64_t vaciadoTotalMicros = 0;
+        uint64_t vaciadoMaximoMicros = 0;
+    };
+
+private:
+    /**
+     * @struct RegistroPendiente
+     * @brief Registro encolado; la fecha se formatea en el hilo escritor
+     */
+    struct RegistroPendiente {
+        std::string tipoOperacion;
+        std::string cedula;
+        std::chrono::system_clock::time_point momento;
+    };
+
+    /**
+     * @struct Celda
+     * @brief Celda del anillo; secuencia indica si está libre o lista para consumir
+     */
+    struct Celda {
+        std::atomic<size_t> secuencia;
+        RegistroPendiente registro;
+    };
+
+    static constexpr size_t CAPACIDAD_COLA = 4096;  // Potencia de 2
+    static constexpr size_t TAMANO_LOTE = 256;
+
+    static std::unique_ptr<Celda[]> celdas;
+    alignas(64) static std::atomic<size_t> posicionEncolar;
+    alignas(64) static std::atomic<size_t> posicionDesencolar;
+
+    static std::thread hiloEscritor;
+    static std::mutex mutexEscritor;
+    static std::condition_variable condicionEscritor;
+    static std::atomic<bool> enEjecucion;
+    static std::once_flag banderaInicio;
+
+    static std::string archivoRegistros;
+    static std::FILE* archivo;
+    static PoliticaSincronizacion politica;
+    static std::chrono::milliseconds intervaloVaciado;
+    static std::chrono::milliseconds intervaloSincronizacion;
+    static std::chrono::steady_clock::time_point ultimaSincronizacion;
+
+    static std::atomic<uint64_t> totalEncolados;
+    static std::atomic<uint64_t> totalRechazados;
+    static std::atomic<uint64_t> totalEscritos;
+    static std::atomic<uint64_t> totalFallidosMongo;
+    static std::atomic<uint64_t> totalLotes;
+    static std::atomic<uint64_t> ultimoVaciadoMicros;
+    static std::atomic<uint64_t> vaciadoTotalMicros;
+    static std::atomic<uint64_t> vaciadoMaximoMicros;
+
+    /**
+     * @brief Crea el anillo e inicia el hilo escritor la primera vez que se encola
+     */
+    static void iniciar();
+
+    static bool intentarEncolar(RegistroPendiente&& registro);
+    static bool intentarDesencolar(RegistroPendiente& registro);
+
+    /**
+     * @brief Bucle del hilo escritor: espera registros o el intervalo y vacía por lotes
+     */
+    static void ejecutarEscritor();
+
+    /**
+     * @brief Persiste un lote: una escritura al archivo y un insert_many
+     */
+    static void escribirLote(const std::vector<RegistroPendiente>& lote);
+
+    static std::string formatearFechaHora(std::chrono::system_clock::time_point momento);
+
+public:
+    /**
+     * @brief Encola un registro de operación sin tocar disco ni red
+     *
+     * Si la cola está llena despierta al escritor y reintenta durante un tiempo
+     * acotado; si sigue llena el registro se rechaza.
+     * @param tipoOperacion Tipo de operación realizada
+     * @param cedula Cédula de la persona involucrada
+     * @return true si el registro quedó encolado, false si la cola estaba llena
+     */
+    static bool encolar(const std::string& tipoOperacion, const std::string& cedula);
+
+    /**
+     * @brief Vacía la cola pendiente y detiene el hilo escritor
+     *
+     * Es idempotente; se registra con std::atexit al iniciar para que exit() no
+     * descarte registros encolados.
+     */
+    static void detener();
+
+    /**
+     * @brief Define la política de sincronización a disco
+     * @param nuevaPolitica Política a aplicar
+     * @param intervalo Intervalo máximo entre sincronizaciones para INTERVALO
+     */
+    static void setPoliticaSincronizacion(PoliticaSincronizacion nuevaPolitica,
+        std::chrono::milliseconds intervalo = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Define cada cuánto despierta el escritor si el lote no se completa
+     */
+    static void setIntervaloVaciado(std::chrono::milliseconds intervalo);
+
+    /**
+     * @brief Define el archivo local de registros (antes del primer registro)
+     */
+    static void setArchivoRegistros(const std::string& ruta);
+
+    /**
+     * @brief Obtiene una instantánea de las métricas de la cola
+     */
+    static MetricasAuditoria obtenerMetricas();
+
+    /**
+     * @brief Imprime las métricas de la cola por consola
+     */
+    static void mostrarMetricas();
+};
+
+#endif // AUDITORIAASINCRONA_H
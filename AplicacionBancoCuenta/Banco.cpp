@@ -10,7 +10,7 @@
 #include "Cuenta.h"  
 #include "BancoManejoPersona.h"  
 #include "BancoManejoCuenta.h"  
-#include "_BaseDatosPersona.h"  
+#include "FabricaRepositorioBanco.h"  
 #include "CreadorCuentas.h"  
 #include "BuscadorCuentas.h"  
 #include "ValidadorBaseDatos.h" 
@@ -21,13 +21,16 @@
 #include <memory>
 #include <iomanip>
 
-Banco::Banco() :
+Banco::Banco() : Banco(FabricaRepositorioBanco::obtenerRepositorio()) {
+}
+
+Banco::Banco(IRepositorioBanco& repositorioBanco) :
+	repositorio(repositorioBanco),
 	manejoPersonas(std::make_unique<BancoManejoPersona>()),
-	manejoCuentas(std::make_unique<BancoManejoCuenta>(*manejoPersonas)),
+	manejoCuentas(std::make_unique<BancoManejoCuenta>(*manejoPersonas, repositorio)),
 	manejoRegistros(std::make_unique<BancoManejaRegistro>()),
-	baseDatosPersona(ConexionMongo::obtenerClienteBaseDatos()),
-	buscadorCuentas(std::make_unique<BuscadorCuentas>(baseDatosPersona)),
-	validadorBaseDatos(std::make_unique<ValidadorBaseDatos>(baseDatosPersona)) {
+	buscadorCuentas(std::make_unique<BuscadorCuentas>(repositorio)),
+	validadorBaseDatos(std::make_unique<ValidadorBaseDatos>(repositorio)) {
 }
 
 Banco::~Banco() = default;
@@ -82,7 +85,7 @@ void Banco::agregarPersonaConCuenta() {
 	if (tipoCuenta == "Cancelar" || tipoCuentaInt == -1) return;
 
 	// Buscar persona existente
-	Persona* personaExistente = baseDatosPersona.obtenerPersonaPorCedula(cedula);
+	Persona* personaExistente = repositorio.obtenerPersonaPorCedula(cedula);
 
 	bool operacionExitosa = false;
 	std::string tipoOperacion;
@@ -156,6 +159,8 @@ bool Banco::procesarPersonaNueva(const std::string& tipoCuenta, const std::strin
 
 	// Persistir persona en base de datos
 	if (!persistirPersonaEnBaseDatos(*nuevaPersona)) {
+		// La persona se libera al salir: no debe quedar registrada
+		manejoPersonas->quitarPersona(cedula);
 		return false;
 	}
 
@@ -165,6 +170,7 @@ bool Banco::procesarPersonaNueva(const std::string& tipoCuenta, const std::strin
 
 	if (!resultadoCreacion.first) {
 		std::cout << "Error al crear la cuenta para la nueva persona.\n";
+		manejoPersonas->quitarPersona(cedula);
 		return false;
 	}
 
@@ -191,7 +197,7 @@ bool Banco::crearCuentaPorTipo(const std::string& tipoCuenta,
 			return false;
 		}
 
-		CreadorCuentas creador(baseDatosPersona);
+		CreadorCuentas creador(repositorio);
 		auto resultado = crearCuentaParaPersonaExistente(creador, tipoCuenta, persona.get(), cedula);
 
 		mostrarResultadoCreacion(resultado.first, tipoCuenta, nombreCompleto);
@@ -226,7 +232,7 @@ std::unique_ptr<Persona> Banco::prepararNuevaPersona(const std::string& cedula)
 std::pair<bool, std::string> Banco::crearCuentaSegunTipo(const std::string& tipoCuenta, Persona* persona, const std::string& cedula)
 {
 
-	CreadorCuentas creador(baseDatosPersona);
+	CreadorCuentas creador(repositorio);
 
 	if (tipoCuenta == "ahorros") {
 		auto cuenta = std::make_unique<CuentaAhorros>();
@@ -243,7 +249,7 @@ std::pair<bool, std::string> Banco::crearCuentaSegunTipo(const std::string& tipo
 }
 
 bool Banco::persistirPersonaEnBaseDatos(const Persona& persona) {
-	bool exitoBaseDatos = baseDatosPersona.insertarNuevaPersona(persona);
+	bool exitoBaseDatos = repositorio.insertarNuevaPersona(persona);
 	if (!exitoBaseDatos) {
 		std::cout << "Error al insertar nueva persona en la base de datos.\n";
 		return false;
@@ -252,7 +258,7 @@ bool Banco::persistirPersonaEnBaseDatos(const Persona& persona) {
 }
 
 std::unique_ptr<Persona> Banco::obtenerPersonaExistente(const std::string& cedula) {
-	auto persona = baseDatosPersona.obtenerPersonaPorCedula(cedula);
+	auto persona = repositorio.obtenerPersonaPorCedula(cedula);
 	return persona ? std::unique_ptr<Persona>(persona) : nullptr;
 }
 
@@ -330,16 +336,17 @@ void Banco::buscarCuenta() {
 		"Por criterio de usuario",
 		"Por numero de cuenta",
 		"Por cedula",
+		"Busqueda aproximada (tolera errores)",
 		"Cancelar"
 	};
 	
 	Utilidades::limpiarPantallaPreservandoMarquesina(1);
 	int seleccion = Utilidades::menuInteractivo("Seleccione el tipo de busqueda:", opcionesBusqueda, 0, 0);
 
-	if (seleccion >= 0 && seleccion <= 3) {
+	if (seleccion >= 0 && seleccion <= 4) {
 		buscadorCuentas->ejecutarBusqueda(seleccion);
 	}
-	else if (seleccion == 4 || seleccion == -1) {
+	else if (seleccion == 5 || seleccion == -1) {
 		std::cout << "Búsqueda cancelada.\n";
 	}
 
@@ -348,7 +355,7 @@ void Banco::buscarCuenta() {
 
 bool Banco::verificarCuentasBanco() const {
 	// Crear validador especializado para verificación de base de datos
-	ValidadorBaseDatos validador(const_cast<_BaseDatosPersona&>(baseDatosPersona));
+	ValidadorBaseDatos validador(repositorio);
 
 	// Verificar directamente en MongoDB si existen cuentas
 	bool tieneCuentas = validador.tieneCuentasRegistradas();
@@ -440,7 +447,7 @@ void Banco::subMenuCuentasBancarias() {
 	do {
 
 		// Mostrar estadísticas actuales de la base de datos
-		ValidadorBaseDatos validador(baseDatosPersona);
+		ValidadorBaseDatos validador(repositorio);
 		validador.mostrarEstadoBaseDatos();
 
 		Utilidades::limpiarPantallaPreservandoMarquesina(1);
@@ -478,14 +485,15 @@ void Banco::realizarDeposito() {
 	std::string numeroCuenta = ManejoMenus::solicitarNumeroCuenta("para depósito");
 	if (!numeroCuenta.empty()) {
 		// Verificar existencia usando MongoDB directamente
-		double saldoActual = baseDatosPersona.obtenerSaldoCuenta(numeroCuenta);
+		double saldoActual = repositorio.obtenerSaldoCuenta(numeroCuenta);
 		if (saldoActual >= 0) { // Cuenta existe
 			double monto = ManejoMenus::solicitarMonto();
 			if (monto > 0) {
-				if (baseDatosPersona.depositarEnCuenta(numeroCuenta, monto)) {
+				double nuevoSaldo = 0.0;
+				if (repositorio.depositarEnCuenta(numeroCuenta, monto, &nuevoSaldo)) {
 					ManejoMenus::mostrarMensajeExito("Depósito realizado exitosamente.");
 					std::cout << "Nuevo saldo: $" << std::fixed << std::setprecision(2)
-						<< baseDatosPersona.obtenerSaldoCuenta(numeroCuenta) << std::endl;
+						<< nuevoSaldo << std::endl;
 					registrarOperacion("deposito");
 				}
 				else {
@@ -503,21 +511,18 @@ void Banco::realizarDeposito() {
 void Banco::realizarRetiro() {
 	std::string numeroCuenta = ManejoMenus::solicitarNumeroCuenta("para retiro");
 	if (!numeroCuenta.empty()) {
-		double saldoActual = baseDatosPersona.obtenerSaldoCuenta(numeroCuenta);
+		double saldoActual = repositorio.obtenerSaldoCuenta(numeroCuenta);
 		if (saldoActual >= 0) { // Cuenta existe
 			std::cout << "Saldo actual: $" << std::fixed << std::setprecision(2) << saldoActual << std::endl;
 
 			double monto = ManejoMenus::solicitarMonto();
-			if (monto > 0 && baseDatosPersona.verificarFondosSuficientes(numeroCuenta, monto)) {
-				if (baseDatosPersona.retirarDeCuenta(numeroCuenta, monto)) {
-					ManejoMenus::mostrarMensajeExito("Retiro realizado exitosamente.");
-					std::cout << "Nuevo saldo: $" << std::fixed << std::setprecision(2)
-						<< baseDatosPersona.obtenerSaldoCuenta(numeroCuenta) << std::endl;
-					registrarOperacion("retiro");
-				}
-				else {
-					ManejoMenus::mostrarMensajeError("Error al realizar el retiro.");
-				}
+			double nuevoSaldo = 0.0;
+			// El retiro verifica fondos y descuenta en una sola operación atómica
+			if (monto > 0 && repositorio.retirarDeCuenta(numeroCuenta, monto, &nuevoSaldo)) {
+				ManejoMenus::mostrarMensajeExito("Retiro realizado exitosamente.");
+				std::cout << "Nuevo saldo: $" << std::fixed << std::setprecision(2)
+					<< nuevoSaldo << std::endl;
+				registrarOperacion("retiro");
 			}
 			else {
 				ManejoMenus::mostrarMensajeError("Fondos insuficientes o monto inválido.");
@@ -533,7 +538,7 @@ void Banco::realizarRetiro() {
 void Banco::consultarSaldo() {
 	std::string numeroCuenta = ManejoMenus::solicitarNumeroCuenta("para consulta");
 	if (!numeroCuenta.empty()) {
-		double saldo = baseDatosPersona.obtenerSaldoCuenta(numeroCuenta);
+		double saldo = repositorio.obtenerSaldoCuenta(numeroCuenta);
 		if (saldo >= 0) {
 			std::cout << "Saldo actual de la cuenta " << numeroCuenta << ": $"
 				<< std::fixed << std::setprecision(2) << saldo << std::endl;
@@ -549,7 +554,7 @@ void Banco::consultarSaldo() {
 void Banco::mostrarInformacionCuenta() {
 	std::string numeroCuenta = ManejoMenus::solicitarNumeroCuenta("para información");
 	if (!numeroCuenta.empty()) {
-		auto infoCuenta = baseDatosPersona.obtenerInformacionCuenta(numeroCuenta);
+		auto infoCuenta = repositorio.obtenerInformacionCuenta(numeroCuenta);
 		auto view = infoCuenta.view();
 
 		if (!view.empty() && view.find("numeroCuenta") != view.end()) {
@@ -15,7 +15,7 @@ class NodoPersona;
 class CuentaAhorros;
 class CuentaCorriente;
 
-#include "_BaseDatosPersona.h"
+#include "IRepositorioBanco.h"
 #include <string>
 #include <tuple>
 #include <memory>
@@ -23,10 +23,10 @@ class CuentaCorriente;
 
 class Banco {
 private:
+	IRepositorioBanco& repositorio;
 	std::unique_ptr<BancoManejoPersona> manejoPersonas;
 	std::unique_ptr<BancoManejoCuenta> manejoCuentas;
 	std::unique_ptr<BancoManejaRegistro> manejoRegistros;
-	_BaseDatosPersona baseDatosPersona;
 	std::unique_ptr<BuscadorCuentas> buscadorCuentas;
 	std::unique_ptr<ValidadorBaseDatos> validadorBaseDatos;
 
@@ -59,6 +59,12 @@ private:
 public:
 
 	Banco();
+
+	/**
+	 * @brief Construye el banco sobre un repositorio concreto (p. ej. el motor en memoria)
+	 * @param repositorioBanco Repositorio que usarán todas las operaciones del banco
+	 */
+	explicit Banco(IRepositorioBanco& repositorioBanco);
 	~Banco();
 
 	void agregarPersonaConCuenta();
@@ -1,9 +1,7 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include "BancoManejaRegistro.h"
-#include "ConexionMongo.h"
-#include <bsoncxx/builder/basic/document.hpp>
-#include <bsoncxx/builder/basic/kvp.hpp>
+#include "AuditoriaAsincrona.h"
 #include <string>
 #include <vector>
 #include <fstream>
@@ -17,48 +15,12 @@ BancoManejaRegistro::BancoManejaRegistro() {
 }
 
 bool BancoManejaRegistro::agregarRegistroBaseDatos(const std::string& tipoOperacion, const std::string& cedula) {
-    try {
-        // 1. Guardar en archivo local (mantener funcionalidad existente)
-        std::ofstream archivo(ARCHIVO_REGISTROS, std::ios::app);
-        if (!archivo.is_open()) {
-            std::cerr << "Error: No se pudo abrir el archivo de registros." << std::endl;
-            return false;
-        }
-
-        std::string fechaHora = obtenerFechaHoraActual();
-
-        // Formato: [FECHA_HORA] TIPO_OPERACION - CEDULA
-        archivo << "[" << fechaHora << "] " << tipoOperacion << " - Cedula: " << cedula << std::endl;
-        archivo.close();
-
-        // 2. Guardar en MongoDB (nueva funcionalidad)
-        mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-        auto db = client["Banco"];
-        auto collection = db["registros"];
-
-        // Crear documento para MongoDB
-        auto registroDoc = bsoncxx::builder::basic::document{};
-        registroDoc.append(
-            bsoncxx::builder::basic::kvp("fechaHora", fechaHora),
-            bsoncxx::builder::basic::kvp("tipoOperacion", tipoOperacion),
-            bsoncxx::builder::basic::kvp("cedula", cedula),
-            bsoncxx::builder::basic::kvp("timestamp", std::chrono::duration_cast<std::chrono::milliseconds>(
-                std::chrono::system_clock::now().time_since_epoch()).count())
-        );
-
-        auto result = collection.insert_one(registroDoc.view());
-
-        if (!result) {
-            std::cerr << "Error: No se pudo insertar el registro en MongoDB." << std::endl;
-            return false;
-        }
-
-        return true;
-    }
-    catch (const std::exception& e) {
-        std::cerr << "Error al escribir registro: " << e.what() << std::endl;
+    // Sin E/S en el camino de la operación: archivo y MongoDB se escriben por lotes
+    if (!AuditoriaAsincrona::encolar(tipoOperacion, cedula)) {
+        std::cerr << "Error: La cola de registros está llena." << std::endl;
         return false;
     }
+    return true;
 }
 
 std::string BancoManejaRegistro::obtenerFechaHoraActual() const {
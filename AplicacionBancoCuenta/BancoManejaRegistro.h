@@ -9,6 +9,9 @@
 /**
  * @class BancoManejaRegistro
  * @brief Clase para gestionar registros de operaciones bancarias
+ *
+ * Delega la persistencia en AuditoriaAsincrona: el registro se encola y el hilo
+ * escritor lo guarda por lotes en el archivo local y en la colección registros.
  */
 class BancoManejaRegistro {
 public:
@@ -18,10 +21,10 @@ public:
     BancoManejaRegistro();
 
     /**
-     * @brief Agrega un registro de operación a la base de datos
+     * @brief Encola un registro de operación para el archivo local y la base de datos
      * @param tipoOperacion Tipo de operación realizada
      * @param cedula Número de cédula de la persona involucrada
-     * @return true si se registró correctamente, false en caso contrario
+     * @return true si el registro quedó encolado, false si la cola de auditoría estaba llena
      */
     bool agregarRegistroBaseDatos(const std::string& tipoOperacion, const std::string& cedula);
 
@@ -30,7 +33,4 @@ public:
      * @return Fecha y hora formateada
      */
     std::string obtenerFechaHoraActual() const;
-
-private:
-    const std::string ARCHIVO_REGISTROS = "registros_operaciones.log";
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
  * @file BancoManejoCuenta.cpp
  */
 #include "BancoManejoCuenta.h"
-#include "ConexionMongo.h"
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/json.hpp>
@@ -10,96 +9,103 @@
 #include <vector>
 #include "Cuenta.h"
 
-BancoManejoCuenta::BancoManejoCuenta(BancoManejoPersona& manejadorPersonas)
-	: manejoPersonas(manejadorPersonas) {
+BancoManejoCuenta::BancoManejoCuenta(BancoManejoPersona& manejadorPersonas, IRepositorioBanco& repositorioBanco)
+	: manejoPersonas(manejadorPersonas), repositorio(repositorioBanco) {
 }
 
-// Implementación recursiva para búsqueda de cuentas
-template<typename TipoCuenta>
-TipoCuenta* BancoManejoCuenta::buscarCuentaRecursivo(TipoCuenta* cuenta, const std::string& numeroCuenta) {
-	if (!cuenta) return nullptr;
-
-	if (cuenta->getNumeroCuenta() == numeroCuenta) {
-		return cuenta;
+// Búsqueda de una cuenta por número en la columna de números de la tabla
+template<typename T>
+std::pair<T*, Persona*> BancoManejoCuenta::buscarCuentaEnTabla(TipoCuenta tipo, const std::string& numeroCuenta) {
+	const TablaCuentas& tabla = TablaCuentas::global();
+	TablaCuentas::Fila fila = tabla.buscarPorNumero(numeroCuenta);
+	if (fila == TablaCuentas::SIN_FILA || tabla.tipo(fila) != tipo || !tabla.titular(fila)) {
+		return { nullptr, nullptr };
 	}
-
-	return buscarCuentaRecursivo(cuenta->getSiguiente(), numeroCuenta);
+	return { static_cast<T*>(tabla.cuenta(fila)), tabla.titular(fila) };
 }
 
-std::pair<CuentaAhorros*, Persona*> BancoManejoCuenta::buscarCuentaAhorros(const std::string& numeroCuenta) {
-	std::pair<CuentaAhorros*, Persona*> resultado = { nullptr, nullptr };
+TablaCuentas::Fila BancoManejoCuenta::filaEnMemoria(const std::string& numeroCuenta) const {
+	const TablaCuentas& tabla = TablaCuentas::global();
+	TablaCuentas::Fila fila = tabla.buscarPorNumero(numeroCuenta);
+	if (fila == TablaCuentas::SIN_FILA || !tabla.titular(fila)) {
+		return TablaCuentas::SIN_FILA;
+	}
+	return fila;
+}
 
-	manejoPersonas.forEachPersona([&](Persona* persona) {
-		if (resultado.first) return; // Ya encontrado
+void BancoManejoCuenta::sincronizarSaldo(const std::string& numeroCuenta, double saldo) {
+	TablaCuentas::Fila fila = filaEnMemoria(numeroCuenta);
+	if (fila != TablaCuentas::SIN_FILA) {
+		TablaCuentas::global().setSaldo(fila, saldo);
+	}
+}
 
-		CuentaAhorros* cuenta = buscarCuentaRecursivo(persona->getCabezaAhorros(), numeroCuenta);
-		if (cuenta) {
-			resultado = { cuenta, persona };
-		}
-		});
+void BancoManejoCuenta::sincronizarMovimiento(const std::string& numeroCuenta, double delta) {
+	TablaCuentas::Fila fila = filaEnMemoria(numeroCuenta);
+	if (fila != TablaCuentas::SIN_FILA) {
+		TablaCuentas& tabla = TablaCuentas::global();
+		tabla.setSaldo(fila, tabla.saldo(fila) + delta);
+	}
+}
 
-	return resultado;
+std::pair<CuentaAhorros*, Persona*> BancoManejoCuenta::buscarCuentaAhorros(const std::string& numeroCuenta) {
+	return buscarCuentaEnTabla<CuentaAhorros>(TipoCuenta::AHORROS, numeroCuenta);
 }
 
 std::pair<CuentaCorriente*, Persona*> BancoManejoCuenta::buscarCuentaCorriente(const std::string& numeroCuenta) {
-	std::pair<CuentaCorriente*, Persona*> resultado = { nullptr, nullptr };
-
-	manejoPersonas.forEachPersona([&](Persona* persona) {
-		if (resultado.first) return; // Ya encontrado
-
-		CuentaCorriente* cuenta = buscarCuentaRecursivo(persona->getCabezaCorriente(), numeroCuenta);
-		if (cuenta) {
-			resultado = { cuenta, persona };
-		}
-		});
-
-	return resultado;
+	return buscarCuentaEnTabla<CuentaCorriente>(TipoCuenta::CORRIENTE, numeroCuenta);
 }
 
-// Búsqueda recursiva por criterios múltiples
-void BancoManejoCuenta::buscarCuentasPorCriterioRecursivo(NodoPersona* nodo, const std::string& criterio, const std::string& valor, std::vector<std::pair<Persona*, void*>>& resultados) {
-	if (!nodo || !nodo->persona) return;
+// Búsqueda por criterios múltiples en las cuentas de una persona
+void BancoManejoCuenta::buscarCuentasPorCriterioEnPersona(Persona* persona, const std::string& criterio, const std::string& valor, std::vector<std::pair<Persona*, void*>>& resultados) {
+	if (!persona) return;
+
+	// La fecha buscada se interpreta una vez y se compara como entero con cada cuenta
+	Fecha fechaBuscada = criterio == "fecha" ? Fecha(valor) : Fecha(0, 0, 0);
 
 	// Buscar en cuentas de ahorros
-	std::function<void(CuentaAhorros*)> buscarEnAhorros = [&](CuentaAhorros* cuenta) {
-		if (!cuenta) return;
+	persona->recorrerCuentas(TipoCuenta::AHORROS, [&](Cuenta<double>* base) {
+		CuentaAhorros* cuenta = static_cast<CuentaAhorros*>(base);
 
 		bool coincide = false;
-		if (criterio == "numero" && cuenta->getCuentaAhorros()->getNumeroCuenta() == valor) coincide = true;
-		if (criterio == "fecha" && cuenta->getCuentaAhorros()->getFechaApertura() == valor) coincide = true;
+		if (criterio == "numero" && cuenta->getNumeroCuenta() == valor) coincide = true;
+		if (criterio == "fecha" && fechaBuscada.tieneFecha() && base->getFechaApertura() == fechaBuscada) coincide = true;
 
 		if (coincide) {
-			resultados.push_back({ nodo->persona, cuenta->getCuentaAhorros() });
+			resultados.push_back({ persona, cuenta });
 		}
-
-		buscarEnAhorros(cuenta->getSiguiente());
-		};
+		});
 
 	// Buscar en cuentas corrientes
-	std::function<void(CuentaCorriente*)> buscarEnCorrientes = [&](CuentaCorriente* cuenta) {
-		if (!cuenta) return;
+	persona->recorrerCuentas(TipoCuenta::CORRIENTE, [&](Cuenta<double>* base) {
+		CuentaCorriente* cuenta = static_cast<CuentaCorriente*>(base);
 
 		bool coincide = false;
-		if (criterio == "numero" && cuenta->getCuentaCorriente()->getNumeroCuenta() == valor) coincide = true;
-		if (criterio == "fecha" && cuenta->getCuentaCorriente()->getFechaApertura() == valor) coincide = true;
+		if (criterio == "numero" && cuenta->getNumeroCuenta() == valor) coincide = true;
+		if (criterio == "fecha" && fechaBuscada.tieneFecha() && base->getFechaApertura() == fechaBuscada) coincide = true;
 
 		if (coincide) {
-			resultados.push_back({ nodo->persona, cuenta->getCuentaCorriente() });
+			resultados.push_back({ persona, cuenta });
 		}
-
-		buscarEnCorrientes(cuenta->getSiguiente());
-		};
-
-	buscarEnAhorros(nodo->persona->getCabezaAhorros());
-	buscarEnCorrientes(nodo->persona->getCabezaCorriente());
-
-	// Recursión al siguiente nodo
-	buscarCuentasPorCriterioRecursivo(nodo->siguiente, criterio, valor, resultados);
+		});
 }
 
 std::vector<std::pair<Persona*, void*>> BancoManejoCuenta::buscarCuentasPorNumero(const std::string& numero) {
 	std::vector<std::pair<Persona*, void*>> resultados;
-	buscarCuentasPorCriterioRecursivo(manejoPersonas.getListaPersonas(), "numero", numero, resultados);
+
+	// El número identifica a una sola cuenta: se resuelve en el índice de la tabla
+	TablaCuentas::Fila fila = filaEnMemoria(numero);
+	if (fila == TablaCuentas::SIN_FILA) {
+		return resultados;
+	}
+	const TablaCuentas& tabla = TablaCuentas::global();
+	Cuenta<double>* cuenta = tabla.cuenta(fila);
+	if (tabla.tipo(fila) == TipoCuenta::AHORROS) {
+		resultados.push_back({ tabla.titular(fila), static_cast<CuentaAhorros*>(cuenta) });
+	}
+	else {
+		resultados.push_back({ tabla.titular(fila), static_cast<CuentaCorriente*>(cuenta) });
+	}
 	return resultados;
 }
 
@@ -108,19 +114,16 @@ bool BancoManejoCuenta::crearCuentaAhorros(const std::string& cedula, CuentaAhor
 
 	// Crear documento para MongoDB
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
-
 		auto cuentaDoc = bsoncxx::builder::basic::document{};
 		cuentaDoc.append(
 			bsoncxx::builder::basic::kvp("tipo", "ahorros"),
 			bsoncxx::builder::basic::kvp("numeroCuenta", cuenta->getNumeroCuenta()),
 			bsoncxx::builder::basic::kvp("saldo", cuenta->getSaldo()),
 			bsoncxx::builder::basic::kvp("fechaApertura", cuenta->getFechaApertura()),
-			bsoncxx::builder::basic::kvp("estado", cuenta->getEstadoCuenta())
+			bsoncxx::builder::basic::kvp("estado", std::string(cuenta->getEstadoCuenta()))
 		);
 
-		return dbPersona.agregarCuentaPersona(cedula, cuentaDoc.extract());
+		return repositorio.agregarCuentaPersona(cedula, cuentaDoc.extract());
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error creando cuenta: " << e.what() << std::endl;
@@ -133,19 +136,16 @@ bool BancoManejoCuenta::crearCuentaCorriente(const std::string& cedula, CuentaCo
 
 	// Crear documento para MongoDB
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
-
 		auto cuentaDoc = bsoncxx::builder::basic::document{};
 		cuentaDoc.append(
 			bsoncxx::builder::basic::kvp("tipo", "corriente"),
 			bsoncxx::builder::basic::kvp("numeroCuenta", cuenta->getNumeroCuenta()),
 			bsoncxx::builder::basic::kvp("saldo", cuenta->getSaldo()),
 			bsoncxx::builder::basic::kvp("fechaApertura", cuenta->getFechaApertura()),
-			bsoncxx::builder::basic::kvp("estado", cuenta->getEstadoCuenta())
+			bsoncxx::builder::basic::kvp("estado", std::string(cuenta->getEstadoCuenta()))
 		);
 
-		return dbPersona.agregarCuentaPersona(cedula, cuentaDoc.extract());
+		return repositorio.agregarCuentaPersona(cedula, cuentaDoc.extract());
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error creando cuenta corriente: " << e.what() << std::endl;
@@ -157,10 +157,12 @@ bool BancoManejoCuenta::crearCuentaCorriente(const std::string& cedula, CuentaCo
 
 bool BancoManejoCuenta::depositar(const std::string& numeroCuenta, double monto) {
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
-
-		return dbPersona.depositarEnCuenta(numeroCuenta, monto);
+		double nuevoSaldo = 0.0;
+		if (!repositorio.depositarEnCuenta(numeroCuenta, monto, &nuevoSaldo)) {
+			return false;
+		}
+		sincronizarSaldo(numeroCuenta, nuevoSaldo);
+		return true;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error en depósito: " << e.what() << std::endl;
@@ -170,10 +172,12 @@ bool BancoManejoCuenta::depositar(const std::string& numeroCuenta, double monto)
 
 bool BancoManejoCuenta::retirar(const std::string& numeroCuenta, double monto) {
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
-
-		return dbPersona.retirarDeCuenta(numeroCuenta, monto);
+		double nuevoSaldo = 0.0;
+		if (!repositorio.retirarDeCuenta(numeroCuenta, monto, &nuevoSaldo)) {
+			return false;
+		}
+		sincronizarSaldo(numeroCuenta, nuevoSaldo);
+		return true;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error en retiro: " << e.what() << std::endl;
@@ -183,10 +187,7 @@ bool BancoManejoCuenta::retirar(const std::string& numeroCuenta, double monto) {
 
 double BancoManejoCuenta::consultarSaldo(const std::string& numeroCuenta) {
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
-
-		return dbPersona.obtenerSaldoCuenta(numeroCuenta);
+		return repositorio.obtenerSaldoCuenta(numeroCuenta);
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al consultar saldo: " << e.what() << std::endl;
@@ -196,10 +197,7 @@ double BancoManejoCuenta::consultarSaldo(const std::string& numeroCuenta) {
 
 bool BancoManejoCuenta::validarFondosSuficientes(const std::string& numeroCuenta, double monto) {
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
-
-		return dbPersona.verificarFondosSuficientes(numeroCuenta, monto);
+		return repositorio.verificarFondosSuficientes(numeroCuenta, monto);
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al validar fondos: " << e.what() << std::endl;
@@ -209,10 +207,12 @@ bool BancoManejoCuenta::validarFondosSuficientes(const std::string& numeroCuenta
 
 bool BancoManejoCuenta::transferir(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto) {
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
-
-		return dbPersona.realizarTransferencia(cuentaOrigen, cuentaDestino, monto);
+		if (!repositorio.realizarTransferencia(cuentaOrigen, cuentaDestino, monto)) {
+			return false;
+		}
+		sincronizarMovimiento(cuentaOrigen, -monto);
+		sincronizarMovimiento(cuentaDestino, monto);
+		return true;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error en transferencia: " << e.what() << std::endl;
@@ -220,12 +220,23 @@ bool BancoManejoCuenta::transferir(const std::string& cuentaOrigen, const std::s
 	}
 }
 
-std::string BancoManejoCuenta::obtenerInformacionCompleta(const std::string& numeroCuenta) {
+std::vector<ResultadoTransferencia> BancoManejoCuenta::transferirLote(const std::vector<Transferencia>& transferencias) {
 	try {
-		mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona dbPersona(client);
+		return repositorio.realizarTransferenciasLote(transferencias);
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error en transferencia por lotes: " << e.what() << std::endl;
+		std::vector<ResultadoTransferencia> resultados(transferencias.size());
+		for (auto& resultado : resultados) {
+			resultado.mensaje = e.what();
+		}
+		return resultados;
+	}
+}
 
-		auto infoDoc = dbPersona.obtenerInformacionCuenta(numeroCuenta);
+std::string BancoManejoCuenta::obtenerInformacionCompleta(const std::string& numeroCuenta) {
+	try {
+		auto infoDoc = repositorio.obtenerInformacionCuenta(numeroCuenta);
 
 		if (infoDoc.view().empty()) {
 			return "Cuenta no encontrada";
@@ -244,6 +255,10 @@ std::string BancoManejoCuenta::obtenerInformacionCompleta(const std::string& num
 }
 
 bool BancoManejoCuenta::existeCuenta(const std::string& numeroCuenta) {
+	// Una cuenta cargada en memoria existe sin consultar la base
+	if (filaEnMemoria(numeroCuenta) != TablaCuentas::SIN_FILA) {
+		return true;
+	}
 	double saldo = consultarSaldo(numeroCuenta);
 	return saldo >= 0.0; // Si devuelve -1.0, la cuenta no existe
 }
@@ -252,40 +267,29 @@ bool BancoManejoCuenta::existeCuenta(const std::string& numeroCuenta) {
 
 std::vector<std::pair<Persona*, void*>> BancoManejoCuenta::buscarCuentasPorFecha(const std::string& fecha) {
 	std::vector<std::pair<Persona*, void*>> resultados;
-	buscarCuentasPorCriterioRecursivo(manejoPersonas.getListaPersonas(), "fecha", fecha, resultados);
+	manejoPersonas.forEachPersona([&](Persona* persona) {
+		buscarCuentasPorCriterioEnPersona(persona, "fecha", fecha, resultados);
+		});
 	return resultados;
 }
 
 std::vector<std::pair<Persona*, void*>> BancoManejoCuenta::buscarCuentasPorSaldo(double saldoMinimo) {
 	std::vector<std::pair<Persona*, void*>> resultados;
 
-	// Esta implementación necesita lógica diferente ya que el saldo se debe comparar numéricamente
-	manejoPersonas.forEachPersona([&](Persona* persona) {
-		// Buscar en cuentas de ahorros
-		std::function<void(CuentaAhorros*)> buscarEnAhorros = [&](CuentaAhorros* cuenta) {
-			if (!cuenta || !cuenta->getCuentaAhorros()) return;
-
-			if (cuenta->getCuentaAhorros()->getSaldo() >= saldoMinimo) {
-				resultados.push_back({ persona, cuenta->getCuentaAhorros() });
-			}
-
-			buscarEnAhorros(cuenta->getSiguiente());
-			};
-
-		// Buscar en cuentas corrientes
-		std::function<void(CuentaCorriente*)> buscarEnCorrientes = [&](CuentaCorriente* cuenta) {
-			if (!cuenta || !cuenta->getCuentaCorriente()) return;
+	// Un solo recorrido secuencial de la columna de saldos; el titular sale de la misma fila
+	const TablaCuentas& tabla = TablaCuentas::global();
+	for (TablaCuentas::Fila fila : tabla.filasConSaldoMinimo(saldoMinimo)) {
+		Persona* titular = tabla.titular(fila);
+		if (!titular) continue;
 
-			if (cuenta->getCuentaCorriente()->getSaldo() >= saldoMinimo) {
-				resultados.push_back({ persona, cuenta->getCuentaCorriente() });
-			}
-
-			buscarEnCorrientes(cuenta->getSiguiente());
-			};
-
-		buscarEnAhorros(persona->getCabezaAhorros());
-		buscarEnCorrientes(persona->getCabezaCorriente());
-		});
+		Cuenta<double>* cuenta = tabla.cuenta(fila);
+		if (tabla.tipo(fila) == TipoCuenta::AHORROS) {
+			resultados.push_back({ titular, static_cast<CuentaAhorros*>(cuenta) });
+		}
+		else {
+			resultados.push_back({ titular, static_cast<CuentaCorriente*>(cuenta) });
+		}
+	}
 
 	return resultados;
 }
@@ -297,22 +301,12 @@ std::vector<std::pair<Persona*, void*>> BancoManejoCuenta::buscarCuentasPorCedul
 	if (!persona) return resultados;
 
 	// Agregar todas las cuentas de esta persona
-	std::function<void(CuentaAhorros*)> agregarAhorros = [&](CuentaAhorros* cuenta) {
-		if (!cuenta || !cuenta->getCuentaAhorros()) return;
-
-		resultados.push_back({ persona, cuenta->getCuentaAhorros() });
-		agregarAhorros(cuenta->getSiguiente());
-		};
-
-	std::function<void(CuentaCorriente*)> agregarCorrientes = [&](CuentaCorriente* cuenta) {
-		if (!cuenta || !cuenta->getCuentaCorriente()) return;
-
-		resultados.push_back({ persona, cuenta->getCuentaCorriente() });
-		agregarCorrientes(cuenta->getSiguiente());
-		};
-
-	agregarAhorros(persona->getCabezaAhorros());
-	agregarCorrientes(persona->getCabezaCorriente());
+	persona->recorrerCuentas(TipoCuenta::AHORROS, [&](Cuenta<double>* cuenta) {
+		resultados.push_back({ persona, static_cast<CuentaAhorros*>(cuenta) });
+		});
+	persona->recorrerCuentas(TipoCuenta::CORRIENTE, [&](Cuenta<double>* cuenta) {
+		resultados.push_back({ persona, static_cast<CuentaCorriente*>(cuenta) });
+		});
 
 	return resultados;
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "CuentaAhorros.h"
 #include "CuentaCorriente.h"
 #include "BancoManejoPersona.h"
-#include "_BaseDatosPersona.h"
+#include "IRepositorioBanco.h"
 #include <string>
 #include <vector>
 
@@ -16,12 +16,20 @@
 class BancoManejoCuenta {
 private:
     BancoManejoPersona& manejoPersonas;
+    IRepositorioBanco& repositorio;
 
-    // Métodos recursivos para búsquedas en cuentas
-    template<typename TipoCuenta>
-    TipoCuenta* buscarCuentaRecursivo(TipoCuenta* cuenta, const std::string& numeroCuenta);
+    // Búsqueda por número en el índice de TablaCuentas, con el titular de la fila
+    template<typename T>
+    std::pair<T*, Persona*> buscarCuentaEnTabla(TipoCuenta tipo, const std::string& numeroCuenta);
 
-    void buscarCuentasPorCriterioRecursivo(NodoPersona* nodo,
+    // Fila en memoria de una cuenta con titular, o SIN_FILA; O(1)
+    TablaCuentas::Fila filaEnMemoria(const std::string& numeroCuenta) const;
+
+    // Copia en memoria del saldo que la base confirmó, si la cuenta está cargada
+    void sincronizarSaldo(const std::string& numeroCuenta, double saldo);
+    void sincronizarMovimiento(const std::string& numeroCuenta, double delta);
+
+    void buscarCuentasPorCriterioEnPersona(Persona* persona,
         const std::string& criterio,
         const std::string& valor,
         std::vector<std::pair<Persona*, void*>>& resultados);
@@ -30,7 +38,7 @@ public:
 	CuentaAhorros* cuentaAhorrosActual;
 	CuentaCorriente* cuentaCorrienteActual;
 
-    explicit BancoManejoCuenta(BancoManejoPersona& manejadorPersonas);
+    BancoManejoCuenta(BancoManejoPersona& manejadorPersonas, IRepositorioBanco& repositorioBanco);
 
     // Operaciones de búsqueda de cuentas
     std::pair<CuentaAhorros*, Persona*> buscarCuentaAhorros(const std::string& numeroCuenta);
@@ -84,6 +92,13 @@ public:
      */
     bool transferir(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto);
 
+    /**
+     * @brief Liquida un lote de transferencias en una sola transacción
+     * @param transferencias Transferencias a aplicar, en orden
+     * @return Un resultado por transferencia, en el mismo orden
+     */
+    std::vector<ResultadoTransferencia> transferirLote(const std::vector<Transferencia>& transferencias);
+
     /**
      * @brief Obtiene información completa de una cuenta desde la base de datos
      * @param numeroCuenta Número de cuenta a consultar
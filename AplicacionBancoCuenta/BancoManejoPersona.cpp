@@ -1,101 +1,123 @@
 #include "BancoManejoPersona.h"
 #include "ConexionMongo.h"
+#include "FabricaRepositorioBanco.h"
 #include <algorithm>
 #include <conio.h>
 
-BancoManejoPersona::BancoManejoPersona() : listaPersonas(nullptr), personaActual(nullptr) {}
+BancoManejoPersona::BancoManejoPersona() : vistaVigente(false), personaActual(nullptr) {}
 
-BancoManejoPersona::~BancoManejoPersona() {
-    eliminarPersonasRecursivo(listaPersonas);
-}
-
-// Implementación recursiva para eliminar toda la lista
-void BancoManejoPersona::eliminarPersonasRecursivo(NodoPersona* nodo) {
-    if (!nodo) return;
-
-    eliminarPersonasRecursivo(nodo->siguiente);
-    delete nodo;
-}
-
-// Búsqueda recursiva más eficiente integrada con base de datos
-NodoPersona* BancoManejoPersona::buscarPersonaRecursivo(NodoPersona* nodo, const std::string& cedula) {
-    if (!nodo) {
-        // Si no se encontró en la lista enlazada, buscar en la base de datos
-        try {
-            std::cout << " Cargando... Por favor espere." << std::endl;
-
-            mongocxx::client& client = ConexionMongo::obtenerClienteBaseDatos();
-            _BaseDatosPersona dbPersona(client);
+BancoManejoPersona::~BancoManejoPersona() = default;
 
-            // Buscar en la base de datos MongoDB
-            Persona* personaBD = dbPersona.obtenerPersonaPorCedula(cedula);
+// Si no está en memoria, se busca en la base de datos y se registra
+Persona* BancoManejoPersona::cargarPersonaDesdeBaseDatos(const std::string& cedula) {
+    try {
+        std::cout << " Cargando... Por favor espere." << std::endl;
 
-            if (personaBD) {
-                // Si se encontró en la base de datos, agregarla a la lista enlazada
-                agregarPersona(personaBD);
+        // Buscar en el repositorio del motor configurado
+        Persona* personaBD = FabricaRepositorioBanco::obtenerRepositorio().obtenerPersonaPorCedula(cedula);
 
-                // Retornar el nodo recién agregado (que será la cabeza de la lista)
-                return listaPersonas;
-            }
-            std::cout << "Presione cualquier tecla para continuar..." << std::endl;
-            int teclaCualquiera = _getch();
-			(void)teclaCualquiera; 
-
-			Utilidades::limpiarPantallaPreservandoMarquesina(0);
-        }
-        catch (const std::exception& e) {
-            std::cerr << "Error al buscar en base de datos: " << e.what() << std::endl;
-            system("pause");
-            Utilidades::limpiarPantallaPreservandoMarquesina(0);
+        if (personaBD) {
+            agregarPersona(personaBD);
+            return personaBD;
         }
+        std::cout << "Presione cualquier tecla para continuar..." << std::endl;
+        int teclaCualquiera = _getch();
+		(void)teclaCualquiera; 
 
-        return nullptr; // No se encontró ni en memoria ni en base de datos
+		Utilidades::limpiarPantallaPreservandoMarquesina(0);
     }
-
-    if (nodo->persona && nodo->persona->getCedula() == cedula) {
-        return nodo;
+    catch (const std::exception& e) {
+        std::cerr << "Error al buscar en base de datos: " << e.what() << std::endl;
+        system("pause");
+        Utilidades::limpiarPantallaPreservandoMarquesina(0);
     }
 
-    return buscarPersonaRecursivo(nodo->siguiente, cedula);
+    return nullptr; // No se encontró ni en memoria ni en base de datos
 }
 
 void BancoManejoPersona::agregarPersona(Persona* persona) {
     if (!persona) return;
 
-    NodoPersona* nuevo = new NodoPersona(persona);
-    nuevo->siguiente = listaPersonas;
-    listaPersonas = nuevo;
+    personas.insertar(persona);
+    vistaVigente = false;
 }
 
 Persona* BancoManejoPersona::buscarPersonaPorCedula(const std::string& cedula) {
-    NodoPersona* nodo = buscarPersonaRecursivo(listaPersonas, cedula);
-    return nodo ? nodo->persona : nullptr;
+    Persona* persona = personas.buscar(cedula);
+    return persona ? persona : cargarPersonaDesdeBaseDatos(cedula);
 }
 
 bool BancoManejoPersona::existePersona(const std::string& cedula) {
     return buscarPersonaPorCedula(cedula) != nullptr;
 }
 
-// Aplicar función recursivamente
-void BancoManejoPersona::aplicarFuncionRecursivo(NodoPersona* nodo, const std::function<void(Persona*)>& funcion) {
-    if (!nodo) return;
-
-    if (nodo->persona) {
-        funcion(nodo->persona);
+bool BancoManejoPersona::quitarPersona(const std::string& cedula) {
+    if (personaActual && personaActual->getCedula() == cedula) {
+        personaActual = nullptr;
     }
-    aplicarFuncionRecursivo(nodo->siguiente, funcion);
+    vistaVigente = false;
+    return personas.quitar(cedula);
+}
+
+void BancoManejoPersona::limpiarPersonas() {
+    personas.limpiar();
+    personaActual = nullptr;
+    vistaVigente = false;
 }
 
 void BancoManejoPersona::forEachPersona(const std::function<void(Persona*)>& funcion) {
-    aplicarFuncionRecursivo(listaPersonas, funcion);
+    personas.paraCada([&funcion](Persona* persona) {
+        funcion(persona);
+        });
 }
 
 void BancoManejoPersona::forEachNodoPersona(const std::function<void(NodoPersona*)>& funcion) {
-    std::function<void(NodoPersona*)> aplicarRecursivo = [&](NodoPersona* nodo) {
-        if (!nodo) return;
+    for (NodoPersona* nodo = getListaPersonas(); nodo; nodo = nodo->siguiente) {
         funcion(nodo);
-        aplicarRecursivo(nodo->siguiente);
-        };
+    }
+}
+
+NodoPersona* BancoManejoPersona::getListaPersonas() const {
+    if (!vistaVigente) {
+        // La lista enlazada antigua ponía a la persona más reciente al principio
+        vistaLista.clear();
+        vistaLista.reserve(personas.tamano());
+        personas.paraCada([this](Persona* persona) {
+            vistaLista.emplace_back(persona);
+            });
+        std::reverse(vistaLista.begin(), vistaLista.end());
+        for (size_t i = 0; i + 1 < vistaLista.size(); ++i) {
+            vistaLista[i].siguiente = &vistaLista[i + 1];
+        }
+        vistaVigente = true;
+    }
+    return vistaLista.empty() ? nullptr : &vistaLista.front();
+}
 
-    aplicarRecursivo(listaPersonas);
-}
\ No newline at end of file
+void BancoManejoPersona::setListaPersonas(NodoPersona* nuevaLista) {
+    // La lista puede continuar en nodos de la vista propia, que no se liberan
+    std::less<const NodoPersona*> menor;
+    const NodoPersona* inicioVista = vistaLista.data();
+    const NodoPersona* finVista = inicioVista + vistaLista.size();
+
+    std::vector<Persona*> nuevas;
+    NodoPersona* nodo = nuevaLista;
+    while (nodo) {
+        NodoPersona* siguiente = nodo->siguiente;
+        if (nodo->persona) {
+            nuevas.push_back(nodo->persona);
+        }
+        bool esDeLaVista = !menor(nodo, inicioVista) && menor(nodo, finVista);
+        if (!esDeLaVista) {
+            delete nodo;
+        }
+        nodo = siguiente;
+    }
+
+    personas.limpiar();
+    // Se registran de la más antigua a la más reciente para conservar el orden de la lista
+    for (auto it = nuevas.rbegin(); it != nuevas.rend(); ++it) {
+        personas.insertar(*it);
+    }
+    vistaVigente = false;
+}
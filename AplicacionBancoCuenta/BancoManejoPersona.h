@@ -4,24 +4,34 @@
 
 #include "Persona.h"
 #include "NodoPersona.h"
+#include "RegistroPersonas.h"
 #include "_BaseDatosPersona.h"
 #include <functional>
 #include <string>
+#include <vector>
 
 /**
  * @class BancoManejoPersona
  * @brief Responsable únicamente del manejo de personas en el banco
  *
  * Aplicando SRP: Una sola responsabilidad - gestionar la lista de personas
+ *
+ * Las personas se guardan en un RegistroPersonas: buscar por cédula es O(1) y recorrer
+ * es secuencial, sin recursión. getListaPersonas() sigue entregando una lista de
+ * NodoPersona para el código que aún la recorre, armada a pedido sobre el registro.
  */
 class BancoManejoPersona {
 private:
-    NodoPersona* listaPersonas;
+    RegistroPersonas personas;
+
+    // Vista en lista enlazada para compatibilidad; se rearma si el registro cambió
+    mutable std::vector<NodoPersona> vistaLista;
+    mutable bool vistaVigente;
 
-    // Métodos recursivos para operaciones en lista
-    void eliminarPersonasRecursivo(NodoPersona* nodo);
-    NodoPersona* buscarPersonaRecursivo(NodoPersona* nodo, const std::string& cedula);
-    void aplicarFuncionRecursivo(NodoPersona* nodo, const std::function<void(Persona*)>& funcion);
+    /**
+     * @brief Carga la persona desde la base de datos y la registra; nullptr si no existe
+     */
+    Persona* cargarPersonaDesdeBaseDatos(const std::string& cedula);
 
 public:
     BancoManejoPersona();
@@ -33,14 +43,41 @@ public:
     Persona* buscarPersonaPorCedula(const std::string& cedula);
     bool existePersona(const std::string& cedula);
 
+    /**
+     * @brief Quita la persona del registro sin liberarla
+     * @return true si estaba registrada
+     */
+    bool quitarPersona(const std::string& cedula);
+
+    /**
+     * @brief Quita todas las personas del registro sin liberarlas
+     */
+    void limpiarPersonas();
+
     // Iteradores funcionales
     void forEachPersona(const std::function<void(Persona*)>& funcion);
     void forEachNodoPersona(const std::function<void(NodoPersona*)>& funcion);
 
     // Getters/Setters
-    NodoPersona* getListaPersonas() const { return listaPersonas; }
-    void setListaPersonas(NodoPersona* nuevaLista) { listaPersonas = nuevaLista; }
-    bool tienePersonas() const { return listaPersonas != nullptr; }
+
+    /**
+     * @brief Lista enlazada con las personas registradas, de la más reciente a la más antigua
+     *
+     * Los nodos pertenecen a este objeto y dejan de ser válidos al agregar o quitar personas.
+     * Preferir forEachPersona() o buscarPersonaPorCedula().
+     */
+    NodoPersona* getListaPersonas() const;
+
+    /**
+     * @brief Reemplaza las personas registradas por las de la lista indicada
+     *
+     * Como antes, los nodos recibidos pasan a ser de este objeto (se liberan aquí);
+     * nullptr vacía el registro.
+     */
+    void setListaPersonas(NodoPersona* nuevaLista);
+
+    bool tienePersonas() const { return !personas.vacio(); }
+    size_t totalPersonas() const { return personas.tamano(); }
 };
 
 #endif // BANCOMANEJOPERSONA_H
\ No newline at end of file
@@ -2,8 +2,20 @@
 #include "Validar.h"
 #include <iostream>
 #include <iomanip>
+#include <conio.h>
 
-BuscadorCuentas::BuscadorCuentas(_BaseDatosPersona& bd) : baseDatos(bd) {
+namespace {
+    // Sugerencias que se muestran bajo el texto mientras se escribe
+    constexpr size_t SUGERENCIAS_VISIBLES = 5;
+
+    // Personas que se muestran en una búsqueda aproximada
+    constexpr size_t RESULTADOS_APROXIMADOS = 20;
+}
+
+BuscadorCuentas::BuscadorCuentas(IRepositorioBanco& bd) : baseDatos(bd), indices(bd) {
+    indices.registrarIndice(std::make_unique<ExtractorNombre>(), true);
+    indices.registrarIndice(std::make_unique<ExtractorApellido>(), true);
+    indices.registrarIndice(std::make_unique<ExtractorFecha>());
     inicializarEstrategias();
 }
 
@@ -12,7 +24,8 @@ void BuscadorCuentas::inicializarEstrategias() {
         { 0, [this]() { buscarPorFechaCreacion(); }},
         { 1, [this]() { buscarPorCriterioUsuario(); }},
         { 2, [this]() { buscarPorNumeroCuenta(); }},
-        { 3, [this]() { buscarPorCedula(); }}
+        { 3, [this]() { buscarPorCedula(); }},
+        { 4, [this]() { buscarAproximado(); }}
     };
 }
 
@@ -43,6 +56,29 @@ void BuscadorCuentas::buscarPorFechaCreacion() {
     system("pause");
 }
 
+void BuscadorCuentas::buscarAproximado() {
+    std::cout << "Ingrese nombre, apellido, correo o dirección (se toleran errores): ";
+    std::string consulta;
+    std::getline(std::cin, consulta);
+
+    if (consulta.empty()) {
+        std::cout << "Búsqueda cancelada.\n";
+        return;
+    }
+
+    auto resultados = indices.buscarAproximado(consulta, RESULTADOS_APROXIMADOS);
+
+    if (resultados.empty()) {
+        std::cout << "No se encontraron personas parecidas a: " << consulta << "\n";
+    }
+    else {
+        std::cout << "Personas parecidas a '" << consulta << "', de la más a la menos parecida:\n\n";
+        mostrarResultadosCriterio(resultados);
+    }
+
+    system("pause");
+}
+
 void BuscadorCuentas::buscarPorCriterioUsuario() {
     std::vector<std::string> criterios = {
         "Nombre",
@@ -82,17 +118,58 @@ void BuscadorCuentas::buscarPorCriterioUsuario() {
     }
 }
 
+std::string BuscadorCuentas::leerConSugerencias(const std::string& mensaje, const std::string& nombreIndice) {
+    std::string entrada;
+    while (true) {
+        auto sugerencias = entrada.empty()
+            ? std::vector<ArbolPrefijos::Sugerencia>()
+            : indices.sugerir(nombreIndice, entrada, SUGERENCIAS_VISIBLES);
+
+        Utilidades::limpiarPantallaPreservandoMarquesina(1);
+        std::cout << mensaje << entrada << "\n\n";
+        for (const auto& sugerencia : sugerencias) {
+            std::cout << "  " << sugerencia.texto << " (" << sugerencia.total << ")\n";
+        }
+        std::cout << "\n[Tab] completar  [Enter] buscar  [Esc] cancelar";
+
+        int tecla = _getch();
+        if (tecla == 0 || tecla == 224) {
+            (void)_getch(); // Flechas y teclas de función no se usan
+        }
+        else if (tecla == 13) {
+            std::cout << "\n";
+            return entrada;
+        }
+        else if (tecla == 27) {
+            std::cout << "\n";
+            return "";
+        }
+        else if (tecla == 9) {
+            if (!sugerencias.empty()) {
+                entrada = sugerencias.front().texto;
+            }
+        }
+        else if (tecla == 8) {
+            if (!entrada.empty()) {
+                entrada.pop_back();
+            }
+        }
+        else if (tecla >= 32) {
+            entrada.push_back(static_cast<char>(tecla));
+        }
+    }
+}
+
 void BuscadorCuentas::buscarPorNombre() {
-    std::cout << "Ingrese el nombre a buscar: ";
-    std::string nombre;
-    std::getline(std::cin, nombre);
+    std::string nombre = leerConSugerencias("Ingrese el nombre a buscar: ", "Nombre");
 
     if (nombre.empty()) {
         std::cout << "Búsqueda cancelada.\n";
         return;
     }
 
-    auto resultados = baseDatos.buscarPersonasPorCriterio("nombre", nombre);
+    // Coincidencia en cualquier parte del nombre, sin distinguir mayúsculas ni tildes
+    auto resultados = indices.buscarSubcadena(IndiceTrigramas::NOMBRE, nombre);
 
     if (resultados.empty()) {
         std::cout << "No se encontraron personas con el nombre: " << nombre << "\n";
@@ -106,16 +183,14 @@ void BuscadorCuentas::buscarPorNombre() {
 }
 
 void BuscadorCuentas::buscarPorApellido() {
-    std::cout << "Ingrese el apellido a buscar: ";
-    std::string apellido;
-    std::getline(std::cin, apellido);
+    std::string apellido = leerConSugerencias("Ingrese el apellido a buscar: ", "Apellido");
 
     if (apellido.empty()) {
         std::cout << "Búsqueda cancelada.\n";
         return;
     }
 
-    auto resultados = baseDatos.buscarPersonasPorCriterio("apellido", apellido);
+    auto resultados = indices.buscarSubcadena(IndiceTrigramas::APELLIDO, apellido);
 
     if (resultados.empty()) {
         std::cout << "No se encontraron personas con el apellido: " << apellido << "\n";
@@ -135,7 +210,7 @@ void BuscadorCuentas::buscarPorFechaNacimiento() {
         return;
     }
 
-    auto resultados = baseDatos.buscarPersonasPorCriterio("fechaNacimiento", fecha);
+    auto resultados = indices.buscarExacto("Fecha", fecha);
 
     if (resultados.empty()) {
         std::cout << "No se encontraron personas nacidas el: " << fecha << "\n";
@@ -1,5 +1,7 @@
 #pragma once
-#include "_BaseDatosPersona.h"
+#include "IRepositorioBanco.h"
+#include "GestorIndices.h"
+#include <bsoncxx/array/view.hpp>
 #include "ManejoMenus.h"
 #include "Utilidades.h"
 #include <vector>
@@ -12,10 +14,16 @@
  * @brief Responsable únicamente de las operaciones de búsqueda de cuentas
  *
  * Aplicando SRP: Una sola responsabilidad - gestionar búsquedas de cuentas
+ *
+ * Las búsquedas por nombre, apellido y fecha de nacimiento se responden desde los
+ * índices en memoria de GestorIndices, sin consultar la base de datos. Mientras se
+ * escribe un nombre o apellido se muestran las coincidencias más frecuentes. La búsqueda
+ * aproximada tolera errores de tipeo en nombre, apellido, correo y dirección.
  */
 class BuscadorCuentas {
 private:
-    _BaseDatosPersona& baseDatos;
+    IRepositorioBanco& baseDatos;
+    GestorIndices indices;
 
     std::map<int, std::function<void()>> mapaEstrategiasBusqueda;
 
@@ -25,6 +33,7 @@ private:
     void buscarPorFechaCreacion();
     void buscarPorCriterioUsuario();
     void buscarPorCedula();
+    void buscarAproximado();
 
     // Métodos auxiliares para criterios de usuario
     void buscarPorNombre();
@@ -36,6 +45,14 @@ private:
     void buscarPorNumeroCorrientes();
     void buscarPorTotalCuentas();
 
+    /**
+     * @brief Lee un texto tecla por tecla mostrando sugerencias del índice indicado
+     *
+     * Tab completa con la primera sugerencia, Enter acepta y Esc cancela.
+     * @return Texto ingresado, o vacío si se canceló
+     */
+    std::string leerConSugerencias(const std::string& mensaje, const std::string& nombreIndice);
+
     // Métodos de presentación de resultados
     void mostrarResultadosFechas(const std::vector<bsoncxx::document::value>& resultados);
     void mostrarResultadosCriterio(const std::vector<bsoncxx::document::value>& resultados);
@@ -45,6 +62,6 @@ private:
 
 public:
     void buscarPorNumeroCuenta();
-    explicit BuscadorCuentas(_BaseDatosPersona& bd);
+    explicit BuscadorCuentas(IRepositorioBanco& bd);
     void ejecutarBusqueda(int tipoBusqueda);
 };
\ No newline at end of file
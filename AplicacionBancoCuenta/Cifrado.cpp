@@ -239,7 +239,7 @@ bool Cifrado::descifrarSinCargarDatos(const Banco& banco, const std::string& nom
  * @param baseDatos Referencia a la base de datos de personas (para consistencia de API)
  * @return true si el proceso fue exitoso, false en caso contrario
  */
-bool Cifrado::iniciarProcesoDescifrado(const _BaseDatosPersona& baseDatos) {
+bool Cifrado::iniciarProcesoDescifrado(const IRepositorioBanco& baseDatos) {
     try {
 
         Utilidades::limpiarPantallaPreservandoMarquesina(1);
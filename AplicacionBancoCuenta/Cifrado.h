@@ -87,7 +87,7 @@ public:
 	 * generados por ExportadorArchivo::guardarArchivoConCifrado. Aplica principios SOLID,
 	 * usa programación funcional y recursión donde sea posible.
 	 */
-	static bool iniciarProcesoDescifrado(const class _BaseDatosPersona& baseDatos);
+	static bool iniciarProcesoDescifrado(const class IRepositorioBanco& baseDatos);
 
 private:
 	// === MÉTODOS AUXILIARES PARA EL PROCESO DE DESCIFRADO ===
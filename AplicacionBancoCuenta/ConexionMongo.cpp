@@ -2,6 +2,8 @@
 
 #include "ConexionMongo.h"
 #include "Utilidades.h"
+#include "MetricasLatencia.h"
+#include "MetricasMemoria.h"
 #include <winsock2.h>
 #include <ws2tcpip.h>
 #pragma comment(lib, "ws2_32.lib")
@@ -12,6 +14,217 @@ std::string ConexionMongo::uriServidor = "";
 std::string ConexionMongo::uriCliente = "";
 std::string ConexionMongo::uriInternet = "";
 
+size_t ConexionMongo::tamanoPool = 10;
+
+std::atomic<uint64_t> ConexionMongo::totalArrendamientos{ 0 };
+std::atomic<uint64_t> ConexionMongo::arrendamientosActivos{ 0 };
+std::atomic<uint64_t> ConexionMongo::esperasBloqueantes{ 0 };
+std::atomic<uint64_t> ConexionMongo::esperaTotalMicros{ 0 };
+std::atomic<uint64_t> ConexionMongo::esperaMaximaMicros{ 0 };
+std::atomic<uint64_t> ConexionMongo::generacionConexion{ 0 };
+
+thread_local mongocxx::pool* ConexionMongo::ClienteArrendado::poolHilo = nullptr;
+thread_local mongocxx::client* ConexionMongo::ClienteArrendado::clienteHilo = nullptr;
+
+// === ARRENDAMIENTO DE CLIENTES ===
+
+/**
+ * @brief Construye un arrendamiento dueño de un cliente del pool
+ *
+ * Queda registrado como arrendamiento vigente del hilo hasta su destrucción.
+ */
+ConexionMongo::ClienteArrendado::ClienteArrendado(mongocxx::pool& pool, mongocxx::pool::entry entrada)
+    : pool(&pool), entrada(std::move(entrada)), cliente(nullptr),
+      poolAnterior(poolHilo), clienteAnterior(clienteHilo) {
+    cliente = this->entrada.get();
+    poolHilo = this->pool;
+    clienteHilo = cliente;
+    arrendamientosActivos.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Construye un arrendamiento anidado que reutiliza el cliente vigente del hilo
+ */
+ConexionMongo::ClienteArrendado::ClienteArrendado(mongocxx::pool& pool, mongocxx::client* prestado)
+    : pool(&pool), entrada(nullptr), cliente(prestado),
+      poolAnterior(poolHilo), clienteAnterior(clienteHilo) {
+}
+
+/**
+ * @brief Devuelve el cliente al pool (si es dueño) y restaura el arrendamiento previo del hilo
+ */
+ConexionMongo::ClienteArrendado::~ClienteArrendado() {
+    if (entrada) {
+        poolHilo = poolAnterior;
+        clienteHilo = clienteAnterior;
+        arrendamientosActivos.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Estado del driver, creado en el primer uso
+ *
+ * Instancia y pools viven en el mismo objeto estático local para que su orden de
+ * destrucción quede fijado por el orden de los miembros y no por el de los estáticos.
+ */
+ConexionMongo::EstadoDriver& ConexionMongo::estadoDriver() {
+    static EstadoDriver estado;
+    return estado;
+}
+
+/**
+ * @brief Crea la instancia del driver una sola vez por proceso
+ */
+mongocxx::instance& ConexionMongo::obtenerInstancia() {
+    return estadoDriver().instancia;
+}
+
+/**
+ * @brief Agrega maxPoolSize a la URI si no lo especifica
+ */
+std::string ConexionMongo::aplicarTamanoPool(const std::string& uri) {
+    if (uri.find("maxPoolSize=") != std::string::npos) {
+        return uri;
+    }
+    std::string separador;
+    if (uri.find('?') != std::string::npos) {
+        separador = "&";
+    }
+    else {
+        separador = (!uri.empty() && uri.back() == '/') ? "?" : "/?";
+    }
+    return uri + separador + "maxPoolSize=" + std::to_string(tamanoPool);
+}
+
+/**
+ * @brief Obtiene (o crea) el pool asociado a una URI
+ *
+ * Los pools nunca se destruyen antes del final del proceso, por lo que la referencia
+ * devuelta puede usarse fuera del bloqueo.
+ */
+mongocxx::pool& ConexionMongo::obtenerPool(const std::string& uri) {
+    EstadoDriver& estado = estadoDriver();
+    std::string uriPool = aplicarTamanoPool(uri);
+
+    std::lock_guard<std::mutex> lock(estado.mutexPools);
+    auto it = estado.pools.find(uriPool);
+    if (it == estado.pools.end()) {
+        it = estado.pools.emplace(uriPool, std::make_unique<mongocxx::pool>(mongocxx::uri{ uriPool })).first;
+    }
+    return *it->second;
+}
+
+/**
+ * @brief Registra la espera de un arrendamiento en las métricas
+ */
+void ConexionMongo::registrarEspera(uint64_t micros) {
+    totalArrendamientos.fetch_add(1, std::memory_order_relaxed);
+    esperaTotalMicros.fetch_add(micros, std::memory_order_relaxed);
+    if (micros > 1000) {
+        esperasBloqueantes.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t maximo = esperaMaximaMicros.load(std::memory_order_relaxed);
+    while (micros > maximo && !esperaMaximaMicros.compare_exchange_weak(maximo, micros, std::memory_order_relaxed)) {
+    }
+}
+
+ConexionMongo::ClienteArrendado ConexionMongo::arrendarCliente() {
+    return arrendarCliente(obtenerURISilenciosa());
+}
+
+/**
+ * @brief Arrienda un cliente del pool de la URI indicada
+ *
+ * pool::acquire bloquea mientras el pool está agotado; ese tiempo es el que se
+ * acumula en las métricas de espera.
+ */
+ConexionMongo::ClienteArrendado ConexionMongo::arrendarCliente(const std::string& uri) {
+    mongocxx::pool& pool = obtenerPool(uri);
+
+    if (ClienteArrendado::poolHilo == &pool && ClienteArrendado::clienteHilo) {
+        return ClienteArrendado(pool, ClienteArrendado::clienteHilo);
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    mongocxx::pool::entry entrada = pool.acquire();
+    auto espera = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - inicio);
+    registrarEspera(static_cast<uint64_t>(espera.count()));
+
+    return ClienteArrendado(pool, std::move(entrada));
+}
+
+/**
+ * @brief Obtiene una instantánea de las métricas de los pools
+ */
+ConexionMongo::MetricasPool ConexionMongo::obtenerMetricasPool() {
+    MetricasPool metricas;
+    metricas.arrendamientos = totalArrendamientos.load(std::memory_order_relaxed);
+    metricas.arrendamientosActivos = arrendamientosActivos.load(std::memory_order_relaxed);
+    metricas.esperasBloqueantes = esperasBloqueantes.load(std::memory_order_relaxed);
+    metricas.esperaTotalMicros = esperaTotalMicros.load(std::memory_order_relaxed);
+    metricas.esperaMaximaMicros = esperaMaximaMicros.load(std::memory_order_relaxed);
+    metricas.tamanoPool = tamanoPool;
+    {
+        EstadoDriver& estado = estadoDriver();
+        std::lock_guard<std::mutex> lock(estado.mutexPools);
+        metricas.poolsAbiertos = estado.pools.size();
+    }
+    return metricas;
+}
+
+/**
+ * @brief Imprime las métricas de los pools por consola
+ */
+void ConexionMongo::mostrarMetricasPool() {
+    MetricasPool metricas = obtenerMetricasPool();
+    double promedioMicros = metricas.arrendamientos > 0
+        ? static_cast<double>(metricas.esperaTotalMicros) / metricas.arrendamientos
+        : 0.0;
+
+    std::cout << "\n=== MÉTRICAS DEL POOL DE CONEXIONES ===" << std::endl;
+    std::cout << "Pools abiertos: " << metricas.poolsAbiertos << " (maxPoolSize=" << metricas.tamanoPool << ")" << std::endl;
+    std::cout << "Arrendamientos totales: " << metricas.arrendamientos << std::endl;
+    std::cout << "Arrendamientos activos: " << metricas.arrendamientosActivos << std::endl;
+    std::cout << "Esperas mayores a 1 ms: " << metricas.esperasBloqueantes << std::endl;
+    std::cout << "Espera promedio: " << promedioMicros << " us" << std::endl;
+    std::cout << "Espera máxima: " << metricas.esperaMaximaMicros << " us" << std::endl;
+}
+
+/**
+ * @brief Verifica el acceso a MongoDB con mensajes de diagnóstico (para configuración inicial)
+ * @return true si el cliente responde correctamente
+ */
+bool ConexionMongo::getCliente() {
+    // Obtener la URI según el modo seleccionado
+    std::string uri = obtenerURI();
+    std::cout << "Inicializando pool MongoDB con URI: " << uri << std::endl;
+
+    std::string modoTexto;
+    switch (modoActual) {
+    case SERVIDOR:
+        modoTexto = "SERVIDOR (Local)";
+        break;
+    case CLIENTE:
+        modoTexto = "CLIENTE (Remoto)";
+        break;
+    case INTERNET:
+        modoTexto = "INTERNET (MongoDB Atlas)";
+        break;
+    }
+    std::cout << "Modo: " << modoTexto << std::endl;
+    std::cout << "Tamaño máximo del pool: " << tamanoPool << std::endl;
+
+    auto cliente = arrendarCliente(uri);
+
+    // Verificar que el cliente funcione con la base de datos real "Banco"
+    if (!verificarCliente(*cliente)) {
+        std::cerr << "ADVERTENCIA: Cliente MongoDB creado pero no responde correctamente" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 /**
  * @brief Obtiene la URI sin imprimir mensajes de diagnóstico
  * @return URI de conexión apropiada sin logging
@@ -115,6 +328,7 @@ bool ConexionMongo::probarConexion(const std::string& uri, int timeoutSegundos)
     std::cout << "Probando conexión con URI: " << uri << std::endl;
 
     try {
+        obtenerInstancia();
         mongocxx::uri mongoUri{ uri };
         std::cout << "URI parseada correctamente" << std::endl;
 
@@ -299,6 +513,10 @@ void ConexionMongo::ejecutarDiagnosticoCompleto() {
             std::cout << "4. Comprobar que el cluster esté activo" << std::endl;
         }
     }
+    mostrarMetricasPool();
+    MetricasLatencia::mostrarResumen();
+    MetricasMemoria::mostrarResumen();
+    MetricasLatencia::volcarJSON(MetricasLatencia::ARCHIVO_METRICAS_LATENCIA);
 	system("pause");
     std::cout << "\n=== FIN DEL DIAGNÓSTICO ===" << std::endl;
 }
@@ -381,6 +599,11 @@ std::vector<std::string> ConexionMongo::escanearRedMongoDB(const std::string& re
 
     std::cout << "Escaneando red " << redBase << ".x para servidores MongoDB..." << std::endl;
 
+    // Cada sondeo apunta a un host distinto y casi todos fallan: un pool por candidato
+    // dejaría hilos de monitoreo abiertos sin reutilizarse, así que aquí se mantienen
+    // clientes de un solo uso.
+    obtenerInstancia();
+
     // Escanear IPs comunes para servidores (1-20)
     for (int i = 1; i <= 20; i++) {
         std::string ip = redBase + "." + std::to_string(i);
@@ -5,6 +5,7 @@
 #define CONEXIONMONGO_H
 
 #include <mongocxx/client.hpp>
+#include <mongocxx/pool.hpp>
 #include <mongocxx/instance.hpp>
 #include <mongocxx/uri.hpp>
 #include <mongocxx/exception/operation_exception.hpp>
@@ -20,6 +21,11 @@
 #include <chrono>
 #include <thread>
 #include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <iphlpapi.h>
 #pragma comment(lib, "iphlpapi.lib")
 
@@ -33,12 +39,116 @@ public:
         INTERNET = 2   // Conexión a través de Internet (opcional)
     };
 
+    /**
+     * @struct MetricasPool
+     * @brief Instantánea del uso de los pools de conexiones
+     */
+    struct MetricasPool {
+        uint64_t arrendamientos = 0;        // Clientes entregados por algún pool
+        uint64_t arrendamientosActivos = 0; // Arrendamientos vigentes en este momento
+        uint64_t esperasBloqueantes = 0;    // Arrendamientos que esperaron más de 1 ms
+        uint64_t esperaTotalMicros = 0;     // Tiempo acumulado esperando un cliente libre
+        uint64_t esperaMaximaMicros = 0;    // Mayor espera observada
+        size_t tamanoPool = 0;              // maxPoolSize aplicado a los pools nuevos
+        size_t poolsAbiertos = 0;           // Un pool por URI distinta
+    };
+
+    /**
+     * @class ClienteArrendado
+     * @brief Arrendamiento RAII de un mongocxx::client tomado de un mongocxx::pool
+     *
+     * El cliente vuelve al pool al destruirse el objeto. Un mongocxx::client no es
+     * seguro entre hilos, por eso cada operación toma su propio arrendamiento en lugar
+     * de compartir un cliente estático. Si el hilo ya tiene un arrendamiento vigente del
+     * mismo pool, el nuevo reutiliza ese cliente: las llamadas anidadas no consumen un
+     * segundo cliente y no pueden agotar el pool esperándose a sí mismas.
+     *
+     * Debe vivir más que las bases de datos, colecciones, cursores y sesiones obtenidos
+     * a partir de él; por eso se declara siempre antes que ellos.
+     */
+    class ClienteArrendado {
+    public:
+        ClienteArrendado(const ClienteArrendado&) = delete;
+        ClienteArrendado& operator=(const ClienteArrendado&) = delete;
+        ~ClienteArrendado();
+
+        mongocxx::client& operator*() const { return *cliente; }
+        mongocxx::client* operator->() const { return cliente; }
+        mongocxx::database operator[](bsoncxx::string::view_or_value nombre) const { return (*cliente)[std::move(nombre)]; }
+
+    private:
+        friend class ConexionMongo;
+
+        ClienteArrendado(mongocxx::pool& pool, mongocxx::pool::entry entrada);
+        ClienteArrendado(mongocxx::pool& pool, mongocxx::client* prestado);
+
+        mongocxx::pool* pool;
+        mongocxx::pool::entry entrada;  // Vacía si el cliente es prestado por un arrendamiento externo
+        mongocxx::client* cliente;
+        mongocxx::pool* poolAnterior;
+        mongocxx::client* clienteAnterior;
+
+        // Arrendamiento vigente más externo del hilo actual
+        static thread_local mongocxx::pool* poolHilo;
+        static thread_local mongocxx::client* clienteHilo;
+    };
+
 private:
     static ModoConexion modoActual;
     static std::string uriServidor;
     static std::string uriCliente;
     static std::string uriInternet;
 
+    // Pools de conexiones, uno por URI efectiva (incluye maxPoolSize)
+    static size_t tamanoPool;
+
+    /**
+     * @struct EstadoDriver
+     * @brief Instancia del driver y pools abiertos, creados y destruidos juntos
+     *
+     * La instancia se declara primero: se construye antes que cualquier pool y se
+     * destruye (mongoc_cleanup) después de todos ellos al terminar el proceso.
+     */
+    struct EstadoDriver {
+        mongocxx::instance instancia;
+        std::mutex mutexPools;
+        std::map<std::string, std::unique_ptr<mongocxx::pool>> pools;
+    };
+
+    static EstadoDriver& estadoDriver();
+
+    // Métricas de espera, acumuladas sin bloqueo
+    static std::atomic<uint64_t> totalArrendamientos;
+    static std::atomic<uint64_t> arrendamientosActivos;
+    static std::atomic<uint64_t> esperasBloqueantes;
+    static std::atomic<uint64_t> esperaTotalMicros;
+    static std::atomic<uint64_t> esperaMaximaMicros;
+
+    // Aumenta cada vez que cambian el modo o las URIs: el servidor puede ser otro
+    static std::atomic<uint64_t> generacionConexion;
+
+    /**
+     * @brief Crea la instancia del driver una sola vez por proceso
+     */
+    static mongocxx::instance& obtenerInstancia();
+
+    /**
+     * @brief Obtiene (o crea) el pool asociado a una URI
+     * @param uri URI de conexión sin maxPoolSize
+     * @return Referencia al pool, válida durante toda la ejecución
+     */
+    static mongocxx::pool& obtenerPool(const std::string& uri);
+
+    /**
+     * @brief Agrega maxPoolSize a la URI si no lo especifica
+     */
+    static std::string aplicarTamanoPool(const std::string& uri);
+
+    /**
+     * @brief Registra la espera de un arrendamiento en las métricas
+     */
+    static void registrarEspera(uint64_t micros);
+
 public:
     /**
      * @brief Establece el modo de conexión (servidor, cliente o internet)
@@ -46,6 +156,7 @@ public:
      */
     static void setModoConexion(ModoConexion modo) {
         modoActual = modo;
+        generacionConexion.fetch_add(1, std::memory_order_relaxed);
         std::string modoTexto;
         switch (modo) {
         case SERVIDOR:
@@ -88,52 +199,67 @@ public:
         else {
             uriCliente = uriCli;
         }
+        generacionConexion.fetch_add(1, std::memory_order_relaxed);
     }
 
     /**
-     * @brief Obtiene el cliente MongoDB con mensajes de diagnóstico (para configuración inicial)
-     * @return Referencia al cliente MongoDB
+     * @brief Identifica la configuración de conexión vigente
+     *
+     * Los datos cacheados de un servidor deben descartarse cuando este valor cambia.
      */
-    static mongocxx::client& getCliente() {
-        static mongocxx::instance instance{};
-
-        // Obtener la URI según el modo seleccionado
-        std::string uri = obtenerURI();
-        std::cout << "Inicializando cliente MongoDB con URI: " << uri << std::endl;
+    static uint64_t getGeneracionConexion() {
+        return generacionConexion.load(std::memory_order_relaxed);
+    }
 
-        std::string modoTexto;
-        switch (modoActual) {
-        case SERVIDOR:
-            modoTexto = "SERVIDOR (Local)";
-            break;
-        case CLIENTE:
-            modoTexto = "CLIENTE (Remoto)";
-            break;
-        case INTERNET:
-            modoTexto = "INTERNET (MongoDB Atlas)";
-            break;
-        }
-        std::cout << "Modo: " << modoTexto << std::endl;
+    /**
+     * @brief Verifica el acceso a MongoDB con mensajes de diagnóstico (para configuración inicial)
+     *
+     * Toma un arrendamiento del pool del modo actual, de modo que el pool queda creado
+     * y con una conexión establecida antes de las operaciones normales.
+     * @return true si el cliente responde correctamente
+     */
+    static bool getCliente();
 
-        static mongocxx::client cliente{ mongocxx::uri{uri} };
+    /**
+     * @brief Arrienda un cliente del pool del modo de conexión actual (sin mensajes de diagnóstico)
+     * @return Arrendamiento RAII; el cliente vuelve al pool al salir de alcance
+     */
+    static ClienteArrendado arrendarCliente();
 
-        // Verificar que el cliente funcione con la base de datos real "Banco"
-        if (!verificarCliente(cliente)) {
-            std::cerr << "ADVERTENCIA: Cliente MongoDB creado pero no responde correctamente" << std::endl;
-        }
+    /**
+     * @brief Arrienda un cliente del pool asociado a una URI explícita
+     * @param uri URI de conexión
+     * @return Arrendamiento RAII; el cliente vuelve al pool al salir de alcance
+     */
+    static ClienteArrendado arrendarCliente(const std::string& uri);
 
-        return cliente;
+    /**
+     * @brief Define el tamaño máximo (maxPoolSize) de los pools creados en adelante
+     *
+     * Los pools ya abiertos conservan su tamaño; debe llamarse antes del primer arrendamiento.
+     * @param tamano Número máximo de clientes por pool (mínimo 1)
+     */
+    static void setTamanoPool(size_t tamano) {
+        tamanoPool = (std::max)(static_cast<size_t>(1), tamano);
     }
 
     /**
-     * @brief Obtiene el cliente MongoDB sin mensajes de diagnóstico (para operaciones normales)
-     * @return Referencia al cliente MongoDB
+     * @brief Obtiene el tamaño configurado para los pools
      */
-    static mongocxx::client& obtenerClienteBaseDatos() {
-        static mongocxx::client cliente{ mongocxx::uri{obtenerURISilenciosa()} };
-        return cliente;
+    static size_t getTamanoPool() {
+        return tamanoPool;
     }
 
+    /**
+     * @brief Obtiene una instantánea de las métricas de los pools
+     */
+    static MetricasPool obtenerMetricasPool();
+
+    /**
+     * @brief Imprime las métricas de los pools por consola
+     */
+    static void mostrarMetricasPool();
+
     /**
      * @brief Verifica que el cliente MongoDB funcione correctamente con la base de datos "Banco"
      */
@@ -1,4 +1,5 @@
 #include "ConfiguradorSistema.h"
+#include "FabricaRepositorioBanco.h"
 #include <iostream>
 #include <windows.h>
 #include <conio.h>
@@ -13,7 +14,12 @@ bool ConfiguradorSistema::inicializarSistema() {
         return false;
     }
 
-    verificarConexionBaseDatos();
+    // El motor en memoria no abre ninguna conexión
+    if (FabricaRepositorioBanco::getMotor() == MotorAlmacenamiento::MONGODB) {
+        verificarConexionBaseDatos();
+    }
+    // Sin almacén local el sistema sigue funcionando; solo se pierde la operación sin conexión
+    FabricaRepositorioBanco::abrirAlmacenLocal(DIRECTORIO_ALMACEN_LOCAL);
     inicializarMarquesina();
 
     return true;
@@ -35,7 +41,8 @@ bool ConfiguradorSistema::seleccionarModoConexion() {
     std::vector<std::string> opcionesConexion = {
         "SERVIDOR (Local - localhost:27017)",
         "CLIENTE (Remoto - Red Local Automática)",
-        "INTERNET (MongoDB Atlas - Nube)"
+        "INTERNET (MongoDB Atlas - Nube)",
+        "MEMORIA (Sin MongoDB - Datos en memoria)"
     };
 
     std::cout << "=== CONFIGURACIÓN DE CONEXIÓN MONGODB ===" << std::endl;
@@ -45,6 +52,7 @@ bool ConfiguradorSistema::seleccionarModoConexion() {
     std::cout << "• SERVIDOR: Para ejecutar en la máquina que tiene MongoDB instalado localmente" << std::endl;
     std::cout << "• CLIENTE: Para ejecutar en máquinas remotas conectadas al servidor (detección automática)" << std::endl;
     std::cout << "• INTERNET: Para conectar a MongoDB Atlas en la nube (acceso desde cualquier lugar)" << std::endl;
+    std::cout << "• MEMORIA: Para trabajar sin MongoDB; los datos se conservan solo durante la ejecución" << std::endl;
     std::cout << std::endl;
 
     int seleccionConexion = Utilidades::menuInteractivo("Modo de Conexión MongoDB", opcionesConexion, 0, 0);
@@ -91,6 +99,15 @@ void ConfiguradorSistema::mostrarInformacionModo(int seleccion) {
         std::cout << "• Asegúrese de tener conexión a Internet estable" << std::endl;
         std::cout << "• Perfecto para trabajo remoto y control de versiones con Git" << std::endl;
         break;
+
+    case 3:
+        FabricaRepositorioBanco::setMotor(MotorAlmacenamiento::MEMORIA);
+        std::cout << "=== MODO MEMORIA SELECCIONADO ===" << std::endl;
+        std::cout << "• No se conectará a MongoDB" << std::endl;
+        std::cout << "• Personas y cuentas se guardan en memoria y se pierden al salir" << std::endl;
+        std::cout << "• Las personas de la última sesión con MongoDB se consultan desde el almacén local" << std::endl;
+        std::cout << "• Las opciones propias de MongoDB (respaldos del servidor) no están disponibles" << std::endl;
+        break;
     }
 }
 
@@ -127,6 +144,7 @@ Marquesina* ConfiguradorSistema::getMarquesina() const {
 }
 
 void ConfiguradorSistema::finalizarSistema() {
+    FabricaRepositorioBanco::cerrarAlmacenLocal();
     if (marquesina) {
         marquesina.reset();
     }
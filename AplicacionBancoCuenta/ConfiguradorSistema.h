@@ -16,6 +16,8 @@ class ConfiguradorSistema {
 private:
     std::unique_ptr<Marquesina> marquesina;
 
+    static constexpr const char* DIRECTORIO_ALMACEN_LOCAL = "almacen_local";
+
     bool configurarConexionMongoDB();
     bool seleccionarModoConexion();
     void mostrarInformacionModo(int seleccion);
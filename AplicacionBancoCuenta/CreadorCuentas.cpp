@@ -3,6 +3,7 @@
 #include "Fecha.h"
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
+#include <bsoncxx/types.hpp>
 #include <chrono>
 #include <iostream>
 
@@ -18,6 +19,10 @@ std::pair<bool, std::string> CreadorCuentas::crearCuentaAhorros(
 		return { false, "Parámetros inválidos" };
 	}
 
+	if (persona->cuentasLlenas()) {
+		return { false, "No se pueden agregar mas cuentas, limite alcanzado" };
+	}
+
 	try {
 		// Configurar datos básicos
 		configurarDatosBasicosCuenta(cuenta);
@@ -69,6 +74,10 @@ std::pair<bool, std::string> CreadorCuentas::crearCuentaCorriente(
 		return { false, "Parámetros inválidos" };
 	}
 
+	if (persona->cuentasLlenas()) {
+		return { false, "No se pueden agregar mas cuentas, limite alcanzado" };
+	}
+
 	try {
 		// Configurar datos básicos
 		configurarDatosBasicosCuenta(cuenta);
@@ -164,7 +173,7 @@ void CreadorCuentas::configurarDatosBasicosCuenta(Cuenta<double>* cuenta) {
 	Fecha fechaActual;
 	std::string fechaStr = fechaActual.obtenerFechaFormateada();
 	cuenta->setFechaApertura(fechaStr);
-	cuenta->setEstadoCuenta("ACTIVA");
+	cuenta->setEstado(EstadoCuenta::ACTIVA);
 }
 
 void CreadorCuentas::finalizarConfiguracionCuenta(Cuenta<double>* cuenta, const std::string& numeroCuenta, double monto) {
@@ -172,20 +181,6 @@ void CreadorCuentas::finalizarConfiguracionCuenta(Cuenta<double>* cuenta, const
 	cuenta->depositar(monto);
 }
 
-void CreadorCuentas::agregarCuentaAMemoria(Persona* persona, CuentaAhorros* cuenta) {
-	cuenta->setSiguiente(persona->getCabezaAhorros());
-	cuenta->setAnterior(nullptr);
-	if (persona->getCabezaAhorros() != nullptr) {
-		persona->getCabezaAhorros()->setAnterior(cuenta);
-	}
-	persona->setCabezaAhorros(cuenta);
-}
-
-void CreadorCuentas::agregarCuentaAMemoria(Persona* persona, CuentaCorriente* cuenta) {
-	cuenta->setSiguiente(persona->getCabezaCorriente());
-	cuenta->setAnterior(nullptr);
-	if (persona->getCabezaCorriente() != nullptr) {
-		persona->getCabezaCorriente()->setAnterior(cuenta);
-	}
-	persona->setCabezaCorriente(cuenta);
+void CreadorCuentas::agregarCuentaAMemoria(Persona* persona, Cuenta<double>* cuenta) {
+	persona->agregarCuenta(cuenta);
 }
\ No newline at end of file
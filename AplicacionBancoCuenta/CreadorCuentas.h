@@ -1,5 +1,5 @@
 #pragma once
-#include "_BaseDatosPersona.h"
+#include "IRepositorioBanco.h"
 #include "Persona.h"
 #include "CuentaAhorros.h"
 #include "CuentaCorriente.h"
@@ -15,10 +15,10 @@
  */
 class CreadorCuentas {
 private:
-    _BaseDatosPersona& baseDatos;
+    IRepositorioBanco& baseDatos;
 
 public:
-    explicit CreadorCuentas(_BaseDatosPersona& bd) : baseDatos(bd) {}
+    explicit CreadorCuentas(IRepositorioBanco& bd) : baseDatos(bd) {}
 
     /**
      * @brief Crea una cuenta de ahorros completa con persistencia
@@ -50,6 +50,5 @@ private:
     );
     void configurarDatosBasicosCuenta(Cuenta<double>* cuenta);
     void finalizarConfiguracionCuenta(Cuenta<double>* cuenta, const std::string& numeroCuenta, double monto);
-    void agregarCuentaAMemoria(Persona* persona, CuentaAhorros* cuenta);
-    void agregarCuentaAMemoria(Persona* persona, CuentaCorriente* cuenta);
+    void agregarCuentaAMemoria(Persona* persona, Cuenta<double>* cuenta);
 };
\ No newline at end of file
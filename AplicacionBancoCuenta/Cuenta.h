@@ -4,147 +4,141 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <regex> // Incluye la libreria regex para validacion de fecha
 #include "Validar.h" // Incluye la clase de validacion
 #include "Fecha.h" // Incluye la clase Fecha para manejar fechas
+#include "TablaCuentas.h"
+#include <type_traits>
 
 /**
  * @class Cuenta
  * @brief Clase abstracta que representa una cuenta bancaria genérica
  *
- * Esta clase implementa una estructura de lista doblemente enlazada y utiliza
- * templates para permitir diferentes tipos de datos para el saldo (T).
- * Sirve como base para diferentes tipos de cuentas bancarias.
+ * Los datos de la cuenta (número, saldo, fecha de apertura y estado) viven en una
+ * fila de TablaCuentas; el objeto registra la fila al construirse, la libera al
+ * destruirse y aporta el comportamiento de cada tipo de cuenta. Las cuentas de una
+ * persona se agrupan por fila en Persona, no enlazadas entre sí.
  *
- * @tparam T Tipo de dato para almacenar el saldo (típicamente double o float)
+ * @tparam T Tipo de dato del saldo; la columna de saldos de la tabla es double
  */
 template <typename T>
 class Cuenta {
-protected:
-    /** @brief Número identificador único de la cuenta */
-    std::string numeroCuenta;
-
-    /** @brief Saldo actual disponible en la cuenta */
-    T saldo;
-
-    /** @brief Fecha en que se abrió la cuenta */
-    Fecha fechaApertura;
+    static_assert(std::is_same<T, double>::value, "TablaCuentas guarda los saldos como double");
 
-    /** @brief Estado actual de la cuenta (activa, inactiva, bloqueada, etc.) */
-    std::string estadoCuenta;
-
-    /** @brief Puntero al siguiente nodo en la lista doblemente enlazada */
-    Cuenta<T>* siguiente;
+protected:
+    /** @brief Fila de la cuenta en TablaCuentas::global() */
+    TablaCuentas::Fila fila;
 
-    /** @brief Puntero al nodo anterior en la lista doblemente enlazada */
-    Cuenta<T>* anterior;
+    static TablaCuentas& tabla() { return TablaCuentas::global(); }
 
     /**
      * @brief Constructor por defecto
      *
-     * Inicializa una cuenta con valores vacíos y punteros nulos
+     * Registra una fila vacía del tipo indicado
      */
-    Cuenta()
-        : numeroCuenta(""), saldo(0), fechaApertura(""), estadoCuenta(""), siguiente(nullptr), anterior(nullptr) {
+    explicit Cuenta(TipoCuenta tipo)
+        : fila(tabla().registrar(this, tipo)) {
     }
 
     /**
      * @brief Constructor con parámetros
      *
+     * @param tipo Tipo de cuenta de la fila
      * @param numeroCuenta Número identificador de la cuenta
      * @param saldo Saldo inicial de la cuenta
      * @param fechaStr Fecha de apertura en formato de cadena
      * @param estadoCuenta Estado inicial de la cuenta
      */
-    Cuenta(std::string numeroCuenta, T saldo, const std::string& fechaStr, std::string estadoCuenta)
-        : numeroCuenta(numeroCuenta), saldo(saldo), fechaApertura(fechaStr),
-        estadoCuenta(estadoCuenta), siguiente(nullptr), anterior(nullptr) {
+    Cuenta(TipoCuenta tipo, const std::string& numeroCuenta, T saldo, const std::string& fechaStr, const std::string& estadoCuenta)
+        : fila(tabla().registrar(this, tipo)) {
+        tabla().setNumero(fila, numeroCuenta);
+        tabla().setSaldo(fila, saldo);
+        tabla().setFechaApertura(fila, Fecha(fechaStr));
+        tabla().setEstado(fila, estadoDesdeTexto(estadoCuenta));
     }
 
     /**
      * @brief Destructor virtual
      *
-     * Permite la correcta liberación de recursos en clases derivadas
+     * Libera la fila de la cuenta en la tabla
      */
-    virtual ~Cuenta() {}
+    virtual ~Cuenta() { tabla().liberar(fila); }
 
 public:
+    // Dos objetos no pueden representar la misma fila
+    Cuenta(const Cuenta&) = delete;
+    Cuenta& operator=(const Cuenta&) = delete;
+
+    /**
+     * @brief Obtiene la fila de la cuenta en TablaCuentas
+     */
+    TablaCuentas::Fila getFila() const { return fila; }
+
     /**
      * @brief Obtiene el número de cuenta
-     * @return Número de cuenta como cadena
+     * @return Copia del número (10 caracteres, sin memoria dinámica); una vista a la
+     * tabla quedaría inválida al registrarse otra cuenta
      */
-    std::string getNumeroCuenta() const { return numeroCuenta; }
+    std::string getNumeroCuenta() const { return std::string(tabla().numero(fila)); }
 
     /**
      * @brief Obtiene el saldo actual
      * @return Saldo de la cuenta
      */
-    T getSaldo() const { return saldo; }
+    T getSaldo() const { return tabla().saldo(fila); }
 
     /**
      * @brief Obtiene la fecha de apertura
      * @return Objeto Fecha con la fecha de apertura
      */
-    Fecha getFechaApertura() const { return fechaApertura; }
+    Fecha getFechaApertura() const { return tabla().fechaApertura(fila); }
 
     /**
      * @brief Obtiene el estado actual de la cuenta
-     * @return Estado de la cuenta como cadena
      */
-    std::string getEstadoCuenta() const { return estadoCuenta; }
+    EstadoCuenta getEstado() const { return tabla().estado(fila); }
 
     /**
-     * @brief Obtiene el puntero al siguiente nodo
-     * @return Puntero al siguiente nodo en la lista
-     */
-    Cuenta<T>* getSiguiente() const { return siguiente; }
-
-    /**
-     * @brief Obtiene el puntero al nodo anterior
-     * @return Puntero al nodo anterior en la lista
+     * @brief Obtiene el estado actual de la cuenta
+     * @return Texto del estado ("" si no tiene)
      */
-    Cuenta<T>* getAnterior() const { return anterior; }
+    std::string_view getEstadoCuenta() const { return nombreEstado(getEstado()); }
 
     /**
      * @brief Establece el número de cuenta
      * @param numero Nuevo número de cuenta
      * @return Número de cuenta actualizado
      */
-    std::string setNumeroCuenta(const std::string& numero) { numeroCuenta = numero; return numeroCuenta; }
+    std::string setNumeroCuenta(const std::string& numero) { tabla().setNumero(fila, numero); return numero; }
 
     /**
      * @brief Establece el saldo de la cuenta
      * @param nuevoSaldo Nuevo saldo a establecer
      * @return Saldo actualizado
      */
-    T setSaldo(T nuevoSaldo) { saldo = nuevoSaldo; return saldo; }
+    T setSaldo(T nuevoSaldo) { tabla().setSaldo(fila, nuevoSaldo); return nuevoSaldo; }
 
     /**
      * @brief Establece la fecha de apertura
      * @param fechaStr Fecha en formato de cadena
      * @return Objeto Fecha actualizado
      */
-    Fecha setFechaApertura(const std::string& fechaStr) { fechaApertura = Fecha(fechaStr); return fechaApertura; }
+    Fecha setFechaApertura(const std::string& fechaStr) { tabla().setFechaApertura(fila, Fecha(fechaStr)); return tabla().fechaApertura(fila); }
 
     /**
      * @brief Establece el estado de la cuenta
      * @param estado Nuevo estado de la cuenta
-     * @return Estado actualizado
      */
-    std::string setEstadoCuenta(const std::string& estado) { estadoCuenta = estado; return estadoCuenta; }
+    void setEstado(EstadoCuenta estado) { tabla().setEstado(fila, estado); }
 
     /**
-     * @brief Establece el puntero al siguiente nodo
-     * @param sig Puntero al siguiente nodo
-     */
-    void setSiguiente(Cuenta<T>* sig) { siguiente = sig; }
-
-    /**
-     * @brief Establece el puntero al nodo anterior
-     * @param ant Puntero al nodo anterior
+     * @brief Establece el estado de la cuenta a partir de su texto
+     * @param estado Nuevo estado; un texto desconocido deja la cuenta sin estado
+     * @return Estado actualizado
      */
-    void setAnterior(Cuenta<T>* ant) { anterior = ant; }
+    std::string setEstadoCuenta(const std::string& estado) { setEstado(estadoDesdeTexto(estado)); return estado; }
 
     /**
      * @brief Realiza un depósito en la cuenta
@@ -166,9 +160,9 @@ public:
 
     /**
      * @brief Consulta el estado actual de la cuenta
-     * @return Estado de la cuenta como cadena
+     * @return Texto del estado de la cuenta
      */
-    virtual std::string consultarEstado() const = 0;
+    virtual std::string_view consultarEstado() const = 0;
 
     /**
      * @brief Guarda los datos de la cuenta en un archivo
@@ -32,7 +32,7 @@ void CuentaAhorros::depositar(double cantidad) {
     }
 
     // Convertir a un tipo más amplio para evitar desbordamiento  
-    long double nuevoSaldo = static_cast<long double>(saldo) + static_cast<long double>(cantidad);
+    long double nuevoSaldo = static_cast<long double>(getSaldo()) + static_cast<long double>(cantidad);
 
     // Verificar si el nuevo saldo excede el límite de la cuenta (15000.00 dólares)
     constexpr double LIMITE_MAXIMO = 15000.00;
@@ -41,7 +41,7 @@ void CuentaAhorros::depositar(double cantidad) {
         return;
     }
 
-    saldo = static_cast<double>(nuevoSaldo);
+    setSaldo(static_cast<double>(nuevoSaldo));
     std::cout << "Depósito realizado con éxito. Nuevo saldo: $" << formatearSaldo() << std::endl;
 }
 
@@ -57,11 +57,11 @@ void CuentaAhorros::retirar(double cantidad) {
         std::cout << "El monto a retirar debe ser mayor a cero." << std::endl;
         return;
     }
-    if (cantidad > this->saldo) {
+    if (cantidad > getSaldo()) {
         std::cout << "Fondos insuficientes." << std::endl;
         return;
     }
-    this->saldo -= cantidad;
+    setSaldo(getSaldo() - cantidad);
 }
 
 /**
@@ -70,16 +70,17 @@ void CuentaAhorros::retirar(double cantidad) {
  * @return double Retorna el saldo actual de la cuenta
  */
 double CuentaAhorros::consultarSaldo() const {
-    return this->saldo;
+    return getSaldo();
 }
 
 /**
  * @brief Método para consultar el estado de la cuenta de ahorros
  *
- * @return std::string Retorna "ACTIVA" si no hay un estado explícito, o el estado actual de la cuenta
+ * @return std::string_view Retorna "ACTIVA" si no hay un estado explícito, o el estado actual de la cuenta
  */
-std::string CuentaAhorros::consultarEstado() const {
-    return this->estadoCuenta.empty() ? "ACTIVA" : this->estadoCuenta;
+std::string_view CuentaAhorros::consultarEstado() const {
+    EstadoCuenta estado = getEstado();
+    return nombreEstado(estado == EstadoCuenta::SIN_ESTADO ? EstadoCuenta::ACTIVA : estado);
 }
 
 /**
@@ -88,7 +89,7 @@ std::string CuentaAhorros::consultarEstado() const {
  * @return std::string Saldo formateado con comas y dos decimales
  */
 std::string CuentaAhorros::formatearSaldo() const {
-    return formatearConComas(this->saldo);
+    return formatearConComas(getSaldo());
 }
 
 /**
@@ -130,14 +131,14 @@ void CuentaAhorros::mostrarInformacion(const std::string& cedula, bool limpiarPa
     }
 
     std::cout << "Tipo de cuenta: AHORROS" << std::endl;
-    std::cout << "Numero de cuenta: " << this->numeroCuenta << std::endl;
-    std::cout << "Fecha de apertura: " << this->fechaApertura.obtenerFechaFormateada() << std::endl;
+    std::cout << "Numero de cuenta: " << getNumeroCuenta() << std::endl;
+    std::cout << "Fecha de apertura: " << Cuenta<double>::getFechaApertura().obtenerFechaFormateada() << std::endl;
 
     // Estado de la cuenta por defecto es "ACTIVA"
-    std::string estado = consultarEstado();
+    std::string_view estado = consultarEstado();
     std::cout << "Estado de la cuenta: " << estado << std::endl;
-    std::cout << "Saldo actual: $" << formatearConComas(this->saldo) << std::endl;
-    std::cout << "Tasa de interes: " << this->tasaInteres << "%" << std::endl;
+    std::cout << "Saldo actual: $" << formatearConComas(getSaldo()) << std::endl;
+    std::cout << "Tasa de interes: " << getTasaInteres() << "%" << std::endl;
 
     std::cout << "\n" << std::string(50, '-') << std::endl;
     std::cout << "Presione cualquier tecla para continuar..." << std::endl;
@@ -155,14 +156,20 @@ void CuentaAhorros::guardarEnArchivo(const std::string& nombreArchivo) const {
     if (!archivo.is_open()) {
         return;
     }
-    archivo.write(reinterpret_cast<const char*>(&this->numeroCuenta), sizeof(this->numeroCuenta));
-    archivo.write(reinterpret_cast<const char*>(&this->saldo), sizeof(this->saldo));
+    std::string numero = getNumeroCuenta();
+    archivo.write(numero.data(), numero.size());
+    archivo.put('\0');
+    double saldoActual = getSaldo();
+    archivo.write(reinterpret_cast<const char*>(&saldoActual), sizeof(saldoActual));
 
-    std::string fechaStr = this->fechaApertura.obtenerFechaFormateada();
+    std::string fechaStr = Cuenta<double>::getFechaApertura().obtenerFechaFormateada();
     archivo.write(fechaStr.c_str(), fechaStr.size() + 1);
 
-    archivo.write(this->estadoCuenta.c_str(), this->estadoCuenta.size() + 1);
-    archivo.write(reinterpret_cast<const char*>(&tasaInteres), sizeof(tasaInteres));
+    std::string_view estado = getEstadoCuenta();
+    archivo.write(estado.data(), estado.size());
+    archivo.put('\0');
+    double tasa = getTasaInteres();
+    archivo.write(reinterpret_cast<const char*>(&tasa), sizeof(tasa));
     archivo.close();
 }
 
@@ -176,17 +183,23 @@ void CuentaAhorros::cargarDesdeArchivo(const std::string& nombreArchivo) {
     if (!archivo.is_open()) {
         return;
     }
-    archivo.read(reinterpret_cast<char*>(&this->numeroCuenta), sizeof(this->numeroCuenta));
-    archivo.read(reinterpret_cast<char*>(&this->saldo), sizeof(this->saldo));
-
     char buffer[100];
     archivo.getline(buffer, 100, '\0');
-    this->fechaApertura = Fecha(buffer);
+    setNumeroCuenta(buffer);
+
+    double saldoLeido = 0.0;
+    archivo.read(reinterpret_cast<char*>(&saldoLeido), sizeof(saldoLeido));
+    setSaldo(saldoLeido);
+
+    archivo.getline(buffer, 100, '\0');
+    setFechaApertura(buffer);
 
     archivo.getline(buffer, 100, '\0');
-    this->estadoCuenta = buffer;
+    setEstadoCuenta(buffer);
 
-    archivo.read(reinterpret_cast<char*>(&tasaInteres), sizeof(tasaInteres));
+    double tasa = 0.0;
+    archivo.read(reinterpret_cast<char*>(&tasa), sizeof(tasa));
+    setTasaInteres(tasa);
     archivo.close();
 }
 
@@ -196,11 +209,11 @@ void CuentaAhorros::cargarDesdeArchivo(const std::string& nombreArchivo) {
  * @return int Valor del interés calculado basado en el saldo actual y la tasa de interés
  */
 int CuentaAhorros::calcularInteres() const {
-    if (this->tasaInteres < 0.0) {
+    if (getTasaInteres() < 0.0) {
         std::cout << "La tasa de interes no puede ser negativa." << std::endl;
         return 0;
     }
-    double interes = (this->saldo * this->tasaInteres) / 100;
+    double interes = (getSaldo() * getTasaInteres()) / 100;
     return static_cast<int>(interes);
 }
 #pragma endregion
\ No newline at end of file
@@ -3,6 +3,7 @@
 #define CUENTAAHORROS_H
 
 #include "Cuenta.h"
+#include "PoolObjetos.h"
 #include "Validar.h" // Include validation class
 #include "Cifrado.h" // Include encryption class
 #include "Fecha.h"   // Include date class
@@ -17,20 +18,13 @@
  * el clculo de intereses y operaciones bsicas bancarias.
  */
 class CuentaAhorros : public Cuenta<double> {
-private:
-    /** @brief Tasa de inters anual de la cuenta de ahorros */
-    double tasaInteres;
-
-    /** @brief Fecha de apertura de la cuenta */
-    Fecha fechaApertura;
-
 public:
     /**
      * @brief Constructor por defecto
      *
      * Inicializa una cuenta de ahorros con valores predeterminados
      */
-    CuentaAhorros() : Cuenta<double>(), tasaInteres(0.0) {}
+    CuentaAhorros() : Cuenta<double>(TipoCuenta::AHORROS) {}
 
     /**
      * @brief Constructor con parmetros
@@ -42,7 +36,9 @@ public:
      * @param tasa Tasa de inters anual aplicable a la cuenta
      */
     CuentaAhorros(std::string numCuenta, double saldo, const std::string& fecha, const std::string& estado, double tasa)
-        : Cuenta<double>(numCuenta, saldo, fecha, estado), tasaInteres(tasa) {}
+        : Cuenta<double>(TipoCuenta::AHORROS, numCuenta, saldo, fecha, estado) {
+        setTasaInteres(tasa);
+    }
 
     /**
      * @brief Destructor
@@ -59,31 +55,31 @@ public:
      * @brief Establece la tasa de inters de la cuenta
      * @param tast Nueva tasa de inters
      */
-    void setTasaInteres(double tast) { this->tasaInteres = tast; }
+    void setTasaInteres(double tast) { tabla().setTasaInteres(fila, tast); }
 
     /**
      * @brief Establece el nmero de cuenta
      * @param numCuenta Nuevo nmero de cuenta
      */
-    void setNumeroCuenta(std::string numCuenta) { this->numeroCuenta = numCuenta; }
+    void setNumeroCuenta(std::string numCuenta) { Cuenta<double>::setNumeroCuenta(numCuenta); }
 
     /**
      * @brief Establece el saldo de la cuenta
      * @param saldo Nuevo saldo
      */
-    void setSaldo(double saldo) { this->saldo = saldo; }
+    void setSaldo(double saldo) { Cuenta<double>::setSaldo(saldo); }
 
     /**
      * @brief Establece la fecha de apertura de la cuenta
      * @param fecha Nueva fecha en formato de cadena
      */
-    void setFechaApertura(const std::string& fecha) { this->fechaApertura = fecha; }
+    void setFechaApertura(const std::string& fecha) { Cuenta<double>::setFechaApertura(fecha); }
 
     /**
      * @brief Establece el estado de la cuenta
      * @param estado Nuevo estado
      */
-    void setEstadoCuenta(const std::string& estado) { this->estadoCuenta = estado; }
+    void setEstadoCuenta(const std::string& estado) { Cuenta<double>::setEstadoCuenta(estado); }
 
     /**
      * @brief Devuelve una referencia a esta cuenta
@@ -93,48 +89,40 @@ public:
     CuentaAhorros* setCuentaAhorros(CuentaAhorros* cuenta) { return this; }
 
     /**
-     * @brief Establece la siguiente cuenta en la lista enlazada
-     * @param siguiente Puntero a la siguiente cuenta
-     * @return Puntero a esta cuenta
-     */
-    CuentaAhorros* setSiguiente(CuentaAhorros* siguiente) { this->siguiente = siguiente; return this; }
-
-    /**
-     * @brief Establece la cuenta anterior en la lista enlazada
-     * @param anterior Puntero a la cuenta anterior
-     * @return Puntero a esta cuenta
+     * @brief Establece la tasa de inters (sobrecargado)
+     * @param tasa Nueva tasa de inters
      */
-    CuentaAhorros* setAnterior(CuentaAhorros* anterior) { this->anterior = anterior; return this; }
+    void getTasaInteres(double tasa) { setTasaInteres(tasa); }
 
     /**
-     * @brief Establece la tasa de inters (sobrecargado)
-     * @param tasa Nueva tasa de inters
+     * @brief Obtiene la tasa de inters anual
+     * @return Tasa de inters en porcentaje
      */
-    void getTasaInteres(double tasa) { this->tasaInteres = tasa; }
+    double getTasaInteres() const { return tabla().tasaInteres(fila); }
 
     /**
      * @brief Obtiene el nmero de cuenta
      * @return Nmero de cuenta como cadena
      */
-    std::string getNumeroCuenta() const { return this->numeroCuenta; }
+    std::string getNumeroCuenta() const { return Cuenta<double>::getNumeroCuenta(); }
 
     /**
      * @brief Obtiene la fecha de apertura
      * @return Fecha de apertura como cadena formateada
      */
-    std::string getFechaApertura() const { return this->fechaApertura.toString(); }
+    std::string getFechaApertura() const { return Cuenta<double>::getFechaApertura().toString(); }
 
     /**
      * @brief Obtiene el saldo actual de la cuenta
      * @return Saldo de la cuenta
      */
-    double getSaldo() const { return this->saldo; }
+    double getSaldo() const { return Cuenta<double>::getSaldo(); }
 
     /**
      * @brief Obtiene el estado actual de la cuenta
-     * @return Estado de la cuenta como cadena
+     * @return Texto del estado de la cuenta
      */
-    std::string getEstadoCuenta() const { return this->estadoCuenta; }
+    std::string_view getEstadoCuenta() const { return Cuenta<double>::getEstadoCuenta(); }
 
     /**
      * @brief Obtiene una referencia a esta cuenta
@@ -142,21 +130,6 @@ public:
      */
     CuentaAhorros* getCuentaAhorros() { return this; }
 
-    /**
-     * @brief Obtiene la siguiente cuenta en la lista enlazada
-     * @return Puntero a la siguiente cuenta, o nullptr si no existe
-     */
-    CuentaAhorros* getSiguiente() const {
-        Cuenta<double>* sig = this->siguiente;
-        return sig ? dynamic_cast<CuentaAhorros*>(sig) : nullptr;
-    }
-
-    /**
-     * @brief Obtiene la cuenta anterior en la lista enlazada
-     * @return Puntero a la cuenta anterior, o nullptr si no existe
-     */
-    CuentaAhorros* getAnterior() const { return dynamic_cast<CuentaAhorros*>(this->anterior); }
-
     /**
      * @brief Realiza un depsito en la cuenta
      * @param cantidad Monto a depositar
@@ -177,9 +150,9 @@ public:
 
     /**
      * @brief Consulta el estado actual de la cuenta
-     * @return Estado de la cuenta como cadena
+     * @return Texto del estado de la cuenta
      */
-    std::string consultarEstado() const;
+    std::string_view consultarEstado() const;
 
     /**
      * @brief Formatea el saldo para presentacin
@@ -218,6 +191,12 @@ public:
      * @return Inters calculado en base a la tasa y saldo actual
      */
     int calcularInteres() const;
+
+    /**
+     * @brief Reserva la cuenta en el pool compartido de su tipo en lugar de un new suelto
+     */
+    static void* operator new(size_t tamano) { return PoolCompartido<CuentaAhorros>::reservar(tamano); }
+    static void operator delete(void* memoria, size_t tamano) { PoolCompartido<CuentaAhorros>::devolver(memoria, tamano); }
 };
 
 #endif // CUENTAAHORROS_H
\ No newline at end of file
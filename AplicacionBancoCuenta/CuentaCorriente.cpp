@@ -24,7 +24,7 @@ using namespace std;
  */
 void CuentaCorriente::depositar(double cantidad) {
 	if (cantidad > 0) {
-		this->saldo += cantidad;
+		setSaldo(getSaldo() + cantidad);
 	}
 	else {
 		std::cout << "La cantidad a depositar debe ser positiva." << std::endl;
@@ -39,8 +39,8 @@ void CuentaCorriente::depositar(double cantidad) {
  * @param cantidad Monto a retirar de la cuenta
  */
 void CuentaCorriente::retirar(double cantidad) {
-	if (cantidad <= this->saldo) {
-		this->saldo -= cantidad;
+	if (cantidad <= getSaldo()) {
+		setSaldo(getSaldo() - cantidad);
 	}
 	else {
 		std::cout << "Fondos insuficientes." << std::endl;
@@ -53,16 +53,17 @@ void CuentaCorriente::retirar(double cantidad) {
  * @return double Retorna el saldo actual de la cuenta
  */
 double CuentaCorriente::consultarSaldo() const {
-	return this->saldo;
+	return getSaldo();
 }
 
 /**
  * @brief Método para consultar el estado de la cuenta corriente
  *
- * @return std::string Retorna "ACTIVA" si no hay un estado explícito, o el estado actual de la cuenta
+ * @return std::string_view Retorna "ACTIVA" si no hay un estado explícito, o el estado actual de la cuenta
  */
-std::string CuentaCorriente::consultarEstado() const {
-	return this->estadoCuenta.empty() ? "ACTIVA" : this->estadoCuenta;
+std::string_view CuentaCorriente::consultarEstado() const {
+	EstadoCuenta estado = getEstado();
+	return nombreEstado(estado == EstadoCuenta::SIN_ESTADO ? EstadoCuenta::ACTIVA : estado);
 }
 
 /**
@@ -71,7 +72,7 @@ std::string CuentaCorriente::consultarEstado() const {
  * @return std::string Saldo formateado con comas y dos decimales
  */
 std::string CuentaCorriente::formatearSaldo() const {
-	return formatearConComas(this->saldo);
+	return formatearConComas(getSaldo());
 }
 
 /**
@@ -124,13 +125,12 @@ void CuentaCorriente::mostrarInformacion(const std::string& cedula = "", bool li
 
 	// Informacion comun
 	std::cout << "Tipo de cuenta: CORRIENTE" << std::endl;
-	std::cout << "Numero de cuenta: " << this->numeroCuenta << std::endl;
+	std::cout << "Numero de cuenta: " << getNumeroCuenta() << std::endl;
 	std::cout << "Fecha de apertura: "
-		<< this->fechaApertura.obtenerFechaFormateada()
+		<< Cuenta<double>::getFechaApertura().obtenerFechaFormateada()
 		<< std::endl;
-	const_cast<std::string&>(this->estadoCuenta) = consultarEstado();
-	std::cout << "Estado: " << this->estadoCuenta << std::endl;
-	std::cout << "Saldo actual: $" << formatearConComas(this->saldo) << std::endl;
+	std::cout << "Estado: " << consultarEstado() << std::endl;
+	std::cout << "Saldo actual: $" << formatearConComas(getSaldo()) << std::endl;
 
 	// Pie de pagina
 	std::cout << "\n" << std::string(50, '-') << std::endl;
@@ -145,14 +145,19 @@ void CuentaCorriente::mostrarInformacion(const std::string& cedula = "", bool li
 void CuentaCorriente::guardarEnArchivo(const std::string& nombreArchivo) const {
 	std::ofstream archivo(nombreArchivo, std::ios::binary);
 	if (archivo.is_open()) {
-		archivo.write(reinterpret_cast<const char*>(&this->numeroCuenta), sizeof(this->numeroCuenta));
-		archivo.write(reinterpret_cast<const char*>(&this->saldo), sizeof(this->saldo));
+		std::string numero = getNumeroCuenta();
+		archivo.write(numero.data(), numero.size());
+		archivo.put('\0');
+		double saldoActual = getSaldo();
+		archivo.write(reinterpret_cast<const char*>(&saldoActual), sizeof(saldoActual));
 
 		// Convertir Fecha a string y escribir
-		std::string fechaStr = this->fechaApertura.obtenerFechaFormateada();
+		std::string fechaStr = Cuenta<double>::getFechaApertura().obtenerFechaFormateada();
 		archivo.write(fechaStr.c_str(), fechaStr.size() + 1);
 
-		archivo.write(this->estadoCuenta.c_str(), this->estadoCuenta.size() + 1);
+		std::string_view estado = getEstadoCuenta();
+		archivo.write(estado.data(), estado.size());
+		archivo.put('\0');
 		archivo.write(reinterpret_cast<const char*>(&montoMinimo), sizeof(montoMinimo));
 		archivo.close();
 	}
@@ -166,15 +171,20 @@ void CuentaCorriente::guardarEnArchivo(const std::string& nombreArchivo) const {
 void CuentaCorriente::cargarDesdeArchivo(const std::string& nombreArchivo) {
 	std::ifstream archivo(nombreArchivo, std::ios::binary);
 	if (archivo.is_open()) {
-		archivo.read(reinterpret_cast<char*>(&this->numeroCuenta), sizeof(this->numeroCuenta));
-		archivo.read(reinterpret_cast<char*>(&this->saldo), sizeof(this->saldo));
 		char buffer[100];
+		archivo.getline(buffer, 100, '\0');
+		setNumeroCuenta(buffer);
+
+		double saldoLeido = 0.0;
+		archivo.read(reinterpret_cast<char*>(&saldoLeido), sizeof(saldoLeido));
+		setSaldo(saldoLeido);
+
 		archivo.getline(buffer, 100, '\0');
 		// Reconstruir la fecha desde el string
-		this->fechaApertura = Fecha(buffer);
+		setFechaApertura(buffer);
 
 		archivo.getline(buffer, 100, '\0');
-		this->estadoCuenta = buffer;
+		setEstadoCuenta(buffer);
 
 		archivo.read(reinterpret_cast<char*>(&montoMinimo), sizeof(montoMinimo));
 		archivo.close();
@@ -3,6 +3,7 @@
 #define CUENTACORRIENTE_H
 
 #include "Cuenta.h"
+#include "PoolObjetos.h"
 #include "Validar.h"
 #include "Cifrado.h"
 #include "Fecha.h"
@@ -20,16 +21,13 @@ private:
     /** @brief Monto mnimo requerido para mantener la cuenta (en dlares) */
     double montoMinimo; // monto minimo sino es $250.00, no se puede tener una CuentaCorriente / monto minimo en dolares
 
-    /** @brief Fecha de apertura de la cuenta */
-    Fecha fechaApertura;
-
 public:
     /**
      * @brief Constructor por defecto
      *
      * Inicializa una cuenta corriente con valores predeterminados
      */
-    CuentaCorriente() : Cuenta<double>(), montoMinimo(0.00) {}
+    CuentaCorriente() : Cuenta<double>(TipoCuenta::CORRIENTE), montoMinimo(0.00) {}
 
     /**
      * @brief Constructor con parmetros
@@ -41,7 +39,7 @@ public:
      * @param montoMinimo Monto mnimo requerido para la cuenta
      */
     CuentaCorriente(std::string numeroCuenta, double saldo, const std::string& fechaApertura, const std::string estadoCuenta, double montoMinimo)
-        : Cuenta<double>(numeroCuenta, saldo, fechaApertura, estadoCuenta), montoMinimo(montoMinimo) {}
+        : Cuenta<double>(TipoCuenta::CORRIENTE, numeroCuenta, saldo, fechaApertura, estadoCuenta), montoMinimo(montoMinimo) {}
 
     /**
      * @brief Establece el monto mnimo de la cuenta
@@ -53,25 +51,25 @@ public:
      * @brief Establece el nmero de cuenta
      * @param numeroCuenta Nuevo nmero de cuenta
      */
-    void setNumeroCuenta(std::string numeroCuenta) { this->numeroCuenta = numeroCuenta; }
+    void setNumeroCuenta(std::string numeroCuenta) { Cuenta<double>::setNumeroCuenta(numeroCuenta); }
 
     /**
      * @brief Establece el saldo de la cuenta
      * @param saldo Nuevo saldo
      */
-    void setSaldo(double saldo) { this->saldo = saldo; }
+    void setSaldo(double saldo) { Cuenta<double>::setSaldo(saldo); }
 
     /**
      * @brief Establece la fecha de apertura de la cuenta
      * @param fecha Nueva fecha en formato de cadena
      */
-    void setFechaApertura(const std::string& fecha) { this->fechaApertura = fecha; }
+    void setFechaApertura(const std::string& fecha) { Cuenta<double>::setFechaApertura(fecha); }
 
     /**
      * @brief Establece el estado de la cuenta
      * @param estadoCuenta Nuevo estado
      */
-    void setEstadoCuenta(const std::string& estadoCuenta) { this->estadoCuenta = estadoCuenta; }
+    void setEstadoCuenta(const std::string& estadoCuenta) { Cuenta<double>::setEstadoCuenta(estadoCuenta); }
 
     /**
      * @brief Devuelve una referencia a esta cuenta
@@ -80,20 +78,6 @@ public:
      */
     CuentaCorriente* setCuentaCorriente(CuentaCorriente* cuentaCorriente) { return this; }
 
-    /**
-     * @brief Establece la siguiente cuenta en la lista enlazada
-     * @param cuentaSiguiente Puntero a la siguiente cuenta
-     * @return Puntero a esta cuenta
-     */
-    CuentaCorriente* setSiguiente(CuentaCorriente* cuentaSiguiente) { this->siguiente = siguiente; return this; }
-
-    /**
-     * @brief Establece la cuenta anterior en la lista enlazada
-     * @param cuentaAnterior Puntero a la cuenta anterior
-     * @return Puntero a esta cuenta
-     */
-    CuentaCorriente* setAnterior(CuentaCorriente* cuentaAnterior) { this->anterior = anterior; return this; }
-
     /**
      * @brief Obtiene el monto mnimo de la cuenta
      * @return Monto mnimo actual
@@ -104,25 +88,25 @@ public:
      * @brief Obtiene el nmero de cuenta
      * @return Nmero de cuenta como cadena
      */
-    std::string getNumeroCuenta() const { return this->numeroCuenta; }
+    std::string getNumeroCuenta() const { return Cuenta<double>::getNumeroCuenta(); }
 
     /**
      * @brief Obtiene el saldo actual de la cuenta
      * @return Saldo de la cuenta
      */
-    double getSaldo() const { return this->saldo; }
+    double getSaldo() const { return Cuenta<double>::getSaldo(); }
 
     /**
      * @brief Obtiene la fecha de apertura
      * @return Fecha de apertura como cadena formateada
      */
-    std::string getFechaApertura() const { return this->fechaApertura.toString(); }
+    std::string getFechaApertura() const { return Cuenta<double>::getFechaApertura().toString(); }
 
     /**
      * @brief Obtiene el estado actual de la cuenta
-     * @return Estado de la cuenta como cadena
+     * @return Texto del estado de la cuenta
      */
-    std::string getEstadoCuenta() const { return this->estadoCuenta; }
+    std::string_view getEstadoCuenta() const { return Cuenta<double>::getEstadoCuenta(); }
 
     /**
      * @brief Obtiene una referencia a esta cuenta
@@ -130,21 +114,6 @@ public:
      */
     CuentaCorriente* getCuentaCorriente() { return this; }
 
-    /**
-     * @brief Obtiene la siguiente cuenta en la lista enlazada
-     * @return Puntero a la siguiente cuenta, o nullptr si no existe
-     */
-    CuentaCorriente* getSiguiente() const {
-        Cuenta<double>* sig = this->siguiente;
-        return sig ? dynamic_cast<CuentaCorriente*>(sig) : nullptr;
-    }
-
-    /**
-     * @brief Obtiene la cuenta anterior en la lista enlazada
-     * @return Puntero a la cuenta anterior, o nullptr si no existe
-     */
-    CuentaCorriente* getAnterior() const { return dynamic_cast<CuentaCorriente*>(this->anterior); }
-
     /**
      * @brief Realiza un depsito en la cuenta
      * @param cantidad Monto a depositar
@@ -165,9 +134,9 @@ public:
 
     /**
      * @brief Consulta el estado actual de la cuenta
-     * @return Estado de la cuenta como cadena
+     * @return Texto del estado de la cuenta
      */
-    std::string consultarEstado() const;
+    std::string_view consultarEstado() const;
 
     /**
      * @brief Formatea el saldo para presentacin
@@ -207,5 +176,10 @@ public:
      */
     void esMontoMinimo(double montoMinimo);
 
+    /**
+     * @brief Reserva la cuenta en el pool compartido de su tipo en lugar de un new suelto
+     */
+    static void* operator new(size_t tamano) { return PoolCompartido<CuentaCorriente>::reservar(tamano); }
+    static void operator delete(void* memoria, size_t tamano) { PoolCompartido<CuentaCorriente>::devolver(memoria, tamano); }
 };
 #endif // CUENTACORRIENTE_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+/**
+ * @file FabricaRepositorioBanco.cpp
+ * @brief Implementación de la fábrica de repositorios bancarios
+ */
+#include "FabricaRepositorioBanco.h"
+#include "_BaseDatosPersona.h"
+#include "RepositorioBancoMemoria.h"
+#include "AlmacenLocalBanco.h"
+#include <iostream>
+
+MotorAlmacenamiento FabricaRepositorioBanco::motorActual = MotorAlmacenamiento::MONGODB;
+std::unique_ptr<AlmacenLocalBanco> FabricaRepositorioBanco::almacenLocal;
+
+void FabricaRepositorioBanco::setMotor(MotorAlmacenamiento motor) {
+	motorActual = motor;
+}
+
+MotorAlmacenamiento FabricaRepositorioBanco::getMotor() {
+	return motorActual;
+}
+
+IRepositorioBanco& FabricaRepositorioBanco::obtenerRepositorio() {
+	if (motorActual == MotorAlmacenamiento::MEMORIA) {
+		static RepositorioBancoMemoria repositorioMemoria;
+		return repositorioMemoria;
+	}
+
+	// Solo se conecta a MongoDB si realmente se usa este motor
+	static _BaseDatosPersona repositorioMongo;
+	return repositorioMongo;
+}
+
+bool FabricaRepositorioBanco::abrirAlmacenLocal(const std::string& directorio) {
+	cerrarAlmacenLocal();
+
+	auto almacen = std::make_unique<AlmacenLocalBanco>();
+	if (!almacen->abrir(directorio)) {
+		std::cerr << "Error: No se pudo abrir el almacén local en " << directorio << std::endl;
+		return false;
+	}
+
+	IRepositorioBanco& repositorio = obtenerRepositorio();
+	if (motorActual == MotorAlmacenamiento::MEMORIA) {
+		static_cast<RepositorioBancoMemoria&>(repositorio).usarAlmacenLocal(almacen.get());
+	}
+	else if (!almacen->sincronizarCon(repositorio)) {
+		std::cerr << "Error: No se pudo sincronizar el almacén local con MongoDB" << std::endl;
+		return false;
+	}
+	almacenLocal = std::move(almacen);
+	return true;
+}
+
+void FabricaRepositorioBanco::cerrarAlmacenLocal() {
+	if (!almacenLocal) {
+		return;
+	}
+	if (motorActual == MotorAlmacenamiento::MEMORIA) {
+		static_cast<RepositorioBancoMemoria&>(obtenerRepositorio()).usarAlmacenLocal(nullptr);
+	}
+	almacenLocal.reset();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#ifndef FABRICAREPOSITORIOBANCO_H
+#define FABRICAREPOSITORIOBANCO_H
+
+#include "IRepositorioBanco.h"
+#include <string>
+#include <memory>
+
+class AlmacenLocalBanco;
+
+/**
+ * @enum MotorAlmacenamiento
+ * @brief Motores de almacenamiento disponibles para IRepositorioBanco
+ */
+enum class MotorAlmacenamiento {
+    MONGODB,
+    MEMORIA
+};
+
+/**
+ * @class FabricaRepositorioBanco
+ * @brief Selecciona y entrega el repositorio compartido del motor configurado
+ *
+ * Aplicando el patrón Factory: la capa de negocio pide un IRepositorioBanco sin
+ * conocer el motor. Cada motor tiene una única instancia por proceso; en el motor
+ * en memoria esto es lo que mantiene los datos entre operaciones.
+ */
+class FabricaRepositorioBanco {
+private:
+    static MotorAlmacenamiento motorActual;
+    static std::unique_ptr<AlmacenLocalBanco> almacenLocal;
+
+public:
+    /**
+     * @brief Establece el motor a usar; debe llamarse antes de construir Banco
+     * @param motor Motor de almacenamiento
+     */
+    static void setMotor(MotorAlmacenamiento motor);
+
+    /**
+     * @brief Obtiene el motor configurado (MONGODB por defecto)
+     */
+    static MotorAlmacenamiento getMotor();
+
+    /**
+     * @brief Obtiene el repositorio compartido del motor configurado
+     * @return Referencia al repositorio, válida durante toda la ejecución
+     */
+    static IRepositorioBanco& obtenerRepositorio();
+
+    /**
+     * @brief Abre el almacén local y lo conecta con el motor configurado
+     *
+     * Con MongoDB el almacén se pone al día y sigue las escrituras; con el motor en
+     * memoria las personas y cuentas que no están en memoria se leen del almacén, lo
+     * que permite operar sin conexión con los datos de la última sesión conectada.
+     * @return false si no se pudo abrir o sincronizar; el sistema sigue sin almacén
+     */
+    static bool abrirAlmacenLocal(const std::string& directorio);
+
+    /**
+     * @brief Cierra el almacén local; debe llamarse antes de cerrar las conexiones
+     */
+    static void cerrarAlmacenLocal();
+};
+
+#endif // FABRICAREPOSITORIOBANCO_H
@@ -13,6 +13,57 @@
 #include <iostream>
 #include <string>
 
+/**
+ * @brief Días desde el 01/01/1970 de una fecha civil (calendario gregoriano proléptico)
+ *
+ * Mes y día fuera de rango se normalizan igual que en mktime; 0/0/0 es SIN_FECHA
+ */
+int32_t Fecha::diasDesdeCivil(int d, int m, int a) {
+	if (d == 0 && m == 0 && a == 0) {
+		return SIN_FECHA;
+	}
+	// Llevar el mes a [1, 12] ajustando el año
+	int64_t meses = static_cast<int64_t>(a) * 12 + (m - 1);
+	int64_t y = (meses >= 0 ? meses : meses - 11) / 12;
+	int64_t mm = meses - y * 12 + 1;
+
+	// Años contados desde marzo, para que el 29 de febrero quede al final
+	y -= mm <= 2;
+	const int64_t era = (y >= 0 ? y : y - 399) / 400;
+	const int64_t anioEra = y - era * 400;
+	const int64_t diaAnio = (153 * (mm + (mm > 2 ? -3 : 9)) + 2) / 5;
+	const int64_t diaEra = anioEra * 365 + anioEra / 4 - anioEra / 100 + diaAnio;
+	return static_cast<int32_t>(era * 146097 + diaEra - 719468 + (d - 1));
+}
+
+/**
+ * @brief Descompone los días guardados en día, mes y año
+ */
+void Fecha::aCivil(int& d, int& m, int& a) const {
+	if (dias == SIN_FECHA) {
+		d = m = a = 0;
+		return;
+	}
+	const int64_t z = static_cast<int64_t>(dias) + 719468;
+	const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+	const int64_t diaEra = z - era * 146097;
+	const int64_t anioEra = (diaEra - diaEra / 1460 + diaEra / 36524 - diaEra / 146096) / 365;
+	const int64_t diaAnio = diaEra - (365 * anioEra + anioEra / 4 - anioEra / 100);
+	const int64_t mesMarzo = (5 * diaAnio + 2) / 153;
+	d = static_cast<int>(diaAnio - (153 * mesMarzo + 2) / 5 + 1);
+	m = static_cast<int>(mesMarzo < 10 ? mesMarzo + 3 : mesMarzo - 9);
+	a = static_cast<int>(anioEra + era * 400 + (m <= 2));
+}
+
+/**
+ * @brief Día de la semana sin pasar por mktime: el 01/01/1970 fue jueves
+ *
+ * @return int 0 domingo ... 6 sábado
+ */
+int Fecha::diaSemana() const {
+	return static_cast<int>(((static_cast<int64_t>(dias) % 7) + 11) % 7);
+}
+
  /**
   * @brief Constructor por defecto
   *
@@ -22,9 +73,7 @@ Fecha::Fecha() {
 	time_t t = time(0);
 	tm now = {};
 	localtime_s(&now, &t);
-	dia = now.tm_mday;
-	mes = now.tm_mon + 1;
-	anio = now.tm_year + 1900;
+	dias = diasDesdeCivil(now.tm_mday, now.tm_mon + 1, now.tm_year + 1900);
 	//corregirSiNoLaborable();
 }
 
@@ -35,7 +84,7 @@ Fecha::Fecha() {
  * @param m Mes del año (1-12)
  * @param a Año
  */
-Fecha::Fecha(int d, int m, int a) : dia(d), mes(m), anio(a) {
+Fecha::Fecha(int d, int m, int a) : dias(diasDesdeCivil(d, m, a)) {
 	//corregirSiNoLaborable();
 }
 
@@ -46,10 +95,11 @@ Fecha::Fecha(int d, int m, int a) : dia(d), mes(m), anio(a) {
  * @throws std::invalid_argument Si el formato de la fecha no es válido
  */
 Fecha::Fecha(const std::string& fechaFormateada) {
-	int d, m, a;
+	int d = 0, m = 0, a = 0; // Una cadena inválida queda sin fecha
 	try {
 
 		if (sscanf_s(fechaFormateada.c_str(), "%d/%d/%d", &d, &m, &a) != 3) {
+			d = m = a = 0;
 		//	std::ostringstream oss;
 		//	oss << "Formato de fecha invalido. Use DD/MM/AAAA. Valor recibido: '" << fechaFormateada << "'";
 		//	std::cerr << oss.str() << std::endl;
@@ -62,9 +112,7 @@ Fecha::Fecha(const std::string& fechaFormateada) {
 		std::cerr << "Excepción capturada: " << ex.what() << std::endl;
 	}
 
-	dia = d;
-	mes = m;
-	anio = a;
+	dias = diasDesdeCivil(d, m, a);
 
 	//corregirSiNoLaborable();
 }
@@ -90,12 +138,8 @@ bool Fecha::esBisiesto(int a) const {
  * @return true si es sábado o domingo, false en caso contrario
  */
 bool Fecha::esFinDeSemana(int d, int m, int a) const {
-	tm tiempo = {};
-	tiempo.tm_mday = d;
-	tiempo.tm_mon = m - 1;
-	tiempo.tm_year = a - 1900;
-	mktime(&tiempo);
-	return (tiempo.tm_wday == 0 || tiempo.tm_wday == 6); // domingo o sabado
+	int semana = Fecha(d, m, a).diaSemana();
+	return (semana == 0 || semana == 6); // domingo o sabado
 }
 
 /**
@@ -128,25 +172,26 @@ bool Fecha::esFeriado(int d, int m, int a) const {
  * Si la fecha cae en fin de semana o es feriado, se avanza hasta el siguiente día laborable
  */
 void Fecha::corregirSiNoLaborable() {
-	while (esFinDeSemana(dia, mes, anio) || esFeriado(dia, mes, anio)) {
+	if (!tieneFecha()) {
+		return;
+	}
+	int d, m, a;
+	aCivil(d, m, a);
+	while (diaSemana() == 0 || diaSemana() == 6 || esFeriado(d, m, a)) {
 		avanzarADiaLaborable();
+		aCivil(d, m, a);
 	}
 }
 
 /**
  * @brief Avanza la fecha al siguiente día laborable
  *
- * Incrementa la fecha en un día y actualiza los valores de día, mes y año
+ * Incrementa la fecha en un día; mes y año se derivan de los días guardados
  */
 void Fecha::avanzarADiaLaborable() {
-	tm tiempo = {};
-	tiempo.tm_mday = dia + 1;
-	tiempo.tm_mon = mes - 1;
-	tiempo.tm_year = anio - 1900;
-	mktime(&tiempo);
-	dia = tiempo.tm_mday;
-	mes = tiempo.tm_mon + 1;
-	anio = tiempo.tm_year + 1900;
+	if (tieneFecha()) {
+		dias++;
+	}
 }
 
 /**
@@ -155,6 +200,8 @@ void Fecha::avanzarADiaLaborable() {
  * @return std::string Fecha formateada como "DD/MM/AAAA"
  */
 std::string Fecha::obtenerFechaFormateada() const {
+	int dia, mes, anio;
+	aCivil(dia, mes, anio);
 	std::ostringstream oss;
 	if (dia < 10) oss << '0';
 	oss << dia << '/';
@@ -175,7 +222,7 @@ bool Fecha::esFechaSistemaManipulada() const {
 	tm now = {}; // Estructura para almacenar la fecha actual
 	localtime_s(&now, &t); // Convierte el tiempo a la estructura tm
 	// Comparamos la fecha almacenada con la del sistema
-	return (dia != now.tm_mday || mes != (now.tm_mon + 1) || anio != (now.tm_year + 1900)); // Verifica si hay discrepancias
+	return dias != diasDesdeCivil(now.tm_mday, now.tm_mon + 1, now.tm_year + 1900); // Verifica si hay discrepancias
 }
 
 /**
@@ -186,9 +233,7 @@ bool Fecha::esFechaSistemaManipulada() const {
  * @param a Año
  */
 void Fecha::setFecha(int d, int m, int a) {
-	dia = d;
-	mes = m;
-	anio = a;
+	dias = diasDesdeCivil(d, m, a);
 	//corregirSiNoLaborable();
 }
 
@@ -213,6 +258,8 @@ std::string Fecha::obtenerFechaActual() const {
 	time_t t = time(0);
 	tm now = {};
 	localtime_s(&now, &t);
+	int dia, mes, anio;
+	aCivil(dia, mes, anio);
 	std::ostringstream oss;
 	oss << "Fecha del sistema:"
 		<< (now.tm_mday < 10 ? "0" : "") << now.tm_mday << '/'
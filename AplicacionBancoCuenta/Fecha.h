@@ -4,6 +4,7 @@
 
 #include <string>
 #include <vector>
+#include <cstdint>
 
 /**
  * @class Fecha
@@ -12,54 +13,84 @@
  * Esta clase permite crear, validar y manipular fechas, incluyendo
  * funcionalidades para determinar das laborables, feriados,
  * y formatear fechas para su presentacin.
+ *
+ * La fecha se guarda como das transcurridos desde el 01/01/1970 (4 bytes): comparar
+ * dos fechas es comparar dos enteros y el da de la semana sale de un mdulo. Da,
+ * mes y ao se calculan al pedirlos. Como mktime, una fecha fuera de rango se
+ * normaliza (32/01 pasa a ser 01/02); 0/0/0 representa la ausencia de fecha.
  */
 class Fecha {
 private:
-    /** @brief Da del mes (1-31) */
-    int dia;
+    /** @brief Das desde el 01/01/1970, o SIN_FECHA */
+    int32_t dias;
+
+    static constexpr int32_t SIN_FECHA = INT32_MIN;
 
-    /** @brief Mes del ao (1-12) */
-    int mes;
+    /**
+     * @brief Das desde el 01/01/1970 de una fecha civil, normalizando mes y da
+     */
+    static int32_t diasDesdeCivil(int d, int m, int a);
 
-    /** @brief Ao (formato de 4 dgitos) */
-    int anio;
+    /**
+     * @brief Descompone los das guardados en da, mes y ao (0/0/0 sin fecha)
+     */
+    void aCivil(int& d, int& m, int& a) const;
 
 public:
     /**
      * @brief Establece el da del mes
      * @param d Da a establecer
      */
-    void setDia(int d) { dia = d; }
+    void setDia(int d) { int dd, m, a; aCivil(dd, m, a); setFecha(d, m, a); }
 
     /**
      * @brief Establece el mes del ao
      * @param m Mes a establecer
      */
-    void setMes(int m) { mes = m; }
+    void setMes(int m) { int d, mm, a; aCivil(d, mm, a); setFecha(d, m, a); }
 
     /**
      * @brief Establece el ao
      * @param a Ao a establecer
      */
-    void setAnio(int a) { anio = a; }
+    void setAnio(int a) { int d, m, aa; aCivil(d, m, aa); setFecha(d, m, a); }
 
     /**
      * @brief Obtiene el da del mes
      * @return Da actual
      */
-    int getDia() const { return dia; }
+    int getDia() const { int d, m, a; aCivil(d, m, a); return d; }
 
     /**
      * @brief Obtiene el mes del ao
      * @return Mes actual
      */
-    int getMes() const { return mes; }
+    int getMes() const { int d, m, a; aCivil(d, m, a); return m; }
 
     /**
      * @brief Obtiene el ao
      * @return Ao actual
      */
-    int getAnio() const { return anio; }
+    int getAnio() const { int d, m, a; aCivil(d, m, a); return a; }
+
+    /**
+     * @brief Das transcurridos desde el 01/01/1970
+     */
+    int32_t getDiasDesdeEpoca() const { return dias; }
+
+    /**
+     * @brief Indica si la fecha tiene valor (no es 0/0/0 ni una cadena invlida)
+     */
+    bool tieneFecha() const { return dias != SIN_FECHA; }
+
+    /**
+     * @brief Da de la semana: 0 domingo ... 6 sbado
+     */
+    int diaSemana() const;
+
+    bool operator==(const Fecha& otra) const { return dias == otra.dias; }
+    bool operator!=(const Fecha& otra) const { return dias != otra.dias; }
+    bool operator<(const Fecha& otra) const { return dias < otra.dias; }
 
     /**
      * @brief Constructor por defecto
@@ -64,7 +64,7 @@ std::string ProveedorDatosMongoDB::obtenerDatosCompletosBaseDatos() {
 
 std::string ProveedorDatosMongoDB::obtenerDatosColeccion(const std::string& nombreColeccion) {
     try {
-        auto& cliente = conexion.obtenerClienteBaseDatos();
+        auto cliente = conexion.arrendarCliente();
         auto db = cliente[NOMBRE_DB];
         auto coleccion = db[nombreColeccion];
 
@@ -113,7 +113,7 @@ std::string PersistenciaHashImpl::leerHashDeArchivo(const std::string& rutaArchi
 
 bool PersistenciaHashImpl::enviarHashABaseDatos(const std::string& hashCalculado, const std::string& hashRecibido) {
     try {
-        auto& cliente = conexion.obtenerClienteBaseDatos();
+        auto cliente = conexion.arrendarCliente();
         auto db = cliente[NOMBRE_DB];
         auto coleccion = db[COLECCION_CIFRADO];
 
@@ -209,7 +209,7 @@ std::vector<bsoncxx::document::value> ConsultorHistorialHash::obtenerHistorialHa
     std::vector<bsoncxx::document::value> historial;
 
     try {
-        auto& cliente = conexion.obtenerClienteBaseDatos();
+        auto cliente = conexion.arrendarCliente();
         auto db = cliente[NOMBRE_DB];
         auto coleccion = db[COLECCION_CIFRADO];
 
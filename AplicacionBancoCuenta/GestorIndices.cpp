@@ -0,0 +1,331 @@
+/**
+ * @file GestorIndices.cpp
+ * @brief Implementación de los índices secundarios en memoria sobre personas
+ */
+#include "GestorIndices.h"
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include "MetricasMemoria.h"
+#include <iostream>
+#include <mutex>
+
+using bsoncxx::builder::basic::kvp;
+
+namespace {
+	std::string leerTexto(const bsoncxx::document::view& doc, const char* campo) {
+		auto elemento = doc[campo];
+		if (elemento && elemento.type() == bsoncxx::type::k_utf8) {
+			return std::string(elemento.get_string().value);
+		}
+		return "";
+	}
+}
+
+GestorIndices::GestorIndices(IRepositorioBanco& repositorio)
+	: repositorio(repositorio), cargado(false), idObservador(0), contadorCarga(0), escriturasAplicadas(0) {
+	idObservador = IRepositorioBanco::registrarObservadorPersonas([this](const EscrituraPersona& escritura) {
+		aplicarEscritura(escritura);
+	});
+}
+
+GestorIndices::~GestorIndices() {
+	IRepositorioBanco::eliminarObservadorPersonas(idObservador);
+}
+
+IndiceTrigramas::Campos GestorIndices::camposTrigramas(const Persona& persona) {
+	return IndiceTrigramas::Campos{ persona.getNombres(), persona.getApellidos(), persona.getCorreo(), persona.getDireccion() };
+}
+
+GestorIndices::RegistroPersona* GestorIndices::LotePersonas::crear(const bsoncxx::document::view& documento) {
+	std::string cedula = leerTexto(documento, "cedula");
+	if (cedula.empty()) {
+		return nullptr;
+	}
+	Persona* persona = personas.crear(
+		cedula,
+		leerTexto(documento, "nombre"),
+		leerTexto(documento, "apellido"),
+		leerTexto(documento, "fechaNacimiento"),
+		leerTexto(documento, "correo"),
+		leerTexto(documento, "direccion")
+	);
+	return registros.crear(RegistroPersona{ persona, documentoIndexado(documento) });
+}
+
+void GestorIndices::LotePersonas::destruir(RegistroPersona* registro) {
+	if (!registro) {
+		return;
+	}
+	personas.destruir(registro->persona);
+	registros.destruir(registro);
+}
+
+bsoncxx::document::value GestorIndices::documentoIndexado(const bsoncxx::document::view& documento) {
+	bsoncxx::builder::basic::document doc;
+	for (const auto& elemento : documento) {
+		if (elemento.key() == "_id") {
+			continue;
+		}
+		if (elemento.key() != "cuentas" || elemento.type() != bsoncxx::type::k_array) {
+			doc.append(kvp(elemento.key(), elemento.get_value()));
+			continue;
+		}
+
+		bsoncxx::builder::basic::array cuentasArray;
+		for (const auto& cuenta : elemento.get_array().value) {
+			if (cuenta.type() != bsoncxx::type::k_document) {
+				continue;
+			}
+			bsoncxx::builder::basic::document cuentaDoc;
+			for (const auto& campo : cuenta.get_document().value) {
+				if (campo.key() != "saldo") {
+					cuentaDoc.append(kvp(campo.key(), campo.get_value()));
+				}
+			}
+			cuentasArray.append(cuentaDoc.extract());
+		}
+		doc.append(kvp("cuentas", cuentasArray));
+	}
+	return doc.extract();
+}
+
+bool GestorIndices::registrarIndice(std::unique_ptr<IExtractorCampo> extractor, bool sugerencias) {
+	std::unique_lock<std::shared_mutex> lock(mutexIndices);
+	for (const auto& indice : indices) {
+		if (indice.extractor->obtenerNombre() == extractor->obtenerNombre()) {
+			return false;
+		}
+	}
+
+	indices.push_back(Indice{ std::move(extractor), nullptr,
+		sugerencias ? std::make_unique<ArbolPrefijos>() : nullptr });
+	if (cargado) {
+		construirIndice(indices.back());
+	}
+	return true;
+}
+
+void GestorIndices::construirIndice(Indice& indice) {
+	std::vector<Persona*> personas;
+	personas.reserve(registros.size());
+	for (const auto& par : registros) {
+		personas.push_back(par.second->persona);
+	}
+
+	indice.arbol = std::make_unique<ArbolBPlus<Persona>>(repositorio);
+	indice.arbol->usarExtractor(*indice.extractor);
+	indice.arbol->construir(personas);
+
+	if (indice.prefijos) {
+		// Las claves salen ordenadas del árbol: las repetidas se cuentan y se insertan juntas
+		indice.prefijos->limpiar();
+		for (auto it = indice.arbol->begin(); it != indice.arbol->end();) {
+			const std::string& clave = it.clave();
+			size_t repeticiones = 0;
+			auto siguiente = it;
+			while (siguiente != indice.arbol->end() && siguiente.clave() == clave) {
+				++siguiente;
+				++repeticiones;
+			}
+			if (!clave.empty()) {
+				indice.prefijos->insertar(clave, repeticiones);
+			}
+			it = siguiente;
+		}
+	}
+}
+
+bool GestorIndices::cargar() {
+	// La lectura del repositorio no bloquea las búsquedas en curso. El contador se lee
+	// antes que las personas: una escritura intermedia solo provoca otra recarga
+	std::vector<bsoncxx::document::value> documentos;
+	uint64_t contador = 0;
+	try {
+		contador = repositorio.obtenerContadorCambiosPersonas();
+		documentos = repositorio.mostrarTodasPersonas();
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al cargar los índices de personas: " << e.what() << std::endl;
+		return false;
+	}
+
+	// Los registros nuevos van a su propio lote; el anterior se libera de una vez al cambiarlos
+	MetricasMemoria::Instantanea antes = MetricasMemoria::tomar();
+	LotePersonas nuevoLote;
+	std::unordered_map<std::string, RegistroPersona*> nuevos;
+	nuevos.reserve(documentos.size());
+	for (const auto& documento : documentos) {
+		RegistroPersona* registro = nuevoLote.crear(documento.view());
+		if (registro && !nuevos.emplace(registro->persona->getCedula(), registro).second) {
+			nuevoLote.destruir(registro); // Cédula repetida: se queda el primero
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(mutexIndices);
+	registros = std::move(nuevos);
+	lote = std::move(nuevoLote);
+	for (auto& indice : indices) {
+		construirIndice(indice);
+	}
+	trigramas.limpiar();
+	for (const auto& par : registros) {
+		trigramas.agregar(par.first, camposTrigramas(*par.second->persona));
+	}
+	cargado = true;
+	contadorCarga = contador;
+	escriturasAplicadas = 0;
+	MetricasMemoria::registrarCarga("Indices de personas", antes, MetricasMemoria::tomar());
+	return !registros.empty();
+}
+
+void GestorIndices::asegurarCarga() {
+	uint64_t contador = 0;
+	try {
+		contador = repositorio.obtenerContadorCambiosPersonas();
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al leer el contador de cambios de personas: " << e.what() << std::endl;
+	}
+	{
+		std::shared_lock<std::shared_mutex> lock(mutexIndices);
+		// Sin contador (motor en memoria o error de lectura) se confía en el observador
+		if (cargado && (contador == 0 || contadorCarga == 0 || contador == contadorCarga + escriturasAplicadas)) {
+			return;
+		}
+	}
+	cargar();
+}
+
+void GestorIndices::aplicarEscritura(const EscrituraPersona& escritura) {
+	const std::string& cedula = escritura.persona.getCedula();
+	std::unique_lock<std::shared_mutex> lock(mutexIndices);
+	if (!cargado) {
+		return; // La primera carga ya leerá esta escritura
+	}
+
+	// El documento se arma con lo que trae la escritura sobre el registro vigente; solo
+	// una cuenta agregada a un titular que el índice aún no conoce obliga a releerlo
+	auto existente = registros.find(cedula);
+	bsoncxx::document::view documentoAnterior;
+	if (existente != registros.end()) {
+		documentoAnterior = existente->second->documento.view();
+	}
+	auto documento = escritura.documentoResultante(existente != registros.end() ? &documentoAnterior : nullptr);
+	if (!documento) {
+		lock.unlock();
+		auto releido = repositorio.buscarPersonaCompletaPorCedula(cedula);
+		if (leerTexto(releido.view(), "cedula").empty()) {
+			return; // La escritura fue en otro repositorio
+		}
+		lock.lock();
+		if (!cargado) {
+			return;
+		}
+		existente = registros.find(cedula);
+		documento = std::move(releido);
+	}
+	RegistroPersona* registro = lote.crear(documento->view());
+	if (existente != registros.end()) {
+		const Persona* anterior = existente->second->persona;
+		for (auto& indice : indices) {
+			std::string clave = indice.extractor->extraerClave(anterior);
+			indice.arbol->eliminar(clave, anterior);
+			if (indice.prefijos) {
+				indice.prefijos->eliminar(clave);
+			}
+		}
+	}
+	for (auto& indice : indices) {
+		indice.arbol->insertar(registro->persona);
+		if (indice.prefijos) {
+			std::string clave = indice.extractor->extraerClave(registro->persona);
+			if (!clave.empty()) {
+				indice.prefijos->insertar(clave);
+			}
+		}
+	}
+	// agregar() reemplaza la entrada anterior de la cédula
+	trigramas.agregar(cedula, camposTrigramas(*registro->persona));
+	if (existente != registros.end()) {
+		lote.destruir(existente->second);
+		existente->second = registro;
+	}
+	else {
+		registros.emplace(cedula, registro);
+	}
+	escriturasAplicadas++;
+}
+
+const GestorIndices::Indice* GestorIndices::buscarIndice(const std::string& nombre) const {
+	for (const auto& indice : indices) {
+		if (indice.extractor->obtenerNombre() == nombre) {
+			return &indice;
+		}
+	}
+	std::cerr << "Error: No existe un índice de personas por " << nombre << std::endl;
+	return nullptr;
+}
+
+std::vector<bsoncxx::document::value> GestorIndices::recolectar(const ArbolBPlus<Persona>::Rango& rango) const {
+	std::vector<bsoncxx::document::value> resultados;
+	for (const Persona* persona : rango) {
+		auto registro = registros.find(persona->getCedula());
+		if (registro != registros.end()) {
+			resultados.push_back(registro->second->documento);
+		}
+	}
+	return resultados;
+}
+
+std::vector<bsoncxx::document::value> GestorIndices::buscarExacto(const std::string& nombreIndice, const std::string& valor) {
+	asegurarCarga();
+	std::shared_lock<std::shared_mutex> lock(mutexIndices);
+	const Indice* indice = buscarIndice(nombreIndice);
+	if (!indice) {
+		return {};
+	}
+	std::string clave = indice->extractor->normalizarConsulta(valor);
+	return recolectar(indice->arbol->rango(clave, clave));
+}
+
+std::vector<ArbolPrefijos::Sugerencia> GestorIndices::sugerir(const std::string& nombreIndice, const std::string& prefijo, size_t limite) {
+	asegurarCarga();
+	std::shared_lock<std::shared_mutex> lock(mutexIndices);
+	const Indice* indice = buscarIndice(nombreIndice);
+	if (!indice || !indice->prefijos) {
+		return {};
+	}
+	return indice->prefijos->sugerir(indice->extractor->normalizarConsulta(prefijo), limite);
+}
+
+std::vector<bsoncxx::document::value> GestorIndices::buscarAproximado(const std::string& consulta, size_t limite) {
+	asegurarCarga();
+	std::shared_lock<std::shared_mutex> lock(mutexIndices);
+	std::vector<bsoncxx::document::value> resultados;
+	for (const auto& coincidencia : trigramas.buscar(consulta, limite)) {
+		auto registro = registros.find(coincidencia.cedula);
+		if (registro != registros.end()) {
+			resultados.push_back(registro->second->documento);
+		}
+	}
+	return resultados;
+}
+
+std::vector<bsoncxx::document::value> GestorIndices::buscarSubcadena(IndiceTrigramas::Campo campo, const std::string& texto) {
+	asegurarCarga();
+	std::shared_lock<std::shared_mutex> lock(mutexIndices);
+	std::vector<bsoncxx::document::value> resultados;
+	for (const auto& cedula : trigramas.contienen(texto, 1u << campo)) {
+		auto registro = registros.find(cedula);
+		if (registro != registros.end()) {
+			resultados.push_back(registro->second->documento);
+		}
+	}
+	return resultados;
+}
+
+size_t GestorIndices::totalRegistros() const {
+	std::shared_lock<std::shared_mutex> lock(mutexIndices);
+	return registros.size();
+}
@@ -0,0 +1,175 @@
+#pragma once
+#ifndef GESTORINDICES_H
+#define GESTORINDICES_H
+
+#include "IRepositorioBanco.h"
+#include "ArbolBPlusGrafico.h"
+#include "ArbolPrefijos.h"
+#include "IndiceTrigramas.h"
+#include "PoolObjetos.h"
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <unordered_map>
+#include <shared_mutex>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class GestorIndices
+ * @brief Índices secundarios en memoria sobre las personas de un repositorio
+ *
+ * Mantiene un ArbolBPlus por cada IExtractorCampo registrado y, en los índices que lo
+ * piden, un ArbolPrefijos con las claves y su frecuencia para sugerir al escribir. Aparte,
+ * un IndiceTrigramas sobre nombre, apellido, correo y dirección responde búsquedas
+ * aproximadas que toleran errores de tipeo. Todos los árboles
+ * apuntan a los mismos registros (uno por cédula), de modo que una persona se guarda
+ * una sola vez aunque esté en varios índices. Cada escritura de persona notificada por
+ * el repositorio actualiza el registro y todos los índices juntos, bajo un único
+ * bloqueo exclusivo; las búsquedas toman el bloqueo compartido.
+ *
+ * Los cambios que no se notifican (una restauración, otro proceso) se detectan con el
+ * contador de cambios de personas: cada búsqueda lo compara con el leído en la carga
+ * más las escrituras aplicadas desde entonces y recarga si no coincide.
+ *
+ * Los documentos guardados omiten el saldo de las cuentas: cambia con cada depósito o
+ * retiro, que no se notifica, y mostrarlo desde el índice lo daría desactualizado.
+ */
+class GestorIndices {
+private:
+    /**
+     * @struct RegistroPersona
+     * @brief Persona compartida por todos los índices y su documento para mostrar
+     */
+    struct RegistroPersona {
+        Persona* persona;
+        bsoncxx::document::value documento;
+    };
+
+    /**
+     * @struct LotePersonas
+     * @brief Memoria de los registros y personas de una carga, liberada entera al recargar
+     */
+    struct LotePersonas {
+        PoolObjetos<Persona> personas;
+        PoolObjetos<RegistroPersona> registros;
+
+        /**
+         * @brief Crea el registro de un documento de persona; nullptr si no trae cédula
+         */
+        RegistroPersona* crear(const bsoncxx::document::view& documento);
+        void destruir(RegistroPersona* registro);
+    };
+
+    /**
+     * @struct Indice
+     * @brief Árbol ordenado por la clave de un extractor; no posee a las personas
+     *
+     * prefijos cuenta cuántas personas tienen cada clave; es nulo si el índice no
+     * ofrece sugerencias.
+     */
+    struct Indice {
+        std::unique_ptr<IExtractorCampo> extractor;
+        std::unique_ptr<ArbolBPlus<Persona>> arbol;
+        std::unique_ptr<ArbolPrefijos> prefijos;
+    };
+
+    IRepositorioBanco& repositorio;
+    LotePersonas lote;
+    std::unordered_map<std::string, RegistroPersona*> registros;
+    std::vector<Indice> indices;
+    IndiceTrigramas trigramas;
+    mutable std::shared_mutex mutexIndices;
+    bool cargado;
+    int idObservador;
+    uint64_t contadorCarga;         // Contador de cambios leído al cargar; 0 si el motor no lo lleva
+    uint64_t escriturasAplicadas;   // Escrituras notificadas aplicadas desde la carga
+
+    /**
+     * @brief Textos de una persona en el orden de IndiceTrigramas::Campo
+     */
+    static IndiceTrigramas::Campos camposTrigramas(const Persona& persona);
+
+    /**
+     * @brief Copia del documento sin _id ni saldos de cuentas
+     */
+    static bsoncxx::document::value documentoIndexado(const bsoncxx::document::view& documento);
+
+    /**
+     * @brief Reconstruye el árbol de un índice con los registros actuales (bloqueo exclusivo tomado)
+     */
+    void construirIndice(Indice& indice);
+
+    /**
+     * @brief Observador de escrituras: actualiza el registro de la persona y la reubica en todos los índices
+     */
+    void aplicarEscritura(const EscrituraPersona& escritura);
+
+    /**
+     * @brief Carga los registros la primera vez que se consulta, o de nuevo si el
+     *        contador de cambios indica escrituras que no pasaron por el observador
+     */
+    void asegurarCarga();
+
+    const Indice* buscarIndice(const std::string& nombre) const;
+    std::vector<bsoncxx::document::value> recolectar(const ArbolBPlus<Persona>::Rango& rango) const;
+
+public:
+    explicit GestorIndices(IRepositorioBanco& repositorio);
+    ~GestorIndices();
+
+    GestorIndices(const GestorIndices&) = delete;
+    GestorIndices& operator=(const GestorIndices&) = delete;
+
+    /**
+     * @brief Agrega un índice identificado por extractor->obtenerNombre()
+     * @param extractor Estrategia que define la clave del índice
+     * @param sugerencias true para mantener además un ArbolPrefijos para sugerir()
+     * @return true si se registró, false si ya había un índice con ese nombre
+     */
+    bool registrarIndice(std::unique_ptr<IExtractorCampo> extractor, bool sugerencias = false);
+
+    /**
+     * @brief Carga (o recarga) todas las personas del repositorio y reconstruye los índices
+     * @return true si se cargó al menos una persona, false en caso contrario
+     */
+    bool cargar();
+
+    /**
+     * @brief Personas cuya clave en el índice es exactamente el valor indicado
+     * @param nombreIndice Nombre del extractor del índice (p. ej. "Fecha")
+     * @param valor Texto ingresado por el usuario; se normaliza con el extractor
+     * @return Documentos de las personas encontradas, en orden de la clave
+     */
+    std::vector<bsoncxx::document::value> buscarExacto(const std::string& nombreIndice, const std::string& valor);
+
+    /**
+     * @brief Claves del índice que completan el prefijo, de la más a la menos frecuente
+     * @param limite Cantidad máxima (a lo sumo ArbolPrefijos::MAX_SUGERENCIAS)
+     * @return Sugerencias ya normalizadas; vacío si el índice no ofrece sugerencias
+     */
+    std::vector<ArbolPrefijos::Sugerencia> sugerir(const std::string& nombreIndice, const std::string& prefijo, size_t limite);
+
+    /**
+     * @brief Personas con nombre, apellido, correo o dirección parecidos a la consulta
+     *
+     * Tolera errores de tipeo (1 a 3 ediciones según el largo de la consulta), tildes y
+     * mayúsculas. Ver IndiceTrigramas::buscar.
+     * @param limite Cantidad máxima de resultados
+     * @return Documentos de las personas, de la más a la menos parecida
+     */
+    std::vector<bsoncxx::document::value> buscarAproximado(const std::string& consulta, size_t limite);
+
+    /**
+     * @brief Personas cuyo campo contiene el texto en cualquier posición
+     *
+     * Misma semántica que la búsqueda parcial de buscarPersonasPorCriterio, sin
+     * distinguir mayúsculas ni tildes. Ver IndiceTrigramas::contienen.
+     * @param campo Campo de texto donde buscar
+     */
+    std::vector<bsoncxx::document::value> buscarSubcadena(IndiceTrigramas::Campo campo, const std::string& texto);
+
+    size_t totalRegistros() const;
+};
+
+#endif // GESTORINDICES_H
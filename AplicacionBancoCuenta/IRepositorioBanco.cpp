@@ -0,0 +1,108 @@
+/**
+ * @file IRepositorioBanco.cpp
+ * @brief Utilidades comunes a los observadores de escrituras de IRepositorioBanco
+ */
+#include "IRepositorioBanco.h"
+#include "Persona.h"
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+
+using bsoncxx::builder::basic::kvp;
+
+std::optional<bsoncxx::document::value> EscrituraPersona::documentoResultante(const bsoncxx::document::view* anterior) const {
+	if (nuevaPersona) {
+		// Misma forma que el alta en los motores: la cuenta inicial, si la hay, es la única
+		bsoncxx::builder::basic::array cuentas;
+		if (cuentaAgregada) {
+			cuentas.append(*cuentaAgregada);
+		}
+		bsoncxx::builder::basic::document doc;
+		doc.append(
+			kvp("cedula", persona.getCedula()),
+			kvp("nombre", persona.getNombres()),
+			kvp("apellido", persona.getApellidos()),
+			kvp("fechaNacimiento", persona.getFechaNacimiento()),
+			kvp("correo", persona.getCorreo()),
+			kvp("direccion", persona.getDireccion()),
+			kvp("numAhorros", persona.getNumCuentas()),
+			kvp("numCorrientes", persona.getNumCorrientes()),
+			kvp("totalCuentasExistentes", cuentaAgregada ? 1 : 0),
+			kvp("cuentas", cuentas)
+		);
+		bsoncxx::types::b_date fecha{ std::chrono::milliseconds{ 0 } };
+		if (IRepositorioBanco::convertirFechaABsonDate(persona.getFechaNacimiento(), fecha)) {
+			doc.append(kvp("fechaNacimientoDate", fecha));
+		}
+		return doc.extract();
+	}
+
+	if (!anterior) {
+		return std::nullopt;
+	}
+
+	std::string tipo;
+	if (cuentaAgregada) {
+		auto tipoElement = (*cuentaAgregada)["tipo"];
+		if (tipoElement && tipoElement.type() == bsoncxx::type::k_utf8) {
+			tipo = std::string(tipoElement.get_string().value);
+		}
+
+		// Un documento leído después de la escritura ya trae la cuenta
+		auto numeroElement = (*cuentaAgregada)["numeroCuenta"];
+		auto cuentasAnteriores = (*anterior)["cuentas"];
+		if (numeroElement && numeroElement.type() == bsoncxx::type::k_utf8 &&
+			cuentasAnteriores && cuentasAnteriores.type() == bsoncxx::type::k_array) {
+			for (auto&& cuenta : cuentasAnteriores.get_array().value) {
+				if (cuenta.type() != bsoncxx::type::k_document) {
+					continue;
+				}
+				auto numero = cuenta.get_document().value["numeroCuenta"];
+				if (numero && numero.type() == bsoncxx::type::k_utf8 &&
+					numero.get_string().value == numeroElement.get_string().value) {
+					return bsoncxx::document::value(*anterior);
+				}
+			}
+		}
+	}
+	const char* contadorTipo = tipo == "ahorros" ? "numAhorros" : tipo == "corriente" ? "numCorrientes" : "";
+
+	// Se conserva el documento previo; solo cambian el arreglo de cuentas y sus contadores
+	bsoncxx::builder::basic::document doc;
+	int totalCuentas = 0;
+	bool conCuentas = false;
+	for (auto&& elemento : *anterior) {
+		if (elemento.key() == "cuentas" && elemento.type() == bsoncxx::type::k_array) {
+			bsoncxx::builder::basic::array cuentas;
+			for (auto&& cuenta : elemento.get_array().value) {
+				cuentas.append(cuenta.get_value());
+				totalCuentas++;
+			}
+			if (cuentaAgregada) {
+				cuentas.append(*cuentaAgregada);
+				totalCuentas++;
+			}
+			doc.append(kvp("cuentas", cuentas));
+			conCuentas = true;
+		}
+		else if (elemento.key() == "totalCuentasExistentes") {
+			continue;
+		}
+		else if (cuentaAgregada && elemento.key() == contadorTipo && elemento.type() == bsoncxx::type::k_int32) {
+			doc.append(kvp(elemento.key(), elemento.get_int32().value + 1));
+		}
+		else {
+			doc.append(kvp(elemento.key(), elemento.get_value()));
+		}
+	}
+	if (!conCuentas) {
+		bsoncxx::builder::basic::array cuentas;
+		if (cuentaAgregada) {
+			cuentas.append(*cuentaAgregada);
+			totalCuentas++;
+		}
+		doc.append(kvp("cuentas", cuentas));
+	}
+	doc.append(kvp("totalCuentasExistentes", totalCuentas));
+	return doc.extract();
+}
@@ -0,0 +1,257 @@
+#pragma once
+#ifndef IREPOSITORIOBANCO_H
+#define IREPOSITORIOBANCO_H
+
+#include <bsoncxx/document/value.hpp>
+#include <bsoncxx/document/view.hpp>
+#include <bsoncxx/types.hpp>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <mutex>
+#include <utility>
+#include <algorithm>
+#include <iostream>
+
+class Persona;
+
+/**
+ * @struct Transferencia
+ * @brief Solicitud individual dentro de una liquidación por lotes
+ */
+struct Transferencia {
+    std::string cuentaOrigen;
+    std::string cuentaDestino;
+    double monto;
+};
+
+/**
+ * @struct ResultadoTransferencia
+ * @brief Resultado de una transferencia del lote, en el mismo orden de la solicitud
+ */
+struct ResultadoTransferencia {
+    bool exitosa = false;
+    std::string mensaje;
+};
+
+/**
+ * @struct EscrituraPersona
+ * @brief Escritura de persona confirmada, entregada a los observadores del repositorio
+ *
+ * Lleva lo que el motor ya tenía a mano al escribir, para que un observador pueda
+ * actualizar su copia sin volver a leer la persona.
+ */
+struct EscrituraPersona {
+    /** @brief Datos personales tal como quedaron guardados */
+    const Persona& persona;
+    /** @brief true si la escritura dio de alta a la persona; false si le agregó una cuenta */
+    bool nuevaPersona;
+    /** @brief Cuenta que quedó al final del arreglo cuentas, o nullptr si no se agregó ninguna */
+    const bsoncxx::document::view* cuentaAgregada;
+
+    /**
+     * @brief Documento de la persona después de esta escritura
+     * Si el documento previo ya contiene la cuenta agregada (porque se leyó después de
+     * la escritura) se devuelve sin cambios, de modo que aplicar la escritura dos veces
+     * no duplica la cuenta.
+     * @param anterior Documento previo de la persona, o nullptr si no se conoce
+     * @return El documento resultante, o std::nullopt si la escritura agregó una cuenta a
+     *         una persona cuyo documento previo no se conoce (hay que releerla)
+     */
+    std::optional<bsoncxx::document::value> documentoResultante(const bsoncxx::document::view* anterior) const;
+};
+
+/**
+ * @interface IRepositorioBanco
+ * @brief Contrato de almacenamiento de personas y cuentas usado por la capa de negocio
+ *
+ * Aplicando DIP: Banco, BancoManejoCuenta, CreadorCuentas, BuscadorCuentas y
+ * ValidadorBaseDatos dependen de esta abstracción y no del motor concreto.
+ * Los documentos devueltos tienen la misma forma en todos los motores.
+ */
+class IRepositorioBanco {
+public:
+    virtual ~IRepositorioBanco() = default;
+
+#pragma region === OBSERVADORES DE ESCRITURA ===
+    /**
+     * @brief Registra una función que se invoca tras cada escritura confirmada de una persona
+     *
+     * Todos los motores la llaman con los datos tal como quedaron guardados después de
+     * insertarNuevaPersona, insertarPersona y agregarCuentaPersona, en el hilo que hizo la
+     * escritura y sin bloqueos del motor tomados, de modo que el observador puede consultar
+     * el repositorio. Sirve a los índices en memoria de larga vida.
+     * @param observador Función a invocar
+     * @return int Identificador para eliminarObservadorPersonas
+     */
+    static int registrarObservadorPersonas(std::function<void(const EscrituraPersona&)> observador) {
+        std::lock_guard<std::mutex> lock(mutexObservadores);
+        int id = siguienteIdObservador++;
+        observadoresPersonas.emplace_back(id, std::move(observador));
+        return id;
+    }
+
+    /**
+     * @brief Deja de notificar al observador indicado
+     */
+    static void eliminarObservadorPersonas(int id) {
+        std::lock_guard<std::mutex> lock(mutexObservadores);
+        observadoresPersonas.erase(std::remove_if(observadoresPersonas.begin(), observadoresPersonas.end(),
+            [id](const auto& par) { return par.first == id; }), observadoresPersonas.end());
+    }
+#pragma endregion
+
+#pragma region === OPERACIONES DE PERSONA ===
+    virtual bool insertarNuevaPersona(const Persona& persona) = 0;
+    virtual bool insertarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial = nullptr) = 0;
+    virtual bool existePersonaPorCedula(const std::string& cedula) = 0;
+    virtual Persona* obtenerPersonaPorCedula(const std::string& cedula) = 0;
+    virtual bool agregarCuentaPersona(const std::string& cedula, const bsoncxx::document::value& cuentaDoc) = 0;
+    virtual std::vector<bsoncxx::document::value> buscarPersonasPorCriterio(const std::string& criterio, const std::string& valor) = 0;
+    virtual std::vector<bsoncxx::document::value> buscarCuentasPorRangoFechas(const std::string& fechaInicio) = 0;
+    virtual bsoncxx::document::value buscarPersonaCompletaPorCedula(const std::string& cedula) = 0;
+#pragma endregion
+
+#pragma region === OPERACIONES BANCARIAS ===
+    virtual bool depositarEnCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante = nullptr) = 0;
+    virtual bool retirarDeCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante = nullptr) = 0;
+    virtual double obtenerSaldoCuenta(const std::string& numeroCuenta) = 0;
+    virtual bool verificarFondosSuficientes(const std::string& numeroCuenta, double monto) = 0;
+    virtual bool realizarTransferencia(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto) = 0;
+    virtual std::vector<ResultadoTransferencia> realizarTransferenciasLote(const std::vector<Transferencia>& transferencias) = 0;
+    virtual bsoncxx::document::value obtenerInformacionCuenta(const std::string& numeroCuenta) = 0;
+    virtual std::string obtenerCedulaPorNumeroCuenta(const std::string& numeroCuenta) = 0;
+    virtual bool existenPersonasEnBaseDatos() = 0;
+    virtual long obtenerTotalPersonasRegistradas() = 0;
+    virtual bool existenCuentasEnBaseDatos() = 0;
+    virtual long obtenerTotalCuentasRegistradas() = 0;
+    virtual std::vector<bsoncxx::document::value> mostrarTodasPersonas() = 0;
+
+    /**
+     * @brief Contador persistente que aumenta con cada escritura de persona
+     *
+     * Mientras no cambie, cualquier estructura derivada de las personas (p. ej. una
+     * instantánea de árbol en disco) sigue vigente.
+     * @return Valor actual, o 0 si el motor no conserva un contador entre ejecuciones
+     */
+    virtual uint64_t obtenerContadorCambiosPersonas() = 0;
+#pragma endregion
+
+#pragma region === SECUENCIALES ===
+    virtual int obtenerUltimoSecuencial(const std::string& sucursal) = 0;
+    virtual bool actualizarSecuencial(const std::string& sucursal, int nuevoSecuencial) = 0;
+    virtual int obtenerMayorNumeroCuentaPorSucursal(const std::string& sucursal) = 0;
+
+    /**
+     * @brief Reserva atómicamente un bloque de secuenciales consecutivos para una sucursal
+     *
+     * Si la sucursal aún no tiene contador, se inicializa una única vez con el mayor
+     * secuencial existente en sus cuentas.
+     * @param sucursal Código de sucursal
+     * @param tamanoBloque Cantidad de secuenciales a reservar
+     * @param primero Salida con el primer secuencial del bloque reservado
+     * @return true si se reservó el bloque, false en caso de error
+     */
+    virtual bool reservarBloqueSecuencial(const std::string& sucursal, int tamanoBloque, int& primero) = 0;
+#pragma endregion
+
+#pragma region === UTILIDADES ===
+    /**
+     * @brief Valida que el monto sea un número válido, positivo y dentro del límite por operación
+     * @param monto Monto a validar
+     * @return true si el monto es válido, false en caso contrario
+     */
+    bool validarMonto(double monto) const {
+        return monto > 0.0 && monto <= 15000.00 && !std::isnan(monto) && !std::isinf(monto);
+    }
+
+    /**
+     * @brief Redondea un monto a 2 decimales para operaciones monetarias
+     * @param monto Monto a redondear
+     * @return Monto redondeado a 2 decimales
+     */
+    double redondearMonto(double monto) const {
+        return std::round(monto * 100.0) / 100.0;
+    }
+
+    /**
+     * @brief Convierte una fecha DD/MM/AAAA a b_date (medianoche UTC)
+     *
+     * Las fechas se guardan también como b_date (fechaAperturaDate, fechaNacimientoDate)
+     * para que los rangos se comparen cronológicamente y puedan usar un índice; la
+     * cadena DD/MM/AAAA se conserva para presentación.
+     * @param fecha Fecha en formato DD/MM/AAAA
+     * @param resultado Salida con la fecha convertida
+     * @return true si la cadena es una fecha válida, false en caso contrario
+     */
+    static bool convertirFechaABsonDate(const std::string& fecha, bsoncxx::types::b_date& resultado) {
+        if (fecha.size() != 10 || fecha[2] != '/' || fecha[5] != '/') {
+            return false;
+        }
+        for (int i : { 0, 1, 3, 4, 6, 7, 8, 9 }) {
+            if (fecha[i] < '0' || fecha[i] > '9') {
+                return false;
+            }
+        }
+        int dia = (fecha[0] - '0') * 10 + (fecha[1] - '0');
+        int mes = (fecha[3] - '0') * 10 + (fecha[4] - '0');
+        int anio = (fecha[6] - '0') * 1000 + (fecha[7] - '0') * 100 + (fecha[8] - '0') * 10 + (fecha[9] - '0');
+        if (mes < 1 || mes > 12 || dia < 1) {
+            return false;
+        }
+        // Sin esta verificación 31/02 o 29/02 de un año no bisiesto pasarían a marzo
+        static const int diasPorMes[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        bool bisiesto = (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+        int diasMes = (mes == 2 && bisiesto) ? 29 : diasPorMes[mes - 1];
+        if (dia > diasMes) {
+            return false;
+        }
+
+        // Días desde 1970-01-01 en el calendario gregoriano proléptico (sin zona horaria)
+        int a = anio - (mes <= 2 ? 1 : 0);
+        int era = (a >= 0 ? a : a - 399) / 400;
+        int anioEra = a - era * 400;
+        int diaAnio = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+        int diaEra = anioEra * 365 + anioEra / 4 - anioEra / 100 + diaAnio;
+        int64_t dias = static_cast<int64_t>(era) * 146097 + diaEra - 719468;
+
+        resultado = bsoncxx::types::b_date{ std::chrono::milliseconds{ dias * 86400000LL } };
+        return true;
+    }
+#pragma endregion
+
+protected:
+    /**
+     * @brief Entrega a los observadores los datos de una persona recién escrita
+     *
+     * Notifica fuera del mutex, sobre una copia de la lista, para que un observador pueda
+     * registrar o eliminar observadores sin bloquearse.
+     */
+    static void notificarPersonaEscrita(const EscrituraPersona& escritura) {
+        std::vector<std::pair<int, std::function<void(const EscrituraPersona&)>>> copia;
+        {
+            std::lock_guard<std::mutex> lock(mutexObservadores);
+            if (observadoresPersonas.empty()) return;
+            copia = observadoresPersonas;
+        }
+        for (auto& par : copia) {
+            try {
+                par.second(escritura);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "Error al notificar escritura de persona: " << e.what() << std::endl;
+            }
+        }
+    }
+
+private:
+    inline static std::vector<std::pair<int, std::function<void(const EscrituraPersona&)>>> observadoresPersonas;
+    inline static std::mutex mutexObservadores;
+    inline static int siguienteIdObservador = 1;
+};
+
+#endif // IREPOSITORIOBANCO_H
@@ -0,0 +1,74 @@
+#pragma once
+#ifndef IDENTIFICADORFIJO_H
+#define IDENTIFICADORFIJO_H
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstring>
+#include <cstddef>
+
+/**
+ * @class IdentificadorFijo
+ * @brief Texto de como máximo N caracteres guardado en línea, sin memoria dinámica
+ *
+ * Para identificadores de longitud conocida (números de cuenta de 10 dígitos): ocupa
+ * exactamente N bytes, rellenos con '\0' tras el último carácter, y se compara con
+ * memcmp sobre esos N bytes en lugar de comparar std::string.
+ */
+template<size_t N>
+class IdentificadorFijo {
+private:
+    char caracteres[N];
+
+public:
+    IdentificadorFijo() { std::memset(caracteres, 0, N); }
+
+    /**
+     * @brief Guarda el texto indicado
+     * @return false si tiene más de N caracteres; en ese caso queda vacío
+     */
+    bool asignar(std::string_view texto) {
+        std::memset(caracteres, 0, N);
+        if (texto.size() > N) {
+            return false;
+        }
+        std::memcpy(caracteres, texto.data(), texto.size());
+        return true;
+    }
+
+    void limpiar() { std::memset(caracteres, 0, N); }
+
+    size_t longitud() const {
+        const void* fin = std::memchr(caracteres, '\0', N);
+        return fin ? static_cast<size_t>(static_cast<const char*>(fin) - caracteres) : N;
+    }
+
+    bool vacio() const { return caracteres[0] == '\0'; }
+
+    /**
+     * @brief Vista del texto; válida mientras el identificador no cambie ni se mueva
+     */
+    std::string_view vista() const { return std::string_view(caracteres, longitud()); }
+    std::string texto() const { return std::string(vista()); }
+
+    bool operator==(const IdentificadorFijo& otro) const { return std::memcmp(caracteres, otro.caracteres, N) == 0; }
+    bool operator!=(const IdentificadorFijo& otro) const { return !(*this == otro); }
+    bool operator<(const IdentificadorFijo& otro) const { return std::memcmp(caracteres, otro.caracteres, N) < 0; }
+
+    /**
+     * @brief Hash sobre los N bytes, para usarlo como clave de unordered_map
+     */
+    struct Hash {
+        size_t operator()(const IdentificadorFijo& id) const {
+            return std::hash<std::string_view>()(std::string_view(id.caracteres, N));
+        }
+    };
+};
+
+/**
+ * @brief Número de cuenta: 10 dígitos (ver Validar::ValidarNumeroCuenta)
+ */
+using NumeroCuenta = IdentificadorFijo<10>;
+
+#endif // IDENTIFICADORFIJO_H
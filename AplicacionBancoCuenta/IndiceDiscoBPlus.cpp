@@ -0,0 +1,791 @@
+/**
+ * @file IndiceDiscoBPlus.cpp
+ * @brief Implementación del árbol B+ paginado en disco con pool LRU y WAL
+ */
+#include "IndiceDiscoBPlus.h"
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	const char FIRMA_INDICE[8] = { 'B', 'P', 'L', 'U', 'S', 'I', 'D', 'X' };
+	const char FIRMA_WAL[8] = { 'B', 'P', 'L', 'U', 'S', 'W', 'A', 'L' };
+	const char FIRMA_FIN_WAL[8] = { 'C', 'O', 'N', 'F', 'I', 'R', 'M', 'A' };
+
+	bool posicionar(std::FILE* archivo, uint64_t desplazamiento) {
+#ifdef _WIN32
+		return _fseeki64(archivo, static_cast<long long>(desplazamiento), SEEK_SET) == 0;
+#else
+		return fseeko(archivo, static_cast<off_t>(desplazamiento), SEEK_SET) == 0;
+#endif
+	}
+
+	uint64_t tamanoArchivo(std::FILE* archivo) {
+		std::fflush(archivo);
+#ifdef _WIN32
+		_fseeki64(archivo, 0, SEEK_END);
+		long long tamano = _ftelli64(archivo);
+#else
+		fseeko(archivo, 0, SEEK_END);
+		long long tamano = static_cast<long long>(ftello(archivo));
+#endif
+		return tamano > 0 ? static_cast<uint64_t>(tamano) : 0;
+	}
+
+	/**
+	 * @brief Vacía el búfer de C y fuerza el archivo a disco
+	 */
+	bool forzarADisco(std::FILE* archivo) {
+		if (std::fflush(archivo) != 0) {
+			return false;
+		}
+#ifdef _WIN32
+		return _commit(_fileno(archivo)) == 0;
+#else
+		return fsync(fileno(archivo)) == 0;
+#endif
+	}
+
+	bool reemplazarArchivo(const std::string& origen, const std::string& destino) {
+#ifdef _WIN32
+		return MoveFileExA(origen.c_str(), destino.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		return std::rename(origen.c_str(), destino.c_str()) == 0;
+#endif
+	}
+
+	/**
+	 * @brief Tramo [inicio, fin) del grupo indicado al repartir total elementos en partes casi iguales
+	 */
+	std::pair<size_t, size_t> limitesGrupo(size_t total, size_t grupos, size_t grupo) {
+		size_t base = total / grupos;
+		size_t resto = total % grupos;
+		size_t inicio = grupo * base + (std::min)(grupo, resto);
+		return { inicio, inicio + base + (grupo < resto ? 1 : 0) };
+	}
+}
+
+IndiceDiscoBPlus::IndiceDiscoBPlus()
+	: archivo(nullptr), mapeo(nullptr), tamanoMapeado(0), manejadorMapeo(nullptr),
+	capacidadMarcos(MARCOS_POR_DEFECTO), marcosSucios(0) {
+	static_assert(sizeof(NodoDisco) <= TAMANO_PAGINA, "El nodo debe caber en una página");
+	static_assert(sizeof(CabeceraArchivo) <= TAMANO_PAGINA, "La cabecera debe caber en una página");
+}
+
+IndiceDiscoBPlus::~IndiceDiscoBPlus() {
+	cerrar();
+}
+
+// ===== CLAVES =====
+
+bool IndiceDiscoBPlus::convertirClave(const std::string& texto, ClaveDisco& clave) {
+	if (texto.size() > static_cast<size_t>(LONGITUD_CLAVE)) {
+		return false;
+	}
+	// Relleno con ceros: memcmp ordena igual que la comparación de std::string
+	std::memset(clave.bytes, 0, sizeof(clave.bytes));
+	std::memcpy(clave.bytes, texto.data(), texto.size());
+	return true;
+}
+
+std::string IndiceDiscoBPlus::textoClave(const ClaveDisco& clave) {
+	size_t longitud = 0;
+	while (longitud < static_cast<size_t>(LONGITUD_CLAVE) && clave.bytes[longitud] != '\0') {
+		longitud++;
+	}
+	return std::string(clave.bytes, longitud);
+}
+
+int IndiceDiscoBPlus::compararClaves(const ClaveDisco& a, const ClaveDisco& b) {
+	return std::memcmp(a.bytes, b.bytes, sizeof(a.bytes));
+}
+
+/**
+ * @brief FNV-1a de 32 bits; detecta páginas del WAL escritas a medias
+ */
+uint32_t IndiceDiscoBPlus::sumaVerificacion(const unsigned char* datos, size_t longitud) {
+	uint32_t suma = 2166136261u;
+	for (size_t i = 0; i < longitud; ++i) {
+		suma ^= datos[i];
+		suma *= 16777619u;
+	}
+	return suma;
+}
+
+void IndiceDiscoBPlus::inicializarCabecera(CabeceraArchivo& cabecera) {
+	std::memset(&cabecera, 0, sizeof(cabecera));
+	std::memcpy(cabecera.firma, FIRMA_INDICE, sizeof(cabecera.firma));
+	cabecera.version = VERSION_FORMATO;
+	cabecera.tamanoPagina = TAMANO_PAGINA;
+	cabecera.longitudClave = LONGITUD_CLAVE;
+	cabecera.raiz = SIN_PAGINA;
+	cabecera.totalPaginas = 1;
+}
+
+// ===== ARCHIVO Y PROYECCIÓN =====
+
+bool IndiceDiscoBPlus::proyectar() {
+	liberarProyeccion();
+	uint64_t tamano = tamanoArchivo(archivo);
+	if (tamano == 0) {
+		return true;
+	}
+
+#ifdef _WIN32
+	HANDLE manejadorArchivo = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(archivo)));
+	HANDLE proyeccion = CreateFileMappingA(manejadorArchivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!proyeccion) {
+		return false;
+	}
+	void* vista = MapViewOfFile(proyeccion, FILE_MAP_READ, 0, 0, 0);
+	if (!vista) {
+		CloseHandle(proyeccion);
+		return false;
+	}
+	manejadorMapeo = proyeccion;
+#else
+	void* vista = mmap(nullptr, static_cast<size_t>(tamano), PROT_READ, MAP_SHARED, fileno(archivo), 0);
+	if (vista == MAP_FAILED) {
+		return false;
+	}
+#endif
+	mapeo = static_cast<const unsigned char*>(vista);
+	tamanoMapeado = static_cast<size_t>(tamano);
+	return true;
+}
+
+void IndiceDiscoBPlus::liberarProyeccion() {
+	if (!mapeo) {
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(mapeo);
+	CloseHandle(manejadorMapeo);
+#else
+	munmap(const_cast<unsigned char*>(mapeo), tamanoMapeado);
+#endif
+	mapeo = nullptr;
+	manejadorMapeo = nullptr;
+	tamanoMapeado = 0;
+}
+
+bool IndiceDiscoBPlus::escribirPaginaArchivo(std::FILE* destino, uint32_t numero, const unsigned char* datos) {
+	return posicionar(destino, static_cast<uint64_t>(numero) * TAMANO_PAGINA) &&
+		std::fwrite(datos, 1, TAMANO_PAGINA, destino) == TAMANO_PAGINA;
+}
+
+/**
+ * @brief Aplica un WAL completo al índice o descarta uno incompleto
+ *
+ * Un WAL solo se aplica si todas sus páginas superan la suma de verificación y tiene
+ * el registro final: en ese caso el índice puede haber quedado a medio sobrescribir y
+ * se rehace. Si el registro final falta, la confirmación no llegó a tocar el índice.
+ */
+bool IndiceDiscoBPlus::recuperarWAL() {
+	std::FILE* wal = std::fopen(rutaWAL.c_str(), "rb");
+	if (!wal) {
+		return true;
+	}
+
+	std::vector<std::pair<uint32_t, std::unique_ptr<Pagina>>> paginas;
+	bool completo = false;
+	char firma[8];
+	uint32_t cantidad = 0;
+	if (std::fread(firma, 1, sizeof(firma), wal) == sizeof(firma) &&
+		std::memcmp(firma, FIRMA_WAL, sizeof(firma)) == 0 &&
+		std::fread(&cantidad, sizeof(cantidad), 1, wal) == 1) {
+
+		bool valido = true;
+		for (uint32_t i = 0; i < cantidad && valido; ++i) {
+			uint32_t numero = 0;
+			uint32_t suma = 0;
+			auto pagina = std::make_unique<Pagina>();
+			valido = std::fread(&numero, sizeof(numero), 1, wal) == 1 &&
+				std::fread(&suma, sizeof(suma), 1, wal) == 1 &&
+				std::fread(pagina->datos, 1, TAMANO_PAGINA, wal) == TAMANO_PAGINA &&
+				sumaVerificacion(pagina->datos, TAMANO_PAGINA) == suma;
+			paginas.emplace_back(numero, std::move(pagina));
+		}
+
+		uint32_t cantidadFinal = 0;
+		completo = valido &&
+			std::fread(firma, 1, sizeof(firma), wal) == sizeof(firma) &&
+			std::memcmp(firma, FIRMA_FIN_WAL, sizeof(firma)) == 0 &&
+			std::fread(&cantidadFinal, sizeof(cantidadFinal), 1, wal) == 1 &&
+			cantidadFinal == cantidad;
+	}
+	std::fclose(wal);
+
+	if (completo) {
+		for (const auto& par : paginas) {
+			if (!escribirPaginaArchivo(archivo, par.first, par.second->datos)) {
+				std::cerr << "Error: No se pudo rehacer el WAL en " << rutaIndice << std::endl;
+				return false;
+			}
+		}
+		if (!forzarADisco(archivo)) {
+			std::cerr << "Error: No se pudo forzar a disco el índice " << rutaIndice << std::endl;
+			return false;
+		}
+	}
+	std::remove(rutaWAL.c_str());
+	return true;
+}
+
+bool IndiceDiscoBPlus::abrir(const std::string& ruta) {
+	cerrar();
+	std::lock_guard<std::mutex> lock(mutexIndice);
+
+	rutaIndice = ruta;
+	rutaWAL = ruta + ".wal";
+	archivo = std::fopen(ruta.c_str(), "r+b");
+	if (!archivo) {
+		archivo = std::fopen(ruta.c_str(), "w+b");
+	}
+	if (!archivo) {
+		std::cerr << "Error: No se pudo abrir el índice " << ruta << std::endl;
+		return false;
+	}
+
+	if (!recuperarWAL() || !proyectar()) {
+		std::cerr << "Error: No se pudo preparar el índice " << ruta << std::endl;
+		std::fclose(archivo);
+		archivo = nullptr;
+		return false;
+	}
+
+	if (tamanoMapeado < TAMANO_PAGINA) {
+		// Archivo nuevo: la cabecera se confirma de inmediato
+		inicializarCabecera(*cabeceraModificable());
+		return confirmarSinBloqueo();
+	}
+
+	const CabeceraArchivo* actual = cabecera();
+	if (std::memcmp(actual->firma, FIRMA_INDICE, sizeof(actual->firma)) != 0 ||
+		actual->version != VERSION_FORMATO ||
+		actual->tamanoPagina != TAMANO_PAGINA ||
+		actual->longitudClave != LONGITUD_CLAVE) {
+		std::cerr << "Error: Formato de índice no reconocido en " << ruta << std::endl;
+		liberarProyeccion();
+		std::fclose(archivo);
+		archivo = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void IndiceDiscoBPlus::cerrar() {
+	std::lock_guard<std::mutex> lock(mutexIndice);
+	if (!archivo) {
+		return;
+	}
+	confirmarSinBloqueo();
+	liberarProyeccion();
+	std::fclose(archivo);
+	archivo = nullptr;
+	marcos.clear();
+	ordenLRU.clear();
+	marcosSucios = 0;
+}
+
+// ===== POOL DE PÁGINAS =====
+
+void IndiceDiscoBPlus::tocarLRU(Marco& marco) {
+	ordenLRU.splice(ordenLRU.begin(), ordenLRU, marco.posicionLRU);
+}
+
+const unsigned char* IndiceDiscoBPlus::leerPagina(uint32_t numero) {
+	auto marco = marcos.find(numero);
+	if (marco != marcos.end()) {
+		tocarLRU(marco->second);
+		return marco->second.pagina->datos;
+	}
+	uint64_t fin = (static_cast<uint64_t>(numero) + 1) * TAMANO_PAGINA;
+	if (mapeo && fin <= tamanoMapeado) {
+		return mapeo + static_cast<size_t>(numero) * TAMANO_PAGINA;
+	}
+	return nullptr;
+}
+
+unsigned char* IndiceDiscoBPlus::modificarPagina(uint32_t numero) {
+	auto marco = marcos.find(numero);
+	if (marco == marcos.end()) {
+		Marco nuevo;
+		nuevo.pagina = std::make_unique<Pagina>();
+		uint64_t fin = (static_cast<uint64_t>(numero) + 1) * TAMANO_PAGINA;
+		if (mapeo && fin <= tamanoMapeado) {
+			std::memcpy(nuevo.pagina->datos, mapeo + static_cast<size_t>(numero) * TAMANO_PAGINA, TAMANO_PAGINA);
+		}
+		else {
+			std::memset(nuevo.pagina->datos, 0, TAMANO_PAGINA);
+		}
+		ordenLRU.push_front(numero);
+		nuevo.posicionLRU = ordenLRU.begin();
+		marco = marcos.emplace(numero, std::move(nuevo)).first;
+	}
+	else {
+		tocarLRU(marco->second);
+	}
+
+	if (!marco->second.sucia) {
+		marco->second.sucia = true;
+		marcosSucios++;
+	}
+	desalojarLimpios();
+	return marco->second.pagina->datos;
+}
+
+/**
+ * @brief Desaloja marcos limpios desde el menos usado hasta volver a la capacidad
+ *
+ * Los marcos sucios nunca se desalojan: sus punteros siguen siendo válidos durante
+ * toda una inserción aunque esta toque varias páginas.
+ */
+void IndiceDiscoBPlus::desalojarLimpios() {
+	auto posicion = ordenLRU.end();
+	while (marcos.size() > capacidadMarcos && posicion != ordenLRU.begin()) {
+		--posicion;
+		auto marco = marcos.find(*posicion);
+		if (marco->second.sucia) {
+			continue;
+		}
+		marcos.erase(marco);
+		posicion = ordenLRU.erase(posicion);
+	}
+}
+
+uint32_t IndiceDiscoBPlus::nuevaPagina(bool hoja) {
+	uint32_t numero = cabeceraModificable()->totalPaginas++;
+	NodoDisco* nodo = reinterpret_cast<NodoDisco*>(modificarPagina(numero));
+	std::memset(nodo, 0, TAMANO_PAGINA);
+	nodo->cabecera.esHoja = hoja ? 1 : 0;
+	return numero;
+}
+
+// ===== CONFIRMACIÓN =====
+
+bool IndiceDiscoBPlus::confirmar() {
+	std::lock_guard<std::mutex> lock(mutexIndice);
+	return archivo && confirmarSinBloqueo();
+}
+
+bool IndiceDiscoBPlus::confirmarSinBloqueo() {
+	if (marcosSucios == 0) {
+		return true;
+	}
+
+	std::vector<uint32_t> sucias;
+	sucias.reserve(marcosSucios);
+	for (const auto& par : marcos) {
+		if (par.second.sucia) {
+			sucias.push_back(par.first);
+		}
+	}
+	std::sort(sucias.begin(), sucias.end());
+
+	// 1. Imágenes completas de las páginas al WAL, forzado a disco
+	std::FILE* wal = std::fopen(rutaWAL.c_str(), "wb");
+	if (!wal) {
+		std::cerr << "Error: No se pudo crear el WAL " << rutaWAL << std::endl;
+		return false;
+	}
+	uint32_t cantidad = static_cast<uint32_t>(sucias.size());
+	bool escrito = std::fwrite(FIRMA_WAL, 1, sizeof(FIRMA_WAL), wal) == sizeof(FIRMA_WAL) &&
+		std::fwrite(&cantidad, sizeof(cantidad), 1, wal) == 1;
+	for (size_t i = 0; i < sucias.size() && escrito; ++i) {
+		const unsigned char* datos = marcos[sucias[i]].pagina->datos;
+		uint32_t suma = sumaVerificacion(datos, TAMANO_PAGINA);
+		escrito = std::fwrite(&sucias[i], sizeof(uint32_t), 1, wal) == 1 &&
+			std::fwrite(&suma, sizeof(suma), 1, wal) == 1 &&
+			std::fwrite(datos, 1, TAMANO_PAGINA, wal) == TAMANO_PAGINA;
+	}
+	escrito = escrito &&
+		std::fwrite(FIRMA_FIN_WAL, 1, sizeof(FIRMA_FIN_WAL), wal) == sizeof(FIRMA_FIN_WAL) &&
+		std::fwrite(&cantidad, sizeof(cantidad), 1, wal) == 1 &&
+		forzarADisco(wal);
+	std::fclose(wal);
+	if (!escrito) {
+		std::cerr << "Error: No se pudo escribir el WAL " << rutaWAL << std::endl;
+		std::remove(rutaWAL.c_str());
+		return false;
+	}
+
+	// 2. Las mismas páginas en su lugar dentro del índice
+	for (uint32_t numero : sucias) {
+		if (!escribirPaginaArchivo(archivo, numero, marcos[numero].pagina->datos)) {
+			std::cerr << "Error: No se pudo escribir la página " << numero << " de " << rutaIndice << std::endl;
+			return false;  // El WAL queda y abrir() lo rehará
+		}
+	}
+	if (!forzarADisco(archivo)) {
+		std::cerr << "Error: No se pudo forzar a disco el índice " << rutaIndice << std::endl;
+		return false;
+	}
+
+	// 3. El índice ya es duradero: el WAL sobra
+	std::remove(rutaWAL.c_str());
+	for (uint32_t numero : sucias) {
+		marcos[numero].sucia = false;
+	}
+	marcosSucios = 0;
+
+	if (tamanoArchivo(archivo) > tamanoMapeado && !proyectar()) {
+		std::cerr << "Error: No se pudo proyectar el índice " << rutaIndice << std::endl;
+		return false;
+	}
+	desalojarLimpios();
+	return true;
+}
+
+// ===== CONSULTAS =====
+
+/**
+ * @brief Desciende hasta la hoja donde está (o estaría) la clave
+ *
+ * En cada nodo interno sigue al hijo del último separador <= clave.
+ */
+uint32_t IndiceDiscoBPlus::buscarHoja(const ClaveDisco& clave) {
+	uint32_t pagina = cabecera()->raiz;
+	while (pagina != SIN_PAGINA) {
+		const NodoDisco* nodo = reinterpret_cast<const NodoDisco*>(leerPagina(pagina));
+		if (!nodo) {
+			std::cerr << "Error: Página " << pagina << " fuera del índice " << rutaIndice << std::endl;
+			return SIN_PAGINA;
+		}
+		if (nodo->cabecera.esHoja) {
+			return pagina;
+		}
+		const EntradaInterna* inicio = nodo->internas;
+		const EntradaInterna* fin = inicio + nodo->cabecera.numClaves;
+		const EntradaInterna* siguiente = std::upper_bound(inicio, fin, clave,
+			[](const ClaveDisco& c, const EntradaInterna& e) { return compararClaves(c, e.clave) < 0; });
+		pagina = siguiente == inicio ? nodo->cabecera.primerHijo : (siguiente - 1)->hijo;
+	}
+	return SIN_PAGINA;
+}
+
+bool IndiceDiscoBPlus::buscar(const std::string& clave, uint64_t& valor) {
+	ClaveDisco buscada;
+	if (!convertirClave(clave, buscada)) {
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(mutexIndice);
+	if (!archivo) {
+		return false;
+	}
+
+	uint32_t pagina = buscarHoja(buscada);
+	if (pagina == SIN_PAGINA) {
+		return false;
+	}
+	const NodoDisco* hoja = reinterpret_cast<const NodoDisco*>(leerPagina(pagina));
+	const EntradaHoja* inicio = hoja->hojas;
+	const EntradaHoja* fin = inicio + hoja->cabecera.numClaves;
+	const EntradaHoja* posicion = std::lower_bound(inicio, fin, buscada,
+		[](const EntradaHoja& e, const ClaveDisco& c) { return compararClaves(e.clave, c) < 0; });
+	if (posicion == fin || compararClaves(posicion->clave, buscada) != 0) {
+		return false;
+	}
+	valor = posicion->valor;
+	return true;
+}
+
+std::vector<std::pair<std::string, uint64_t>> IndiceDiscoBPlus::rango(const std::string& desde, const std::string& hasta) {
+	std::vector<std::pair<std::string, uint64_t>> resultados;
+	ClaveDisco claveDesde;
+	ClaveDisco claveHasta;
+	if (!convertirClave(desde, claveDesde) || !convertirClave(hasta, claveHasta)) {
+		return resultados;
+	}
+	std::lock_guard<std::mutex> lock(mutexIndice);
+	if (!archivo) {
+		return resultados;
+	}
+
+	uint32_t pagina = buscarHoja(claveDesde);
+	bool primera = true;
+	while (pagina != SIN_PAGINA) {
+		const NodoDisco* hoja = reinterpret_cast<const NodoDisco*>(leerPagina(pagina));
+		if (!hoja) {
+			break;
+		}
+		const EntradaHoja* inicio = hoja->hojas;
+		const EntradaHoja* fin = inicio + hoja->cabecera.numClaves;
+		if (primera) {
+			inicio = std::lower_bound(inicio, fin, claveDesde,
+				[](const EntradaHoja& e, const ClaveDisco& c) { return compararClaves(e.clave, c) < 0; });
+			primera = false;
+		}
+		for (const EntradaHoja* entrada = inicio; entrada != fin; ++entrada) {
+			if (compararClaves(entrada->clave, claveHasta) > 0) {
+				return resultados;
+			}
+			resultados.emplace_back(textoClave(entrada->clave), entrada->valor);
+		}
+		pagina = hoja->cabecera.siguiente;
+	}
+	return resultados;
+}
+
+uint64_t IndiceDiscoBPlus::totalClaves() {
+	std::lock_guard<std::mutex> lock(mutexIndice);
+	return archivo ? cabecera()->totalClaves : 0;
+}
+
+// ===== MODIFICACIONES =====
+
+/**
+ * @brief Inserta en el subárbol de la página; si el nodo se divide informa separador y hermano
+ * @return true si el nodo se dividió
+ */
+bool IndiceDiscoBPlus::insertarEnNodo(uint32_t pagina, const ClaveDisco& clave, uint64_t valor, DivisionDisco& division, bool& nueva) {
+	const NodoDisco* lectura = reinterpret_cast<const NodoDisco*>(leerPagina(pagina));
+	if (!lectura) {
+		std::cerr << "Error: Página " << pagina << " fuera del índice " << rutaIndice << std::endl;
+		return false;
+	}
+
+	if (lectura->cabecera.esHoja) {
+		NodoDisco* hoja = reinterpret_cast<NodoDisco*>(modificarPagina(pagina));
+		int n = hoja->cabecera.numClaves;
+		EntradaHoja* inicio = hoja->hojas;
+		EntradaHoja* posicion = std::lower_bound(inicio, inicio + n, clave,
+			[](const EntradaHoja& e, const ClaveDisco& c) { return compararClaves(e.clave, c) < 0; });
+		int indice = static_cast<int>(posicion - inicio);
+
+		if (indice < n && compararClaves(posicion->clave, clave) == 0) {
+			posicion->valor = valor;
+			nueva = false;
+			return false;
+		}
+		nueva = true;
+
+		if (n < MAX_HOJA) {
+			std::memmove(posicion + 1, posicion, static_cast<size_t>(n - indice) * sizeof(EntradaHoja));
+			*posicion = EntradaHoja{ clave, valor };
+			hoja->cabecera.numClaves++;
+			return false;
+		}
+
+		// Hoja llena: repartir n + 1 entradas entre la hoja y una vecina derecha nueva
+		std::vector<EntradaHoja> todas(inicio, inicio + n);
+		todas.insert(todas.begin() + indice, EntradaHoja{ clave, valor });
+		int mitad = static_cast<int>(todas.size()) / 2;
+
+		uint32_t derecha = nuevaPagina(true);
+		NodoDisco* nodoDerecho = reinterpret_cast<NodoDisco*>(modificarPagina(derecha));
+		std::copy(todas.begin(), todas.begin() + mitad, hoja->hojas);
+		std::copy(todas.begin() + mitad, todas.end(), nodoDerecho->hojas);
+		hoja->cabecera.numClaves = static_cast<uint16_t>(mitad);
+		nodoDerecho->cabecera.numClaves = static_cast<uint16_t>(todas.size() - mitad);
+
+		nodoDerecho->cabecera.siguiente = hoja->cabecera.siguiente;
+		nodoDerecho->cabecera.anterior = pagina;
+		if (hoja->cabecera.siguiente != SIN_PAGINA) {
+			reinterpret_cast<NodoDisco*>(modificarPagina(hoja->cabecera.siguiente))->cabecera.anterior = derecha;
+		}
+		hoja->cabecera.siguiente = derecha;
+
+		division.separador = nodoDerecho->hojas[0].clave;
+		division.pagina = derecha;
+		return true;
+	}
+
+	// Nodo interno: elegir el hijo antes de descender (la lectura puede invalidarse)
+	const EntradaInterna* inicio = lectura->internas;
+	const EntradaInterna* fin = inicio + lectura->cabecera.numClaves;
+	const EntradaInterna* siguiente = std::upper_bound(inicio, fin, clave,
+		[](const ClaveDisco& c, const EntradaInterna& e) { return compararClaves(c, e.clave) < 0; });
+	int indice = static_cast<int>(siguiente - inicio);
+	uint32_t hijo = indice == 0 ? lectura->cabecera.primerHijo : (siguiente - 1)->hijo;
+
+	DivisionDisco divisionHijo;
+	if (!insertarEnNodo(hijo, clave, valor, divisionHijo, nueva)) {
+		return false;
+	}
+
+	NodoDisco* nodo = reinterpret_cast<NodoDisco*>(modificarPagina(pagina));
+	int n = nodo->cabecera.numClaves;
+	EntradaInterna nuevaEntrada{ divisionHijo.separador, divisionHijo.pagina };
+	if (n < MAX_INTERNO) {
+		std::memmove(nodo->internas + indice + 1, nodo->internas + indice, static_cast<size_t>(n - indice) * sizeof(EntradaInterna));
+		nodo->internas[indice] = nuevaEntrada;
+		nodo->cabecera.numClaves++;
+		return false;
+	}
+
+	// Nodo interno lleno: la entrada central sube como separador y su hijo pasa a ser
+	// el primer hijo del hermano derecho
+	std::vector<EntradaInterna> todas(nodo->internas, nodo->internas + n);
+	todas.insert(todas.begin() + indice, nuevaEntrada);
+	int medio = static_cast<int>(todas.size()) / 2;
+
+	uint32_t derecha = nuevaPagina(false);
+	NodoDisco* nodoDerecho = reinterpret_cast<NodoDisco*>(modificarPagina(derecha));
+	std::copy(todas.begin(), todas.begin() + medio, nodo->internas);
+	nodo->cabecera.numClaves = static_cast<uint16_t>(medio);
+	nodoDerecho->cabecera.primerHijo = todas[medio].hijo;
+	std::copy(todas.begin() + medio + 1, todas.end(), nodoDerecho->internas);
+	nodoDerecho->cabecera.numClaves = static_cast<uint16_t>(todas.size() - medio - 1);
+
+	division.separador = todas[medio].clave;
+	division.pagina = derecha;
+	return true;
+}
+
+bool IndiceDiscoBPlus::insertar(const std::string& clave, uint64_t valor) {
+	ClaveDisco nueva;
+	if (!convertirClave(clave, nueva)) {
+		std::cerr << "Error: La clave '" << clave << "' excede " << LONGITUD_CLAVE << " caracteres" << std::endl;
+		return false;
+	}
+	std::lock_guard<std::mutex> lock(mutexIndice);
+	if (!archivo) {
+		return false;
+	}
+
+	uint32_t raiz = cabecera()->raiz;
+	if (raiz == SIN_PAGINA) {
+		raiz = nuevaPagina(true);
+		CabeceraArchivo* actual = cabeceraModificable();
+		actual->raiz = raiz;
+		actual->altura = 1;
+	}
+
+	DivisionDisco division;
+	bool claveNueva = false;
+	if (insertarEnNodo(raiz, nueva, valor, division, claveNueva)) {
+		uint32_t nuevaRaiz = nuevaPagina(false);
+		NodoDisco* nodo = reinterpret_cast<NodoDisco*>(modificarPagina(nuevaRaiz));
+		nodo->cabecera.primerHijo = raiz;
+		nodo->internas[0] = EntradaInterna{ division.separador, division.pagina };
+		nodo->cabecera.numClaves = 1;
+		CabeceraArchivo* actual = cabeceraModificable();
+		actual->raiz = nuevaRaiz;
+		actual->altura++;
+	}
+	if (claveNueva) {
+		cabeceraModificable()->totalClaves++;
+	}
+
+	if (marcosSucios >= capacidadMarcos) {
+		return confirmarSinBloqueo();
+	}
+	return true;
+}
+
+// ===== CARGA MASIVA =====
+
+bool IndiceDiscoBPlus::construir(const std::vector<std::pair<std::string, uint64_t>>& pares) {
+	std::lock_guard<std::mutex> lock(mutexIndice);
+	if (!archivo) {
+		return false;
+	}
+
+	std::vector<EntradaHoja> entradas(pares.size());
+	for (size_t i = 0; i < pares.size(); ++i) {
+		if (!convertirClave(pares[i].first, entradas[i].clave)) {
+			std::cerr << "Error: La clave '" << pares[i].first << "' excede " << LONGITUD_CLAVE << " caracteres" << std::endl;
+			return false;
+		}
+		if (i > 0 && compararClaves(entradas[i - 1].clave, entradas[i].clave) >= 0) {
+			std::cerr << "Error: Las claves de la carga masiva deben estar ordenadas y sin repetir" << std::endl;
+			return false;
+		}
+		entradas[i].valor = pares[i].second;
+	}
+
+	std::string rutaTemporal = rutaIndice + ".tmp";
+	std::FILE* destino = std::fopen(rutaTemporal.c_str(), "wb");
+	if (!destino) {
+		std::cerr << "Error: No se pudo crear " << rutaTemporal << std::endl;
+		return false;
+	}
+
+	auto pagina = std::make_unique<Pagina>();
+	NodoDisco* nodo = reinterpret_cast<NodoDisco*>(pagina->datos);
+	uint32_t siguientePagina = 1;
+	uint32_t altura = 0;
+	bool escrito = true;
+
+	// Hojas al 90 %: deja espacio para inserciones sin dividir de inmediato
+	std::vector<std::pair<ClaveDisco, uint32_t>> nivel;
+	if (!entradas.empty()) {
+		size_t porHoja = (std::max)(size_t{ 1 }, static_cast<size_t>(MAX_HOJA) * 9 / 10);
+		size_t hojas = (entradas.size() + porHoja - 1) / porHoja;
+		for (size_t h = 0; h < hojas && escrito; ++h) {
+			auto limites = limitesGrupo(entradas.size(), hojas, h);
+			std::memset(pagina->datos, 0, TAMANO_PAGINA);
+			nodo->cabecera.esHoja = 1;
+			nodo->cabecera.numClaves = static_cast<uint16_t>(limites.second - limites.first);
+			nodo->cabecera.anterior = h > 0 ? siguientePagina - 1 : SIN_PAGINA;
+			nodo->cabecera.siguiente = h + 1 < hojas ? siguientePagina + 1 : SIN_PAGINA;
+			std::copy(entradas.begin() + limites.first, entradas.begin() + limites.second, nodo->hojas);
+			nivel.emplace_back(entradas[limites.first].clave, siguientePagina);
+			escrito = escribirPaginaArchivo(destino, siguientePagina++, pagina->datos);
+		}
+		altura = 1;
+	}
+
+	// Niveles internos hasta que quede una sola raíz
+	size_t porNodo = (std::max)(size_t{ 2 }, static_cast<size_t>(MAX_INTERNO + 1) * 9 / 10);
+	while (nivel.size() > 1 && escrito) {
+		size_t nodos = (nivel.size() + porNodo - 1) / porNodo;
+		std::vector<std::pair<ClaveDisco, uint32_t>> superior;
+		for (size_t g = 0; g < nodos && escrito; ++g) {
+			auto limites = limitesGrupo(nivel.size(), nodos, g);
+			std::memset(pagina->datos, 0, TAMANO_PAGINA);
+			nodo->cabecera.primerHijo = nivel[limites.first].second;
+			for (size_t i = limites.first + 1; i < limites.second; ++i) {
+				nodo->internas[i - limites.first - 1] = EntradaInterna{ nivel[i].first, nivel[i].second };
+			}
+			nodo->cabecera.numClaves = static_cast<uint16_t>(limites.second - limites.first - 1);
+			superior.emplace_back(nivel[limites.first].first, siguientePagina);
+			escrito = escribirPaginaArchivo(destino, siguientePagina++, pagina->datos);
+		}
+		nivel = std::move(superior);
+		altura++;
+	}
+
+	std::memset(pagina->datos, 0, TAMANO_PAGINA);
+	CabeceraArchivo* nuevaCabecera = reinterpret_cast<CabeceraArchivo*>(pagina->datos);
+	inicializarCabecera(*nuevaCabecera);
+	nuevaCabecera->raiz = nivel.empty() ? SIN_PAGINA : nivel.front().second;
+	nuevaCabecera->totalPaginas = siguientePagina;
+	nuevaCabecera->altura = altura;
+	nuevaCabecera->totalClaves = entradas.size();
+	escrito = escrito && escribirPaginaArchivo(destino, 0, pagina->datos) && forzarADisco(destino);
+	std::fclose(destino);
+	if (!escrito) {
+		std::cerr << "Error: No se pudo escribir " << rutaTemporal << std::endl;
+		std::remove(rutaTemporal.c_str());
+		return false;
+	}
+
+	// Las modificaciones no confirmadas quedan reemplazadas por la carga
+	liberarProyeccion();
+	std::fclose(archivo);
+	marcos.clear();
+	ordenLRU.clear();
+	marcosSucios = 0;
+	std::remove(rutaWAL.c_str());
+
+	bool reemplazado = reemplazarArchivo(rutaTemporal, rutaIndice);
+	if (!reemplazado) {
+		std::cerr << "Error: No se pudo reemplazar el índice " << rutaIndice << std::endl;
+		std::remove(rutaTemporal.c_str());
+	}
+	archivo = std::fopen(rutaIndice.c_str(), "r+b");
+	if (!archivo || !proyectar()) {
+		std::cerr << "Error: No se pudo reabrir el índice " << rutaIndice << std::endl;
+		return false;
+	}
+	return reemplazado;
+}
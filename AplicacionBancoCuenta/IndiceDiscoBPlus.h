@@ -0,0 +1,214 @@
+#pragma once
+#ifndef INDICEDISCOBPLUS_H
+#define INDICEDISCOBPLUS_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <cstdio>
+#include <cstdint>
+
+/**
+ * @class IndiceDiscoBPlus
+ * @brief Árbol B+ persistente en un archivo de páginas de 4 KiB (clave de texto -> desplazamiento)
+ *
+ * Sigue el diseño de ArbolBPlus: las hojas guardan las claves y los valores y están
+ * enlazadas en ambos sentidos; los nodos internos guardan como separador la clave
+ * mínima de cada hijo derecho. La página 0 es la cabecera del archivo.
+ *
+ * Las lecturas se hacen sobre una proyección en memoria del archivo (sin copias); las
+ * páginas modificadas viven en un pool LRU de marcos hasta confirmar(). Al confirmar,
+ * las imágenes de las páginas sucias se escriben primero en un WAL (archivo .wal) que
+ * se fuerza a disco, y solo después se sobrescriben en el índice. Si el proceso se
+ * interrumpe, abrir() vuelve a aplicar un WAL completo o descarta uno incompleto, de
+ * modo que el archivo nunca queda con una página escrita a medias.
+ *
+ * Las claves son únicas (cédula, número de cuenta): insertar reemplaza el valor de una
+ * clave existente. No hay borrado: las claves solo se agregan o se reemplazan, y
+ * construir() rehace el índice completo.
+ */
+class IndiceDiscoBPlus {
+public:
+    static constexpr uint32_t TAMANO_PAGINA = 4096;
+    static constexpr int LONGITUD_CLAVE = 24;
+
+private:
+    static constexpr uint32_t VERSION_FORMATO = 1;
+    static constexpr uint32_t SIN_PAGINA = 0;       // La página 0 es la cabecera
+    static constexpr size_t MARCOS_POR_DEFECTO = 256;  // 1 MiB de páginas modificables
+
+    struct ClaveDisco {
+        char bytes[LONGITUD_CLAVE];
+    };
+
+    struct EntradaHoja {
+        ClaveDisco clave;
+        uint64_t valor;
+    };
+
+    struct EntradaInterna {
+        ClaveDisco clave;   // Clave mínima del subárbol hijo
+        uint32_t hijo;
+    };
+
+    struct CabeceraNodo {
+        uint16_t esHoja;
+        uint16_t numClaves;
+        uint32_t siguiente;   // Hojas: vecina derecha
+        uint32_t anterior;    // Hojas: vecina izquierda
+        uint32_t primerHijo;  // Internos: hijo con claves menores al primer separador
+    };
+
+    static constexpr int MAX_HOJA = static_cast<int>((TAMANO_PAGINA - sizeof(CabeceraNodo)) / sizeof(EntradaHoja));
+    static constexpr int MAX_INTERNO = static_cast<int>((TAMANO_PAGINA - sizeof(CabeceraNodo)) / sizeof(EntradaInterna));
+
+    struct NodoDisco {
+        CabeceraNodo cabecera;
+        union {
+            EntradaHoja hojas[MAX_HOJA];
+            EntradaInterna internas[MAX_INTERNO];
+        };
+    };
+
+    struct CabeceraArchivo {
+        char firma[8];
+        uint32_t version;
+        uint32_t tamanoPagina;
+        uint32_t longitudClave;
+        uint32_t raiz;
+        uint32_t totalPaginas;
+        uint32_t altura;
+        uint64_t totalClaves;
+    };
+
+    struct alignas(64) Pagina {
+        unsigned char datos[TAMANO_PAGINA];
+    };
+
+    /**
+     * @struct Marco
+     * @brief Página del pool; las sucias no se desalojan hasta confirmar()
+     */
+    struct Marco {
+        std::unique_ptr<Pagina> pagina;
+        bool sucia = false;
+        std::list<uint32_t>::iterator posicionLRU;
+    };
+
+    /**
+     * @brief Resultado de dividir un nodo: separador y página del hermano derecho nuevo
+     */
+    struct DivisionDisco {
+        ClaveDisco separador;
+        uint32_t pagina = SIN_PAGINA;
+    };
+
+    std::string rutaIndice;
+    std::string rutaWAL;
+    std::FILE* archivo;
+
+    // Proyección de solo lectura del archivo confirmado
+    const unsigned char* mapeo;
+    size_t tamanoMapeado;
+    void* manejadorMapeo;
+
+    std::unordered_map<uint32_t, Marco> marcos;
+    std::list<uint32_t> ordenLRU;   // Frente: más reciente
+    size_t capacidadMarcos;
+    size_t marcosSucios;
+
+    mutable std::mutex mutexIndice;
+
+    static bool convertirClave(const std::string& texto, ClaveDisco& clave);
+    static std::string textoClave(const ClaveDisco& clave);
+    static int compararClaves(const ClaveDisco& a, const ClaveDisco& b);
+    static uint32_t sumaVerificacion(const unsigned char* datos, size_t longitud);
+    static void inicializarCabecera(CabeceraArchivo& cabecera);
+
+    bool proyectar();
+    void liberarProyeccion();
+    bool recuperarWAL();
+    bool escribirPaginaArchivo(std::FILE* destino, uint32_t numero, const unsigned char* datos);
+
+    /**
+     * @brief Página para leer: el marco si está en el pool, si no la proyección
+     */
+    const unsigned char* leerPagina(uint32_t numero);
+
+    /**
+     * @brief Página para modificar: la trae al pool (o la crea) y la marca sucia
+     */
+    unsigned char* modificarPagina(uint32_t numero);
+    void tocarLRU(Marco& marco);
+    void desalojarLimpios();
+
+    const CabeceraArchivo* cabecera() { return reinterpret_cast<const CabeceraArchivo*>(leerPagina(0)); }
+    CabeceraArchivo* cabeceraModificable() { return reinterpret_cast<CabeceraArchivo*>(modificarPagina(0)); }
+    uint32_t nuevaPagina(bool hoja);
+
+    uint32_t buscarHoja(const ClaveDisco& clave);
+    bool insertarEnNodo(uint32_t pagina, const ClaveDisco& clave, uint64_t valor, DivisionDisco& division, bool& nueva);
+    bool confirmarSinBloqueo();
+
+public:
+    IndiceDiscoBPlus();
+    ~IndiceDiscoBPlus();
+
+    IndiceDiscoBPlus(const IndiceDiscoBPlus&) = delete;
+    IndiceDiscoBPlus& operator=(const IndiceDiscoBPlus&) = delete;
+
+    /**
+     * @brief Abre (o crea) el índice; aplica o descarta el WAL pendiente
+     *
+     * No recorre el árbol: solo valida la cabecera y proyecta el archivo, por lo que
+     * abrir un índice existente toma milisegundos sin importar su tamaño.
+     * @param ruta Archivo del índice; el WAL se guarda junto a él con extensión .wal
+     * @return true si el índice quedó listo, false en caso contrario
+     */
+    bool abrir(const std::string& ruta);
+
+    /**
+     * @brief Confirma lo pendiente y cierra el archivo
+     */
+    void cerrar();
+
+    bool estaAbierto() const { return archivo != nullptr; }
+
+    /**
+     * @brief Reemplaza el contenido por los pares dados, ordenados y sin claves repetidas
+     *
+     * Escribe un archivo nuevo de forma secuencial (hojas llenas al 90 %) y lo coloca en
+     * lugar del anterior con un renombrado, sin pasar por el WAL.
+     */
+    bool construir(const std::vector<std::pair<std::string, uint64_t>>& pares);
+
+    /**
+     * @brief Busca el valor de una clave
+     * @return true si la clave existe
+     */
+    bool buscar(const std::string& clave, uint64_t& valor);
+
+    /**
+     * @brief Pares con clave en [desde, hasta], en orden ascendente
+     */
+    std::vector<std::pair<std::string, uint64_t>> rango(const std::string& desde, const std::string& hasta);
+
+    /**
+     * @brief Inserta o reemplaza el valor de una clave (queda pendiente hasta confirmar)
+     * @return false si la clave excede LONGITUD_CLAVE o el índice no está abierto
+     */
+    bool insertar(const std::string& clave, uint64_t valor);
+
+    /**
+     * @brief Hace duraderas las modificaciones pendientes a través del WAL
+     */
+    bool confirmar();
+
+    uint64_t totalClaves();
+};
+
+#endif // INDICEDISCOBPLUS_H
@@ -0,0 +1,342 @@
+/**
+ * @file IndiceTrigramas.cpp
+ * @brief Implementación del índice invertido de trigramas con listas comprimidas
+ */
+#include "IndiceTrigramas.h"
+#include "Utilidades.h"
+#include <algorithm>
+#include <numeric>
+#include <cstdlib>
+#include <cctype>
+
+namespace {
+	bool esSeparador(unsigned char c) {
+		// Los bytes >= 0x80 (letras fuera de ASCII en UTF-8) forman parte de las palabras
+		return c < 0x80 && !std::isalnum(c);
+	}
+
+	/**
+	 * @brief Distancia máxima tolerada según el largo de la consulta
+	 */
+	int distanciaMaxima(size_t longitud) {
+		return longitud <= 4 ? 1 : (longitud <= 8 ? 2 : 3);
+	}
+}
+
+IndiceTrigramas::IndiceTrigramas() : borrados(0) {
+}
+
+void IndiceTrigramas::limpiar() {
+	posteos.clear();
+	documentos.clear();
+	idPorCedula.clear();
+	borrados = 0;
+}
+
+std::vector<std::string> IndiceTrigramas::palabras(const std::string& texto) {
+	std::vector<std::string> resultado;
+	size_t inicio = 0;
+	while (inicio < texto.size()) {
+		while (inicio < texto.size() && esSeparador(static_cast<unsigned char>(texto[inicio]))) {
+			inicio++;
+		}
+		size_t fin = inicio;
+		while (fin < texto.size() && !esSeparador(static_cast<unsigned char>(texto[fin]))) {
+			fin++;
+		}
+		if (fin > inicio) {
+			resultado.push_back(texto.substr(inicio, fin - inicio));
+		}
+		inicio = fin;
+	}
+	return resultado;
+}
+
+std::vector<uint32_t> IndiceTrigramas::trigramas(const std::string& texto) {
+	std::vector<uint32_t> resultado;
+	for (const auto& palabra : palabras(texto)) {
+		std::string rodeada = " " + palabra + " ";
+		for (size_t i = 0; i + 2 < rodeada.size(); ++i) {
+			resultado.push_back((static_cast<uint32_t>(static_cast<unsigned char>(rodeada[i])) << 16) |
+				(static_cast<uint32_t>(static_cast<unsigned char>(rodeada[i + 1])) << 8) |
+				static_cast<uint32_t>(static_cast<unsigned char>(rodeada[i + 2])));
+		}
+	}
+	std::sort(resultado.begin(), resultado.end());
+	resultado.erase(std::unique(resultado.begin(), resultado.end()), resultado.end());
+	return resultado;
+}
+
+void IndiceTrigramas::agregarPosteo(ListaPosteo& lista, uint32_t id) {
+	// El primer valor se guarda tal cual; los siguientes, como diferencia con el anterior
+	uint32_t valor = lista.cantidad == 0 ? id : id - lista.ultimo;
+	while (valor >= 0x80) {
+		lista.bytes.push_back(static_cast<uint8_t>(valor | 0x80));
+		valor >>= 7;
+	}
+	lista.bytes.push_back(static_cast<uint8_t>(valor));
+	lista.ultimo = id;
+	lista.cantidad++;
+}
+
+template<typename Visita>
+void IndiceTrigramas::recorrerPosteo(const ListaPosteo& lista, Visita&& visita) {
+	uint32_t id = 0;
+	size_t posicion = 0;
+	for (uint32_t i = 0; i < lista.cantidad; ++i) {
+		uint32_t valor = 0;
+		int desplazamiento = 0;
+		uint8_t byte;
+		do {
+			byte = lista.bytes[posicion++];
+			valor |= static_cast<uint32_t>(byte & 0x7F) << desplazamiento;
+			desplazamiento += 7;
+		} while (byte & 0x80);
+		id = i == 0 ? valor : id + valor;
+		visita(id);
+	}
+}
+
+void IndiceTrigramas::indexar(uint32_t id) {
+	const Documento& documento = documentos[id];
+	for (int campo = 0; campo < TOTAL_CAMPOS; ++campo) {
+		for (uint32_t trigrama : trigramas(documento.campos[campo])) {
+			agregarPosteo(posteos[claveTrigrama(campo, trigrama)], id);
+		}
+	}
+}
+
+void IndiceTrigramas::agregar(const std::string& cedula, const Campos& campos) {
+	quitar(cedula);
+
+	Documento documento{ cedula, {}, true };
+	for (int campo = 0; campo < TOTAL_CAMPOS; ++campo) {
+		documento.campos[campo] = Utilidades::NormalizarTexto(campos[campo]);
+	}
+
+	// Los identificadores nuevos son siempre mayores: las listas siguen ordenadas
+	uint32_t id = static_cast<uint32_t>(documentos.size());
+	documentos.push_back(std::move(documento));
+	idPorCedula[cedula] = id;
+	indexar(id);
+}
+
+bool IndiceTrigramas::quitar(const std::string& cedula) {
+	auto existente = idPorCedula.find(cedula);
+	if (existente == idPorCedula.end()) {
+		return false;
+	}
+
+	Documento& documento = documentos[existente->second];
+	documento.vivo = false;
+	documento.campos = Campos();
+	idPorCedula.erase(existente);
+	borrados++;
+
+	if (borrados > 1024 && borrados > documentos.size() / 2) {
+		reconstruir();
+	}
+	return true;
+}
+
+void IndiceTrigramas::reconstruir() {
+	std::vector<Documento> vivos;
+	vivos.reserve(documentos.size() - borrados);
+	for (auto& documento : documentos) {
+		if (documento.vivo) {
+			vivos.push_back(std::move(documento));
+		}
+	}
+
+	limpiar();
+	documentos = std::move(vivos);
+	for (uint32_t id = 0; id < documentos.size(); ++id) {
+		idPorCedula[documentos[id].cedula] = id;
+		indexar(id);
+	}
+}
+
+size_t IndiceTrigramas::bytesPosteos() const {
+	size_t total = 0;
+	for (const auto& par : posteos) {
+		total += par.second.bytes.size();
+	}
+	return total;
+}
+
+int IndiceTrigramas::distanciaAcotada(const std::string& a, const std::string& b, int maximo) {
+	int largoA = static_cast<int>(a.size());
+	int largoB = static_cast<int>(b.size());
+	if (std::abs(largoA - largoB) > maximo) {
+		return maximo + 1;
+	}
+
+	std::vector<int> anterior(largoB + 1);
+	std::vector<int> actual(largoB + 1);
+	std::iota(anterior.begin(), anterior.end(), 0);
+	for (int i = 1; i <= largoA; ++i) {
+		actual[0] = i;
+		int minimoFila = i;
+		for (int j = 1; j <= largoB; ++j) {
+			int sustitucion = anterior[j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1);
+			actual[j] = std::min({ anterior[j] + 1, actual[j - 1] + 1, sustitucion });
+			minimoFila = std::min(minimoFila, actual[j]);
+		}
+		// Ninguna celda posterior puede bajar del mínimo de la fila
+		if (minimoFila > maximo) {
+			return maximo + 1;
+		}
+		std::swap(anterior, actual);
+	}
+	return std::min(anterior[largoB], maximo + 1);
+}
+
+std::vector<IndiceTrigramas::Coincidencia> IndiceTrigramas::buscar(const std::string& consulta, size_t limite, unsigned campos) const {
+	std::string normalizada = Utilidades::NormalizarTexto(consulta);
+	auto trigramasConsulta = trigramas(normalizada);
+	if (trigramasConsulta.empty() || documentos.empty() || limite == 0) {
+		return {};
+	}
+
+	int maximo = distanciaMaxima(normalizada.size());
+	size_t minimoCompartidos = trigramasConsulta.size() > static_cast<size_t>(3 * maximo)
+		? trigramasConsulta.size() - 3 * maximo : 1;
+
+	// Trigramas compartidos por identificador (saturado en 255)
+	std::vector<uint8_t> compartidos(documentos.size(), 0);
+	std::vector<uint32_t> tocados;
+	for (uint32_t trigrama : trigramasConsulta) {
+		for (int campo = 0; campo < TOTAL_CAMPOS; ++campo) {
+			if (!(campos & (1u << campo))) continue;
+			auto lista = posteos.find(claveTrigrama(campo, trigrama));
+			if (lista == posteos.end()) continue;
+			recorrerPosteo(lista->second, [&](uint32_t id) {
+				if (compartidos[id] == 0) tocados.push_back(id);
+				if (compartidos[id] < 255) compartidos[id]++;
+			});
+		}
+	}
+
+	std::vector<uint32_t> candidatos;
+	for (uint32_t id : tocados) {
+		if (compartidos[id] >= minimoCompartidos && documentos[id].vivo) {
+			candidatos.push_back(id);
+		}
+	}
+	auto masCompartidos = [&compartidos](uint32_t a, uint32_t b) {
+		return compartidos[a] != compartidos[b] ? compartidos[a] > compartidos[b] : a < b;
+	};
+	if (candidatos.size() > MAX_CANDIDATOS) {
+		std::nth_element(candidatos.begin(), candidatos.begin() + MAX_CANDIDATOS, candidatos.end(), masCompartidos);
+		candidatos.resize(MAX_CANDIDATOS);
+	}
+
+	// Verificación: distancia acotada contra el campo completo y contra cada tramo del campo
+	// con tantas palabras consecutivas como la consulta
+	size_t palabrasConsulta = std::max<size_t>(1, palabras(normalizada).size());
+	struct Verificada {
+		uint32_t id;
+		int distancia;
+		Campo campo;
+	};
+	std::vector<Verificada> verificadas;
+	for (uint32_t id : candidatos) {
+		Verificada mejor{ id, maximo + 1, NOMBRE };
+		for (int campo = 0; campo < TOTAL_CAMPOS && mejor.distancia > 0; ++campo) {
+			if (!(campos & (1u << campo))) continue;
+			const std::string& texto = documentos[id].campos[campo];
+			int distancia = distanciaAcotada(normalizada, texto, maximo);
+			auto palabrasTexto = palabras(texto);
+			for (size_t inicio = 0; inicio + palabrasConsulta <= palabrasTexto.size() && distancia > 0; ++inicio) {
+				std::string tramo = palabrasTexto[inicio];
+				for (size_t i = 1; i < palabrasConsulta; ++i) {
+					tramo += ' ';
+					tramo += palabrasTexto[inicio + i];
+				}
+				distancia = std::min(distancia, distanciaAcotada(normalizada, tramo, maximo));
+			}
+			if (distancia < mejor.distancia) {
+				mejor.distancia = distancia;
+				mejor.campo = static_cast<Campo>(campo);
+			}
+		}
+		if (mejor.distancia <= maximo) {
+			verificadas.push_back(mejor);
+		}
+	}
+
+	std::sort(verificadas.begin(), verificadas.end(), [&masCompartidos](const Verificada& a, const Verificada& b) {
+		return a.distancia != b.distancia ? a.distancia < b.distancia : masCompartidos(a.id, b.id);
+	});
+
+	std::vector<Coincidencia> resultados;
+	for (size_t i = 0; i < verificadas.size() && i < limite; ++i) {
+		resultados.push_back(Coincidencia{ documentos[verificadas[i].id].cedula, verificadas[i].distancia, verificadas[i].campo });
+	}
+	return resultados;
+}
+
+std::vector<std::string> IndiceTrigramas::contienen(const std::string& consulta, unsigned campos) const {
+	std::string normalizada = Utilidades::NormalizarTexto(consulta);
+	if (normalizada.empty() || documentos.empty()) {
+		return {};
+	}
+
+	// Sin los espacios de relleno: la consulta puede ser un trozo de palabra
+	std::vector<uint32_t> interiores;
+	for (const auto& palabra : palabras(normalizada)) {
+		for (size_t i = 0; i + 2 < palabra.size(); ++i) {
+			interiores.push_back((static_cast<uint32_t>(static_cast<unsigned char>(palabra[i])) << 16) |
+				(static_cast<uint32_t>(static_cast<unsigned char>(palabra[i + 1])) << 8) |
+				static_cast<uint32_t>(static_cast<unsigned char>(palabra[i + 2])));
+		}
+	}
+	std::sort(interiores.begin(), interiores.end());
+	interiores.erase(std::unique(interiores.begin(), interiores.end()), interiores.end());
+
+	std::vector<uint8_t> encontrada(documentos.size(), 0);
+	std::vector<uint32_t> compartidos(documentos.size(), 0);
+	for (int campo = 0; campo < TOTAL_CAMPOS; ++campo) {
+		if (!(campos & (1u << campo))) continue;
+
+		// Consultas con palabras de menos de tres letras no filtran: se revisan todas
+		std::vector<uint32_t> candidatos;
+		if (interiores.empty()) {
+			candidatos.resize(documentos.size());
+			std::iota(candidatos.begin(), candidatos.end(), 0);
+		}
+		else {
+			std::fill(compartidos.begin(), compartidos.end(), 0);
+			bool completo = true;
+			for (uint32_t trigrama : interiores) {
+				auto lista = posteos.find(claveTrigrama(campo, trigrama));
+				if (lista == posteos.end()) {
+					completo = false;
+					break;
+				}
+				recorrerPosteo(lista->second, [&compartidos](uint32_t id) { compartidos[id]++; });
+			}
+			if (!completo) continue;
+			for (uint32_t id = 0; id < documentos.size(); ++id) {
+				if (compartidos[id] == interiores.size()) {
+					candidatos.push_back(id);
+				}
+			}
+		}
+
+		for (uint32_t id : candidatos) {
+			if (!encontrada[id] && documentos[id].vivo &&
+				documentos[id].campos[campo].find(normalizada) != std::string::npos) {
+				encontrada[id] = 1;
+			}
+		}
+	}
+
+	std::vector<std::string> resultados;
+	for (uint32_t id = 0; id < documentos.size(); ++id) {
+		if (encontrada[id]) {
+			resultados.push_back(documentos[id].cedula);
+		}
+	}
+	return resultados;
+}
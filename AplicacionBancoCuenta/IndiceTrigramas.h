@@ -0,0 +1,145 @@
+#pragma once
+#ifndef INDICETRIGRAMAS_H
+#define INDICETRIGRAMAS_H
+
+#include <string>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class IndiceTrigramas
+ * @brief Índice invertido de trigramas para búsquedas tolerantes a errores de tipeo
+ *
+ * Cada persona recibe un identificador consecutivo y sus campos de texto (nombre,
+ * apellido, correo y dirección, normalizados con Utilidades::NormalizarTexto) se
+ * parten en palabras y trigramas. Por cada trigrama y campo se guarda la lista de
+ * identificadores que lo contienen, en orden ascendente y comprimida como diferencias
+ * en varint: agregar una persona solo escribe al final de sus listas.
+ *
+ * Una consulta cuenta cuántos de sus trigramas comparte cada persona; como una edición
+ * altera a lo sumo tres trigramas, las personas a distancia <= k comparten al menos
+ * |trigramas| - 3k. Solo las candidatas más prometedoras se verifican con la distancia
+ * de edición acotada a k.
+ *
+ * Quitar o actualizar una persona deja su identificador anterior marcado como borrado;
+ * cuando los borrados superan a los vivos, las listas se reconstruyen. No sincroniza el
+ * acceso: el dueño (GestorIndices) lo protege con su propio bloqueo.
+ */
+class IndiceTrigramas {
+public:
+    enum Campo {
+        NOMBRE = 0,
+        APELLIDO = 1,
+        CORREO = 2,
+        DIRECCION = 3,
+        TOTAL_CAMPOS = 4
+    };
+
+    static constexpr unsigned TODOS_LOS_CAMPOS = (1u << TOTAL_CAMPOS) - 1;
+
+    using Campos = std::array<std::string, TOTAL_CAMPOS>;
+
+    /**
+     * @struct Coincidencia
+     * @brief Persona encontrada, con la menor distancia de edición y el campo donde se dio
+     */
+    struct Coincidencia {
+        std::string cedula;
+        int distancia;
+        Campo campo;
+    };
+
+private:
+    // Candidatas (por trigramas compartidos) que se verifican con la distancia de edición
+    static constexpr size_t MAX_CANDIDATOS = 4096;
+
+    /**
+     * @struct ListaPosteo
+     * @brief Identificadores ascendentes codificados como diferencias en varint
+     */
+    struct ListaPosteo {
+        std::vector<uint8_t> bytes;
+        uint32_t ultimo = 0;
+        uint32_t cantidad = 0;
+    };
+
+    struct Documento {
+        std::string cedula;
+        Campos campos;   // Ya normalizados
+        bool vivo;
+    };
+
+    std::unordered_map<uint32_t, ListaPosteo> posteos;
+    std::vector<Documento> documentos;
+    std::unordered_map<std::string, uint32_t> idPorCedula;
+    size_t borrados;
+
+    /**
+     * @brief Trigramas distintos de un texto normalizado; cada palabra se rodea de espacios
+     */
+    static std::vector<uint32_t> trigramas(const std::string& texto);
+    static std::vector<std::string> palabras(const std::string& texto);
+    static void agregarPosteo(ListaPosteo& lista, uint32_t id);
+    template<typename Visita>
+    static void recorrerPosteo(const ListaPosteo& lista, Visita&& visita);
+    static uint32_t claveTrigrama(int campo, uint32_t trigrama) { return (static_cast<uint32_t>(campo) << 24) | trigrama; }
+
+    void indexar(uint32_t id);
+    void reconstruir();
+
+public:
+    IndiceTrigramas();
+
+    /**
+     * @brief Agrega una persona o reemplaza sus campos si la cédula ya estaba
+     * @param campos Textos originales; se normalizan al indexarlos
+     */
+    void agregar(const std::string& cedula, const Campos& campos);
+
+    /**
+     * @brief Quita una persona
+     * @return true si estaba en el índice
+     */
+    bool quitar(const std::string& cedula);
+
+    void limpiar();
+
+    /**
+     * @brief Personas con algún campo parecido a la consulta, de la más a la menos parecida
+     *
+     * La distancia máxima depende del largo de la consulta: 1 hasta 4 caracteres, 2
+     * hasta 8 y 3 en adelante. Se compara con el campo completo y con cada tramo de
+     * tantas palabras como tenga la consulta, así "gonzales" encuentra "maria gonzalez".
+     * @param limite Cantidad máxima de resultados
+     * @param campos Máscara de bits de Campo a considerar
+     */
+    std::vector<Coincidencia> buscar(const std::string& consulta, size_t limite, unsigned campos = TODOS_LOS_CAMPOS) const;
+
+    /**
+     * @brief Personas con algún campo que contiene la consulta, sin distinguir mayúsculas ni tildes
+     *
+     * Equivale a la búsqueda parcial con $regex de MongoDB. Los trigramas interiores de
+     * cada palabra de la consulta deben estar todos en el campo; las candidatas se
+     * confirman buscando la consulta normalizada dentro del texto.
+     * @param campos Máscara de bits de Campo a considerar
+     * @return Cédulas en orden de alta en el índice
+     */
+    std::vector<std::string> contienen(const std::string& consulta, unsigned campos = TODOS_LOS_CAMPOS) const;
+
+    size_t tamano() const { return documentos.size() - borrados; }
+
+    /**
+     * @brief Bytes ocupados por las listas comprimidas
+     */
+    size_t bytesPosteos() const;
+
+    /**
+     * @brief Distancia de Levenshtein, o maximo + 1 si supera maximo (corta en cuanto lo sabe)
+     */
+    static int distanciaAcotada(const std::string& a, const std::string& b, int maximo);
+};
+
+#endif // INDICETRIGRAMAS_H
@@ -0,0 +1,194 @@
+/**
+ * @file InstantaneaArbol.cpp
+ * @brief Escritura y proyección de instantáneas binarias de árboles
+ */
+#include "InstantaneaArbol.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	const char FIRMA_INSTANTANEA[8] = { 'A', 'R', 'B', 'O', 'L', 'S', 'N', 'P' };
+	constexpr uint64_t ALINEACION_SECCION = 8;
+
+	uint64_t alinear(uint64_t desplazamiento) {
+		return (desplazamiento + ALINEACION_SECCION - 1) / ALINEACION_SECCION * ALINEACION_SECCION;
+	}
+
+	bool reemplazarArchivo(const std::string& origen, const std::string& destino) {
+#ifdef _WIN32
+		return MoveFileExA(origen.c_str(), destino.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+		return std::rename(origen.c_str(), destino.c_str()) == 0;
+#endif
+	}
+}
+
+InstantaneaArbol::RefTexto InstantaneaArbol::TablaTextos::agregar(const std::string& texto) {
+	RefTexto referencia{ static_cast<uint32_t>(datos.size()), static_cast<uint32_t>(texto.size()) };
+	datos.insert(datos.end(), texto.begin(), texto.end());
+	return referencia;
+}
+
+InstantaneaArbol::InstantaneaArbol()
+	: mapeo(nullptr), tamanoMapeado(0), manejadorMapeo(nullptr) {
+}
+
+InstantaneaArbol::~InstantaneaArbol() {
+	cerrar();
+}
+
+uint64_t InstantaneaArbol::huella(const std::string& texto) {
+	uint64_t valor = 14695981039346656037ull;
+	for (unsigned char c : texto) {
+		valor ^= c;
+		valor *= 1099511628211ull;
+	}
+	return valor;
+}
+
+bool InstantaneaArbol::escribir(const std::string& ruta, uint32_t tipoArbol, uint64_t contadorCambios,
+	uint64_t parametro, uint64_t totalElementos, const DatosSeccion (&secciones)[TOTAL_SECCIONES]) {
+	CabeceraArchivo cabeceraNueva{};
+	std::memcpy(cabeceraNueva.firma, FIRMA_INSTANTANEA, sizeof(FIRMA_INSTANTANEA));
+	cabeceraNueva.version = VERSION_FORMATO;
+	cabeceraNueva.tipoArbol = tipoArbol;
+	cabeceraNueva.contadorCambios = contadorCambios;
+	cabeceraNueva.parametro = parametro;
+	cabeceraNueva.totalElementos = totalElementos;
+
+	uint64_t desplazamiento = alinear(sizeof(CabeceraArchivo));
+	for (int i = 0; i < TOTAL_SECCIONES; ++i) {
+		cabeceraNueva.secciones[i].desplazamiento = desplazamiento;
+		cabeceraNueva.secciones[i].longitud = secciones[i].longitud;
+		desplazamiento = alinear(desplazamiento + secciones[i].longitud);
+	}
+
+	std::string rutaTemporal = ruta + ".tmp";
+	std::FILE* destino = std::fopen(rutaTemporal.c_str(), "wb");
+	if (!destino) {
+		std::cerr << "Error: No se pudo crear la instantánea " << rutaTemporal << std::endl;
+		return false;
+	}
+
+	const char relleno[ALINEACION_SECCION] = {};
+	bool correcto = std::fwrite(&cabeceraNueva, sizeof(cabeceraNueva), 1, destino) == 1;
+	uint64_t escrito = sizeof(cabeceraNueva);
+	for (int i = 0; i < TOTAL_SECCIONES && correcto; ++i) {
+		uint64_t inicio = cabeceraNueva.secciones[i].desplazamiento;
+		correcto = std::fwrite(relleno, 1, static_cast<size_t>(inicio - escrito), destino) == inicio - escrito;
+		if (correcto && secciones[i].longitud > 0) {
+			correcto = std::fwrite(secciones[i].datos, 1, secciones[i].longitud, destino) == secciones[i].longitud;
+		}
+		escrito = inicio + secciones[i].longitud;
+	}
+	correcto = std::fclose(destino) == 0 && correcto;
+
+	if (!correcto || !reemplazarArchivo(rutaTemporal, ruta)) {
+		std::cerr << "Error: No se pudo escribir la instantánea " << ruta << std::endl;
+		std::remove(rutaTemporal.c_str());
+		return false;
+	}
+	return true;
+}
+
+bool InstantaneaArbol::proyectar(const std::string& ruta) {
+	std::FILE* archivo = std::fopen(ruta.c_str(), "rb");
+	if (!archivo) {
+		return false;
+	}
+
+#ifdef _WIN32
+	_fseeki64(archivo, 0, SEEK_END);
+	long long tamano = _ftelli64(archivo);
+#else
+	fseeko(archivo, 0, SEEK_END);
+	long long tamano = static_cast<long long>(ftello(archivo));
+#endif
+	if (tamano < static_cast<long long>(sizeof(CabeceraArchivo))) {
+		std::fclose(archivo);
+		return false;
+	}
+
+#ifdef _WIN32
+	HANDLE manejadorArchivo = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(archivo)));
+	HANDLE proyeccion = CreateFileMappingA(manejadorArchivo, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* vista = proyeccion ? MapViewOfFile(proyeccion, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!vista && proyeccion) {
+		CloseHandle(proyeccion);
+	}
+	manejadorMapeo = vista ? proyeccion : nullptr;
+#else
+	void* vista = mmap(nullptr, static_cast<size_t>(tamano), PROT_READ, MAP_SHARED, fileno(archivo), 0);
+	if (vista == MAP_FAILED) {
+		vista = nullptr;
+	}
+#endif
+	// La proyección sigue siendo válida después de cerrar el archivo
+	std::fclose(archivo);
+	if (!vista) {
+		return false;
+	}
+
+	mapeo = static_cast<const unsigned char*>(vista);
+	tamanoMapeado = static_cast<size_t>(tamano);
+	return true;
+}
+
+bool InstantaneaArbol::abrir(const std::string& ruta, uint32_t tipoArbol, uint64_t contadorCambios, uint64_t parametro) {
+	cerrar();
+	if (!proyectar(ruta)) {
+		return false;
+	}
+
+	const CabeceraArchivo* datos = cabecera();
+	bool valida = std::memcmp(datos->firma, FIRMA_INSTANTANEA, sizeof(FIRMA_INSTANTANEA)) == 0 &&
+		datos->version == VERSION_FORMATO &&
+		datos->tipoArbol == tipoArbol &&
+		datos->contadorCambios == contadorCambios &&
+		datos->parametro == parametro;
+	for (int i = 0; i < TOTAL_SECCIONES && valida; ++i) {
+		uint64_t inicio = datos->secciones[i].desplazamiento;
+		uint64_t longitud = datos->secciones[i].longitud;
+		valida = inicio % ALINEACION_SECCION == 0 && inicio >= sizeof(CabeceraArchivo) &&
+			inicio <= tamanoMapeado && longitud <= tamanoMapeado - inicio;
+	}
+
+	if (!valida) {
+		cerrar();
+		return false;
+	}
+	return true;
+}
+
+void InstantaneaArbol::cerrar() {
+	if (!mapeo) {
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(mapeo);
+	CloseHandle(manejadorMapeo);
+#else
+	munmap(const_cast<unsigned char*>(mapeo), tamanoMapeado);
+#endif
+	mapeo = nullptr;
+	manejadorMapeo = nullptr;
+	tamanoMapeado = 0;
+}
+
+bool InstantaneaArbol::leerTexto(const RefTexto& referencia, std::string& texto) const {
+	size_t total = 0;
+	const char* textos = seccion<char>(TEXTOS, total);
+	if (!textos || referencia.desplazamiento > total || referencia.longitud > total - referencia.desplazamiento) {
+		return false;
+	}
+	texto.assign(textos + referencia.desplazamiento, referencia.longitud);
+	return true;
+}
@@ -0,0 +1,173 @@
+#pragma once
+#ifndef INSTANTANEAARBOL_H
+#define INSTANTANEAARBOL_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class InstantaneaArbol
+ * @brief Archivo binario versionado con la estructura de un árbol ya construido
+ *
+ * Una instantánea guarda los nodos de un ArbolB o ArbolBPlus en orden de anchura (los
+ * hijos de cada nodo quedan contiguos) junto con sus arreglos de claves, para poder
+ * reconstruir el árbol sin volver a leer la base ni ordenar. El archivo se compone de
+ * una cabecera y de secciones alineadas a 8 bytes que solo se referencian por
+ * desplazamiento, así que se lee directamente de una proyección en memoria.
+ *
+ * La cabecera registra el contador de cambios de la base con el que se construyó el
+ * árbol (IRepositorioBanco::obtenerContadorCambiosPersonas); abrir() rechaza la
+ * instantánea si ese contador, el tipo de árbol, su parámetro o la versión no coinciden.
+ */
+class InstantaneaArbol {
+public:
+    // 2: las claves de nombre y apellido se guardan sin tildes (Utilidades::NormalizarTexto)
+    static constexpr uint32_t VERSION_FORMATO = 2;
+    static constexpr uint32_t TIPO_ARBOL_B = 1;
+    static constexpr uint32_t TIPO_ARBOL_B_PLUS = 2;
+    static constexpr uint32_t SIN_ELEMENTO = UINT32_MAX;
+
+    /**
+     * @brief Secciones del archivo; TEXTOS y ELEMENTOS solo las usa el árbol B+
+     */
+    enum Seccion {
+        NODOS = 0,
+        CLAVES = 1,
+        TEXTOS = 2,
+        ELEMENTOS = 3,
+        TOTAL_SECCIONES = 4
+    };
+
+    /**
+     * @struct NodoInstantanea
+     * @brief Nodo del árbol: sus claves son [primeraClave, primeraClave + numClaves) y sus
+     * hijos [primerHijo, primerHijo + numHijos), siempre posteriores al propio nodo
+     */
+    struct NodoInstantanea {
+        uint32_t esHoja;
+        uint32_t numClaves;
+        uint32_t primeraClave;
+        uint32_t numHijos;
+        uint32_t primerHijo;
+        uint32_t reservado;
+    };
+
+    /**
+     * @struct RefTexto
+     * @brief Texto dentro de la sección TEXTOS
+     */
+    struct RefTexto {
+        uint32_t desplazamiento;
+        uint32_t longitud;
+    };
+
+    /**
+     * @struct ClaveTexto
+     * @brief Clave de un árbol B+; en las hojas elemento indexa la sección ELEMENTOS y en
+     * los nodos internos vale SIN_ELEMENTO
+     */
+    struct ClaveTexto {
+        RefTexto texto;
+        uint32_t elemento;
+        uint32_t reservado;
+    };
+
+    /**
+     * @class TablaTextos
+     * @brief Acumula los textos de la sección TEXTOS mientras se escribe una instantánea
+     */
+    class TablaTextos {
+    private:
+        std::vector<char> datos;
+
+    public:
+        RefTexto agregar(const std::string& texto);
+        const std::vector<char>& obtenerDatos() const { return datos; }
+    };
+
+    /**
+     * @struct DatosSeccion
+     * @brief Bytes de una sección a escribir
+     */
+    struct DatosSeccion {
+        const void* datos = nullptr;
+        size_t longitud = 0;
+    };
+
+private:
+    struct CabeceraArchivo {
+        char firma[8];
+        uint32_t version;
+        uint32_t tipoArbol;
+        uint64_t contadorCambios;
+        uint64_t parametro;
+        uint64_t totalElementos;
+        struct {
+            uint64_t desplazamiento;
+            uint64_t longitud;
+        } secciones[TOTAL_SECCIONES];
+    };
+
+    const unsigned char* mapeo;
+    size_t tamanoMapeado;
+    void* manejadorMapeo;
+
+    bool proyectar(const std::string& ruta);
+    const CabeceraArchivo* cabecera() const { return reinterpret_cast<const CabeceraArchivo*>(mapeo); }
+
+public:
+    InstantaneaArbol();
+    ~InstantaneaArbol();
+
+    InstantaneaArbol(const InstantaneaArbol&) = delete;
+    InstantaneaArbol& operator=(const InstantaneaArbol&) = delete;
+
+    /**
+     * @brief Escribe una instantánea completa en un archivo temporal y lo coloca en lugar
+     * de la ruta con un renombrado, de modo que un lector nunca ve un archivo a medias
+     * @param parametro Dato propio del árbol que debe coincidir al abrir (grado, extractor...)
+     * @return true si el archivo quedó escrito
+     */
+    static bool escribir(const std::string& ruta, uint32_t tipoArbol, uint64_t contadorCambios,
+        uint64_t parametro, uint64_t totalElementos, const DatosSeccion (&secciones)[TOTAL_SECCIONES]);
+
+    /**
+     * @brief Proyecta la instantánea y valida cabecera y límites de las secciones
+     * @return false si el archivo no existe, está dañado o no corresponde a los datos pedidos
+     */
+    bool abrir(const std::string& ruta, uint32_t tipoArbol, uint64_t contadorCambios, uint64_t parametro);
+
+    void cerrar();
+
+    uint64_t totalElementos() const { return mapeo ? cabecera()->totalElementos : 0; }
+
+    /**
+     * @brief Registros de una sección como arreglo de R
+     * @param cantidad Salida con el número de registros
+     * @return Puntero a la proyección, o nullptr si la sección no es un arreglo de R
+     */
+    template<typename R>
+    const R* seccion(Seccion seccion, size_t& cantidad) const {
+        cantidad = 0;
+        if (!mapeo) return nullptr;
+        const auto& datos = cabecera()->secciones[seccion];
+        if (datos.longitud % sizeof(R) != 0) return nullptr;
+        cantidad = static_cast<size_t>(datos.longitud / sizeof(R));
+        return reinterpret_cast<const R*>(mapeo + datos.desplazamiento);
+    }
+
+    /**
+     * @brief Copia un texto de la sección TEXTOS
+     * @return false si la referencia sale de la sección
+     */
+    bool leerTexto(const RefTexto& referencia, std::string& texto) const;
+
+    /**
+     * @brief FNV-1a de 64 bits, para convertir un nombre (p. ej. el del extractor) en parámetro
+     */
+    static uint64_t huella(const std::string& texto);
+};
+
+#endif // INSTANTANEAARBOL_H
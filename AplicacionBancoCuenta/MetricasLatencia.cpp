@@ -0,0 +1,245 @@
+/**
+ * @file MetricasLatencia.cpp
+ * @brief Implementación de los histogramas de latencia por operación
+ */
+#include "MetricasLatencia.h"
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+std::vector<std::unique_ptr<MetricasLatencia::BloqueHilo>> MetricasLatencia::bloques;
+std::mutex MetricasLatencia::mutexBloques;
+std::atomic<bool> MetricasLatencia::habilitado{ true };
+std::string MetricasLatencia::rutaVolcadoSalida;
+std::once_flag MetricasLatencia::banderaSalida;
+const std::chrono::steady_clock::time_point MetricasLatencia::inicioProceso = std::chrono::steady_clock::now();
+
+namespace {
+	/**
+	 * @brief Número de bits significativos de un valor distinto de cero
+	 */
+	int longitudBits(uint64_t valor) {
+#ifdef _MSC_VER
+		unsigned long indice;
+		_BitScanReverse64(&indice, valor);
+		return static_cast<int>(indice) + 1;
+#else
+		return 64 - __builtin_clzll(valor);
+#endif
+	}
+
+	/**
+	 * @brief Suma relajada para contadores con un único escritor (sin instrucción lock)
+	 */
+	void incrementar(std::atomic<uint64_t>& contador, uint64_t valor) {
+		contador.store(contador.load(std::memory_order_relaxed) + valor, std::memory_order_relaxed);
+	}
+}
+
+MetricasLatencia::BloqueHilo::BloqueHilo() {
+	for (auto& histograma : histogramas) {
+		for (auto& cubeta : histograma.cubetas) {
+			cubeta.store(0, std::memory_order_relaxed);
+		}
+		histograma.conteo.store(0, std::memory_order_relaxed);
+		histograma.sumaNanos.store(0, std::memory_order_relaxed);
+		histograma.maximoNanos.store(0, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * @brief Obtiene el bloque del hilo actual; solo la primera medición del hilo toma el mutex
+ */
+MetricasLatencia::BloqueHilo& MetricasLatencia::bloqueHiloActual() {
+	thread_local BloqueHilo* bloqueHilo = nullptr;
+	if (!bloqueHilo) {
+		auto nuevo = std::make_unique<BloqueHilo>();
+		bloqueHilo = nuevo.get();
+		std::lock_guard<std::mutex> lock(mutexBloques);
+		bloques.push_back(std::move(nuevo));
+	}
+	return *bloqueHilo;
+}
+
+/**
+ * @brief Cubeta log-lineal: los primeros SUBCUBETAS valores son exactos y cada
+ * potencia de 2 posterior se reparte en SUBCUBETAS cubetas de igual ancho
+ */
+int MetricasLatencia::indiceCubeta(uint64_t nanos) {
+	if (nanos < SUBCUBETAS) {
+		return static_cast<int>(nanos);
+	}
+	int desplazamiento = longitudBits(nanos) - 5;  // nanos >> desplazamiento queda en [16, 32)
+	int indice = (desplazamiento + 1) * SUBCUBETAS + static_cast<int>((nanos >> desplazamiento) - SUBCUBETAS);
+	return indice < CUBETAS ? indice : CUBETAS - 1;
+}
+
+uint64_t MetricasLatencia::limiteSuperiorCubeta(int indice) {
+	if (indice < SUBCUBETAS) {
+		return static_cast<uint64_t>(indice);
+	}
+	int desplazamiento = indice / SUBCUBETAS - 1;
+	uint64_t sub = static_cast<uint64_t>(indice % SUBCUBETAS);
+	return ((SUBCUBETAS + sub + 1) << desplazamiento) - 1;
+}
+
+void MetricasLatencia::registrar(Operacion operacion, std::chrono::steady_clock::duration duracion) {
+	if (!habilitado.load(std::memory_order_relaxed)) {
+		return;
+	}
+	auto nanosFirmados = std::chrono::duration_cast<std::chrono::nanoseconds>(duracion).count();
+	uint64_t nanos = nanosFirmados > 0 ? static_cast<uint64_t>(nanosFirmados) : 0;
+
+	Histograma& histograma = bloqueHiloActual().histogramas[operacion];
+	incrementar(histograma.cubetas[indiceCubeta(nanos)], 1);
+	incrementar(histograma.conteo, 1);
+	incrementar(histograma.sumaNanos, nanos);
+	if (nanos > histograma.maximoNanos.load(std::memory_order_relaxed)) {
+		histograma.maximoNanos.store(nanos, std::memory_order_relaxed);
+	}
+}
+
+const char* MetricasLatencia::nombreOperacion(Operacion operacion) {
+	switch (operacion) {
+	case DEPOSITO: return "depositarEnCuenta";
+	case RETIRO: return "retirarDeCuenta";
+	case TRANSFERENCIA: return "realizarTransferencia";
+	case AGREGAR_CUENTA: return "agregarCuentaPersona";
+	case BUSQUEDA_CRITERIO: return "buscarPersonasPorCriterio";
+	case CONSTRUCCION_ARBOL: return "ArbolBPlus.construir";
+	case MONGO_BUSQUEDA: return "mongo.busqueda";
+	case MONGO_ACTUALIZACION: return "mongo.actualizacion";
+	case MONGO_INSERCION: return "mongo.insercion";
+	case MONGO_TRANSACCION: return "mongo.transaccion";
+	default: return "desconocida";
+	}
+}
+
+std::vector<MetricasLatencia::ResumenOperacion> MetricasLatencia::obtenerResumen() {
+	std::vector<ResumenOperacion> resumen;
+	double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicioProceso).count();
+
+	std::lock_guard<std::mutex> lock(mutexBloques);
+	for (int op = 0; op < TOTAL_OPERACIONES; ++op) {
+		std::vector<uint64_t> cubetas(CUBETAS, 0);
+		uint64_t conteo = 0;
+		uint64_t sumaNanos = 0;
+		uint64_t maximoNanos = 0;
+
+		for (const auto& bloque : bloques) {
+			const Histograma& histograma = bloque->histogramas[op];
+			for (int i = 0; i < CUBETAS; ++i) {
+				cubetas[i] += histograma.cubetas[i].load(std::memory_order_relaxed);
+			}
+			conteo += histograma.conteo.load(std::memory_order_relaxed);
+			sumaNanos += histograma.sumaNanos.load(std::memory_order_relaxed);
+			uint64_t maximo = histograma.maximoNanos.load(std::memory_order_relaxed);
+			if (maximo > maximoNanos) maximoNanos = maximo;
+		}
+
+		ResumenOperacion fila;
+		fila.nombre = nombreOperacion(static_cast<Operacion>(op));
+		fila.conteo = conteo;
+		fila.porSegundo = segundos > 0.0 ? conteo / segundos : 0.0;
+		fila.maximoMicros = maximoNanos / 1000.0;
+
+		if (conteo > 0) {
+			fila.mediaMicros = static_cast<double>(sumaNanos) / conteo / 1000.0;
+
+			// Los contadores se leen sin detener a los escritores: el total de las cubetas
+			// puede diferir levemente de conteo, por eso los rangos se calculan sobre él
+			uint64_t totalCubetas = 0;
+			for (uint64_t valor : cubetas) totalCubetas += valor;
+
+			const double percentiles[] = { 0.50, 0.99, 0.999 };
+			double* destinos[] = { &fila.p50Micros, &fila.p99Micros, &fila.p999Micros };
+			for (int p = 0; p < 3; ++p) {
+				uint64_t rango = static_cast<uint64_t>(std::ceil(percentiles[p] * totalCubetas));
+				if (rango == 0) rango = 1;
+				uint64_t acumulado = 0;
+				for (int i = 0; i < CUBETAS; ++i) {
+					acumulado += cubetas[i];
+					if (acumulado >= rango) {
+						uint64_t limite = limiteSuperiorCubeta(i);
+						*destinos[p] = (limite < maximoNanos ? limite : maximoNanos) / 1000.0;
+						break;
+					}
+				}
+			}
+		}
+		resumen.push_back(fila);
+	}
+	return resumen;
+}
+
+bool MetricasLatencia::volcarJSON(const std::string& ruta) {
+	std::ofstream archivo(ruta, std::ios::trunc);
+	if (!archivo.is_open()) {
+		std::cerr << "Error: No se pudo abrir el archivo de métricas: " << ruta << std::endl;
+		return false;
+	}
+
+	auto resumen = obtenerResumen();
+	archivo << std::fixed << std::setprecision(3);
+	archivo << "{\n  \"unidad\": \"us\",\n  \"operaciones\": {\n";
+	for (size_t i = 0; i < resumen.size(); ++i) {
+		const auto& fila = resumen[i];
+		archivo << "    \"" << fila.nombre << "\": { "
+			<< "\"conteo\": " << fila.conteo << ", "
+			<< "\"por_segundo\": " << fila.porSegundo << ", "
+			<< "\"media\": " << fila.mediaMicros << ", "
+			<< "\"p50\": " << fila.p50Micros << ", "
+			<< "\"p99\": " << fila.p99Micros << ", "
+			<< "\"p999\": " << fila.p999Micros << ", "
+			<< "\"max\": " << fila.maximoMicros << " }"
+			<< (i + 1 < resumen.size() ? ",\n" : "\n");
+	}
+	archivo << "  }\n}\n";
+	return archivo.good();
+}
+
+void MetricasLatencia::volcarAlSalir() {
+	std::string ruta;
+	{
+		std::lock_guard<std::mutex> lock(mutexBloques);
+		ruta = rutaVolcadoSalida;
+	}
+	if (!ruta.empty()) {
+		volcarJSON(ruta);
+	}
+}
+
+void MetricasLatencia::setVolcadoAlSalir(const std::string& ruta) {
+	{
+		std::lock_guard<std::mutex> lock(mutexBloques);
+		rutaVolcadoSalida = ruta;
+	}
+	std::call_once(banderaSalida, []() {
+		std::atexit(&MetricasLatencia::volcarAlSalir);
+	});
+}
+
+void MetricasLatencia::mostrarResumen() {
+	auto resumen = obtenerResumen();
+	std::cout << "\n=== LATENCIA POR OPERACIÓN (us) ===" << std::endl;
+	std::cout << std::left << std::setw(28) << "Operación"
+		<< std::right << std::setw(10) << "Conteo"
+		<< std::setw(12) << "p50"
+		<< std::setw(12) << "p99"
+		<< std::setw(12) << "p999"
+		<< std::setw(12) << "Máx" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	for (const auto& fila : resumen) {
+		std::cout << std::left << std::setw(28) << fila.nombre
+			<< std::right << std::setw(10) << fila.conteo
+			<< std::setw(12) << fila.p50Micros
+			<< std::setw(12) << fila.p99Micros
+			<< std::setw(12) << fila.p999Micros
+			<< std::setw(12) << fila.maximoMicros << std::endl;
+	}
+}
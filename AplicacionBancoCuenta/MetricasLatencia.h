@@ -0,0 +1,174 @@
+#pragma once
+#ifndef METRICASLATENCIA_H
+#define METRICASLATENCIA_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class MetricasLatencia
+ * @brief Histogramas de latencia y contadores de rendimiento por operación bancaria
+ *
+ * Cada hilo registra en su propio bloque de histogramas (thread_local), por lo que
+ * medir no toma bloqueos ni compite por líneas de caché: el único escritor de cada
+ * contador es su hilo y la lectura suma todos los bloques con cargas relajadas.
+ *
+ * Los histogramas son log-lineales al estilo HDR: cada potencia de 2 de
+ * nanosegundos se divide en SUBCUBETAS partes iguales, lo que acota el error relativo
+ * de cualquier percentil a 1/SUBCUBETAS con un tamaño fijo por operación.
+ */
+class MetricasLatencia {
+public:
+    /**
+     * @enum Operacion
+     * @brief Operaciones medidas: primitivas bancarias y viajes a MongoDB
+     */
+    enum Operacion {
+        DEPOSITO = 0,
+        RETIRO,
+        TRANSFERENCIA,
+        AGREGAR_CUENTA,
+        BUSQUEDA_CRITERIO,
+        CONSTRUCCION_ARBOL,      // Carga masiva de ArbolBPlus (orden + niveles)
+        MONGO_BUSQUEDA,          // find / find_one
+        MONGO_ACTUALIZACION,     // update_one / find_one_and_update
+        MONGO_INSERCION,         // insert_one
+        MONGO_TRANSACCION,       // with_transaction completo, reintentos incluidos
+        TOTAL_OPERACIONES
+    };
+
+    /**
+     * @struct ResumenOperacion
+     * @brief Percentiles y conteo agregados de todos los hilos
+     */
+    struct ResumenOperacion {
+        std::string nombre;
+        uint64_t conteo = 0;
+        double porSegundo = 0.0;   // Conteo dividido entre el tiempo desde el inicio del proceso
+        double mediaMicros = 0.0;
+        double p50Micros = 0.0;
+        double p99Micros = 0.0;
+        double p999Micros = 0.0;
+        double maximoMicros = 0.0;
+    };
+
+    /**
+     * @class Medidor
+     * @brief Temporizador RAII: registra la duración de su alcance al destruirse
+     */
+    class Medidor {
+    public:
+        explicit Medidor(Operacion operacion)
+            : operacion(operacion), inicio(std::chrono::steady_clock::now()) {}
+        ~Medidor() {
+            registrar(operacion, std::chrono::steady_clock::now() - inicio);
+        }
+        Medidor(const Medidor&) = delete;
+        Medidor& operator=(const Medidor&) = delete;
+
+    private:
+        Operacion operacion;
+        std::chrono::steady_clock::time_point inicio;
+    };
+
+private:
+    static constexpr int SUBCUBETAS = 16;  // Error relativo máximo ~6 %
+    static constexpr int EXPONENTES = 40;  // Hasta 2^40 ns (~18 minutos)
+    static constexpr int CUBETAS = SUBCUBETAS * EXPONENTES;
+
+    /**
+     * @struct Histograma
+     * @brief Contadores de un hilo para una operación; solo su hilo escribe
+     */
+    struct Histograma {
+        std::atomic<uint64_t> cubetas[CUBETAS];
+        std::atomic<uint64_t> conteo;
+        std::atomic<uint64_t> sumaNanos;
+        std::atomic<uint64_t> maximoNanos;
+    };
+
+    /**
+     * @struct BloqueHilo
+     * @brief Histogramas de todas las operaciones de un hilo
+     */
+    struct BloqueHilo {
+        Histograma histogramas[TOTAL_OPERACIONES];
+        BloqueHilo();
+    };
+
+    // Los bloques viven hasta el fin del proceso: un hilo terminado conserva sus mediciones
+    static std::vector<std::unique_ptr<BloqueHilo>> bloques;
+    static std::mutex mutexBloques;
+    static std::atomic<bool> habilitado;
+    static std::string rutaVolcadoSalida;
+    static std::once_flag banderaSalida;
+    static const std::chrono::steady_clock::time_point inicioProceso;
+
+    static BloqueHilo& bloqueHiloActual();
+    static int indiceCubeta(uint64_t nanos);
+    static uint64_t limiteSuperiorCubeta(int indice);
+    static void volcarAlSalir();
+
+public:
+    // Archivo por defecto del volcado JSON
+    static constexpr const char* ARCHIVO_METRICAS_LATENCIA = "metricas_latencia.json";
+
+    /**
+     * @brief Registra una duración para una operación en el bloque del hilo actual
+     */
+    static void registrar(Operacion operacion, std::chrono::steady_clock::duration duracion);
+
+    /**
+     * @brief Ejecuta una función midiendo su duración; devuelve lo que ella devuelva
+     *
+     * Pensado para envolver un único viaje a MongoDB sin cambiar la forma del código:
+     * auto r = MetricasLatencia::medir(MetricasLatencia::MONGO_BUSQUEDA, [&]() { return c.find_one(f); });
+     */
+    template <typename Funcion>
+    static auto medir(Operacion operacion, Funcion&& funcion) -> decltype(funcion()) {
+        Medidor medidor(operacion);
+        return funcion();
+    }
+
+    /**
+     * @brief Activa o desactiva el registro (activo por defecto)
+     */
+    static void setHabilitado(bool valor) { habilitado.store(valor, std::memory_order_relaxed); }
+
+    /**
+     * @brief Nombre estable de una operación, usado como clave en el JSON
+     */
+    static const char* nombreOperacion(Operacion operacion);
+
+    /**
+     * @brief Agrega los histogramas de todos los hilos y calcula los percentiles
+     */
+    static std::vector<ResumenOperacion> obtenerResumen();
+
+    /**
+     * @brief Escribe el resumen en formato JSON
+     * @param ruta Archivo de destino
+     * @return true si el archivo se escribió, false en caso contrario
+     */
+    static bool volcarJSON(const std::string& ruta);
+
+    /**
+     * @brief Define el archivo que se escribe automáticamente al terminar el proceso
+     *
+     * La primera llamada registra el volcado con std::atexit.
+     * @param ruta Archivo de destino
+     */
+    static void setVolcadoAlSalir(const std::string& ruta);
+
+    /**
+     * @brief Imprime el resumen por consola
+     */
+    static void mostrarResumen();
+};
+
+#endif // METRICASLATENCIA_H
@@ -0,0 +1,111 @@
+/**
+ * @file MetricasMemoria.cpp
+ * @brief Implementación de los contadores de reservas y la lectura de memoria residente
+ */
+#include "MetricasMemoria.h"
+#include <iostream>
+#include <iomanip>
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <fstream>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+std::atomic<uint64_t> MetricasMemoria::objetos{ 0 };
+std::atomic<uint64_t> MetricasMemoria::bloques{ 0 };
+std::vector<MetricasMemoria::Carga> MetricasMemoria::cargas;
+std::mutex MetricasMemoria::mutexCargas;
+
+namespace {
+	double enMegas(size_t bytes) {
+		return static_cast<double>(bytes) / (1024.0 * 1024.0);
+	}
+}
+
+size_t MetricasMemoria::rssActual() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS contadores;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))) {
+		return static_cast<size_t>(contadores.WorkingSetSize);
+	}
+	return 0;
+#else
+	// statm: tamaño total y páginas residentes
+	std::ifstream statm("/proc/self/statm");
+	size_t total = 0, residentes = 0;
+	if (statm >> total >> residentes) {
+		return residentes * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+	}
+	return 0;
+#endif
+}
+
+size_t MetricasMemoria::rssPico() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS contadores;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))) {
+		return static_cast<size_t>(contadores.PeakWorkingSetSize);
+	}
+	return 0;
+#else
+	struct rusage uso;
+	if (getrusage(RUSAGE_SELF, &uso) == 0) {
+		return static_cast<size_t>(uso.ru_maxrss) * 1024; // ru_maxrss viene en KiB
+	}
+	return 0;
+#endif
+}
+
+MetricasMemoria::Instantanea MetricasMemoria::tomar() {
+	Instantanea instantanea;
+	instantanea.objetos = objetos.load(std::memory_order_relaxed);
+	instantanea.bloques = bloques.load(std::memory_order_relaxed);
+	instantanea.rssBytes = rssActual();
+	instantanea.rssPicoBytes = rssPico();
+	return instantanea;
+}
+
+void MetricasMemoria::registrarCarga(const std::string& nombre, const Instantanea& antes, const Instantanea& despues) {
+	std::lock_guard<std::mutex> lock(mutexCargas);
+	if (cargas.size() == MAX_CARGAS) {
+		cargas.erase(cargas.begin());
+	}
+	cargas.push_back(Carga{ nombre, antes, despues });
+}
+
+std::vector<MetricasMemoria::Carga> MetricasMemoria::obtenerCargas() {
+	std::lock_guard<std::mutex> lock(mutexCargas);
+	return cargas;
+}
+
+void MetricasMemoria::mostrarResumen() {
+	auto registradas = obtenerCargas();
+	Instantanea actual = tomar();
+
+	std::cout << "\n=== MEMORIA (pools de objetos) ===" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+	std::cout << "RSS actual: " << enMegas(actual.rssBytes) << " MB, pico: " << enMegas(actual.rssPicoBytes) << " MB" << std::endl;
+	std::cout << "Objetos entregados: " << actual.objetos << " en " << actual.bloques << " reservas" << std::endl;
+	if (registradas.empty()) {
+		return;
+	}
+
+	std::cout << std::left << std::setw(28) << "Carga"
+		<< std::right << std::setw(12) << "Objetos"
+		<< std::setw(12) << "Reservas"
+		<< std::setw(14) << "RSS antes"
+		<< std::setw(14) << "RSS despues"
+		<< std::setw(14) << "Pico" << std::endl;
+	for (const auto& carga : registradas) {
+		std::cout << std::left << std::setw(28) << carga.nombre
+			<< std::right << std::setw(12) << (carga.despues.objetos - carga.antes.objetos)
+			<< std::setw(12) << (carga.despues.bloques - carga.antes.bloques)
+			<< std::setw(14) << enMegas(carga.antes.rssBytes)
+			<< std::setw(14) << enMegas(carga.despues.rssBytes)
+			<< std::setw(14) << enMegas(carga.despues.rssPicoBytes) << std::endl;
+	}
+}
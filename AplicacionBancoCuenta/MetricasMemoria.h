@@ -0,0 +1,82 @@
+#pragma once
+#ifndef METRICASMEMORIA_H
+#define METRICASMEMORIA_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class MetricasMemoria
+ * @brief Reservas de los pools de objetos y memoria residente del proceso
+ *
+ * Los pools (PoolObjetos) cuentan cada objeto entregado y cada bloque pedido al
+ * sistema: la diferencia entre ambos es el número de reservas que se ahorraron frente
+ * a un new por objeto. Las cargas masivas toman una instantánea antes y otra después
+ * y registran la diferencia, que se muestra en el diagnóstico junto a la latencia.
+ */
+class MetricasMemoria {
+public:
+    /**
+     * @struct Instantanea
+     * @brief Contadores acumulados y memoria residente en un momento dado
+     */
+    struct Instantanea {
+        uint64_t objetos = 0;      // Objetos entregados por los pools
+        uint64_t bloques = 0;      // Reservas reales hechas por los pools
+        size_t rssBytes = 0;       // Memoria residente actual
+        size_t rssPicoBytes = 0;   // Máximo de memoria residente desde el inicio
+    };
+
+    /**
+     * @struct Carga
+     * @brief Diferencia entre las instantáneas de antes y después de una carga
+     */
+    struct Carga {
+        std::string nombre;
+        Instantanea antes;
+        Instantanea despues;
+    };
+
+private:
+    static std::atomic<uint64_t> objetos;
+    static std::atomic<uint64_t> bloques;
+    static std::vector<Carga> cargas;
+    static std::mutex mutexCargas;
+
+    // Se conservan solo las últimas cargas para mostrarlas en el diagnóstico
+    static constexpr size_t MAX_CARGAS = 16;
+
+public:
+    static void contarObjeto() { objetos.fetch_add(1, std::memory_order_relaxed); }
+    static void contarBloque() { bloques.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Memoria residente actual del proceso en bytes (0 si no se puede leer)
+     */
+    static size_t rssActual();
+
+    /**
+     * @brief Máximo de memoria residente del proceso en bytes (0 si no se puede leer)
+     */
+    static size_t rssPico();
+
+    static Instantanea tomar();
+
+    /**
+     * @brief Guarda el resultado de una carga masiva para el diagnóstico
+     */
+    static void registrarCarga(const std::string& nombre, const Instantanea& antes, const Instantanea& despues);
+
+    static std::vector<Carga> obtenerCargas();
+
+    /**
+     * @brief Imprime por consola las cargas registradas y la memoria actual
+     */
+    static void mostrarResumen();
+};
+
+#endif // METRICASMEMORIA_H
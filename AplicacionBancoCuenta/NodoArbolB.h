@@ -2,7 +2,113 @@
 #ifndef NODOARBOLB_H
 #define NODOARBOLB_H
 
-#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+/**
+ * @class ArregloFijo
+ * @brief Arreglo de capacidad fija almacenado dentro del propio objeto
+ *
+ * Ofrece el subconjunto de la interfaz de std::vector que usan los nodos del árbol
+ * (insert, erase, push_back, iteradores...) sin reservar memoria dinámica: los
+ * elementos quedan contiguos dentro del nodo y leerlos no requiere otra indirección.
+ *
+ * @tparam T Tipo de los elementos
+ * @tparam N Capacidad máxima
+ */
+template<typename T, int N>
+class ArregloFijo {
+	T datos[N] = {};
+	uint8_t cantidad = 0;
+
+	static_assert(N > 0 && N < 256, "La capacidad debe caber en el contador de 8 bits");
+
+public:
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	static constexpr int capacidad() { return N; }
+
+	size_t size() const { return cantidad; }
+	bool empty() const { return cantidad == 0; }
+
+	T* begin() { return datos; }
+	T* end() { return datos + cantidad; }
+	const T* begin() const { return datos; }
+	const T* end() const { return datos + cantidad; }
+
+	T& operator[](size_t i) { return datos[i]; }
+	const T& operator[](size_t i) const { return datos[i]; }
+	T& front() { return datos[0]; }
+	const T& front() const { return datos[0]; }
+	T& back() { return datos[cantidad - 1]; }
+	const T& back() const { return datos[cantidad - 1]; }
+
+	void push_back(T valor) {
+		datos[cantidad++] = std::move(valor);
+	}
+
+	void pop_back() {
+		datos[--cantidad] = T();
+	}
+
+	void clear() {
+		erase(begin(), end());
+	}
+
+	/**
+	 * @brief Inserta un valor en la posición indicada desplazando el resto a la derecha
+	 */
+	T* insert(T* posicion, T valor) {
+		std::move_backward(posicion, end(), end() + 1);
+		*posicion = std::move(valor);
+		cantidad++;
+		return posicion;
+	}
+
+	/**
+	 * @brief Inserta un rango en la posición indicada
+	 */
+	template<typename Iterador>
+	T* insert(T* posicion, Iterador primero, Iterador ultimo) {
+		size_t n = static_cast<size_t>(std::distance(primero, ultimo));
+		std::move_backward(posicion, end(), end() + n);
+		std::copy(primero, ultimo, posicion);
+		cantidad = static_cast<uint8_t>(cantidad + n);
+		return posicion;
+	}
+
+	/**
+	 * @brief Elimina [primero, ultimo) desplazando el resto a la izquierda
+	 *
+	 * Las posiciones liberadas se restablecen para no retener recursos de los valores movidos.
+	 */
+	T* erase(T* primero, T* ultimo) {
+		T* nuevoFin = std::move(ultimo, end(), primero);
+		std::fill(nuevoFin, end(), T());
+		cantidad = static_cast<uint8_t>(nuevoFin - datos);
+		return primero;
+	}
+
+	T* erase(T* posicion) {
+		return erase(posicion, posicion + 1);
+	}
+
+	/**
+	 * @brief Reemplaza el contenido por el rango indicado
+	 */
+	template<typename Iterador>
+	void assign(Iterador primero, Iterador ultimo) {
+		clear();
+		for (; primero != ultimo; ++primero) {
+			datos[cantidad++] = *primero;
+		}
+	}
+};
 
 /**
  * @class NodoArbolB
@@ -11,18 +117,26 @@
  * Clase genérica que representa un nodo en una estructura de árbol B,
  * almacenando punteros a objetos y referencias a nodos hijos.
  *
+ * Todo el nodo ocupa un único bloque alineado a línea de caché: las claves de
+ * ordenamiento van primero y contiguas (con Clave = uint64_t y CAPACIDAD = 15 llenan
+ * exactamente dos líneas de 64 bytes), seguidas de los punteros a hijos y, por
+ * último, de los punteros a los objetos, que solo se leen cuando la búsqueda acierta.
+ *
  * @tparam T Tipo de datos almacenados en el nodo
+ * @tparam Clave Tipo de la clave de ordenamiento
+ * @tparam CAPACIDAD Número máximo de claves por nodo (2 * grado - 1)
  */
-template<typename T>
-class NodoArbolB {
+template<typename T, typename Clave = uint64_t, int CAPACIDAD = 15>
+class alignas(64) NodoArbolB {
 public:
-
+	/** @brief Claves de ordenamiento, ordenadas ascendentemente; valoresClave[i] corresponde a claves[i] */
+	ArregloFijo<Clave, CAPACIDAD> valoresClave;
+	/** @brief Punteros a los nodos hijos */
+	ArregloFijo<NodoArbolB*, CAPACIDAD + 1> hijos; // Punteros a los hijos
+	/** @brief Punteros a las claves (objetos) almacenados en este nodo */
+	ArregloFijo<T*, CAPACIDAD> claves;
 	/** @brief Indica si este nodo es una hoja (no tiene hijos) */
 	bool esHoja;
-	/** @brief Vector de punteros a las claves (objetos) almacenados en este nodo */
-	std::vector<T*> claves;
-	/** @brief Vector de punteros a los nodos hijos */
-	std::vector<NodoArbolB<T>*> hijos; // Punteros a los hijos
 
 	/**
 	 * @brief Constructor del nodo de Árbol B
@@ -30,6 +144,14 @@ public:
 	 */
 	NodoArbolB(bool hoja = true) : esHoja(hoja) {}
 
+	NodoArbolB(const NodoArbolB&) = delete;
+	NodoArbolB& operator=(const NodoArbolB&) = delete;
+
+	/**
+	 * @brief Número de claves almacenadas en el nodo
+	 */
+	int numClaves() const { return static_cast<int>(valoresClave.size()); }
+
 	/**
 	 * @brief Destructor, libera la memoria de los nodos hijos recursivamente
 	 */
@@ -40,4 +162,4 @@ public:
 	}
 };
 
-#endif //NODOARBOLB_H
\ No newline at end of file
+#endif //NODOARBOLB_H
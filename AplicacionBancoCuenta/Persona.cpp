@@ -27,6 +27,8 @@
 #include "Utilidades.h"
 #include "_BaseDatosPersona.h"
 #include "ConexionMongo.h"
+#include "AsignadorNumerosCuenta.h"
+#include "FabricaRepositorioBanco.h"
 
  /**
   * @namespace PersonaUI
@@ -191,49 +193,61 @@ namespace PersonaUI {
 
 using namespace std;
 
-Persona::Persona() : cabezaAhorros(nullptr), cabezaCorriente(nullptr),
+namespace {
+	// Crear los colaboradores por persona costaba varias reservas en cada carga masiva
+	const PersonaValidator* validadorCompartido() {
+		static const PersonaValidator validador;
+		return &validador;
+	}
+
+	const PersonaDataProcessor* procesadorCompartido() {
+		static const PersonaDataProcessor procesador;
+		return &procesador;
+	}
+}
+
+Persona::Persona() : cuentas(),
 numCuentas(0), numCorrientes(0), isDestroyed(false),
-validator(std::make_unique<PersonaValidator>()),
-dataProcessor(std::make_unique<PersonaDataProcessor>()) {
+validator(validadorCompartido()),
+dataProcessor(procesadorCompartido()) {
 }
 
 Persona::Persona(const string& cedula, const string& nombres, const string& apellidos,
 	const string& fechaNacimiento, const string& correo, const string& direccion)
 	: cedula(cedula), nombres(nombres), apellidos(apellidos),
 	fechaNacimiento(fechaNacimiento), correo(correo), direccion(direccion),
-	cabezaAhorros(nullptr), cabezaCorriente(nullptr), numCuentas(0), numCorrientes(0),
+	cuentas(), numCuentas(0), numCorrientes(0),
 	isDestroyed(false),
-	validator(std::make_unique<PersonaValidator>()),
-	dataProcessor(std::make_unique<PersonaDataProcessor>()) {
+	validator(validadorCompartido()),
+	dataProcessor(procesadorCompartido()) {
 }
 
 Persona::~Persona() {
-	liberarListaRecursivo(cabezaAhorros);
-	liberarListaRecursivo(cabezaCorriente);
+	// Cada cuenta libera su fila al destruirse; se recorre una copia de la lista
+	TablaCuentas& tabla = TablaCuentas::global();
+	TablaCuentas::FilasPersona filas = cuentas;
+	cuentas = TablaCuentas::FilasPersona();
+	for (TablaCuentas::Fila fila : filas) {
+		// El destructor de Cuenta es protegido: se borra por la clase concreta
+		if (tabla.tipo(fila) == TipoCuenta::AHORROS) {
+			delete static_cast<CuentaAhorros*>(tabla.cuenta(fila));
+		}
+		else {
+			delete static_cast<CuentaCorriente*>(tabla.cuenta(fila));
+		}
+	}
 	isDestroyed = true;
 }
 
-template void Persona::liberarListaRecursivo<CuentaAhorros>(CuentaAhorros*);
-template void Persona::liberarListaRecursivo<CuentaCorriente>(CuentaCorriente*);
-template CuentaAhorros* Persona::buscarEnListaRecursivo<CuentaAhorros>(CuentaAhorros*, const std::function<bool(CuentaAhorros*)>&);
-template CuentaCorriente* Persona::buscarEnListaRecursivo<CuentaCorriente>(CuentaCorriente*, const std::function<bool(CuentaCorriente*)>&);
-
-// === MÉTODOS RECURSIVOS PRIVADOS ===
-
-template<typename T>
-void Persona::liberarListaRecursivo(T* nodo) {
-	if (!nodo) return;
-
-	T* siguiente = nodo->getSiguiente();
-	delete nodo;
-	liberarListaRecursivo(siguiente);
-}
-
-template<typename T>
-T* Persona::buscarEnListaRecursivo(T* nodo, const std::function<bool(T*)>& criterio) {
-	if (!nodo) return nullptr;
-	if (criterio(nodo)) return nodo;
-	return buscarEnListaRecursivo(nodo->getSiguiente(), criterio);
+bool Persona::agregarCuenta(Cuenta<double>* cuenta) {
+	if (!cuenta) {
+		return false;
+	}
+	if (!cuentas.agregar(cuenta->getFila())) {
+		return false;
+	}
+	TablaCuentas::global().setTitular(cuenta->getFila(), this);
+	return true;
 }
 
 // === SETTERS REFACTORIZADOS CON BUILDER PATTERN ===
@@ -968,10 +982,11 @@ int Persona::buscarPersonaPorCriterio(const std::string& criterioBusqueda, const
 
 	int cuentasEncontradas = 0;
 	bool mostrarDatosTitular = false;
+	const Fecha fechaBuscada(fechaApertura);
 
 	// Lambda para buscar en cada tipo de cuenta
-	auto buscarEnLista = [&](Cuenta<double>* actual, const std::string& tipo) -> void {
-		while (actual) {
+	auto buscarEnLista = [&](TipoCuenta tipoCuenta, const std::string& tipo) -> void {
+		recorrerCuentas(tipoCuenta, [&](Cuenta<double>* actual) {
 			bool encontrado = false;
 
 			if (criterioBusqueda == "Numero de cuenta" &&
@@ -979,8 +994,8 @@ int Persona::buscarPersonaPorCriterio(const std::string& criterioBusqueda, const
 				encontrado = true;
 			}
 			else if (criterioBusqueda == "Fecha de apertura" &&
-				actual->getFechaApertura().toString()
-				== fechaApertura) {
+				fechaBuscada.tieneFecha() &&
+				actual->getFechaApertura() == fechaBuscada) {
 				encontrado = true;
 			}
 			else if (criterioBusqueda == "Saldo mayor a" &&
@@ -1008,14 +1023,12 @@ int Persona::buscarPersonaPorCriterio(const std::string& criterioBusqueda, const
 				actual->mostrarInformacion(this->cedula, false); // false para no borrar la pantalla
 				cuentasEncontradas++;
 			}
-
-			actual = actual->getSiguiente();
-		}
+			});
 		};
 
-	// Buscar en ambas listas
-	buscarEnLista(cabezaAhorros, "Ahorros");
-	buscarEnLista(cabezaCorriente, "Corriente");
+	// Buscar en ambos tipos de cuenta
+	buscarEnLista(TipoCuenta::AHORROS, "Ahorros");
+	buscarEnLista(TipoCuenta::CORRIENTE, "Corriente");
 
 	return cuentasEncontradas;
 }
@@ -1033,17 +1046,13 @@ void Persona::buscarPersonaPorFecha(const std::string& fecha) const {
 
 	int encontrados = 0;
 	bool datosPersonalesMostrados = false;
+	const Fecha fechaBuscada(fecha);
 
 	// Funcion para mostrar datos personales solo una vez
-	auto buscarFecha = [&](Cuenta<double>* actual, const std::string& tipo) -> void {
-		while (actual) {
-			// Verificar puntero a cuenta
-			if (!actual) { // Si el puntero es nulo, continuar con el siguiente nodo
-				actual = actual->getSiguiente();
-				continue;
-			}
+	auto buscarFecha = [&](TipoCuenta tipoCuenta, const std::string& tipo) -> void {
+		recorrerCuentas(tipoCuenta, [&](Cuenta<double>* actual) {
 			// Verificar coincidencia de fecha
-			if (actual->getFechaApertura().toString() == fecha) { // Si la fecha coincide
+			if (fechaBuscada.tieneFecha() && actual->getFechaApertura() == fechaBuscada) { // Si la fecha coincide
 				// Mostrar datos personales antes de la primera cuenta
 				if (!datosPersonalesMostrados) { // Si no se han mostrado los datos personales
 					std::cout << "\n----- DATOS DEL TITULAR -----\n";
@@ -1059,13 +1068,12 @@ void Persona::buscarPersonaPorFecha(const std::string& fecha) const {
 				actual->mostrarInformacion(this->cedula, false); // false para no borrar la pantalla
 				encontrados++;
 			}
-			actual = actual->getSiguiente();
-		}
+			});
 		};
 
-	//buscar en ambas listas
-	buscarFecha(cabezaAhorros, "Ahorros");
-	buscarFecha(cabezaCorriente, "Corriente");
+	//buscar en ambos tipos de cuenta
+	buscarFecha(TipoCuenta::AHORROS, "Ahorros");
+	buscarFecha(TipoCuenta::CORRIENTE, "Corriente");
 }
 
 /**
@@ -1108,9 +1116,9 @@ int Persona::guardarCuentas(std::ofstream& archivo, std::string tipo) const {
 	}
 	int contador = 0;
 
-	auto guardarLista = [&](Cuenta<double>* actual, const std::string& tipo) -> void {
-		while (actual) {
-			if (actual->getNumeroCuenta() != "") { // Asegurarse de que la cuenta no sea nula
+	auto guardarLista = [&](TipoCuenta tipoCuenta, const std::string& tipo) -> void {
+		recorrerCuentas(tipoCuenta, [&](Cuenta<double>* actual) {
+			if (!actual->getNumeroCuenta().empty()) { // Asegurarse de que la cuenta no sea nula
 				archivo << tipo << "_INICIO\n";
 				archivo << "NUMERO_CUENTA:" << actual->getNumeroCuenta() << "\n";
 				archivo << "SALDO:" << actual->consultarSaldo() << "\n";
@@ -1120,16 +1128,15 @@ int Persona::guardarCuentas(std::ofstream& archivo, std::string tipo) const {
 				archivo << "CUENTA_" << tipo << "_FIN\n";
 				contador++;
 			}
-			actual = actual->getSiguiente();
-		}
+			});
 		};
 
 	if (tipo == "AHORROS") { // Si es tipo Ahorros
-		guardarLista(cabezaAhorros, "AHORROS"); // Guardar cuentas de ahorro
+		guardarLista(TipoCuenta::AHORROS, "AHORROS"); // Guardar cuentas de ahorro
 	}
 	else if (tipo == "CORRIENTE") // Si es tipo Corriente
 	{
-		guardarLista(cabezaCorriente, "CORRIENTE"); // Guardar cuentas corrientes
+		guardarLista(TipoCuenta::CORRIENTE, "CORRIENTE"); // Guardar cuentas corrientes
 	}
 
 	return contador;
@@ -1159,14 +1166,14 @@ bool Persona::crearAgregarCuentaAhorros(CuentaAhorros* nuevaCuenta, const std::s
 	}
 
 	// Verificar limite de cuentas
-	if (this->numCuentas >= MAX_CUENTAS) {
+	if (this->numCuentas >= MAX_CUENTAS || this->cuentas.llena()) {
 		cout << "No se pueden agregar mas cuentas, limite alcanzado." << endl;
 		return false;
 	}
 
 	try {
-		// Crear instancia de base de datos
-		_BaseDatosPersona baseDatos(ConexionMongo::obtenerClienteBaseDatos());
+		// Repositorio del motor configurado
+		IRepositorioBanco& baseDatos = FabricaRepositorioBanco::obtenerRepositorio();
 
 		// Generar fecha actual
 		Fecha fechaActual;
@@ -1198,7 +1205,7 @@ bool Persona::crearAgregarCuentaAhorros(CuentaAhorros* nuevaCuenta, const std::s
 
 		// Configurar datos de la cuenta
 		nuevaCuenta->setFechaApertura(fechaStr);
-		nuevaCuenta->setEstadoCuenta("ACTIVA");
+		nuevaCuenta->setEstado(EstadoCuenta::ACTIVA);
 		nuevaCuenta->depositar(montoInicial);
 		nuevaCuenta->setNumeroCuenta(numeroCuenta);
 
@@ -1223,13 +1230,8 @@ bool Persona::crearAgregarCuentaAhorros(CuentaAhorros* nuevaCuenta, const std::s
 			return false;
 		}
 
-		// Agregar a la lista enlazada en memoria
-		nuevaCuenta->setSiguiente(cabezaAhorros);
-		nuevaCuenta->setAnterior(nullptr);
-		if (cabezaAhorros != nullptr) {
-			cabezaAhorros->setAnterior(nuevaCuenta);
-		}
-		this->cabezaAhorros = nuevaCuenta;
+		// Agregar a las cuentas en memoria
+		agregarCuenta(nuevaCuenta);
 		this->numCuentas++;
 
 		// Mostrar información
@@ -1265,9 +1267,15 @@ bool Persona::crearAgregarCuentaCorriente(CuentaCorriente* nuevaCuenta, const st
 		return false;
 	}
 
+	// Verificar limite de cuentas
+	if (this->cuentas.llena()) {
+		cout << "No se pueden agregar mas cuentas, limite alcanzado." << endl;
+		return false;
+	}
+
 	try {
-		// Crear instancia de base de datos
-		_BaseDatosPersona baseDatos(ConexionMongo::obtenerClienteBaseDatos());
+		// Repositorio del motor configurado
+		IRepositorioBanco& baseDatos = FabricaRepositorioBanco::obtenerRepositorio();
 
 		// Generar fecha actual
 		Fecha fechaActual;
@@ -1291,7 +1299,7 @@ bool Persona::crearAgregarCuentaCorriente(CuentaCorriente* nuevaCuenta, const st
 
 		// Configurar datos de la cuenta
 		nuevaCuenta->setFechaApertura(fechaStr);
-		nuevaCuenta->setEstadoCuenta("ACTIVA");
+		nuevaCuenta->setEstado(EstadoCuenta::ACTIVA);
 		nuevaCuenta->depositar(montoInicial);
 		nuevaCuenta->setNumeroCuenta(numeroCuenta);
 
@@ -1316,13 +1324,8 @@ bool Persona::crearAgregarCuentaCorriente(CuentaCorriente* nuevaCuenta, const st
 			return false;
 		}
 
-		// Agregar a la lista enlazada en memoria
-		nuevaCuenta->setSiguiente(cabezaCorriente);
-		nuevaCuenta->setAnterior(nullptr);
-		if (cabezaCorriente != nullptr) {
-			cabezaCorriente->setAnterior(nuevaCuenta);
-		}
-		this->cabezaCorriente = nuevaCuenta;
+		// Agregar a las cuentas en memoria
+		agregarCuenta(nuevaCuenta);
 		this->numCuentas++;
 
 		// Mostrar información
@@ -1356,7 +1359,7 @@ bool Persona::crearSoloCuentaAhorros(CuentaAhorros* nuevaCuenta, const std::stri
 	}
 
 	// Verificar limite de cuentas
-	if (this->numCuentas >= MAX_CUENTAS) {
+	if (this->numCuentas >= MAX_CUENTAS || this->cuentas.llena()) {
 		cout << "No se pueden agregar mas cuentas, limite alcanzado." << endl;
 		return false;
 	}
@@ -1366,7 +1369,7 @@ bool Persona::crearSoloCuentaAhorros(CuentaAhorros* nuevaCuenta, const std::stri
 		Fecha fechaActual;
 		std::string fechaStr = fechaActual.obtenerFechaFormateada();
 		nuevaCuenta->setFechaApertura(fechaStr);
-		nuevaCuenta->setEstadoCuenta("ACTIVA");
+		nuevaCuenta->setEstado(EstadoCuenta::ACTIVA);
 
 		// Desea ingresar un saldo inicial, si o no? maximo 15000.00 USD
 		double montoInicial = 0.0;
@@ -1399,13 +1402,8 @@ bool Persona::crearSoloCuentaAhorros(CuentaAhorros* nuevaCuenta, const std::stri
 		// Mostrar informacion
 		nuevaCuenta->mostrarInformacion(cedulaEsperada, true);
 
-		// Agregar a la lista enlazada
-		nuevaCuenta->setSiguiente(cabezaAhorros);
-		nuevaCuenta->setAnterior(nullptr);
-		if (cabezaAhorros != nullptr) {
-			cabezaAhorros->setAnterior(nuevaCuenta);
-		}
-		this->cabezaAhorros = nuevaCuenta;
+		// Agregar a las cuentas en memoria
+		agregarCuenta(nuevaCuenta);
 		this->numCuentas++;
 
 		std::cout << "---- Cuenta de Ahorros creada correctamente ----" << std::endl;
@@ -1432,12 +1430,18 @@ bool Persona::crearSoloCuentaCorriente(CuentaCorriente* nuevaCuenta, const std::
 		return false;
 	}
 
+	// Verificar limite de cuentas
+	if (this->cuentas.llena()) {
+		cout << "No se pueden agregar mas cuentas, limite alcanzado." << endl;
+		return false;
+	}
+
 	try {
 		// Generar numero de cuenta
 		Fecha fechaActual;
 		std::string fechaStr = fechaActual.obtenerFechaFormateada();
 		nuevaCuenta->setFechaApertura(fechaStr);
-		nuevaCuenta->setEstadoCuenta("ACTIVA");
+		nuevaCuenta->setEstado(EstadoCuenta::ACTIVA);
 
 		// Obligatorio ingresar un monto inicial minimo de 250.00 USD
 		double montoInicial = 0.0;
@@ -1463,13 +1467,8 @@ bool Persona::crearSoloCuentaCorriente(CuentaCorriente* nuevaCuenta, const std::
 		// Mostrar informacion
 		nuevaCuenta->mostrarInformacion(cedulaEsperada, true);
 
-		// Agregar a la lista enlazada
-		nuevaCuenta->setSiguiente(cabezaCorriente);
-		nuevaCuenta->setAnterior(nullptr);
-		if (cabezaCorriente != nullptr) {
-			cabezaCorriente->setAnterior(nuevaCuenta);
-		}
-		this->cabezaCorriente = nuevaCuenta;
+		// Agregar a las cuentas en memoria
+		agregarCuenta(nuevaCuenta);
 		this->numCuentas++;
 
 		std::cout << "---- Cuenta de Corriente creada correctamente ----" << std::endl;
@@ -1499,23 +1498,11 @@ std::string Persona::crearNumeroCuenta(Cuenta<double>* nuevaCuenta, const std::s
 	}
 
 	try {
-		// Crear instancia de base de datos usando la conexión actual
-		_BaseDatosPersona baseDatos(ConexionMongo::obtenerClienteBaseDatos());
-
-		// Obtener el último secuencial desde MongoDB
-		int ultimoSecuencialBD = baseDatos.obtenerUltimoSecuencial(sucursal);
-
-		// Obtener el mayor número de cuenta existente en la BD por si hay inconsistencias
-		int mayorSecuencialCuentas = baseDatos.obtenerMayorNumeroCuentaPorSucursal(sucursal);
-
-		// También verificar en memoria (cuentas locales no guardadas aún)
-		int mayorSecuencialMemoria = obtenerMayorSecuencialEnMemoria(sucursal);
-
-		// Usar el máximo de todos los valores encontrados
-		int mayorSecuencial = std::max({ ultimoSecuencialBD, mayorSecuencialCuentas, mayorSecuencialMemoria });
-
-		// Incrementar para obtener el siguiente número secuencial
-		int nuevoSecuencial = mayorSecuencial + 1;
+		// Secuencial único entre terminales, tomado del bloque reservado por este proceso
+		int nuevoSecuencial = AsignadorNumerosCuenta::siguienteSecuencial(FabricaRepositorioBanco::obtenerRepositorio(), sucursal);
+		if (nuevoSecuencial < 0) {
+			return "";
+		}
 
 		// Formatear el número de cuenta con ceros a la izquierda
 		std::ostringstream oss;
@@ -1538,11 +1525,6 @@ std::string Persona::crearNumeroCuenta(Cuenta<double>* nuevaCuenta, const std::s
 			return "";
 		}
 
-		// Actualizar el secuencial en la base de datos
-		if (!baseDatos.actualizarSecuencial(sucursal, nuevoSecuencial)) {
-			std::cerr << "Advertencia: No se pudo actualizar el secuencial en la base de datos." << std::endl;
-		}
-
 		// Asignar el número de cuenta al objeto
 		nuevaCuenta->setNumeroCuenta(numeroCuentaStr);
 
@@ -1555,48 +1537,6 @@ std::string Persona::crearNumeroCuenta(Cuenta<double>* nuevaCuenta, const std::s
 	}
 }
 
-/**
- * @brief Obtiene el mayor número secuencial de cuentas en memoria para una sucursal
- * @param sucursal Código de sucursal
- * @return Mayor número secuencial encontrado en memoria
- */
-int Persona::obtenerMayorSecuencialEnMemoria(const std::string& sucursal) {
-	int mayorSecuencial = 0;
-	std::vector<Cuenta<double>*> cuentas;
-
-	// Recolectar todas las cuentas en memoria
-	CuentaAhorros* actualAhorros = cabezaAhorros;
-	while (actualAhorros) {
-		cuentas.push_back(actualAhorros);
-		actualAhorros = actualAhorros->getSiguiente();
-	}
-
-	CuentaCorriente* actualCorriente = cabezaCorriente;
-	while (actualCorriente) {
-		cuentas.push_back(actualCorriente);
-		actualCorriente = actualCorriente->getSiguiente();
-	}
-
-	// Buscar el mayor número secuencial para la sucursal especificada
-	for (auto cuenta : cuentas) {
-		std::string numCuenta = cuenta->getNumeroCuenta();
-
-		if (numCuenta.length() == 10 && numCuenta.substr(0, 3) == sucursal) {
-			try {
-				int numSecuencial = std::stoi(numCuenta.substr(3, 6));
-				if (numSecuencial > mayorSecuencial) {
-					mayorSecuencial = numSecuencial;
-				}
-			}
-			catch (const std::exception& e) {
-				std::cerr << "Error al procesar número de cuenta en memoria: " << e.what() << std::endl;
-			}
-		}
-	}
-
-	return mayorSecuencial;
-}
-
 /**
  * @brief Presenta un selector de sucursal bancaria
  *
@@ -1676,32 +1616,4 @@ std::string Persona::seleccionSucursal() {
  */
 std::string Persona::msgIngresoDatos() const {
 	return "\n----- INGRESO DE DATOS -----\n";
-}
-
-template<typename T>
-T* Persona::configurarCabezaLista(T* nuevaCabeza, T*& cabezaActual) {
-	if (!nuevaCabeza) return cabezaActual;
-
-	// Aplicando Command Pattern para encapsular la operación
-	auto comando = [&cabezaActual](T* nodo) {
-		nodo->setSiguiente(cabezaActual);
-		nodo->setAnterior(nullptr);
-
-		if (cabezaActual) {
-			cabezaActual->setAnterior(nodo);
-		}
-		};
-
-	comando(nuevaCabeza);
-	cabezaActual = nuevaCabeza;
-
-	return cabezaActual;
-}
-
-CuentaAhorros* Persona::setCabezaAhorros(CuentaAhorros* nuevaCabeza) {
-	return configurarCabezaLista(nuevaCabeza, cabezaAhorros);
-}
-
-CuentaCorriente* Persona::setCabezaCorriente(CuentaCorriente* nuevaCabeza) {
-	return configurarCabezaLista(nuevaCabeza, cabezaCorriente);
 }
\ No newline at end of file
@@ -39,28 +39,15 @@ private:
     string fechaNacimiento;
     string correo;
     string direccion;
-    CuentaAhorros* cabezaAhorros;
-    CuentaCorriente* cabezaCorriente;
+    TablaCuentas::FilasPersona cuentas;   // Filas de sus cuentas en TablaCuentas, en orden de alta
     int numCuentas = 0;
     int numCorrientes = 0;
     bool isDestroyed = false;
 
     // === COLABORADORES (Dependency Injection) ===
-    std::unique_ptr<PersonaValidator> validator;
-    std::unique_ptr<PersonaDataProcessor> dataProcessor;
-
-    // === MÉTODOS PRIVADOS REFACTORIZADOS ===
-    int obtenerMayorSecuencialEnMemoria(const std::string& sucursal);
-
-    // Métodos recursivos para manejo de listas enlazadas
-    template<typename T>
-    void liberarListaRecursivo(T* nodo);
-
-    template<typename T>
-    T* buscarEnListaRecursivo(T* nodo, const std::function<bool(T*)>& criterio);
-
-    template<typename T>
-    T* configurarCabezaLista(T* nuevaCabeza, T*& cabezaActual);
+    // No guardan estado: todas las personas comparten una instancia de cada uno
+    const PersonaValidator* validator;
+    const PersonaDataProcessor* dataProcessor;
 
     // Input processors refactorizados
     std::string procesarEntradaConValidacion(const std::string& tipo, const std::string& prompt, const std::function<std::string()>& inputFunction);
@@ -72,6 +59,10 @@ public:
         const string& fechaNacimiento, const string& correo, const string& direccion);
     ~Persona();
 
+    // Una persona es dueña de sus cuentas: copiarla las borraría dos veces
+    Persona(const Persona&) = delete;
+    Persona& operator=(const Persona&) = delete;
+
     // === VALIDACIÓN ===
     bool isValidInstance() const { return !isDestroyed; }
 
@@ -85,20 +76,37 @@ public:
     void setNumeCuentas(int numCuentas) { this->numCuentas = numCuentas; }
     void setNumCorrientes(int numCorrientes) { this->numCorrientes = numCorrientes; }
 
-    CuentaAhorros* setCabezaAhorros(CuentaAhorros* nuevaCabeza);
-    CuentaCorriente* setCabezaCorriente(CuentaCorriente* nuevaCabeza);
+    /**
+     * @brief Asocia una cuenta ya construida a la persona, que pasa a ser su dueña
+     * @return false si la cuenta es nula o la persona ya tiene el máximo de cuentas
+     */
+    bool agregarCuenta(Cuenta<double>* cuenta);
 
     // === GETTERS ===
-    string getCedula() const { return this->cedula; }
-    string getNombres() const { return this->nombres; }
-    string getApellidos() const { return this->apellidos; }
-    string getFechaNacimiento() const { return this->fechaNacimiento; }
-    string getCorreo() const { return this->correo; }
-    string getDireccion() const { return this->direccion; }
+    // Devuelven referencias: extractores de claves, índices y comparaciones no copian
+    const string& getCedula() const { return this->cedula; }
+    const string& getNombres() const { return this->nombres; }
+    const string& getApellidos() const { return this->apellidos; }
+    const string& getFechaNacimiento() const { return this->fechaNacimiento; }
+    const string& getCorreo() const { return this->correo; }
+    const string& getDireccion() const { return this->direccion; }
     int getNumCuentas() const { return this->numCuentas; }
     int getNumCorrientes() const { return this->numCorrientes; }
-    CuentaAhorros* getCabezaAhorros() const { return this->cabezaAhorros; }
-    CuentaCorriente* getCabezaCorriente() const { return this->cabezaCorriente; }
+    const TablaCuentas::FilasPersona& getFilasCuentas() const { return this->cuentas; }
+    bool cuentasLlenas() const { return this->cuentas.llena(); }
+
+    /**
+     * @brief Aplica la función a cada cuenta del tipo indicado, en orden de alta
+     */
+    template<typename Funcion>
+    void recorrerCuentas(TipoCuenta tipo, Funcion&& funcion) const {
+        const TablaCuentas& tabla = TablaCuentas::global();
+        for (TablaCuentas::Fila fila : cuentas) {
+            if (tabla.tipo(fila) == tipo) {
+                funcion(tabla.cuenta(fila));
+            }
+        }
+    }
 
     // === MÉTODOS DE ENTRADA DE DATOS REFACTORIZADOS ===
     void ingresarDatos();
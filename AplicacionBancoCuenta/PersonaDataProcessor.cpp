@@ -39,44 +39,33 @@ void PersonaDataProcessor::ejecutarProcesamiento(const std::string& tipo, Person
     }
 }
 
-// === Métodos recursivos ===
+// === Recorridos de cuentas ===
 
 template<typename T>
-void PersonaDataProcessor::procesarListaRecursivo(T* nodo, const std::function<void(T*)>& accion) const {
-    if (!nodo) return;
-
-    accion(nodo);
-    procesarListaRecursivo(nodo->getSiguiente(), accion);
-}
+void PersonaDataProcessor::procesarCuentas(Persona* persona, TipoCuenta tipo, const std::function<void(T*)>& accion) const {
+    if (!persona) return;
 
-template<typename T>
-int PersonaDataProcessor::contarElementosRecursivo(T* nodo) const {
-    if (!nodo) return 0;
-    return 1 + contarElementosRecursivo(nodo->getSiguiente());
+    persona->recorrerCuentas(tipo, [&accion](Cuenta<double>* cuenta) {
+        accion(static_cast<T*>(cuenta));
+    });
 }
 
 void PersonaDataProcessor::procesarCuentasAhorros(Persona* persona, const std::function<void(CuentaAhorros*)>& accion) const {
-    if (persona && persona->getCabezaAhorros()) {
-        procesarListaRecursivo(persona->getCabezaAhorros(), accion);
-    }
+    procesarCuentas<CuentaAhorros>(persona, TipoCuenta::AHORROS, accion);
 }
 
 void PersonaDataProcessor::procesarCuentasCorriente(Persona* persona, const std::function<void(CuentaCorriente*)>& accion) const {
-    if (persona && persona->getCabezaCorriente()) {
-        procesarListaRecursivo(persona->getCabezaCorriente(), accion);
-    }
+    procesarCuentas<CuentaCorriente>(persona, TipoCuenta::CORRIENTE, accion);
 }
 
 int PersonaDataProcessor::contarCuentasAhorros(Persona* persona) const {
-    return persona ? contarElementosRecursivo(persona->getCabezaAhorros()) : 0;
+    int total = 0;
+    procesarCuentasAhorros(persona, [&total](CuentaAhorros*) { total++; });
+    return total;
 }
 
 int PersonaDataProcessor::contarCuentasCorriente(Persona* persona) const {
-    return persona ? contarElementosRecursivo(persona->getCabezaCorriente()) : 0;
+    int total = 0;
+    procesarCuentasCorriente(persona, [&total](CuentaCorriente*) { total++; });
+    return total;
 }
-
-// Instanciaciones explícitas de templates
-template void PersonaDataProcessor::procesarListaRecursivo<CuentaAhorros>(CuentaAhorros*, const std::function<void(CuentaAhorros*)>&) const;
-template void PersonaDataProcessor::procesarListaRecursivo<CuentaCorriente>(CuentaCorriente*, const std::function<void(CuentaCorriente*)>&) const;
-template int PersonaDataProcessor::contarElementosRecursivo<CuentaAhorros>(CuentaAhorros*) const;
-template int PersonaDataProcessor::contarElementosRecursivo<CuentaCorriente>(CuentaCorriente*) const;
\ No newline at end of file
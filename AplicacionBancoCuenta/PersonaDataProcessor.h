@@ -6,6 +6,7 @@
 #include <functional>
 #include <vector>
 #include <memory>
+#include "TablaCuentas.h"
 
 class Persona;
 class CuentaAhorros;
@@ -45,18 +46,15 @@ class PersonaDataProcessor {
 private:
     std::vector<std::unique_ptr<IDataProcessor>> procesadores;
 
-    // Funciones recursivas para manejo de listas enlazadas
+    // Recorre las cuentas de un tipo de la persona convirtiéndolas a su clase concreta
     template<typename T>
-    void procesarListaRecursivo(T* nodo, const std::function<void(T*)>& accion) const;
-
-    template<typename T>
-    int contarElementosRecursivo(T* nodo) const;
+    void procesarCuentas(Persona* persona, TipoCuenta tipo, const std::function<void(T*)>& accion) const;
 
 public:
     PersonaDataProcessor();
     void ejecutarProcesamiento(const std::string& tipo, Persona* persona, const std::string& parametro = "") const;
 
-    // Métodos recursivos específicos
+    // Recorridos específicos
     void procesarCuentasAhorros(Persona* persona, const std::function<void(CuentaAhorros*)>& accion) const;
     void procesarCuentasCorriente(Persona* persona, const std::function<void(CuentaCorriente*)>& accion) const;
 
@@ -0,0 +1,203 @@
+#pragma once
+#ifndef POOLOBJETOS_H
+#define POOLOBJETOS_H
+
+#include "MetricasMemoria.h"
+#include <vector>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+/**
+ * @class PoolObjetos
+ * @brief Objetos de un tipo en bloques de TAMANO_BLOQUE casillas, liberados en lote
+ *
+ * Cada bloque es una sola reserva al sistema, así que una carga de un millón de
+ * personas pide unos miles de bloques en vez de un millón de news, y los objetos
+ * quedan contiguos en el orden en que se crearon. Las direcciones son estables: los
+ * bloques no se mueven al crecer.
+ *
+ * destruir() devuelve una casilla para reutilizarla; liberarTodo() (y el destructor)
+ * destruye en lote todo lo que siga vivo, que es el uso normal: lo que se cargó junto
+ * se libera junto. No sincroniza el acceso.
+ */
+template<typename T, size_t TAMANO_BLOQUE = 1024>
+class PoolObjetos {
+private:
+    /**
+     * @struct Casilla
+     * @brief Memoria para un objeto; viva indica si hay un objeto construido en ella
+     */
+    struct Casilla {
+        alignas(T) unsigned char memoria[sizeof(T)];
+        bool viva;
+    };
+
+    std::vector<std::unique_ptr<Casilla[]>> bloques;
+    size_t usadasUltimo;           // Casillas ya entregadas del último bloque
+    std::vector<Casilla*> libres;  // Casillas devueltas con destruir()
+    size_t vivos;
+
+    static Casilla* casillaDe(void* memoria) {
+        // memoria es el primer miembro de Casilla: comparten dirección
+        return reinterpret_cast<Casilla*>(memoria);
+    }
+
+public:
+    PoolObjetos() : usadasUltimo(TAMANO_BLOQUE), vivos(0) {}
+    ~PoolObjetos() { liberarTodo(); }
+
+    PoolObjetos(const PoolObjetos&) = delete;
+    PoolObjetos& operator=(const PoolObjetos&) = delete;
+
+    PoolObjetos(PoolObjetos&& otro) noexcept
+        : bloques(std::move(otro.bloques)), usadasUltimo(otro.usadasUltimo),
+          libres(std::move(otro.libres)), vivos(otro.vivos) {
+        otro.bloques.clear();
+        otro.libres.clear();
+        otro.usadasUltimo = TAMANO_BLOQUE;
+        otro.vivos = 0;
+    }
+
+    PoolObjetos& operator=(PoolObjetos&& otro) noexcept {
+        if (this != &otro) {
+            liberarTodo();
+            bloques = std::move(otro.bloques);
+            usadasUltimo = otro.usadasUltimo;
+            libres = std::move(otro.libres);
+            vivos = otro.vivos;
+            otro.bloques.clear();
+            otro.libres.clear();
+            otro.usadasUltimo = TAMANO_BLOQUE;
+            otro.vivos = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Memoria sin construir para un T; se devuelve con devolver()
+     */
+    void* reservar() {
+        Casilla* casilla;
+        if (!libres.empty()) {
+            casilla = libres.back();
+            libres.pop_back();
+        }
+        else {
+            if (usadasUltimo == TAMANO_BLOQUE) {
+                bloques.emplace_back(new Casilla[TAMANO_BLOQUE]);
+                usadasUltimo = 0;
+                MetricasMemoria::contarBloque();
+            }
+            casilla = &bloques.back()[usadasUltimo++];
+        }
+        casilla->viva = true;
+        vivos++;
+        MetricasMemoria::contarObjeto();
+        return casilla->memoria;
+    }
+
+    /**
+     * @brief Devuelve una casilla de reservar() cuyo objeto ya se destruyó
+     */
+    void devolver(void* memoria) {
+        if (!memoria) {
+            return;
+        }
+        Casilla* casilla = casillaDe(memoria);
+        casilla->viva = false;
+        libres.push_back(casilla);
+        vivos--;
+    }
+
+    /**
+     * @brief Construye un T en una casilla del pool
+     */
+    template<typename... Argumentos>
+    T* crear(Argumentos&&... argumentos) {
+        void* memoria = reservar();
+        try {
+            return ::new (memoria) T(std::forward<Argumentos>(argumentos)...);
+        }
+        catch (...) {
+            devolver(memoria);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Destruye un objeto creado con crear() y deja su casilla para reutilizarla
+     */
+    void destruir(T* objeto) {
+        if (!objeto) {
+            return;
+        }
+        objeto->~T();
+        devolver(objeto);
+    }
+
+    /**
+     * @brief Destruye todos los objetos vivos y libera los bloques
+     */
+    void liberarTodo() {
+        for (size_t b = 0; b < bloques.size(); ++b) {
+            size_t usadas = (b + 1 == bloques.size()) ? usadasUltimo : TAMANO_BLOQUE;
+            for (size_t i = 0; i < usadas; ++i) {
+                Casilla& casilla = bloques[b][i];
+                if (casilla.viva) {
+                    std::launder(reinterpret_cast<T*>(casilla.memoria))->~T();
+                    casilla.viva = false;
+                }
+            }
+        }
+        bloques.clear();
+        libres.clear();
+        usadasUltimo = TAMANO_BLOQUE;
+        vivos = 0;
+    }
+
+    size_t tamano() const { return vivos; }
+    size_t cantidadBloques() const { return bloques.size(); }
+};
+
+/**
+ * @class PoolCompartido
+ * @brief Pool de todo el proceso para los operator new/delete propios de una clase
+ *
+ * Lo usan las clases cuyos objetos se crean y borran uno a uno en distintos lugares
+ * (las cuentas, que borra su Persona): new y delete siguen igual y la memoria sale de
+ * bloques. Como TablaCuentas, no sincroniza el acceso: las cuentas solo se crean y
+ * borran desde el hilo de la interfaz. El pool no se destruye nunca, ya que al
+ * terminar el proceso aún puede haber objetos vivos.
+ */
+template<typename T>
+class PoolCompartido {
+private:
+    static PoolObjetos<T>& pool() {
+        static PoolObjetos<T>* unico = new PoolObjetos<T>();
+        return *unico;
+    }
+
+public:
+    static void* reservar(size_t tamano) {
+        // Una clase derivada más grande no cabe en la casilla
+        if (tamano != sizeof(T)) {
+            return ::operator new(tamano);
+        }
+        return pool().reservar();
+    }
+
+    static void devolver(void* memoria, size_t tamano) {
+        if (!memoria) {
+            return;
+        }
+        if (tamano != sizeof(T)) {
+            ::operator delete(memoria);
+            return;
+        }
+        pool().devolver(memoria);
+    }
+};
+
+#endif // POOLOBJETOS_H
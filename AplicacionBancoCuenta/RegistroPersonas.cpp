@@ -0,0 +1,144 @@
+/**
+ * @file RegistroPersonas.cpp
+ * @brief Implementación del registro de personas en bloques con índice hash por cédula
+ */
+#include "RegistroPersonas.h"
+#include "Persona.h"
+
+namespace {
+	constexpr size_t CAPACIDAD_INICIAL = 64;
+	constexpr size_t MAX_DIGITOS_NUMERICOS = 17;
+	constexpr uint64_t BIT_TEXTO = 1ull << 63;
+}
+
+RegistroPersonas::RegistroPersonas() : total(0), tabla(CAPACIDAD_INICIAL, Ranura{ 0, 0 }) {
+}
+
+uint64_t RegistroPersonas::claveCedula(const std::string& cedula) {
+	bool numerica = !cedula.empty() && cedula.size() <= MAX_DIGITOS_NUMERICOS;
+	uint64_t valor = 0;
+	for (size_t i = 0; numerica && i < cedula.size(); ++i) {
+		if (cedula[i] < '0' || cedula[i] > '9') {
+			numerica = false;
+		}
+		else {
+			valor = valor * 10 + static_cast<uint64_t>(cedula[i] - '0');
+		}
+	}
+	if (numerica) {
+		// 10^17 < 2^57: los 5 bits siguientes guardan la longitud y el bit alto queda en 0
+		return (static_cast<uint64_t>(cedula.size()) << 57) | valor;
+	}
+
+	uint64_t hash = 1469598103934665603ull;
+	for (unsigned char c : cedula) {
+		hash ^= c;
+		hash *= 1099511628211ull;
+	}
+	return hash | BIT_TEXTO;
+}
+
+size_t RegistroPersonas::ranuraInicial(uint64_t clave) const {
+	// Mezcla de splitmix64: las cédulas consecutivas no caen en ranuras consecutivas
+	clave ^= clave >> 30;
+	clave *= 0xbf58476d1ce4e5b9ull;
+	clave ^= clave >> 27;
+	clave *= 0x94d049bb133111ebull;
+	clave ^= clave >> 31;
+	return static_cast<size_t>(clave) & (tabla.size() - 1);
+}
+
+size_t RegistroPersonas::buscarRanura(uint64_t clave) const {
+	size_t mascara = tabla.size() - 1;
+	size_t ranura = ranuraInicial(clave);
+	while (tabla[ranura].posicion != 0 && tabla[ranura].clave != clave) {
+		ranura = (ranura + 1) & mascara;
+	}
+	return ranura;
+}
+
+void RegistroPersonas::redimensionar(size_t capacidad) {
+	tabla.assign(capacidad, Ranura{ 0, 0 });
+	for (size_t i = 0; i < total; ++i) {
+		const Entrada& actual = entrada(i);
+		tabla[buscarRanura(actual.clave)] = Ranura{ actual.clave, static_cast<uint32_t>(i + 1) };
+	}
+}
+
+bool RegistroPersonas::insertar(Persona* persona) {
+	if (!persona) {
+		return false;
+	}
+
+	uint64_t clave = claveCedula(persona->getCedula());
+	size_t ranura = buscarRanura(clave);
+	if (tabla[ranura].posicion != 0) {
+		entrada(tabla[ranura].posicion - 1).persona = persona;
+		return true;
+	}
+
+	if ((total + 1) * 2 > tabla.size()) {
+		redimensionar(tabla.size() * 2);
+		ranura = buscarRanura(clave);
+	}
+	if (total == bloques.size() * TAMANO_BLOQUE) {
+		bloques.emplace_back(new Entrada[TAMANO_BLOQUE]);
+	}
+
+	entrada(total) = Entrada{ clave, persona };
+	tabla[ranura] = Ranura{ clave, static_cast<uint32_t>(total + 1) };
+	total++;
+	return true;
+}
+
+Persona* RegistroPersonas::buscar(const std::string& cedula) const {
+	const Ranura& ranura = tabla[buscarRanura(claveCedula(cedula))];
+	if (ranura.posicion == 0) {
+		return nullptr;
+	}
+	Persona* persona = entrada(ranura.posicion - 1).persona;
+	// Una clave FNV puede repetirse entre textos distintos: se confirma la cédula
+	if ((ranura.clave & BIT_TEXTO) && persona->getCedula() != cedula) {
+		return nullptr;
+	}
+	return persona;
+}
+
+bool RegistroPersonas::quitar(const std::string& cedula) {
+	size_t mascara = tabla.size() - 1;
+	size_t hueco = buscarRanura(claveCedula(cedula));
+	if (tabla[hueco].posicion == 0 || buscar(cedula) == nullptr) {
+		return false;
+	}
+
+	// La última entrada ocupa el lugar de la quitada y su ranura se actualiza
+	size_t indice = tabla[hueco].posicion - 1;
+	size_t ultimo = total - 1;
+	if (indice != ultimo) {
+		entrada(indice) = entrada(ultimo);
+		tabla[buscarRanura(entrada(indice).clave)].posicion = static_cast<uint32_t>(indice + 1);
+	}
+	total--;
+
+	// Borrado sin lápidas: se retroceden las ranuras siguientes del mismo tramo que
+	// quedarían inalcanzables desde su ranura inicial
+	tabla[hueco].posicion = 0;
+	for (size_t ranura = (hueco + 1) & mascara; tabla[ranura].posicion != 0; ranura = (ranura + 1) & mascara) {
+		size_t inicial = ranuraInicial(tabla[ranura].clave);
+		bool alcanzable = hueco <= ranura
+			? (inicial > hueco && inicial <= ranura)
+			: (inicial > hueco || inicial <= ranura);
+		if (!alcanzable) {
+			tabla[hueco] = tabla[ranura];
+			tabla[ranura].posicion = 0;
+			hueco = ranura;
+		}
+	}
+	return true;
+}
+
+void RegistroPersonas::limpiar() {
+	bloques.clear();
+	total = 0;
+	tabla.assign(CAPACIDAD_INICIAL, Ranura{ 0, 0 });
+}
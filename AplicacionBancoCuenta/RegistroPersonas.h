@@ -0,0 +1,119 @@
+#pragma once
+#ifndef REGISTROPERSONAS_H
+#define REGISTROPERSONAS_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+class Persona;
+
+/**
+ * @class RegistroPersonas
+ * @brief Personas en memoria, en bloques contiguos y con índice hash por cédula
+ *
+ * Las entradas se guardan en bloques de TAMANO_BLOQUE que nunca se mueven ni se
+ * liberan al crecer, así que recorrerlas es una lectura secuencial y sus direcciones
+ * son estables. La tabla hash usa direccionamiento abierto con sondeo lineal sobre la
+ * cédula convertida a número, por lo que buscar cuesta O(1) sin comparar textos.
+ *
+ * Como NodoPersona, no es dueño de las personas: quien las crea las libera.
+ */
+class RegistroPersonas {
+public:
+    static constexpr size_t TAMANO_BLOQUE = 1024;
+
+private:
+    /**
+     * @struct Entrada
+     * @brief Persona registrada con la clave numérica de su cédula
+     */
+    struct Entrada {
+        uint64_t clave;
+        Persona* persona;
+    };
+
+    /**
+     * @struct Ranura
+     * @brief Casilla de la tabla hash; posicion es el índice de la entrada + 1 (0 = vacía)
+     */
+    struct Ranura {
+        uint64_t clave;
+        uint32_t posicion;
+    };
+
+    std::vector<std::unique_ptr<Entrada[]>> bloques;
+    size_t total;
+    std::vector<Ranura> tabla;   // Tamaño potencia de 2, ocupada a lo sumo al 50 %
+
+    Entrada& entrada(size_t indice) { return bloques[indice / TAMANO_BLOQUE][indice % TAMANO_BLOQUE]; }
+    const Entrada& entrada(size_t indice) const { return bloques[indice / TAMANO_BLOQUE][indice % TAMANO_BLOQUE]; }
+
+    size_t ranuraInicial(uint64_t clave) const;
+
+    /**
+     * @brief Ranura con la clave, o la vacía donde iría si no está
+     */
+    size_t buscarRanura(uint64_t clave) const;
+
+    void redimensionar(size_t capacidad);
+
+public:
+    RegistroPersonas();
+
+    RegistroPersonas(const RegistroPersonas&) = delete;
+    RegistroPersonas& operator=(const RegistroPersonas&) = delete;
+
+    /**
+     * @brief Clave numérica de una cédula
+     *
+     * Las cédulas de solo dígitos (hasta 17) se convierten a número y se combinan con su
+     * longitud, para que "0102" y "102" no choquen; cualquier otro texto usa FNV-1a con
+     * el bit alto encendido, que nunca coincide con una cédula numérica.
+     */
+    static uint64_t claveCedula(const std::string& cedula);
+
+    /**
+     * @brief Registra una persona, o reemplaza la que ya tenía su cédula
+     * @return false si persona es nula
+     */
+    bool insertar(Persona* persona);
+
+    /**
+     * @brief Persona con la cédula indicada, o nullptr
+     */
+    Persona* buscar(const std::string& cedula) const;
+
+    /**
+     * @brief Quita la persona de la cédula; la última entrada ocupa su lugar
+     * @return true si estaba registrada
+     */
+    bool quitar(const std::string& cedula);
+
+    void limpiar();
+
+    size_t tamano() const { return total; }
+    bool vacio() const { return total == 0; }
+
+    /**
+     * @brief Aplica la función a cada persona, en orden de registro (salvo quitar())
+     */
+    template<typename Funcion>
+    void paraCada(Funcion&& funcion) const {
+        size_t restantes = total;
+        for (const auto& bloque : bloques) {
+            size_t cantidad = restantes < TAMANO_BLOQUE ? restantes : TAMANO_BLOQUE;
+            for (size_t i = 0; i < cantidad; ++i) {
+                funcion(bloque[i].persona);
+            }
+            restantes -= cantidad;
+            if (restantes == 0) {
+                break;
+            }
+        }
+    }
+};
+
+#endif // REGISTROPERSONAS_H
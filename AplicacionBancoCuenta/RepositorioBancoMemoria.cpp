@@ -0,0 +1,715 @@
+/**
+ * @file RepositorioBancoMemoria.cpp
+ * @brief Implementación del motor en memoria de IRepositorioBanco
+ */
+#include "RepositorioBancoMemoria.h"
+#include "Persona.h"
+#include "AlmacenLocalBanco.h"
+#include "MetricasLatencia.h"
+#include <bsoncxx/builder/basic/document.hpp>
+#include <bsoncxx/builder/basic/array.hpp>
+#include <bsoncxx/builder/basic/kvp.hpp>
+#include <algorithm>
+#include <regex>
+#include <ctime>
+#include <iostream>
+
+using bsoncxx::builder::basic::kvp;
+using bsoncxx::builder::basic::make_document;
+
+namespace {
+	std::string leerTexto(const bsoncxx::document::view& doc, const char* campo) {
+		auto elemento = doc[campo];
+		if (elemento && elemento.type() == bsoncxx::type::k_utf8) {
+			return std::string(elemento.get_string().value);
+		}
+		return "";
+	}
+
+	bsoncxx::document::value documentoVacio() {
+		return bsoncxx::document::value(make_document().view());
+	}
+}
+
+// === BÚSQUEDAS INTERNAS ===
+
+RepositorioBancoMemoria::PersonaMemoria* RepositorioBancoMemoria::buscarPersona(const std::string& cedula) {
+	{
+		std::shared_lock<std::shared_mutex> lock(mutexTablas);
+		auto it = personas.find(cedula);
+		if (it != personas.end()) {
+			return it->second.get();
+		}
+	}
+	if (!almacenLocal) {
+		return nullptr;
+	}
+	auto documento = almacenLocal->buscarPorCedula(cedula);
+	return documento ? importarDesdeAlmacen(documento->view()) : nullptr;
+}
+
+RepositorioBancoMemoria::UbicacionMemoria RepositorioBancoMemoria::buscarCuenta(const std::string& numeroCuenta) {
+	{
+		std::shared_lock<std::shared_mutex> lock(mutexTablas);
+		auto it = indiceCuentas.find(numeroCuenta);
+		if (it != indiceCuentas.end() || !almacenLocal) {
+			return it != indiceCuentas.end() ? it->second : UbicacionMemoria{};
+		}
+	}
+	auto documento = almacenLocal->buscarPorNumeroCuenta(numeroCuenta);
+	if (!documento) {
+		return UbicacionMemoria{};
+	}
+	importarDesdeAlmacen(documento->view());
+
+	std::shared_lock<std::shared_mutex> lock(mutexTablas);
+	auto it = indiceCuentas.find(numeroCuenta);
+	return it != indiceCuentas.end() ? it->second : UbicacionMemoria{};
+}
+
+RepositorioBancoMemoria::PersonaMemoria* RepositorioBancoMemoria::importarDesdeAlmacen(const bsoncxx::document::view& documento) {
+	auto importada = std::make_unique<PersonaMemoria>();
+	importada->cedula = leerTexto(documento, "cedula");
+	importada->nombre = leerTexto(documento, "nombre");
+	importada->apellido = leerTexto(documento, "apellido");
+	importada->fechaNacimiento = leerTexto(documento, "fechaNacimiento");
+	importada->correo = leerTexto(documento, "correo");
+	importada->direccion = leerTexto(documento, "direccion");
+
+	auto cuentas = documento["cuentas"];
+	if (cuentas && cuentas.type() == bsoncxx::type::k_array) {
+		for (const auto& cuentaDoc : cuentas.get_array().value) {
+			if (cuentaDoc.type() != bsoncxx::type::k_document) {
+				continue;
+			}
+			auto cuenta = crearCuentaDesdeDocumento(cuentaDoc.get_document().value);
+			if (cuenta->numeroCuenta.empty()) {
+				continue;
+			}
+			// El saldo guardado puede haber cambiado en línea después de copiarse
+			cuenta->saldo = 0.0;
+			cuenta->saldoConocido = false;
+			if (cuenta->tipo == "ahorros") importada->numAhorros++;
+			else if (cuenta->tipo == "corriente") importada->numCorrientes++;
+			importada->cuentas.push_back(std::move(cuenta));
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(mutexTablas);
+	auto existente = personas.find(importada->cedula);
+	if (existente != personas.end()) {
+		return existente->second.get();
+	}
+	for (const auto& cuenta : importada->cuentas) {
+		indiceCuentas.emplace(cuenta->numeroCuenta, UbicacionMemoria{ importada.get(), cuenta.get() });
+	}
+	PersonaMemoria* resultado = importada.get();
+	std::string cedula = importada->cedula;
+	personas.emplace(std::move(cedula), std::move(importada));
+	return resultado;
+}
+
+void RepositorioBancoMemoria::usarAlmacenLocal(AlmacenLocalBanco* almacen) {
+	almacenLocal = almacen;
+}
+
+long RepositorioBancoMemoria::claveFecha(const std::string& fecha) {
+	if (fecha.size() != 10 || fecha[2] != '/' || fecha[5] != '/') {
+		return -1;
+	}
+	try {
+		int dia = std::stoi(fecha.substr(0, 2));
+		int mes = std::stoi(fecha.substr(3, 2));
+		int anio = std::stoi(fecha.substr(6, 4));
+		return static_cast<long>(anio) * 10000 + mes * 100 + dia;
+	}
+	catch (const std::exception&) {
+		return -1;
+	}
+}
+
+bool RepositorioBancoMemoria::saldoDisponible(const CuentaMemoria& cuenta) {
+	if (!cuenta.saldoConocido) {
+		std::cerr << "Error: El saldo de la cuenta " << cuenta.numeroCuenta
+			<< " no está disponible sin conexión (cuenta del almacén local)" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// === CONSTRUCCIÓN DE DOCUMENTOS ===
+
+std::unique_ptr<RepositorioBancoMemoria::CuentaMemoria> RepositorioBancoMemoria::crearCuentaDesdeDocumento(const bsoncxx::document::view& cuentaDoc) const {
+	auto cuenta = std::make_unique<CuentaMemoria>();
+	cuenta->numeroCuenta = leerTexto(cuentaDoc, "numeroCuenta");
+	cuenta->tipo = leerTexto(cuentaDoc, "tipo");
+	cuenta->fechaApertura = leerTexto(cuentaDoc, "fechaApertura");
+	cuenta->estado = leerTexto(cuentaDoc, "estado");
+	cuenta->sucursal = leerTexto(cuentaDoc, "sucursal");
+
+	auto saldoElement = cuentaDoc["saldo"];
+	if (saldoElement) {
+		if (saldoElement.type() == bsoncxx::type::k_double) cuenta->saldo = saldoElement.get_double().value;
+		else if (saldoElement.type() == bsoncxx::type::k_int32) cuenta->saldo = saldoElement.get_int32().value;
+		else if (saldoElement.type() == bsoncxx::type::k_int64) cuenta->saldo = static_cast<double>(saldoElement.get_int64().value);
+	}
+	return cuenta;
+}
+
+bsoncxx::document::value RepositorioBancoMemoria::documentoCuenta(const CuentaMemoria& cuenta) const {
+	double saldo;
+	{
+		std::lock_guard<std::mutex> lock(cuenta.mutex);
+		saldo = cuenta.saldo;
+	}
+	bsoncxx::builder::basic::document doc;
+	doc.append(
+		kvp("numeroCuenta", cuenta.numeroCuenta),
+		kvp("tipo", cuenta.tipo)
+	);
+	if (cuenta.saldoConocido) {
+		doc.append(kvp("saldo", saldo));
+	}
+	doc.append(
+		kvp("fechaApertura", cuenta.fechaApertura),
+		kvp("estado", cuenta.estado),
+		kvp("sucursal", cuenta.sucursal)
+	);
+	bsoncxx::types::b_date fecha{ std::chrono::milliseconds{ 0 } };
+	if (convertirFechaABsonDate(cuenta.fechaApertura, fecha)) {
+		doc.append(kvp("fechaAperturaDate", fecha));
+	}
+	return doc.extract();
+}
+
+bsoncxx::document::value RepositorioBancoMemoria::documentoPersona(const PersonaMemoria& persona) const {
+	std::lock_guard<std::mutex> lock(persona.mutex);
+
+	bsoncxx::builder::basic::array cuentasArray;
+	for (const auto& cuenta : persona.cuentas) {
+		cuentasArray.append(documentoCuenta(*cuenta));
+	}
+
+	bsoncxx::builder::basic::document doc;
+	doc.append(
+		kvp("cedula", persona.cedula),
+		kvp("nombre", persona.nombre),
+		kvp("apellido", persona.apellido),
+		kvp("fechaNacimiento", persona.fechaNacimiento),
+		kvp("correo", persona.correo),
+		kvp("direccion", persona.direccion),
+		kvp("numAhorros", persona.numAhorros),
+		kvp("numCorrientes", persona.numCorrientes),
+		kvp("totalCuentasExistentes", static_cast<int>(persona.cuentas.size())),
+		kvp("cuentas", cuentasArray)
+	);
+	bsoncxx::types::b_date fecha{ std::chrono::milliseconds{ 0 } };
+	if (convertirFechaABsonDate(persona.fechaNacimiento, fecha)) {
+		doc.append(kvp("fechaNacimientoDate", fecha));
+	}
+	return doc.extract();
+}
+
+// === OPERACIONES DE PERSONA ===
+
+bool RepositorioBancoMemoria::registrarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial) {
+	auto nueva = std::make_unique<PersonaMemoria>();
+	nueva->cedula = persona.getCedula();
+	nueva->nombre = persona.getNombres();
+	nueva->apellido = persona.getApellidos();
+	nueva->fechaNacimiento = persona.getFechaNacimiento();
+	nueva->correo = persona.getCorreo();
+	nueva->direccion = persona.getDireccion();
+
+	std::unique_ptr<CuentaMemoria> cuenta;
+	if (cuentaInicial) {
+		cuenta = crearCuentaDesdeDocumento(cuentaInicial->view());
+		if (cuenta->numeroCuenta.empty()) {
+			return false;
+		}
+	}
+
+	// Trae del almacén local lo que ya exista para que las comprobaciones de abajo lo vean
+	buscarPersona(nueva->cedula);
+	if (cuenta) {
+		buscarCuenta(cuenta->numeroCuenta);
+	}
+
+	std::unique_lock<std::shared_mutex> lock(mutexTablas);
+	if (personas.count(nueva->cedula) > 0) {
+		return false;
+	}
+
+	if (cuenta) {
+		if (indiceCuentas.count(cuenta->numeroCuenta) > 0) {
+			return false;
+		}
+		if (cuenta->tipo == "ahorros") nueva->numAhorros++;
+		else if (cuenta->tipo == "corriente") nueva->numCorrientes++;
+		indiceCuentas[cuenta->numeroCuenta] = UbicacionMemoria{ nueva.get(), cuenta.get() };
+		nueva->cuentas.push_back(std::move(cuenta));
+	}
+
+	std::string cedula = nueva->cedula;
+	personas.emplace(std::move(cedula), std::move(nueva));
+	return true;
+}
+
+bool RepositorioBancoMemoria::insertarNuevaPersona(const Persona& persona) {
+	bool registrada = registrarPersona(persona, nullptr);
+	if (registrada) {
+		notificarPersonaEscrita(EscrituraPersona{ persona, true, nullptr });
+	}
+	return registrada;
+}
+
+bool RepositorioBancoMemoria::insertarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial) {
+	bool registrada = registrarPersona(persona, cuentaInicial);
+	if (registrada) {
+		bsoncxx::document::view vistaCuenta = cuentaInicial ? cuentaInicial->view() : bsoncxx::document::view();
+		notificarPersonaEscrita(EscrituraPersona{ persona, true, cuentaInicial ? &vistaCuenta : nullptr });
+	}
+	return registrada;
+}
+
+bool RepositorioBancoMemoria::existePersonaPorCedula(const std::string& cedula) {
+	return buscarPersona(cedula) != nullptr;
+}
+
+Persona* RepositorioBancoMemoria::obtenerPersonaPorCedula(const std::string& cedula) {
+	PersonaMemoria* persona = buscarPersona(cedula);
+	if (!persona) {
+		return nullptr;
+	}
+	return new Persona(persona->cedula, persona->nombre, persona->apellido,
+		persona->fechaNacimiento, persona->correo, persona->direccion);
+}
+
+bool RepositorioBancoMemoria::agregarCuentaPersona(const std::string& cedula, const bsoncxx::document::value& cuentaDoc) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::AGREGAR_CUENTA);
+	auto cuenta = crearCuentaDesdeDocumento(cuentaDoc.view());
+	if (cuenta->numeroCuenta.empty()) {
+		return false;
+	}
+	buscarPersona(cedula);
+	buscarCuenta(cuenta->numeroCuenta);
+
+	std::unique_ptr<Persona> titular;
+	{
+		std::unique_lock<std::shared_mutex> lockTablas(mutexTablas);
+		auto it = personas.find(cedula);
+		if (it == personas.end() || indiceCuentas.count(cuenta->numeroCuenta) > 0) {
+			return false;
+		}
+
+		PersonaMemoria* persona = it->second.get();
+		std::lock_guard<std::mutex> lockPersona(persona->mutex);
+		if (persona->cuentas.size() >= 5) {
+			return false;
+		}
+
+		if (cuenta->tipo == "ahorros") persona->numAhorros++;
+		else if (cuenta->tipo == "corriente") persona->numCorrientes++;
+		indiceCuentas[cuenta->numeroCuenta] = UbicacionMemoria{ persona, cuenta.get() };
+		persona->cuentas.push_back(std::move(cuenta));
+		titular = std::make_unique<Persona>(persona->cedula, persona->nombre, persona->apellido,
+			persona->fechaNacimiento, persona->correo, persona->direccion);
+	}
+
+	// Fuera de los bloqueos: el observador puede volver a consultar el repositorio
+	bsoncxx::document::view vistaCuenta = cuentaDoc.view();
+	notificarPersonaEscrita(EscrituraPersona{ *titular, false, &vistaCuenta });
+	return true;
+}
+
+std::vector<bsoncxx::document::value> RepositorioBancoMemoria::buscarPersonasPorCriterio(const std::string& criterio, const std::string& valor) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::BUSQUEDA_CRITERIO);
+	std::vector<bsoncxx::document::value> resultados;
+	std::vector<PersonaMemoria*> candidatas;
+	{
+		std::shared_lock<std::shared_mutex> lock(mutexTablas);
+		candidatas.reserve(personas.size());
+		for (const auto& par : personas) {
+			candidatas.push_back(par.second.get());
+		}
+	}
+
+	if (criterio == "numAhorros" || criterio == "numCorrientes" || criterio == "totalCuentasExistentes") {
+		int valorNumerico;
+		try {
+			valorNumerico = std::stoi(valor);
+		}
+		catch (const std::exception&) {
+			return resultados;
+		}
+		for (PersonaMemoria* persona : candidatas) {
+			int actual;
+			{
+				std::lock_guard<std::mutex> lock(persona->mutex);
+				actual = criterio == "numAhorros" ? persona->numAhorros
+					: criterio == "numCorrientes" ? persona->numCorrientes
+					: static_cast<int>(persona->cuentas.size());
+			}
+			if (actual == valorNumerico) {
+				resultados.push_back(documentoPersona(*persona));
+			}
+		}
+		return resultados;
+	}
+
+	std::string PersonaMemoria::* campo = nullptr;
+	if (criterio == "cedula") campo = &PersonaMemoria::cedula;
+	else if (criterio == "nombre") campo = &PersonaMemoria::nombre;
+	else if (criterio == "apellido") campo = &PersonaMemoria::apellido;
+	else if (criterio == "fechaNacimiento") campo = &PersonaMemoria::fechaNacimiento;
+	else if (criterio == "correo") campo = &PersonaMemoria::correo;
+	else if (criterio == "direccion") campo = &PersonaMemoria::direccion;
+	if (!campo) {
+		return resultados;
+	}
+
+	// Misma semántica que el motor MongoDB: $regex con opción "i"
+	std::regex patron;
+	try {
+		patron = std::regex(valor, std::regex::ECMAScript | std::regex::icase);
+	}
+	catch (const std::regex_error&) {
+		return resultados;
+	}
+
+	for (PersonaMemoria* persona : candidatas) {
+		if (std::regex_search(persona->*campo, patron)) {
+			resultados.push_back(documentoPersona(*persona));
+		}
+	}
+	return resultados;
+}
+
+std::vector<bsoncxx::document::value> RepositorioBancoMemoria::buscarCuentasPorRangoFechas(const std::string& fechaInicio) {
+	std::vector<bsoncxx::document::value> resultados;
+	long desde = claveFecha(fechaInicio);
+	if (desde < 0) {
+		return resultados;
+	}
+
+	std::time_t ahora = std::time(nullptr);
+	std::tm tmAhora;
+	localtime_s(&tmAhora, &ahora);
+	long hasta = static_cast<long>(tmAhora.tm_year + 1900) * 10000 + (tmAhora.tm_mon + 1) * 100 + tmAhora.tm_mday;
+
+	std::shared_lock<std::shared_mutex> lock(mutexTablas);
+	for (const auto& par : indiceCuentas) {
+		const CuentaMemoria& cuenta = *par.second.cuenta;
+		long clave = claveFecha(cuenta.fechaApertura);
+		if (clave < desde || clave > hasta) {
+			continue;
+		}
+		const PersonaMemoria& titular = *par.second.titular;
+		resultados.push_back(make_document(
+			kvp("cedula", titular.cedula),
+			kvp("nombre", titular.nombre),
+			kvp("apellido", titular.apellido),
+			kvp("correo", titular.correo),
+			kvp("cuenta", documentoCuenta(cuenta))
+		));
+	}
+	return resultados;
+}
+
+bsoncxx::document::value RepositorioBancoMemoria::buscarPersonaCompletaPorCedula(const std::string& cedula) {
+	PersonaMemoria* persona = buscarPersona(cedula);
+	return persona ? documentoPersona(*persona) : documentoVacio();
+}
+
+// === OPERACIONES BANCARIAS ===
+
+bool RepositorioBancoMemoria::depositarEnCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::DEPOSITO);
+	if (!validarMonto(monto)) {
+		return false;
+	}
+	CuentaMemoria* cuenta = buscarCuenta(numeroCuenta).cuenta;
+	if (!cuenta || !saldoDisponible(*cuenta)) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(cuenta->mutex);
+	cuenta->saldo = redondearMonto(cuenta->saldo + redondearMonto(monto));
+	if (saldoResultante) {
+		*saldoResultante = cuenta->saldo;
+	}
+	return true;
+}
+
+bool RepositorioBancoMemoria::retirarDeCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::RETIRO);
+	if (!validarMonto(monto)) {
+		return false;
+	}
+	CuentaMemoria* cuenta = buscarCuenta(numeroCuenta).cuenta;
+	if (!cuenta || !saldoDisponible(*cuenta)) {
+		return false;
+	}
+
+	monto = redondearMonto(monto);
+	std::lock_guard<std::mutex> lock(cuenta->mutex);
+	if (cuenta->saldo < monto) {
+		return false;
+	}
+	cuenta->saldo = redondearMonto(cuenta->saldo - monto);
+	if (saldoResultante) {
+		*saldoResultante = cuenta->saldo;
+	}
+	return true;
+}
+
+double RepositorioBancoMemoria::obtenerSaldoCuenta(const std::string& numeroCuenta) {
+	CuentaMemoria* cuenta = buscarCuenta(numeroCuenta).cuenta;
+	if (!cuenta || !saldoDisponible(*cuenta)) {
+		return -1.0;
+	}
+	std::lock_guard<std::mutex> lock(cuenta->mutex);
+	return cuenta->saldo;
+}
+
+bool RepositorioBancoMemoria::verificarFondosSuficientes(const std::string& numeroCuenta, double monto) {
+	if (!validarMonto(monto)) {
+		return false;
+	}
+	double saldoActual = obtenerSaldoCuenta(numeroCuenta);
+	return saldoActual >= 0.0 && saldoActual >= redondearMonto(monto);
+}
+
+bool RepositorioBancoMemoria::realizarTransferencia(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::TRANSFERENCIA);
+	if (!validarMonto(monto) || cuentaOrigen == cuentaDestino) {
+		return false;
+	}
+	CuentaMemoria* origen = buscarCuenta(cuentaOrigen).cuenta;
+	CuentaMemoria* destino = buscarCuenta(cuentaDestino).cuenta;
+	if (!origen || !destino || !saldoDisponible(*origen) || !saldoDisponible(*destino)) {
+		return false;
+	}
+
+	monto = redondearMonto(monto);
+	// scoped_lock adquiere ambos mutex sin riesgo de interbloqueo entre transferencias cruzadas
+	std::scoped_lock lock(origen->mutex, destino->mutex);
+	if (origen->saldo < monto) {
+		return false;
+	}
+	origen->saldo = redondearMonto(origen->saldo - monto);
+	destino->saldo = redondearMonto(destino->saldo + monto);
+	return true;
+}
+
+std::vector<ResultadoTransferencia> RepositorioBancoMemoria::realizarTransferenciasLote(const std::vector<Transferencia>& transferencias) {
+	std::vector<ResultadoTransferencia> resultados(transferencias.size());
+	std::vector<std::pair<CuentaMemoria*, CuentaMemoria*>> cuentas(transferencias.size(), { nullptr, nullptr });
+	std::vector<CuentaMemoria*> involucradas;
+
+	for (size_t i = 0; i < transferencias.size(); ++i) {
+		const auto& t = transferencias[i];
+		if (!validarMonto(t.monto)) {
+			resultados[i].mensaje = "Monto inválido";
+			continue;
+		}
+		if (t.cuentaOrigen == t.cuentaDestino) {
+			resultados[i].mensaje = "No se puede transferir a la misma cuenta";
+			continue;
+		}
+		cuentas[i] = { buscarCuenta(t.cuentaOrigen).cuenta, buscarCuenta(t.cuentaDestino).cuenta };
+		if (!cuentas[i].first) {
+			resultados[i].mensaje = "Cuenta origen no encontrada: " + t.cuentaOrigen;
+			continue;
+		}
+		if (!cuentas[i].second) {
+			resultados[i].mensaje = "Cuenta destino no encontrada: " + t.cuentaDestino;
+			continue;
+		}
+		if (!cuentas[i].first->saldoConocido || !cuentas[i].second->saldoConocido) {
+			resultados[i].mensaje = "Saldo no disponible sin conexión para una de las cuentas";
+			cuentas[i] = { nullptr, nullptr };
+			continue;
+		}
+		involucradas.push_back(cuentas[i].first);
+		involucradas.push_back(cuentas[i].second);
+	}
+
+	// Bloquear todas las cuentas del lote en orden de dirección evita interbloqueos
+	std::sort(involucradas.begin(), involucradas.end());
+	involucradas.erase(std::unique(involucradas.begin(), involucradas.end()), involucradas.end());
+	std::vector<std::unique_lock<std::mutex>> bloqueos;
+	bloqueos.reserve(involucradas.size());
+	for (CuentaMemoria* cuenta : involucradas) {
+		bloqueos.emplace_back(cuenta->mutex);
+	}
+
+	for (size_t i = 0; i < transferencias.size(); ++i) {
+		CuentaMemoria* origen = cuentas[i].first;
+		CuentaMemoria* destino = cuentas[i].second;
+		if (!origen || !destino) {
+			continue;
+		}
+		double monto = redondearMonto(transferencias[i].monto);
+		if (origen->saldo < monto) {
+			resultados[i].mensaje = "Fondos insuficientes en cuenta origen";
+			continue;
+		}
+		origen->saldo = redondearMonto(origen->saldo - monto);
+		destino->saldo = redondearMonto(destino->saldo + monto);
+		resultados[i].exitosa = true;
+		resultados[i].mensaje = "Transferencia aplicada";
+	}
+	return resultados;
+}
+
+bsoncxx::document::value RepositorioBancoMemoria::obtenerInformacionCuenta(const std::string& numeroCuenta) {
+	UbicacionMemoria ubicacion = buscarCuenta(numeroCuenta);
+	if (!ubicacion.cuenta) {
+		return documentoVacio();
+	}
+	const PersonaMemoria& titular = *ubicacion.titular;
+	return make_document(
+		kvp("numeroCuenta", numeroCuenta),
+		kvp("cedula", titular.cedula),
+		kvp("titular", make_document(
+			kvp("nombre", titular.nombre),
+			kvp("apellido", titular.apellido),
+			kvp("correo", titular.correo)
+		)),
+		kvp("cuenta", documentoCuenta(*ubicacion.cuenta))
+	);
+}
+
+std::string RepositorioBancoMemoria::obtenerCedulaPorNumeroCuenta(const std::string& numeroCuenta) {
+	UbicacionMemoria ubicacion = buscarCuenta(numeroCuenta);
+	return ubicacion.titular ? ubicacion.titular->cedula : "";
+}
+
+bool RepositorioBancoMemoria::existenPersonasEnBaseDatos() {
+	return obtenerTotalPersonasRegistradas() > 0;
+}
+
+long RepositorioBancoMemoria::obtenerTotalPersonasRegistradas() {
+	std::shared_lock<std::shared_mutex> lock(mutexTablas);
+	return static_cast<long>(personas.size());
+}
+
+bool RepositorioBancoMemoria::existenCuentasEnBaseDatos() {
+	return obtenerTotalCuentasRegistradas() > 0;
+}
+
+long RepositorioBancoMemoria::obtenerTotalCuentasRegistradas() {
+	std::shared_lock<std::shared_mutex> lock(mutexTablas);
+	return static_cast<long>(indiceCuentas.size());
+}
+
+std::vector<bsoncxx::document::value> RepositorioBancoMemoria::mostrarTodasPersonas() {
+	std::vector<PersonaMemoria*> ordenadas;
+	{
+		std::shared_lock<std::shared_mutex> lock(mutexTablas);
+		ordenadas.reserve(personas.size());
+		for (const auto& par : personas) {
+			ordenadas.push_back(par.second.get());
+		}
+	}
+
+	// Mismo orden que el motor MongoDB: apellido y luego nombre
+	std::sort(ordenadas.begin(), ordenadas.end(), [](const PersonaMemoria* a, const PersonaMemoria* b) {
+		return a->apellido != b->apellido ? a->apellido < b->apellido : a->nombre < b->nombre;
+		});
+
+	std::vector<bsoncxx::document::value> resultados;
+	resultados.reserve(ordenadas.size());
+	for (PersonaMemoria* persona : ordenadas) {
+		std::lock_guard<std::mutex> lock(persona->mutex);
+		bsoncxx::builder::basic::array cuentasArray;
+		for (const auto& cuenta : persona->cuentas) {
+			std::lock_guard<std::mutex> lockCuenta(cuenta->mutex);
+			cuentasArray.append(cuenta->saldoConocido
+				? make_document(
+					kvp("numeroCuenta", cuenta->numeroCuenta),
+					kvp("tipo", cuenta->tipo),
+					kvp("saldo", cuenta->saldo))
+				: make_document(
+					kvp("numeroCuenta", cuenta->numeroCuenta),
+					kvp("tipo", cuenta->tipo)));
+		}
+		resultados.push_back(make_document(
+			kvp("cedula", persona->cedula),
+			kvp("nombre", persona->nombre),
+			kvp("apellido", persona->apellido),
+			kvp("fechaNacimiento", persona->fechaNacimiento),
+			kvp("correo", persona->correo),
+			kvp("direccion", persona->direccion),
+			kvp("cuentas", cuentasArray),
+			kvp("numAhorros", persona->numAhorros),
+			kvp("numCorrientes", persona->numCorrientes),
+			kvp("totalCuentasExistentes", static_cast<int>(persona->cuentas.size()))
+		));
+	}
+	return resultados;
+}
+
+/**
+ * @brief Los datos no sobreviven al proceso: no hay instantáneas que validar entre ejecuciones
+ */
+uint64_t RepositorioBancoMemoria::obtenerContadorCambiosPersonas() {
+	return 0;
+}
+
+// === SECUENCIALES ===
+
+int RepositorioBancoMemoria::obtenerUltimoSecuencial(const std::string& sucursal) {
+	std::shared_lock<std::shared_mutex> lock(mutexTablas);
+	auto it = secuenciales.find(sucursal);
+	return it != secuenciales.end() ? it->second : 0;
+}
+
+bool RepositorioBancoMemoria::actualizarSecuencial(const std::string& sucursal, int nuevoSecuencial) {
+	std::unique_lock<std::shared_mutex> lock(mutexTablas);
+	secuenciales[sucursal] = nuevoSecuencial;
+	return true;
+}
+
+int RepositorioBancoMemoria::mayorSecuencialSinBloqueo(const std::string& sucursal) const {
+	int mayor = 0;
+	auto considerar = [&sucursal, &mayor](const std::string& numero) {
+		if (numero.size() >= sucursal.size() + 6 && numero.compare(0, sucursal.size(), sucursal) == 0) {
+			try {
+				mayor = (std::max)(mayor, std::stoi(numero.substr(sucursal.size(), 6)));
+			}
+			catch (const std::exception&) {
+			}
+		}
+	};
+	for (const auto& par : indiceCuentas) {
+		considerar(par.first);
+	}
+	// Las cuentas del almacén aún no importadas también ocupan secuenciales
+	if (almacenLocal) {
+		for (const auto& numero : almacenLocal->numerosCuentaConPrefijo(sucursal)) {
+			considerar(numero);
+		}
+	}
+	return mayor;
+}
+
+int RepositorioBancoMemoria::obtenerMayorNumeroCuentaPorSucursal(const std::string& sucursal) {
+	std::shared_lock<std::shared_mutex> lock(mutexTablas);
+	return mayorSecuencialSinBloqueo(sucursal);
+}
+
+bool RepositorioBancoMemoria::reservarBloqueSecuencial(const std::string& sucursal, int tamanoBloque, int& primero) {
+	if (tamanoBloque <= 0) {
+		return false;
+	}
+	std::unique_lock<std::shared_mutex> lock(mutexTablas);
+	auto it = secuenciales.find(sucursal);
+	if (it == secuenciales.end()) {
+		it = secuenciales.emplace(sucursal, mayorSecuencialSinBloqueo(sucursal)).first;
+	}
+	primero = it->second + 1;
+	it->second += tamanoBloque;
+	return true;
+}
@@ -0,0 +1,144 @@
+#pragma once
+#ifndef REPOSITORIOBANCOMEMORIA_H
+#define REPOSITORIOBANCOMEMORIA_H
+
+#include "IRepositorioBanco.h"
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+
+class AlmacenLocalBanco;
+
+/**
+ * @class RepositorioBancoMemoria
+ * @brief Motor en memoria de IRepositorioBanco, sin dependencia de un servidor MongoDB
+ *
+ * Pensado para simulaciones y pruebas de carga de la lógica bancaria. Las personas y
+ * las cuentas viven en tablas hash; la estructura de las tablas se protege con un
+ * shared_mutex y cada cuenta tiene su propio mutex, de modo que operaciones sobre
+ * cuentas distintas no compiten entre sí. Las entradas nunca se eliminan, por lo que
+ * los punteros obtenidos de las tablas siguen siendo válidos fuera del bloqueo.
+ *
+ * Con un almacén local (usarAlmacenLocal) las personas y cuentas que no están en
+ * memoria se importan desde él la primera vez que se consultan; lo escrito en memoria
+ * no vuelve al almacén. El almacén no guarda saldos, así que las cuentas importadas
+ * no admiten depósitos, retiros, transferencias ni consultas de saldo.
+ *
+ * Orden de bloqueo: mutexTablas -> mutex de persona -> mutex de cuenta.
+ */
+class RepositorioBancoMemoria : public IRepositorioBanco {
+private:
+    struct CuentaMemoria {
+        std::string numeroCuenta;
+        std::string tipo;
+        std::string fechaApertura;
+        std::string estado;
+        std::string sucursal;
+        double saldo = 0.0;
+        bool saldoConocido = true;  // false en cuentas importadas del almacén local
+        mutable std::mutex mutex;
+    };
+
+    struct PersonaMemoria {
+        std::string cedula;
+        std::string nombre;
+        std::string apellido;
+        std::string fechaNacimiento;
+        std::string correo;
+        std::string direccion;
+        int numAhorros = 0;
+        int numCorrientes = 0;
+        std::vector<std::unique_ptr<CuentaMemoria>> cuentas;
+        mutable std::mutex mutex;
+    };
+
+    struct UbicacionMemoria {
+        PersonaMemoria* titular = nullptr;
+        CuentaMemoria* cuenta = nullptr;
+    };
+
+    std::unordered_map<std::string, std::unique_ptr<PersonaMemoria>> personas;
+    std::unordered_map<std::string, UbicacionMemoria> indiceCuentas;
+    std::unordered_map<std::string, int> secuenciales;
+    mutable std::shared_mutex mutexTablas;
+    AlmacenLocalBanco* almacenLocal = nullptr;
+
+    PersonaMemoria* buscarPersona(const std::string& cedula);
+    UbicacionMemoria buscarCuenta(const std::string& numeroCuenta);
+
+    /**
+     * @brief Agrega a las tablas una persona leída del almacén local, con sus cuentas
+     * @return La persona en memoria (la ya existente si otro hilo se adelantó)
+     */
+    PersonaMemoria* importarDesdeAlmacen(const bsoncxx::document::view& documento);
+    bool registrarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial);
+    std::unique_ptr<CuentaMemoria> crearCuentaDesdeDocumento(const bsoncxx::document::view& cuentaDoc) const;
+    bsoncxx::document::value documentoCuenta(const CuentaMemoria& cuenta) const;
+    bsoncxx::document::value documentoPersona(const PersonaMemoria& persona) const;
+
+    /**
+     * @brief Mayor secuencial de las cuentas de una sucursal; requiere mutexTablas tomado
+     */
+    int mayorSecuencialSinBloqueo(const std::string& sucursal) const;
+
+    /**
+     * @brief Convierte una fecha DD/MM/AAAA a un entero AAAAMMDD comparable, -1 si es inválida
+     */
+    static long claveFecha(const std::string& fecha);
+
+    /**
+     * @brief Informa si la cuenta tiene un saldo con el que se pueda operar
+     * @return false (con el motivo en std::cerr) si la cuenta se importó del almacén local
+     */
+    static bool saldoDisponible(const CuentaMemoria& cuenta);
+
+public:
+    RepositorioBancoMemoria() = default;
+
+    /**
+     * @brief Define el almacén local del que se leen las personas ausentes; nullptr lo quita
+     *
+     * Se llama al arrancar y al cerrar, sin operaciones en curso.
+     */
+    void usarAlmacenLocal(AlmacenLocalBanco* almacen);
+
+#pragma region === OPERACIONES DE PERSONA ===
+    bool insertarNuevaPersona(const Persona& persona) override;
+    bool insertarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial = nullptr) override;
+    bool existePersonaPorCedula(const std::string& cedula) override;
+    Persona* obtenerPersonaPorCedula(const std::string& cedula) override;
+    bool agregarCuentaPersona(const std::string& cedula, const bsoncxx::document::value& cuentaDoc) override;
+    std::vector<bsoncxx::document::value> buscarPersonasPorCriterio(const std::string& criterio, const std::string& valor) override;
+    std::vector<bsoncxx::document::value> buscarCuentasPorRangoFechas(const std::string& fechaInicio) override;
+    bsoncxx::document::value buscarPersonaCompletaPorCedula(const std::string& cedula) override;
+#pragma endregion
+
+#pragma region === OPERACIONES BANCARIAS ===
+    bool depositarEnCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante = nullptr) override;
+    bool retirarDeCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante = nullptr) override;
+    double obtenerSaldoCuenta(const std::string& numeroCuenta) override;
+    bool verificarFondosSuficientes(const std::string& numeroCuenta, double monto) override;
+    bool realizarTransferencia(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto) override;
+    std::vector<ResultadoTransferencia> realizarTransferenciasLote(const std::vector<Transferencia>& transferencias) override;
+    bsoncxx::document::value obtenerInformacionCuenta(const std::string& numeroCuenta) override;
+    std::string obtenerCedulaPorNumeroCuenta(const std::string& numeroCuenta) override;
+    bool existenPersonasEnBaseDatos() override;
+    long obtenerTotalPersonasRegistradas() override;
+    bool existenCuentasEnBaseDatos() override;
+    long obtenerTotalCuentasRegistradas() override;
+    std::vector<bsoncxx::document::value> mostrarTodasPersonas() override;
+    uint64_t obtenerContadorCambiosPersonas() override;
+#pragma endregion
+
+#pragma region === SECUENCIALES ===
+    int obtenerUltimoSecuencial(const std::string& sucursal) override;
+    bool actualizarSecuencial(const std::string& sucursal, int nuevoSecuencial) override;
+    int obtenerMayorNumeroCuentaPorSucursal(const std::string& sucursal) override;
+    bool reservarBloqueSecuencial(const std::string& sucursal, int tamanoBloque, int& primero) override;
+#pragma endregion
+};
+
+#endif // REPOSITORIOBANCOMEMORIA_H
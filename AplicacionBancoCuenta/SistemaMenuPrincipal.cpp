@@ -1,8 +1,11 @@
 #include "SistemaMenuPrincipal.h"
 #include "ConexionMongo.h"
 #include "_ExportadorArchivo.h"
+#include "AuditoriaAsincrona.h"
+#include "FabricaRepositorioBanco.h"
+#include "ArbolBPlusGrafico.h"
 
-SistemaMenuPrincipal::SistemaMenuPrincipal(Banco& bancoRef) : banco(bancoRef), baseDatosPersona(ConexionMongo::obtenerClienteBaseDatos()) {
+SistemaMenuPrincipal::SistemaMenuPrincipal(Banco& bancoRef) : banco(bancoRef) {
 	inicializarOpciones();
 	inicializarAcciones();
 }
@@ -119,6 +122,9 @@ void SistemaMenuPrincipal::ejecutarSalir() {
 	Utilidades::ocultarCursor();
 	Utilidades::limpiarPantallaPreservandoMarquesina(0);
 	std::cout << "Saliendo del sistema...\n";
+	AuditoriaAsincrona::detener();
+	// exit() no destruye la aplicación: el almacén local se cierra aquí para registrar su contador
+	FabricaRepositorioBanco::cerrarAlmacenLocal();
 	exit(0);
 }
 
@@ -137,24 +143,56 @@ void SistemaMenuPrincipal::ejecutarGestionHash()
 }
 
 void SistemaMenuPrincipal::ejecutarArbolB() {
-	baseDatosPersona.iniciarBaseDatosArbolB();
+	// Repositorio del motor configurado: en modo MEMORIA no se contacta a MongoDB
+	IRepositorioBanco& baseDatos = FabricaRepositorioBanco::obtenerRepositorio();
+
+	// Verificar que existan datos en la base de datos
+	if (!baseDatos.existenPersonasEnBaseDatos()) {
+		Utilidades::limpiarPantallaPreservandoMarquesina(1);
+		std::cout << "No hay personas registradas en la base de datos.\n";
+		std::cout << "Por favor, registre personas primero.\n";
+		system("pause");
+		return;
+	}
+
+	// Menú de selección de criterio
+	std::vector<std::string> criterios = {
+		"Ordenar por Cédula",
+		"Ordenar por Nombre (3 chars)",
+		"Ordenar por Apellido (3 chars)",
+		"Ordenar por Fecha de Nacimiento",
+		"Volver al menú principal"
+	};
+
+	Utilidades::limpiarPantallaPreservandoMarquesina(1);
+
+	int seleccion = Utilidades::menuInteractivo(
+		"=== Árbol B+ Gráfico - Seleccione Criterio ===",
+		criterios, 0, 0
+	);
+
+	if (seleccion >= 0 && seleccion <= 3) {
+		// Mostrar árbol B+ gráfico con SFML
+		ArbolBPlusGrafico::mostrarAnimadoSFMLGrado3(baseDatos, "", seleccion);
+	}
+	// Si seleccion == 4 o -1 (ESC), simplemente regresa al menú
 }
 
 /**
  * @brief Implementación en SistemaMenuPrincipal para usar la nueva funcionalidad
  */
 void SistemaMenuPrincipal::ejecutarGuardarArchivo() {
-	ExportadorArchivo::procesarSolicitudGuardado(baseDatosPersona);
+	ExportadorArchivo::procesarSolicitudGuardado(FabricaRepositorioBanco::obtenerRepositorio());
 }
 
 void SistemaMenuPrincipal::ejecutarRecuperarArchivo()
 {
-	ExportadorArchivo::procesarSolicitudRecuperacion(baseDatosPersona);
+	ExportadorArchivo::procesarSolicitudRecuperacion(FabricaRepositorioBanco::obtenerRepositorio());
 }
 
 void SistemaMenuPrincipal::ejecutarDescifrarArchivo()
 {
-	bool resultado = Cifrado::iniciarProcesoDescifrado(baseDatosPersona);
+	bool resultado = Cifrado::iniciarProcesoDescifrado(FabricaRepositorioBanco::obtenerRepositorio());
 	(void)resultado; // Evitar warning de variable no utilizada si es necesario
 }
 
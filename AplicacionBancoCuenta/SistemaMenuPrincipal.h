@@ -1,7 +1,6 @@
 #pragma once
 #include "Banco.h"
 #include "_BaseDatosArchivos.h"
-#include "_BaseDatosPersona.h"
 #include "DocumentacionDoxygen.h"
 #include "AdministradorChatSocket.h"
 #include "CodigoQR.h"
@@ -22,7 +21,6 @@ class SistemaMenuPrincipal {
 private:
     Banco& banco;
     _BaseDatosArchivos baseDatosArchivos;
-	_BaseDatosPersona baseDatosPersona;
     DocumentacionDoxygen documentoDoxygen;
 
     std::vector<std::string> opcionesMenu;
@@ -0,0 +1,213 @@
+/**
+ * @file TablaCuentas.cpp
+ * @brief Implementación de la tabla de cuentas por columnas
+ */
+#include "TablaCuentas.h"
+#include <algorithm>
+#include <iostream>
+#include <cctype>
+
+namespace {
+	/**
+	 * @brief Suma valor(i) para i en [0, n) con cuatro acumuladores independientes
+	 *
+	 * Sin reordenar la suma el compilador no puede vectorizarla; con cuatro cadenas
+	 * separadas cada iteración ya es un paquete de cuatro sumas independientes.
+	 */
+	template<typename Valor>
+	double sumarEnCuatro(size_t n, Valor valor) {
+		double a = 0.0, b = 0.0, c = 0.0, d = 0.0;
+		size_t i = 0;
+		for (; i + 4 <= n; i += 4) {
+			a += valor(i);
+			b += valor(i + 1);
+			c += valor(i + 2);
+			d += valor(i + 3);
+		}
+		for (; i < n; ++i) {
+			a += valor(i);
+		}
+		return (a + b) + (c + d);
+	}
+
+	bool igualSinMayusculas(std::string_view a, std::string_view b) {
+		return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+			return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+			});
+	}
+}
+
+std::string_view nombreEstado(EstadoCuenta estado) {
+	switch (estado) {
+	case EstadoCuenta::ACTIVA: return "ACTIVA";
+	case EstadoCuenta::INACTIVA: return "INACTIVA";
+	case EstadoCuenta::BLOQUEADA: return "BLOQUEADA";
+	case EstadoCuenta::CERRADA: return "CERRADA";
+	default: return "";
+	}
+}
+
+EstadoCuenta estadoDesdeTexto(std::string_view texto) {
+	for (EstadoCuenta estado : { EstadoCuenta::ACTIVA, EstadoCuenta::INACTIVA, EstadoCuenta::BLOQUEADA, EstadoCuenta::CERRADA }) {
+		if (igualSinMayusculas(texto, nombreEstado(estado))) {
+			return estado;
+		}
+	}
+	return EstadoCuenta::SIN_ESTADO;
+}
+
+bool TablaCuentas::FilasPersona::agregar(Fila fila) {
+	if (cantidad == MAX_CUENTAS_PERSONA) {
+		return false;
+	}
+	filas[cantidad++] = fila;
+	return true;
+}
+
+bool TablaCuentas::FilasPersona::quitar(Fila fila) {
+	auto fin = filas.begin() + cantidad;
+	auto posicion = std::find(filas.begin(), fin, fila);
+	if (posicion == fin) {
+		return false;
+	}
+	// Se conserva el orden de alta de las demás cuentas
+	std::copy(posicion + 1, fin, posicion);
+	cantidad--;
+	return true;
+}
+
+TablaCuentas::TablaCuentas() : filasVivas(0), repetidos(0) {
+}
+
+TablaCuentas& TablaCuentas::global() {
+	static TablaCuentas tabla;
+	return tabla;
+}
+
+TablaCuentas::Fila TablaCuentas::registrar(Cuenta<double>* cuenta, TipoCuenta tipo) {
+	Fila fila;
+	if (!libres.empty()) {
+		fila = libres.back();
+		libres.pop_back();
+	}
+	else {
+		fila = static_cast<Fila>(saldos.size());
+		numeros.emplace_back();
+		saldos.push_back(0.0);
+		fechasApertura.emplace_back(0, 0, 0);
+		estados.push_back(EstadoCuenta::SIN_ESTADO);
+		tipos.push_back(tipo);
+		tasasInteres.push_back(0.0);
+		vivas.push_back(0);
+		cuentas.push_back(nullptr);
+		titulares.push_back(nullptr);
+	}
+
+	tipos[fila] = tipo;
+	vivas[fila] = 1;
+	cuentas[fila] = cuenta;
+	filasVivas++;
+	return fila;
+}
+
+void TablaCuentas::liberar(Fila fila) {
+	if (fila >= vivas.size() || !vivas[fila]) {
+		return;
+	}
+	desindexarNumero(fila);
+	numeros[fila].limpiar();
+	saldos[fila] = 0.0;
+	fechasApertura[fila] = Fecha(0, 0, 0);
+	estados[fila] = EstadoCuenta::SIN_ESTADO;
+	tasasInteres[fila] = 0.0;
+	vivas[fila] = 0;
+	cuentas[fila] = nullptr;
+	titulares[fila] = nullptr;
+	libres.push_back(fila);
+	filasVivas--;
+}
+
+bool TablaCuentas::setNumero(Fila fila, std::string_view valor) {
+	desindexarNumero(fila);
+	if (!numeros[fila].asignar(valor)) {
+		std::cerr << "Error: Número de cuenta de más de 10 caracteres: " << valor << std::endl;
+		return false;
+	}
+	indexarNumero(fila);
+	return true;
+}
+
+void TablaCuentas::indexarNumero(Fila fila) {
+	if (numeros[fila].vacio()) {
+		return;
+	}
+	if (!indiceNumeros.emplace(numeros[fila], fila).second) {
+		repetidos++;
+	}
+}
+
+void TablaCuentas::desindexarNumero(Fila fila) {
+	if (numeros[fila].vacio()) {
+		return;
+	}
+	auto entrada = indiceNumeros.find(numeros[fila]);
+	if (entrada == indiceNumeros.end()) {
+		return;
+	}
+	if (entrada->second != fila) {
+		repetidos--; // Era una de las filas repetidas que el índice no apuntaba
+		return;
+	}
+	indiceNumeros.erase(entrada);
+	if (repetidos == 0) {
+		return;
+	}
+	// Otra fila viva puede tener el mismo número: pasa a ser la indexada
+	for (size_t i = 0; i < numeros.size(); ++i) {
+		if (i != fila && vivas[i] && numeros[i] == numeros[fila]) {
+			indiceNumeros.emplace(numeros[i], static_cast<Fila>(i));
+			repetidos--;
+			return;
+		}
+	}
+}
+
+std::vector<TablaCuentas::Fila> TablaCuentas::filasConSaldoMinimo(double minimo) const {
+	std::vector<Fila> resultado;
+	const double* saldo = saldos.data();
+	const uint8_t* viva = vivas.data();
+	for (size_t i = 0; i < saldos.size(); ++i) {
+		if (viva[i] & (saldo[i] >= minimo)) {
+			resultado.push_back(static_cast<Fila>(i));
+		}
+	}
+	return resultado;
+}
+
+double TablaCuentas::totalSaldos() const {
+	const double* saldo = saldos.data();
+	return sumarEnCuatro(saldos.size(), [saldo](size_t i) { return saldo[i]; });
+}
+
+double TablaCuentas::totalSaldos(TipoCuenta tipo) const {
+	const double* saldo = saldos.data();
+	const TipoCuenta* tipoFila = tipos.data();
+	return sumarEnCuatro(saldos.size(), [saldo, tipoFila, tipo](size_t i) {
+		return tipoFila[i] == tipo ? saldo[i] : 0.0;
+	});
+}
+
+double TablaCuentas::totalIntereses() const {
+	const double* saldo = saldos.data();
+	const double* tasa = tasasInteres.data();
+	return sumarEnCuatro(saldos.size(), [saldo, tasa](size_t i) { return saldo[i] * tasa[i]; }) / 100.0;
+}
+
+TablaCuentas::Fila TablaCuentas::buscarPorNumero(std::string_view numeroCuenta) const {
+	NumeroCuenta buscado;
+	if (numeroCuenta.empty() || !buscado.asignar(numeroCuenta)) {
+		return SIN_FILA;
+	}
+	auto entrada = indiceNumeros.find(buscado);
+	return entrada != indiceNumeros.end() ? entrada->second : SIN_FILA;
+}
@@ -0,0 +1,195 @@
+#pragma once
+#ifndef TABLACUENTAS_H
+#define TABLACUENTAS_H
+
+#include "Fecha.h"
+#include "IdentificadorFijo.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+template <typename T>
+class Cuenta;
+class Persona;
+
+/**
+ * @brief Tipo de cuenta guardado en la columna de tipos de TablaCuentas
+ */
+enum class TipoCuenta : uint8_t {
+    AHORROS = 0,
+    CORRIENTE = 1
+};
+
+/**
+ * @brief Estado de una cuenta, guardado en un byte en la columna de estados
+ *
+ * SIN_ESTADO es el de una cuenta recién registrada o leída con un texto desconocido;
+ * consultarEstado() lo muestra como ACTIVA.
+ */
+enum class EstadoCuenta : uint8_t {
+    SIN_ESTADO = 0,
+    ACTIVA = 1,
+    INACTIVA = 2,
+    BLOQUEADA = 3,
+    CERRADA = 4
+};
+
+/**
+ * @brief Texto con el que se muestra y guarda un estado ("ACTIVA", ...; "" sin estado)
+ */
+std::string_view nombreEstado(EstadoCuenta estado);
+
+/**
+ * @brief Estado a partir de su texto, sin distinguir mayúsculas; SIN_ESTADO si no se reconoce
+ */
+EstadoCuenta estadoDesdeTexto(std::string_view texto);
+
+/**
+ * @class TablaCuentas
+ * @brief Datos de todas las cuentas en memoria, organizados por columnas
+ *
+ * Cada cuenta ocupa una fila; número, saldo, fecha de apertura, estado, tipo y tasa de
+ * interés se guardan en vectores separados de valores de tamaño fijo (el número en 10
+ * bytes, la fecha en 4 y el estado en 1), de modo que los recorridos de cartera
+ * (saldo mínimo, totales, intereses) leen solo las columnas que necesitan, en orden y
+ * sin saltar entre nodos. Los objetos Cuenta son la vista de una fila: la registran al
+ * construirse y la liberan al destruirse, y sus getters y setters leen y escriben aquí.
+ *
+ * Las filas liberadas quedan con saldo y tasa en 0 y se reutilizan; así las sumas no
+ * necesitan consultar si la fila está viva. Un índice por número de cuenta, mantenido
+ * por setNumero y liberar, resuelve buscarPorNumero sin recorrer la tabla.
+ *
+ * No sincroniza el acceso: las cuentas en memoria solo se crean, modifican y destruyen
+ * desde el hilo de la interfaz (los hilos del chat y la marquesina no las tocan), y
+ * PoolCompartido sigue el mismo modelo.
+ */
+class TablaCuentas {
+public:
+    using Fila = uint32_t;
+    static constexpr Fila SIN_FILA = UINT32_MAX;
+
+    // Límite de cuentas por persona, el mismo que aplica agregarCuentaPersona en la base
+    static constexpr size_t MAX_CUENTAS_PERSONA = 5;
+
+    /**
+     * @class FilasPersona
+     * @brief Filas de las cuentas de una persona, guardadas dentro de la propia Persona
+     */
+    class FilasPersona {
+    private:
+        std::array<Fila, MAX_CUENTAS_PERSONA> filas;
+        size_t cantidad;
+
+    public:
+        FilasPersona() : filas(), cantidad(0) {}
+
+        /**
+         * @return false si la persona ya tiene MAX_CUENTAS_PERSONA cuentas
+         */
+        bool agregar(Fila fila);
+        bool quitar(Fila fila);
+
+        size_t tamano() const { return cantidad; }
+        bool llena() const { return cantidad == MAX_CUENTAS_PERSONA; }
+        const Fila* begin() const { return filas.data(); }
+        const Fila* end() const { return filas.data() + cantidad; }
+    };
+
+private:
+    std::vector<NumeroCuenta> numeros;
+    std::vector<double> saldos;
+    std::vector<Fecha> fechasApertura;
+    std::vector<EstadoCuenta> estados;
+    std::vector<TipoCuenta> tipos;
+    std::vector<double> tasasInteres;      // Porcentaje anual; 0 en cuentas corrientes
+    std::vector<uint8_t> vivas;            // 1 si la fila pertenece a una cuenta
+    std::vector<Cuenta<double>*> cuentas;  // Objeto que representa la fila
+    std::vector<Persona*> titulares;       // nullptr mientras la cuenta no se asocia a nadie
+    std::vector<Fila> libres;
+    size_t filasVivas;
+
+    // Número -> fila. Si dos filas vivas comparten número, el índice apunta a la primera
+    // que lo tomó y repetidos cuenta las demás, para buscar reemplazo solo si hace falta
+    std::unordered_map<NumeroCuenta, Fila, NumeroCuenta::Hash> indiceNumeros;
+    size_t repetidos;
+
+    void indexarNumero(Fila fila);
+    void desindexarNumero(Fila fila);
+
+public:
+    TablaCuentas();
+
+    TablaCuentas(const TablaCuentas&) = delete;
+    TablaCuentas& operator=(const TablaCuentas&) = delete;
+
+    /**
+     * @brief Tabla compartida por todas las cuentas del proceso
+     */
+    static TablaCuentas& global();
+
+    /**
+     * @brief Reserva una fila vacía para la cuenta indicada
+     */
+    Fila registrar(Cuenta<double>* cuenta, TipoCuenta tipo);
+
+    /**
+     * @brief Devuelve la fila al conjunto de libres y la deja en cero
+     */
+    void liberar(Fila fila);
+
+    // === Columnas ===
+    // La vista del número es válida hasta que se registre otra cuenta
+    std::string_view numero(Fila fila) const { return numeros[fila].vista(); }
+    double saldo(Fila fila) const { return saldos[fila]; }
+    Fecha fechaApertura(Fila fila) const { return fechasApertura[fila]; }
+    EstadoCuenta estado(Fila fila) const { return estados[fila]; }
+    TipoCuenta tipo(Fila fila) const { return tipos[fila]; }
+    double tasaInteres(Fila fila) const { return tasasInteres[fila]; }
+    Cuenta<double>* cuenta(Fila fila) const { return cuentas[fila]; }
+    Persona* titular(Fila fila) const { return titulares[fila]; }
+
+    /**
+     * @return false si el número tiene más de 10 caracteres; la fila queda sin número
+     */
+    bool setNumero(Fila fila, std::string_view valor);
+    void setSaldo(Fila fila, double valor) { saldos[fila] = valor; }
+    void setFechaApertura(Fila fila, const Fecha& valor) { fechasApertura[fila] = valor; }
+    void setEstado(Fila fila, EstadoCuenta valor) { estados[fila] = valor; }
+    void setTasaInteres(Fila fila, double valor) { tasasInteres[fila] = valor; }
+    void setTitular(Fila fila, Persona* valor) { titulares[fila] = valor; }
+
+    size_t tamano() const { return filasVivas; }
+
+    // === Recorridos de cartera ===
+
+    /**
+     * @brief Filas vivas con saldo >= minimo, en orden de fila
+     */
+    std::vector<Fila> filasConSaldoMinimo(double minimo) const;
+
+    /**
+     * @brief Suma de los saldos de todas las cuentas
+     */
+    double totalSaldos() const;
+
+    /**
+     * @brief Suma de los saldos de las cuentas de un tipo
+     */
+    double totalSaldos(TipoCuenta tipo) const;
+
+    /**
+     * @brief Interés anual de todas las cuentas de ahorros: suma de saldo * tasa / 100
+     */
+    double totalIntereses() const;
+
+    /**
+     * @brief Fila viva con el número de cuenta indicado, o SIN_FILA; O(1) por el índice
+     */
+    Fila buscarPorNumero(std::string_view numeroCuenta) const;
+};
+
+#endif // TABLACUENTAS_H
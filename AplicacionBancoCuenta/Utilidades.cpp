@@ -39,6 +39,7 @@
 #include "Persona.h"
 #include "ConexionMongo.h"
 #include "_BaseDatosPersona.h"
+#include "FabricaRepositorioBanco.h"
 #include "GestorHashBaseDatos.h"
 
  // Variable externa para acceso a la marquesina global
@@ -427,6 +428,56 @@ std::string Utilidades::ConvertirAMinusculas(const std::string& texto) {
 	return resultado;
 }
 
+/**
+ * @brief Convierte a minúsculas y pliega las letras acentuadas de Latin-1 a su base
+ *
+ * Las letras U+00C0..U+00FF llegan como C3 xx en UTF-8 o como un solo byte en Latin-1;
+ * ambas formas se reemplazan por la misma letra ASCII, de modo que "José", "JOSÉ" y
+ * "Jose" producen la misma clave.
+ *
+ * @param texto Cadena original
+ * @return std::string Cadena normalizada
+ */
+std::string Utilidades::NormalizarTexto(const std::string& texto) {
+	// Letra base de U+00C0..U+00FF; 0 conserva el carácter (Æ, ×, ß, ...)
+	static const char PLEGADO[64] = {
+		'a', 'a', 'a', 'a', 'a', 'a', 0, 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',
+		0, 'n', 'o', 'o', 'o', 'o', 'o', 0, 0, 'u', 'u', 'u', 'u', 'y', 0, 0,
+		'a', 'a', 'a', 'a', 'a', 'a', 0, 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',
+		0, 'n', 'o', 'o', 'o', 'o', 'o', 0, 0, 'u', 'u', 'u', 'u', 'y', 0, 'y'
+	};
+	auto esContinuacion = [&texto](size_t i) {
+		return i < texto.size() && (static_cast<unsigned char>(texto[i]) & 0xC0) == 0x80;
+	};
+
+	std::string resultado;
+	resultado.reserve(texto.size());
+	for (size_t i = 0; i < texto.size(); ++i) {
+		unsigned char c = static_cast<unsigned char>(texto[i]);
+		if (c < 0x80) {
+			resultado.push_back(static_cast<char>(std::tolower(c)));
+		}
+		else if (c == 0xC3 && esContinuacion(i + 1)) {
+			unsigned char siguiente = static_cast<unsigned char>(texto[++i]);
+			char base = PLEGADO[siguiente - 0x80];
+			if (base) {
+				resultado.push_back(base);
+			}
+			else {
+				resultado.push_back(static_cast<char>(c));
+				resultado.push_back(static_cast<char>(siguiente));
+			}
+		}
+		else if (c >= 0xC0 && !esContinuacion(i + 1) && PLEGADO[c - 0xC0]) {
+			resultado.push_back(PLEGADO[c - 0xC0]); // Latin-1
+		}
+		else {
+			resultado.push_back(static_cast<char>(c));
+		}
+	}
+	return resultado;
+}
+
 /**
  * @brief Devuelve un mensaje para regresar al menú principal
  *
@@ -747,7 +798,7 @@ void Utilidades::PorArbolB(NodoPersona* cabeza) {
 	std::sort(personas.begin(), personas.end(), criterioOrdenamiento);
 
 	auto inicio = std::chrono::high_resolution_clock::now();
-	ArbolB<Persona> arbol(3); // Grado 3 para el árbol B
+	ArbolB<Persona> arbol; // Grado mínimo 3 (por defecto): de 2 a 5 claves por nodo, ordenado por cédula
 	arbol.construirDesdeVector(personas);
 	auto fin = std::chrono::high_resolution_clock::now();
 	auto duracion = std::chrono::duration_cast<std::chrono::milliseconds>(fin - inicio).count();
@@ -835,7 +886,10 @@ void Utilidades::PorArbolB(NodoPersona* cabeza) {
 				mostrarArbolConResaltado(criterioBusquedaStr, COLOR_RESALTADO, true);
 
 				// Realizar la búsqueda real
-				Persona* encontrado = arbol.buscar(criterioBusquedaStr, criterioBusqueda);
+				// Por cédula (la clave del árbol) se desciende con búsqueda binaria; el resto recorre
+				Persona* encontrado = (selCriterio == 0)
+					? ExtractorCedulaEmpaquetada::confirmar(arbol.buscarClave(ExtractorCedulaEmpaquetada::empaquetar(criterioBusquedaStr)), criterioBusquedaStr)
+					: arbol.buscar(criterioBusquedaStr, criterioBusqueda);
 
 				auto finBusqueda = std::chrono::high_resolution_clock::now();
 				auto duracionBusqueda = std::chrono::duration_cast<std::chrono::milliseconds>
@@ -894,7 +948,9 @@ void Utilidades::PorArbolB(NodoPersona* cabeza) {
 				mostrarArbolConResaltado(criterioEliminarStr, COLOR_DELETE, true);
 
 				// Realizar la búsqueda real
-				Persona* aEliminar = arbol.buscar(criterioEliminarStr, criterioBusqueda);
+				Persona* aEliminar = (selCriterio == 0)
+					? ExtractorCedulaEmpaquetada::confirmar(arbol.buscarClave(ExtractorCedulaEmpaquetada::empaquetar(criterioEliminarStr)), criterioEliminarStr)
+					: arbol.buscar(criterioEliminarStr, criterioBusqueda);
 
 				gotoxy(0, baseY + 1);
 				if (aEliminar) {
@@ -908,7 +964,7 @@ void Utilidades::PorArbolB(NodoPersona* cabeza) {
 						mostrarArbolConResaltado(criterioEliminarStr, COLOR_DELETE, true);
 
 						// Eliminar del árbol
-						bool eliminado = arbol.eliminar(criterioEliminarStr, criterioBusqueda);
+						bool eliminado = arbol.eliminarClave(ExtractorCedulaEmpaquetada::empaquetar(aEliminar->getCedula()));
 
 						// Eliminar de la lista de personas original
 						if (eliminado) {
@@ -1111,9 +1167,8 @@ void Utilidades::generarQR() {
 		//iniciarOperacionCritica();
 		limpiarPantallaPreservandoMarquesina(1);
 
-		// Obtener datos desde MongoDB usando ConexionMongo
-		auto& clienteDB = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona baseDatos(clienteDB);
+		// Obtener datos del repositorio del motor configurado
+		IRepositorioBanco& baseDatos = FabricaRepositorioBanco::obtenerRepositorio();
 
 		auto personas = baseDatos.mostrarTodasPersonas();
 
@@ -1586,9 +1641,8 @@ void Utilidades::exploradorArchivosInteractivo(Banco& banco) {
 		//iniciarOperacionCritica();
 		limpiarPantallaPreservandoMarquesina(1);
 
-		// Obtener datos desde MongoDB
-		auto& clienteDB = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona baseDatos(clienteDB);
+		// Obtener datos del repositorio del motor configurado
+		IRepositorioBanco& baseDatos = FabricaRepositorioBanco::obtenerRepositorio();
 
 		auto personas = baseDatos.mostrarTodasPersonas();
 
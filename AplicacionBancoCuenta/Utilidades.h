@@ -117,6 +117,15 @@ public:
 	 */
 	static std::string ConvertirAMinusculas(const std::string& texto);
 
+	/**
+	 * @brief Lleva un texto a minúsculas y sin tildes ni diéresis (á -> a, Ñ -> n)
+	 *
+	 * Acepta texto UTF-8 (el de la base) o Latin-1; los demás caracteres se conservan.
+	 * @param texto Cadena a normalizar
+	 * @return Cadena normalizada para comparar nombres
+	 */
+	static std::string NormalizarTexto(const std::string& texto);
+
 	/**
 	 * @brief Retorna una cadena para la opción de regresar al menú principal
 	 * @return Cadena con la opción de regreso
@@ -3,7 +3,7 @@
 #include <iostream>
 #include <iomanip>
 
-ValidadorBaseDatos::ValidadorBaseDatos(_BaseDatosPersona& bd) : baseDatos(bd) {}
+ValidadorBaseDatos::ValidadorBaseDatos(IRepositorioBanco& bd) : baseDatos(bd) {}
 
 bool ValidadorBaseDatos::tienePersonasRegistradas() {
     return baseDatos.existenPersonasEnBaseDatos();
@@ -1,5 +1,5 @@
 #pragma once
-#include "_BaseDatosPersona.h"
+#include "IRepositorioBanco.h"
 #include <memory>
 
 /**
@@ -10,10 +10,10 @@
  */
 class ValidadorBaseDatos {
 private:
-    _BaseDatosPersona& baseDatos;
+    IRepositorioBanco& baseDatos;
 
 public:
-    explicit ValidadorBaseDatos(_BaseDatosPersona& bd);
+    explicit ValidadorBaseDatos(IRepositorioBanco& bd);
 
     /**
      * @brief Verifica si existen personas registradas en la base de datos
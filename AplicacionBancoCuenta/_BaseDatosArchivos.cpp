@@ -1,6 +1,7 @@
 // @file _BaseDatosArchivos.cpp
 #include "_BaseDatosArchivos.h"
 #include "_BaseDatosPersona.h"
+#include "ConexionMongo.h"
 #include "Banco.h"
 #include <mongocxx/client.hpp>
 #include <mongocxx/instance.hpp>
@@ -139,7 +140,7 @@ void _BaseDatosArchivos::exportarBackupMongoDB(const std::string& uri, const std
 		} while (std::filesystem::exists(nombreArchivo));
 
 		// Exportar la colección a archivo
-		mongocxx::client conn{ mongocxx::uri{uri} };
+		auto conn = ConexionMongo::arrendarCliente(uri);
 		auto collection = conn[db][coleccion];
 
 		std::ofstream archivo(nombreArchivo);
@@ -182,7 +183,7 @@ void _BaseDatosArchivos::restaurarBackupMongoDB(const std::string& uri, const st
 	// Extraer el nombre de la colección
 	std::string coleccion = match[1];
 
-	mongocxx::client conn{ mongocxx::uri{uri} };
+	auto conn = ConexionMongo::arrendarCliente(uri);
 	auto collection = conn[db][coleccion];
 
 	std::ifstream archivo(nombreArchivo);
@@ -197,7 +198,13 @@ void _BaseDatosArchivos::restaurarBackupMongoDB(const std::string& uri, const st
 		if (linea.empty()) continue;
 		try {
 			auto doc = bsoncxx::from_json(linea);
-			collection.insert_one(doc.view());
+			if (coleccion == "personas") {
+				// Un respaldo anterior a la migración no trae las fechas b_date que usan las búsquedas
+				collection.insert_one(_BaseDatosPersona::personaConFechasBson(doc.view()).view());
+			}
+			else {
+				collection.insert_one(doc.view());
+			}
 			insertados++;
 		}
 		catch (const std::exception& e) {
@@ -206,5 +213,9 @@ void _BaseDatosArchivos::restaurarBackupMongoDB(const std::string& uri, const st
 	}
 	archivo.close();
 
+	if (coleccion == "personas" && insertados > 0) {
+		_BaseDatosPersona::registrarCambioExternoPersonas(conn[db]);
+	}
+
 	std::cout << "Restauración completada en colección '" << coleccion << "'. Documentos insertados: " << insertados << std::endl;
 }
\ No newline at end of file
@@ -8,33 +8,402 @@
  */
 #include "_BaseDatosPersona.h"
 #include "ConexionMongo.h"
-#include "ArbolBPlusGrafico.h"
+#include "MetricasLatencia.h"
 #include <bsoncxx/builder/stream/document.hpp>
 #include <bsoncxx/builder/basic/document.hpp>
 #include <bsoncxx/builder/basic/array.hpp>
 #include <bsoncxx/builder/basic/kvp.hpp>
 #include <bsoncxx/json.hpp>
+#include <bsoncxx/types.hpp>
 #include <mongocxx/instance.hpp>
 #include <mongocxx/client.hpp>
 #include <mongocxx/uri.hpp>
 #include <mongocxx/pipeline.hpp>
+#include <mongocxx/options/find.hpp>
+#include <mongocxx/options/find_one_and_update.hpp>
+#include <mongocxx/options/transaction.hpp>
+#include <mongocxx/write_concern.hpp>
+#include <mongocxx/bulk_write.hpp>
+#include <mongocxx/model/update_one.hpp>
+#include <mongocxx/options/bulk_write.hpp>
+#include <mongocxx/options/index.hpp>
+#include <mongocxx/options/update.hpp>
+#include <mongocxx/exception/operation_exception.hpp>
 #include <iostream>
 #include <string>
 #include <cmath>
 #include <iomanip>
 #include <chrono>
+#include <stdexcept>
+#include <unordered_map>
+#include <algorithm>
 #include "Persona.h"
 
 using bsoncxx::builder::basic::kvp;
 using bsoncxx::builder::basic::make_document;
 
+namespace {
+	/**
+	 * @brief Rechazo de negocio dentro de una transacción (fondos o cuenta inexistente)
+	 *
+	 * Al no llevar etiquetas de error del servidor, with_transaction aborta y la relanza
+	 * sin reintentar.
+	 */
+	class TransferenciaRechazada : public std::runtime_error {
+	public:
+		explicit TransferenciaRechazada(const std::string& mensaje) : std::runtime_error(mensaje) {}
+	};
+
+	/**
+	 * @brief Escritura de personas que no se aplicó; aborta la transacción del contador de cambios
+	 */
+	class EscrituraNoAplicada : public std::runtime_error {
+	public:
+		EscrituraNoAplicada() : std::runtime_error("Escritura de persona no aplicada") {}
+	};
+
+	/**
+	 * @brief Copia un documento de cuenta agregando fechaAperturaDate (b_date)
+	 *
+	 * Escritura doble durante la migración: fechaApertura sigue siendo DD/MM/AAAA para
+	 * los lectores existentes y fechaAperturaDate sirve al índice de rangos.
+	 */
+	bsoncxx::document::value cuentaConFechaBson(const bsoncxx::document::view& cuentaDoc) {
+		bsoncxx::builder::basic::document resultado;
+		for (auto&& elemento : cuentaDoc) {
+			if (elemento.key() != "fechaAperturaDate") {
+				resultado.append(kvp(elemento.key(), elemento.get_value()));
+			}
+		}
+		auto fechaElement = cuentaDoc["fechaApertura"];
+		bsoncxx::types::b_date fecha{ std::chrono::milliseconds{ 0 } };
+		if (fechaElement && fechaElement.type() == bsoncxx::type::k_utf8 &&
+			IRepositorioBanco::convertirFechaABsonDate(std::string(fechaElement.get_string().value), fecha)) {
+			resultado.append(kvp("fechaAperturaDate", fecha));
+		}
+		return resultado.extract();
+	}
+}
+
 /**
  * @brief Constructor de la clase _BaseDatosPersona
  *
- * @param client Referencia al cliente de MongoDB
+ * No guarda un cliente ni contacta al servidor: cada operación arrienda uno del pool de
+ * ConexionMongo, por lo que una misma instancia puede usarse desde varios hilos, y los
+ * índices se crean en la primera operación.
+ */
+_BaseDatosPersona::_BaseDatosPersona() {
+}
+
+std::once_flag _BaseDatosPersona::banderaIndices;
+std::atomic<uint64_t> _BaseDatosPersona::generacionSoporteTransacciones{ 0 };
+std::atomic<bool> _BaseDatosPersona::soporteTransacciones{ false };
+
+/**
+ * @brief Crea los índices de la colección personas la primera vez que se usa la clase
+ *
+ * create_index es idempotente en el servidor; std::call_once evita repetir el viaje
+ * de red cada vez que se construye una instancia temporal de esta clase.
+ */
+void _BaseDatosPersona::asegurarIndices() {
+	std::call_once(banderaIndices, []() {
+		try {
+			auto cliente = ConexionMongo::arrendarCliente();
+			auto collection = cliente["Banco"]["personas"];
+			collection.create_index(make_document(kvp("cuentas.numeroCuenta", 1)));
+			collection.create_index(make_document(kvp("cedula", 1)));
+			collection.create_index(make_document(kvp("cuentas.fechaAperturaDate", 1)));
+			collection.create_index(make_document(kvp("fechaNacimientoDate", 1)));
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Error al crear índices de personas: " << e.what() << std::endl;
+		}
+
+		migrarFechasABsonDate();
+
+		try {
+			// El contador de cambios existe desde el inicio: leerlo nunca escribe y 0 queda
+			// reservado para "sin contador"
+			auto cliente = ConexionMongo::arrendarCliente();
+			mongocxx::options::update opciones;
+			opciones.upsert(true);
+			cliente["Banco"]["metadatos"].update_one(
+				make_document(kvp("_id", "personas")).view(),
+				make_document(kvp("$setOnInsert", make_document(kvp("contadorCambios", static_cast<int64_t>(1))))).view(),
+				opciones
+			);
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Error al crear el contador de cambios: " << e.what() << std::endl;
+		}
+
+		try {
+			// Un único contador por sucursal: evita contadores duplicados al inicializarlos en paralelo
+			auto cliente = ConexionMongo::arrendarCliente();
+			mongocxx::options::index opcionesIndice;
+			opcionesIndice.unique(true);
+			cliente["Banco"]["secuenciales"].create_index(make_document(kvp("sucursal", 1)), opcionesIndice);
+		}
+		catch (const std::exception& e) {
+			std::cerr << "Error al crear índice de secuenciales: " << e.what() << std::endl;
+		}
+	});
+}
+
+/**
+ * @brief Completa fechaNacimientoDate y cuentas.N.fechaAperturaDate en documentos antiguos
+ *
+ * Solo lee los documentos a los que les falta algún campo b_date y los actualiza por
+ * _id en bloques de bulk_write. Las cuentas solo se agregan al final del arreglo, por
+ * lo que los índices posicionales leídos siguen siendo válidos al escribir.
+ */
+void _BaseDatosPersona::migrarFechasABsonDate() {
+	try {
+		auto cliente = ConexionMongo::arrendarCliente();
+		auto collection = cliente["Banco"]["personas"];
+
+		auto pendientes = make_document(kvp("$or", [](bsoncxx::builder::basic::sub_array condiciones) {
+			condiciones.append(make_document(kvp("fechaNacimientoDate", make_document(kvp("$exists", false)))));
+			condiciones.append(make_document(kvp("cuentas", make_document(kvp("$elemMatch", make_document(
+				kvp("fechaAperturaDate", make_document(kvp("$exists", false)))
+			))))));
+		}));
+
+		mongocxx::options::find opciones;
+		opciones.projection(make_document(
+			kvp("fechaNacimiento", 1),
+			kvp("fechaNacimientoDate", 1),
+			kvp("cuentas.fechaApertura", 1),
+			kvp("cuentas.fechaAperturaDate", 1)
+		));
+
+		mongocxx::options::bulk_write opcionesBulk;
+		opcionesBulk.ordered(false);
+
+		std::vector<mongocxx::model::update_one> actualizaciones;
+		size_t migrados = 0;
+		auto ejecutarBloque = [&]() {
+			if (actualizaciones.empty()) {
+				return;
+			}
+			auto bulk = collection.create_bulk_write(opcionesBulk);
+			for (auto& actualizacion : actualizaciones) {
+				bulk.append(std::move(actualizacion));
+			}
+			bulk.execute();
+			migrados += actualizaciones.size();
+			actualizaciones.clear();
+		};
+
+		for (auto&& doc : collection.find(pendientes.view(), opciones)) {
+			bsoncxx::builder::basic::document set;
+			bool hayCambios = false;
+			bsoncxx::types::b_date fecha{ std::chrono::milliseconds{ 0 } };
+
+			auto nacimiento = doc["fechaNacimiento"];
+			if (!doc["fechaNacimientoDate"] && nacimiento && nacimiento.type() == bsoncxx::type::k_utf8 &&
+				convertirFechaABsonDate(std::string(nacimiento.get_string().value), fecha)) {
+				set.append(kvp("fechaNacimientoDate", fecha));
+				hayCambios = true;
+			}
+
+			auto cuentasElement = doc["cuentas"];
+			if (cuentasElement && cuentasElement.type() == bsoncxx::type::k_array) {
+				int indice = 0;
+				for (auto& cuenta : cuentasElement.get_array().value) {
+					if (cuenta.type() == bsoncxx::type::k_document) {
+						auto cuentaDoc = cuenta.get_document().value;
+						auto apertura = cuentaDoc["fechaApertura"];
+						if (!cuentaDoc["fechaAperturaDate"] && apertura && apertura.type() == bsoncxx::type::k_utf8 &&
+							convertirFechaABsonDate(std::string(apertura.get_string().value), fecha)) {
+							set.append(kvp("cuentas." + std::to_string(indice) + ".fechaAperturaDate", fecha));
+							hayCambios = true;
+						}
+					}
+					indice++;
+				}
+			}
+
+			if (hayCambios) {
+				actualizaciones.emplace_back(
+					make_document(kvp("_id", doc["_id"].get_oid())),
+					make_document(kvp("$set", set.extract()))
+				);
+				if (actualizaciones.size() >= TAMANO_BLOQUE_BULK) {
+					ejecutarBloque();
+				}
+			}
+		}
+		ejecutarBloque();
+
+		if (migrados > 0) {
+			std::cout << "Fechas migradas a formato BSON en " << migrados << " documentos de personas." << std::endl;
+		}
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al migrar fechas a BSON: " << e.what() << std::endl;
+	}
+}
+
+/**
+ * @brief Arrienda un cliente asegurando antes los índices de personas
+ */
+ConexionMongo::ClienteArrendado _BaseDatosPersona::arrendarCliente() {
+	asegurarIndices();
+	return ConexionMongo::arrendarCliente();
+}
+
+bsoncxx::document::value _BaseDatosPersona::personaConFechasBson(const bsoncxx::document::view& personaDoc) {
+	bsoncxx::builder::basic::document resultado;
+	for (auto&& elemento : personaDoc) {
+		if (elemento.key() == "fechaNacimientoDate") {
+			continue;
+		}
+		if (elemento.key() == "cuentas" && elemento.type() == bsoncxx::type::k_array) {
+			bsoncxx::builder::basic::array cuentas;
+			for (auto&& cuenta : elemento.get_array().value) {
+				if (cuenta.type() == bsoncxx::type::k_document) {
+					cuentas.append(cuentaConFechaBson(cuenta.get_document().value));
+				}
+				else {
+					cuentas.append(cuenta.get_value());
+				}
+			}
+			resultado.append(kvp("cuentas", cuentas.extract()));
+			continue;
+		}
+		resultado.append(kvp(elemento.key(), elemento.get_value()));
+	}
+
+	auto nacimiento = personaDoc["fechaNacimiento"];
+	bsoncxx::types::b_date fecha{ std::chrono::milliseconds{ 0 } };
+	if (nacimiento && nacimiento.type() == bsoncxx::type::k_utf8 &&
+		convertirFechaABsonDate(std::string(nacimiento.get_string().value), fecha)) {
+		resultado.append(kvp("fechaNacimientoDate", fecha));
+	}
+	return resultado.extract();
+}
+
+/**
+ * @brief Obtiene el documento del titular de una cuenta con solo esa cuenta proyectada
+ *
+ * Usa el índice cuentas.numeroCuenta y la proyección posicional cuentas.$, por lo que
+ * la consulta es de un solo viaje y no transfiere el resto de cuentas del titular.
+ *
+ * @param numeroCuenta Número de cuenta a buscar
+ * @param incluirTitular Si es true, incluye los datos básicos del titular
+ * @return Documento proyectado, o std::nullopt si la cuenta no existe
  */
-_BaseDatosPersona::_BaseDatosPersona(mongocxx::client& client)
-	: _client(client) {
+std::optional<bsoncxx::document::value> _BaseDatosPersona::buscarDocumentoCuenta(const std::string& numeroCuenta, bool incluirTitular) {
+	auto cliente = arrendarCliente();
+	auto collection = cliente["Banco"]["personas"];
+
+	bsoncxx::builder::basic::document proyeccion;
+	proyeccion.append(kvp("_id", 0));
+	if (incluirTitular) {
+		proyeccion.append(kvp("cedula", 1), kvp("nombre", 1), kvp("apellido", 1), kvp("correo", 1));
+	}
+	proyeccion.append(kvp("cuentas.$", 1));
+
+	mongocxx::options::find opciones;
+	opciones.projection(proyeccion.extract());
+
+	auto resultado = MetricasLatencia::medir(MetricasLatencia::MONGO_BUSQUEDA, [&]() {
+		return collection.find_one(make_document(kvp("cuentas.numeroCuenta", numeroCuenta)), opciones);
+	});
+	if (!resultado) {
+		return std::nullopt;
+	}
+	return bsoncxx::document::value(resultado->view());
+}
+
+/**
+ * @brief Convierte el campo saldo de una cuenta a double
+ *
+ * @param saldoElement Elemento BSON del saldo
+ * @return Saldo leído, -1.0 si el elemento no existe o no es numérico
+ */
+double _BaseDatosPersona::leerSaldo(const bsoncxx::document::element& saldoElement) {
+	if (saldoElement) {
+		if (saldoElement.type() == bsoncxx::type::k_double) {
+			return redondearMonto(saldoElement.get_double().value);
+		}
+		else if (saldoElement.type() == bsoncxx::type::k_int32) {
+			return static_cast<double>(saldoElement.get_int32().value);
+		}
+		else if (saldoElement.type() == bsoncxx::type::k_int64) {
+			return static_cast<double>(saldoElement.get_int64().value);
+		}
+	}
+	return -1.0;
+}
+
+/**
+ * @brief Aplica un movimiento de saldo con una única operación condicional
+ *
+ * El filtro sobre cuentas.numeroCuenta usa el índice de cuentas y el operador
+ * posicional cuentas.$ actualiza solo la cuenta que coincidió. En retiros el
+ * $elemMatch exige además saldo >= monto sobre ese mismo elemento, lo que elimina
+ * la carrera entre verificar fondos y descontar.
+ *
+ * @param sesion Sesión de la transacción en curso, o nullptr
+ * @param numeroCuenta Número de cuenta a modificar
+ * @param delta Monto a sumar (positivo) o restar (negativo)
+ * @param saldoResultante Salida opcional con el saldo posterior
+ * @return true si el documento coincidió y fue actualizado
+ */
+bool _BaseDatosPersona::aplicarMovimientoSaldo(mongocxx::client_session* sesion, const std::string& numeroCuenta, double delta, double* saldoResultante) {
+	// Una sesión solo puede usarse con el cliente que la creó
+	auto cliente = arrendarCliente();
+	auto collection = sesion ? sesion->client()["Banco"]["personas"] : cliente["Banco"]["personas"];
+
+	bsoncxx::document::value filter = (delta < 0.0)
+		? make_document(kvp("cuentas", make_document(kvp("$elemMatch", make_document(
+			kvp("numeroCuenta", numeroCuenta),
+			kvp("saldo", make_document(kvp("$gte", -delta)))
+		)))))
+		: make_document(kvp("cuentas.numeroCuenta", numeroCuenta));
+
+	auto update = make_document(
+		kvp("$inc", make_document(kvp("cuentas.$.saldo", delta)))
+	);
+
+	mongocxx::options::find_one_and_update opciones;
+	opciones.return_document(mongocxx::options::return_document::k_after);
+	opciones.projection(make_document(
+		kvp("_id", 0),
+		kvp("cuentas.numeroCuenta", 1),
+		kvp("cuentas.saldo", 1)
+	));
+
+	auto resultado = MetricasLatencia::medir(MetricasLatencia::MONGO_ACTUALIZACION, [&]() {
+		return sesion
+			? collection.find_one_and_update(*sesion, filter.view(), update.view(), opciones)
+			: collection.find_one_and_update(filter.view(), update.view(), opciones);
+	});
+	if (!resultado) {
+		return false;
+	}
+
+	if (saldoResultante) {
+		*saldoResultante = -1.0;
+		auto cuentasElement = resultado->view()["cuentas"];
+		if (cuentasElement && cuentasElement.type() == bsoncxx::type::k_array) {
+			for (auto& cuenta : cuentasElement.get_array().value) {
+				if (cuenta.type() != bsoncxx::type::k_document) {
+					continue;
+				}
+				auto cuentaDoc = cuenta.get_document().value;
+				auto numElement = cuentaDoc["numeroCuenta"];
+				if (numElement && numElement.type() == bsoncxx::type::k_utf8 &&
+					std::string(numElement.get_string().value) == numeroCuenta) {
+					*saldoResultante = leerSaldo(cuentaDoc["saldo"]);
+					break;
+				}
+			}
+		}
+	}
+	return true;
 }
 
 /**
@@ -45,11 +414,13 @@ _BaseDatosPersona::_BaseDatosPersona(mongocxx::client& client)
  */
 bool _BaseDatosPersona::insertarNuevaPersona(const Persona& persona)  {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		// Construye el documento BSON a partir del objeto Persona con la misma estructura que insertarPersona
-		auto doc = make_document(
+		bsoncxx::builder::basic::document doc;
+		doc.append(
 			kvp("cedula", persona.getCedula()),
 			kvp("nombre", persona.getNombres()),
 			kvp("apellido", persona.getApellidos()),
@@ -61,9 +432,21 @@ bool _BaseDatosPersona::insertarNuevaPersona(const Persona& persona)  {
 			kvp("totalCuentasExistentes", 0), // Siempre 0 para una persona nueva sin cuentas
 			kvp("cuentas", bsoncxx::builder::basic::array{}) // Array vacío de cuentas para persona nueva
 		);
+		bsoncxx::types::b_date fechaNacimiento{ std::chrono::milliseconds{ 0 } };
+		if (convertirFechaABsonDate(persona.getFechaNacimiento(), fechaNacimiento)) {
+			doc.append(kvp("fechaNacimientoDate", fechaNacimiento));
+		}
 
-		auto result = collection.insert_one(doc.view());
-		return result ? true : false;
+		bool insertada = escribirConContadorCambios(*cliente, [&](mongocxx::client_session* sesion) {
+			auto result = MetricasLatencia::medir(MetricasLatencia::MONGO_INSERCION, [&]() {
+				return sesion ? collection.insert_one(*sesion, doc.view()) : collection.insert_one(doc.view());
+			});
+			return result ? true : false;
+		});
+		if (insertada) {
+			notificarPersonaEscrita(EscrituraPersona{ persona, true, nullptr });
+		}
+		return insertada;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al insertar persona: " << e.what() << std::endl;
@@ -80,15 +463,19 @@ bool _BaseDatosPersona::insertarNuevaPersona(const Persona& persona)  {
  */
 bool _BaseDatosPersona::insertarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial) {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
+		std::optional<bsoncxx::document::value> cuentaGuardada;
 		bsoncxx::builder::basic::array cuentasArray;
 		if (cuentaInicial) {
-			cuentasArray.append(*cuentaInicial);
+			cuentaGuardada = cuentaConFechaBson(cuentaInicial->view());
+			cuentasArray.append(cuentaGuardada->view());
 		}
 
-		auto doc = make_document(
+		bsoncxx::builder::basic::document doc;
+		doc.append(
 			kvp("cedula", persona.getCedula()),
 			kvp("nombre", persona.getNombres()),
 			kvp("apellido", persona.getApellidos()),
@@ -100,9 +487,22 @@ bool _BaseDatosPersona::insertarPersona(const Persona& persona, const bsoncxx::d
 			kvp("totalCuentasExistentes", (cuentaInicial ? 1 : 0)),
 			kvp("cuentas", cuentasArray)
 		);
+		bsoncxx::types::b_date fechaNacimiento{ std::chrono::milliseconds{ 0 } };
+		if (convertirFechaABsonDate(persona.getFechaNacimiento(), fechaNacimiento)) {
+			doc.append(kvp("fechaNacimientoDate", fechaNacimiento));
+		}
 
-		auto result = collection.insert_one(doc.view());
-		return result ? true : false;
+		bool insertada = escribirConContadorCambios(*cliente, [&](mongocxx::client_session* sesion) {
+			auto result = MetricasLatencia::medir(MetricasLatencia::MONGO_INSERCION, [&]() {
+				return sesion ? collection.insert_one(*sesion, doc.view()) : collection.insert_one(doc.view());
+			});
+			return result ? true : false;
+		});
+		if (insertada) {
+			bsoncxx::document::view vistaCuenta = cuentaGuardada ? cuentaGuardada->view() : bsoncxx::document::view();
+			notificarPersonaEscrita(EscrituraPersona{ persona, true, cuentaGuardada ? &vistaCuenta : nullptr });
+		}
+		return insertada;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al insertar persona: " << e.what() << std::endl;
@@ -118,7 +518,8 @@ bool _BaseDatosPersona::insertarPersona(const Persona& persona, const bsoncxx::d
  */
 bool _BaseDatosPersona::existePersonaPorCedula(const std::string& cedula) {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 		auto filter = bsoncxx::builder::basic::make_document(
 			bsoncxx::builder::basic::kvp("cedula", cedula)
@@ -140,7 +541,8 @@ bool _BaseDatosPersona::existePersonaPorCedula(const std::string& cedula) {
  */
 Persona* _BaseDatosPersona::obtenerPersonaPorCedula(const std::string& cedula) {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 		auto filter = bsoncxx::builder::basic::make_document(
 			bsoncxx::builder::basic::kvp("cedula", cedula)
@@ -172,13 +574,17 @@ Persona* _BaseDatosPersona::obtenerPersonaPorCedula(const std::string& cedula) {
  * @return true si la cuenta fue agregada exitosamente, false en caso contrario
  */
 bool _BaseDatosPersona::agregarCuentaPersona(const std::string& cedula, const bsoncxx::document::value& cuentaDoc) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::AGREGAR_CUENTA);
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		// Buscar la persona por cédula
 		auto filter = make_document(kvp("cedula", cedula));
-		auto personaDoc = collection.find_one(filter.view());
+		auto personaDoc = MetricasLatencia::medir(MetricasLatencia::MONGO_BUSQUEDA, [&]() {
+			return collection.find_one(filter.view());
+		});
 
 		if (!personaDoc) {
 			std::cerr << "No se encontró la persona con cédula: " << cedula << std::endl;
@@ -205,10 +611,11 @@ bool _BaseDatosPersona::agregarCuentaPersona(const std::string& cedula, const bs
 		}
 
 		// Construir el update según el tipo de cuenta
+		auto cuentaGuardada = cuentaConFechaBson(cuentaDoc.view());
 		bsoncxx::builder::basic::document update;
 		update.append(
 			bsoncxx::builder::basic::kvp("$push", bsoncxx::builder::basic::make_document(
-				bsoncxx::builder::basic::kvp("cuentas", cuentaDoc)
+				bsoncxx::builder::basic::kvp("cuentas", cuentaGuardada.view())
 			))
 		);
 
@@ -224,8 +631,31 @@ bool _BaseDatosPersona::agregarCuentaPersona(const std::string& cedula, const bs
 		}
 		update.append(bsoncxx::builder::basic::kvp("$inc", incDoc.extract()));
 
-		auto result = collection.update_one(filter.view(), update.view());
-		return result && result->modified_count() == 1;
+		bool agregada = escribirConContadorCambios(*cliente, [&](mongocxx::client_session* sesion) {
+			auto result = MetricasLatencia::medir(MetricasLatencia::MONGO_ACTUALIZACION, [&]() {
+				return sesion
+					? collection.update_one(*sesion, filter.view(), update.view())
+					: collection.update_one(filter.view(), update.view());
+			});
+			return result && result->modified_count() == 1;
+		});
+		if (!agregada) {
+			return false;
+		}
+
+		// Los datos personales no cambian, pero la notificación permite a los índices
+		// incorporar a un titular que aún no conocían
+		auto vista = personaDoc->view();
+		auto texto = [&vista](const char* campo) {
+			auto elemento = vista[campo];
+			return (elemento && elemento.type() == bsoncxx::type::k_utf8)
+				? std::string(elemento.get_string().value) : std::string();
+		};
+		Persona titular(cedula, texto("nombre"), texto("apellido"), texto("fechaNacimiento"),
+			texto("correo"), texto("direccion"));
+		bsoncxx::document::view vistaCuenta = cuentaGuardada.view();
+		notificarPersonaEscrita(EscrituraPersona{ titular, false, &vistaCuenta });
+		return true;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al agregar cuenta: " << e.what() << std::endl;
@@ -259,26 +689,6 @@ bool _BaseDatosPersona::probarConexionMongoDB(const std::string& uri_str) {
 	}
 }
 
-/**
- * @brief Valida que el monto sea un número válido y positivo
- *
- * @param monto Monto a validar
- * @return true si el monto es válido, false en caso contrario
- */
-bool _BaseDatosPersona::validarMonto(double monto) {
-	return monto > 0.0 && monto <= 15000.00 && !std::isnan(monto) && !std::isinf(monto);
-}
-
-/**
- * @brief Redondea un monto a dos decimales
- *
- * @param monto Monto a redondear
- * @return Monto redondeado a dos decimales
- */
-double _BaseDatosPersona::redondearMonto(double monto) {
-	return std::round(monto * 100.0) / 100.0;
-}
-
 /**
  * @brief Busca el índice de una cuenta específica dentro del documento de una persona
  *
@@ -318,25 +728,23 @@ int _BaseDatosPersona::buscarIndiceCuentaEnDocumento(const bsoncxx::document::vi
  */
 std::string _BaseDatosPersona::obtenerCedulaPorNumeroCuenta(const std::string& numeroCuenta) {
 	try {
-		auto db = _client["Banco"];
-		auto collection = db["personas"];
-
-		// Buscar en todas las personas una cuenta con ese número
-		auto cursor = collection.find({});
-
-		for (auto& doc : cursor) {
-			auto& view = doc;
-			int indice = buscarIndiceCuentaEnDocumento(view, numeroCuenta);
-
-			if (indice >= 0) {
-				auto cedulaElement = view["cedula"];
-				if (cedulaElement && cedulaElement.type() == bsoncxx::type::k_utf8) {
-					return std::string(cedulaElement.get_string().value);
-				}
-			}
+		auto cliente = arrendarCliente();
+		auto collection = cliente["Banco"]["personas"];
+		mongocxx::options::find opciones;
+		opciones.projection(make_document(kvp("_id", 0), kvp("cedula", 1)));
+
+		// Consulta puntual sobre el índice cuentas.numeroCuenta
+		auto resultado = MetricasLatencia::medir(MetricasLatencia::MONGO_BUSQUEDA, [&]() {
+			return collection.find_one(make_document(kvp("cuentas.numeroCuenta", numeroCuenta)), opciones);
+		});
+		if (!resultado) {
+			return ""; // No se encontró la cuenta
 		}
-
-		return ""; // No se encontró la cuenta
+		auto cedulaElement = resultado->view()["cedula"];
+		if (cedulaElement && cedulaElement.type() == bsoncxx::type::k_utf8) {
+			return std::string(cedulaElement.get_string().value);
+		}
+		return "";
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al obtener cédula por número de cuenta: " << e.what() << std::endl;
@@ -352,41 +760,24 @@ std::string _BaseDatosPersona::obtenerCedulaPorNumeroCuenta(const std::string& n
  */
 double _BaseDatosPersona::obtenerSaldoCuenta(const std::string& numeroCuenta) {
 	try {
-		auto db = _client["Banco"];
-		auto collection = db["personas"];
-
-		// Buscar en todas las personas una cuenta con ese número
-		auto cursor = collection.find({});
-
-		for (auto& doc : cursor) {
-			auto &view = doc;
-			int indice = buscarIndiceCuentaEnDocumento(view, numeroCuenta);
-
-			if (indice >= 0) {
-				auto cuentasArray = view["cuentas"].get_array().value;
-				auto cuentaIterator = cuentasArray.begin();
-				std::advance(cuentaIterator, indice);
+		auto resultado = buscarDocumentoCuenta(numeroCuenta, false);
+		if (!resultado) {
+			return -1.0; // Cuenta no encontrada
+		}
 
-				if (cuentaIterator != cuentasArray.end() && cuentaIterator->type() == bsoncxx::type::k_document) {
-					auto cuentaDoc = cuentaIterator->get_document().value;
-					auto saldoElement = cuentaDoc["saldo"];
+		auto cuentasElement = resultado->view()["cuentas"];
+		if (!cuentasElement || cuentasElement.type() != bsoncxx::type::k_array) {
+			return -1.0;
+		}
 
-					if (saldoElement) {
-						if (saldoElement.type() == bsoncxx::type::k_double) {
-							return redondearMonto(saldoElement.get_double().value);
-						}
-						else if (saldoElement.type() == bsoncxx::type::k_int32) {
-							return static_cast<double>(saldoElement.get_int32().value);
-						}
-						else if (saldoElement.type() == bsoncxx::type::k_int64) {
-							return static_cast<double>(saldoElement.get_int64().value);
-						}
-					}
-				}
-			}
+		// La proyección cuentas.$ deja únicamente la cuenta buscada en el arreglo
+		auto cuentasArray = cuentasElement.get_array().value;
+		auto cuentaIterator = cuentasArray.begin();
+		if (cuentaIterator != cuentasArray.end() && cuentaIterator->type() == bsoncxx::type::k_document) {
+			return leerSaldo(cuentaIterator->get_document().value["saldo"]);
 		}
 
-		return -1.0; // Cuenta no encontrada
+		return -1.0;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al obtener saldo: " << e.what() << std::endl;
@@ -417,7 +808,8 @@ bool _BaseDatosPersona::verificarFondosSuficientes(const std::string& numeroCuen
  * @param monto Monto a depositar
  * @return true si el depósito fue exitoso, false en caso contrario
  */
-bool _BaseDatosPersona::depositarEnCuenta(const std::string& numeroCuenta, double monto) {
+bool _BaseDatosPersona::depositarEnCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::DEPOSITO);
 	try {
 		if (!validarMonto(monto)) {
 			std::cerr << "Monto inválido para depósito: " << monto << std::endl;
@@ -425,45 +817,15 @@ bool _BaseDatosPersona::depositarEnCuenta(const std::string& numeroCuenta, doubl
 		}
 
 		monto = redondearMonto(monto);
-		std::string cedula = obtenerCedulaPorNumeroCuenta(numeroCuenta);
 
-		if (cedula.empty()) {
+		if (!aplicarMovimientoSaldo(nullptr, numeroCuenta, monto, saldoResultante)) {
 			std::cerr << "No se encontró la cuenta: " << numeroCuenta << std::endl;
 			return false;
 		}
 
-		auto db = _client["Banco"];
-		auto collection = db["personas"];
-
-		// Encontrar el documento de la persona
-		auto filter = make_document(kvp("cedula", cedula));
-		auto personaDoc = collection.find_one(filter.view());
-
-		if (!personaDoc) {
-			return false;
-		}
-
-		int indice = buscarIndiceCuentaEnDocumento(personaDoc->view(), numeroCuenta);
-		if (indice < 0) {
-			return false;
-		}
-
-		// Actualizar el saldo usando el operador $inc para incrementar
-		std::string campoSaldo = "cuentas." + std::to_string(indice) + ".saldo";
-
-		auto update = make_document(
-			kvp("$inc", make_document(kvp(campoSaldo, monto)))
-		);
-
-		auto result = collection.update_one(filter.view(), update.view());
-
-		if (result && result->modified_count() == 1) {
-			std::cout << "Depósito exitoso: $" << std::fixed << std::setprecision(2) << monto
-				<< " en cuenta " << numeroCuenta << std::endl;
-			return true;
-		}
-
-		return false;
+		std::cout << "Depósito exitoso: $" << std::fixed << std::setprecision(2) << monto
+			<< " en cuenta " << numeroCuenta << std::endl;
+		return true;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al depositar: " << e.what() << std::endl;
@@ -478,7 +840,8 @@ bool _BaseDatosPersona::depositarEnCuenta(const std::string& numeroCuenta, doubl
  * @param monto Monto a retirar
  * @return true si el retiro fue exitoso, false en caso contrario
  */
-bool _BaseDatosPersona::retirarDeCuenta(const std::string& numeroCuenta, double monto) {
+bool _BaseDatosPersona::retirarDeCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::RETIRO);
 	try {
 		if (!validarMonto(monto)) {
 			std::cerr << "Monto inválido para retiro: " << monto << std::endl;
@@ -487,49 +850,21 @@ bool _BaseDatosPersona::retirarDeCuenta(const std::string& numeroCuenta, double
 
 		monto = redondearMonto(monto);
 
-		// Verificar fondos suficientes antes del retiro
-		if (!verificarFondosSuficientes(numeroCuenta, monto)) {
-			std::cerr << "Fondos insuficientes para el retiro de $" << std::fixed << std::setprecision(2) << monto << std::endl;
-			return false;
-		}
-
-		std::string cedula = obtenerCedulaPorNumeroCuenta(numeroCuenta);
-		if (cedula.empty()) {
-			std::cerr << "No se encontró la cuenta: " << numeroCuenta << std::endl;
-			return false;
-		}
-
-		auto db = _client["Banco"];
-		auto collection = db["personas"];
-
-		auto filter = make_document(kvp("cedula", cedula));
-		auto personaDoc = collection.find_one(filter.view());
-
-		if (!personaDoc) {
-			return false;
-		}
-
-		int indice = buscarIndiceCuentaEnDocumento(personaDoc->view(), numeroCuenta);
-		if (indice < 0) {
+		// La verificación de fondos va dentro del filtro del update (ver aplicarMovimientoSaldo)
+		if (!aplicarMovimientoSaldo(nullptr, numeroCuenta, -monto, saldoResultante)) {
+			// Solo en el camino de fallo se consulta de nuevo para dar un mensaje preciso
+			if (obtenerSaldoCuenta(numeroCuenta) < 0.0) {
+				std::cerr << "No se encontró la cuenta: " << numeroCuenta << std::endl;
+			}
+			else {
+				std::cerr << "Fondos insuficientes para el retiro de $" << std::fixed << std::setprecision(2) << monto << std::endl;
+			}
 			return false;
 		}
 
-		// Actualizar el saldo restando el monto (usando $inc con valor negativo)
-		std::string campoSaldo = "cuentas." + std::to_string(indice) + ".saldo";
-
-		auto update = make_document(
-			kvp("$inc", make_document(kvp(campoSaldo, -monto)))
-		);
-
-		auto result = collection.update_one(filter.view(), update.view());
-
-		if (result && result->modified_count() == 1) {
-			std::cout << "Retiro exitoso: $" << std::fixed << std::setprecision(2) << monto
-				<< " de cuenta " << numeroCuenta << std::endl;
-			return true;
-		}
-
-		return false;
+		std::cout << "Retiro exitoso: $" << std::fixed << std::setprecision(2) << monto
+			<< " de cuenta " << numeroCuenta << std::endl;
+		return true;
 	}
 	catch (const std::exception& e) {
 		std::cerr << "Error al retirar: " << e.what() << std::endl;
@@ -537,15 +872,50 @@ bool _BaseDatosPersona::retirarDeCuenta(const std::string& numeroCuenta, double
 	}
 }
 
+/**
+ * @brief Deposita un monto dentro de la sesión indicada
+ *
+ * @param sesion Sesión con la transacción activa
+ * @param numeroCuenta Número de cuenta destino
+ * @param monto Monto a depositar
+ * @return true si el depósito se aplicó, false en caso contrario
+ */
+bool _BaseDatosPersona::depositarEnCuenta(mongocxx::client_session& sesion, const std::string& numeroCuenta, double monto) {
+	if (!validarMonto(monto)) {
+		return false;
+	}
+	return aplicarMovimientoSaldo(&sesion, numeroCuenta, redondearMonto(monto), nullptr);
+}
+
+/**
+ * @brief Retira un monto dentro de la sesión indicada
+ *
+ * @param sesion Sesión con la transacción activa
+ * @param numeroCuenta Número de cuenta origen
+ * @param monto Monto a retirar
+ * @return true si el retiro se aplicó, false en caso contrario
+ */
+bool _BaseDatosPersona::retirarDeCuenta(mongocxx::client_session& sesion, const std::string& numeroCuenta, double monto) {
+	if (!validarMonto(monto)) {
+		return false;
+	}
+	return aplicarMovimientoSaldo(&sesion, numeroCuenta, -redondearMonto(monto), nullptr);
+}
+
 /**
  * @brief Realiza una transferencia entre dos cuentas
  *
+ * El retiro y el depósito se ejecutan con la misma sesión dentro de with_transaction.
+ * El retiro ya exige fondos en su filtro, por lo que no hacen falta consultas previas
+ * de existencia o saldo; si alguna de las dos cuentas no coincide la transacción se aborta.
+ *
  * @param cuentaOrigen Número de cuenta origen
  * @param cuentaDestino Número de cuenta destino
  * @param monto Monto a transferir
  * @return true si la transferencia fue exitosa, false en caso contrario
  */
 bool _BaseDatosPersona::realizarTransferencia(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::TRANSFERENCIA);
 	try {
 		if (!validarMonto(monto)) {
 			std::cerr << "Monto inválido para transferencia: " << monto << std::endl;
@@ -559,63 +929,249 @@ bool _BaseDatosPersona::realizarTransferencia(const std::string& cuentaOrigen, c
 
 		monto = redondearMonto(monto);
 
-		// Verificar que ambas cuentas existan
-		if (obtenerSaldoCuenta(cuentaOrigen) < 0.0) {
-			std::cerr << "Cuenta origen no encontrada: " << cuentaOrigen << std::endl;
-			return false;
-		}
+		auto cliente = arrendarCliente();
+		auto session = cliente->start_session();
+
+		mongocxx::write_concern concernEscritura;
+		concernEscritura.acknowledge_level(mongocxx::write_concern::level::k_majority);
+		mongocxx::options::transaction opcionesTransaccion;
+		opcionesTransaccion.write_concern(concernEscritura);
 
-		if (obtenerSaldoCuenta(cuentaDestino) < 0.0) {
-			std::cerr << "Cuenta destino no encontrada: " << cuentaDestino << std::endl;
+		bool origenRechazado = false;
+
+		try {
+			// with_transaction reintenta el callback ante TransientTransactionError y el
+			// commit ante UnknownTransactionCommitResult
+			MetricasLatencia::Medidor medidorTransaccion(MetricasLatencia::MONGO_TRANSACCION);
+			session.with_transaction([&](mongocxx::client_session* sesion) {
+				origenRechazado = false;
+
+				// 1. Retirar de cuenta origen
+				if (!retirarDeCuenta(*sesion, cuentaOrigen, monto)) {
+					origenRechazado = true;
+					throw TransferenciaRechazada("Error en el retiro de la cuenta origen");
+				}
+
+				// 2. Depositar en cuenta destino
+				if (!depositarEnCuenta(*sesion, cuentaDestino, monto)) {
+					throw TransferenciaRechazada("Cuenta destino no encontrada: " + cuentaDestino);
+				}
+			}, opcionesTransaccion);
+		}
+		catch (const TransferenciaRechazada& e) {
+			// Diagnóstico fuera de la transacción, solo en el camino de fallo
+			if (origenRechazado) {
+				if (obtenerSaldoCuenta(cuentaOrigen) < 0.0) {
+					std::cerr << "Cuenta origen no encontrada: " << cuentaOrigen << std::endl;
+				}
+				else {
+					std::cerr << "Fondos insuficientes en cuenta origen" << std::endl;
+				}
+			}
+			else {
+				std::cerr << e.what() << std::endl;
+			}
 			return false;
 		}
 
-		// Verificar fondos suficientes
-		if (!verificarFondosSuficientes(cuentaOrigen, monto)) {
-			std::cerr << "Fondos insuficientes en cuenta origen" << std::endl;
-			return false;
+		std::cout << "Transferencia exitosa: $" << std::fixed << std::setprecision(2) << monto
+			<< " de " << cuentaOrigen << " a " << cuentaDestino << std::endl;
+
+		return true;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error en transferencia: " << e.what() << std::endl;
+		return false;
+	}
+}
+
+/**
+ * @brief Liquida un lote de transferencias con bulk_write dentro de una transacción
+ *
+ * Todo el trabajo (lectura de saldos, simulación y escritura) ocurre dentro del callback
+ * de with_transaction: si hay un conflicto de escritura la transacción se reintenta
+ * completa y los resultados se recalculan sobre los saldos nuevos.
+ *
+ * @param transferencias Transferencias a liquidar, en orden de aplicación
+ * @return Un resultado por transferencia, en el mismo orden
+ */
+std::vector<ResultadoTransferencia> _BaseDatosPersona::realizarTransferenciasLote(const std::vector<Transferencia>& transferencias) {
+	std::vector<ResultadoTransferencia> resultados(transferencias.size());
+
+	// 1. Validación previa, independiente de los saldos
+	std::vector<std::string> numerosCuenta;
+	std::vector<bool> valida(transferencias.size(), false);
+	for (size_t i = 0; i < transferencias.size(); ++i) {
+		const auto& t = transferencias[i];
+		if (!validarMonto(t.monto)) {
+			resultados[i].mensaje = "Monto inválido";
+		}
+		else if (t.cuentaOrigen == t.cuentaDestino) {
+			resultados[i].mensaje = "No se puede transferir a la misma cuenta";
 		}
+		else {
+			valida[i] = true;
+			numerosCuenta.push_back(t.cuentaOrigen);
+			numerosCuenta.push_back(t.cuentaDestino);
+		}
+	}
 
-		// Usar transacción para garantizar atomicidad
-		auto session = _client.start_session();
+	std::sort(numerosCuenta.begin(), numerosCuenta.end());
+	numerosCuenta.erase(std::unique(numerosCuenta.begin(), numerosCuenta.end()), numerosCuenta.end());
+	if (numerosCuenta.empty()) {
+		return resultados;
+	}
 
-		try {
-			session.start_transaction();
-
-			// 1. Retirar de cuenta origen
-			bool retiroExitoso = retirarDeCuenta(cuentaOrigen, monto);
-			if (!retiroExitoso) {
-				session.abort_transaction();
-				std::cerr << "Error en el retiro de la cuenta origen" << std::endl;
-				return false;
+	try {
+		auto cliente = arrendarCliente();
+		auto collection = cliente["Banco"]["personas"];
+		auto session = cliente->start_session();
+
+		mongocxx::write_concern concernEscritura;
+		concernEscritura.acknowledge_level(mongocxx::write_concern::level::k_majority);
+		mongocxx::options::transaction opcionesTransaccion;
+		opcionesTransaccion.write_concern(concernEscritura);
+
+		std::vector<ResultadoTransferencia> resultadosIntento;
+
+		session.with_transaction([&](mongocxx::client_session* sesion) {
+			resultadosIntento = resultados;
+
+			// 2. Leer los saldos de todas las cuentas involucradas, en bloques de $in
+			std::unordered_map<std::string, double> saldos;
+			mongocxx::options::find opcionesLectura;
+			opcionesLectura.projection(make_document(
+				kvp("_id", 0),
+				kvp("cuentas.numeroCuenta", 1),
+				kvp("cuentas.saldo", 1)
+			));
+
+			for (size_t inicio = 0; inicio < numerosCuenta.size(); inicio += TAMANO_BLOQUE_BULK) {
+				size_t fin = (std::min)(inicio + TAMANO_BLOQUE_BULK, numerosCuenta.size());
+				bsoncxx::builder::basic::array lista;
+				for (size_t k = inicio; k < fin; ++k) {
+					lista.append(numerosCuenta[k]);
+				}
+
+				auto filtro = make_document(kvp("cuentas.numeroCuenta", make_document(kvp("$in", lista.extract()))));
+				auto cursor = collection.find(*sesion, filtro.view(), opcionesLectura);
+				for (auto&& doc : cursor) {
+					auto cuentasElement = doc["cuentas"];
+					if (!cuentasElement || cuentasElement.type() != bsoncxx::type::k_array) {
+						continue;
+					}
+					for (auto& cuenta : cuentasElement.get_array().value) {
+						if (cuenta.type() != bsoncxx::type::k_document) {
+							continue;
+						}
+						auto cuentaDoc = cuenta.get_document().value;
+						auto numElement = cuentaDoc["numeroCuenta"];
+						auto saldoElement = cuentaDoc["saldo"];
+						if (!numElement || numElement.type() != bsoncxx::type::k_utf8 || !saldoElement) {
+							continue;
+						}
+						double saldo = -1.0;
+						if (saldoElement.type() == bsoncxx::type::k_double) saldo = saldoElement.get_double().value;
+						else if (saldoElement.type() == bsoncxx::type::k_int32) saldo = saldoElement.get_int32().value;
+						else if (saldoElement.type() == bsoncxx::type::k_int64) saldo = static_cast<double>(saldoElement.get_int64().value);
+						if (saldo >= 0.0) {
+							saldos[std::string(numElement.get_string().value)] = saldo;
+						}
+					}
+				}
+			}
+
+			// 3. Simular en orden y acumular el neto por cuenta
+			std::unordered_map<std::string, double> netos;
+			for (size_t i = 0; i < transferencias.size(); ++i) {
+				if (!valida[i]) {
+					continue;
+				}
+				const auto& t = transferencias[i];
+				double monto = redondearMonto(t.monto);
+				auto origen = saldos.find(t.cuentaOrigen);
+				auto destino = saldos.find(t.cuentaDestino);
+
+				if (origen == saldos.end()) {
+					resultadosIntento[i].mensaje = "Cuenta origen no encontrada: " + t.cuentaOrigen;
+				}
+				else if (destino == saldos.end()) {
+					resultadosIntento[i].mensaje = "Cuenta destino no encontrada: " + t.cuentaDestino;
+				}
+				else if (origen->second < monto) {
+					resultadosIntento[i].mensaje = "Fondos insuficientes en cuenta origen";
+				}
+				else {
+					origen->second -= monto;
+					destino->second += monto;
+					netos[t.cuentaOrigen] -= monto;
+					netos[t.cuentaDestino] += monto;
+					resultadosIntento[i].exitosa = true;
+					resultadosIntento[i].mensaje = "Transferencia aplicada";
+				}
 			}
 
-			// 2. Depositar en cuenta destino
-			bool depositoExitoso = depositarEnCuenta(cuentaDestino, monto);
-			if (!depositoExitoso) {
-				session.abort_transaction();
-				std::cerr << "Error en el depósito a la cuenta destino" << std::endl;
-				return false;
+			// 4. Un update_one por cuenta con movimiento neto, en bloques de bulk_write
+			mongocxx::options::bulk_write opcionesBulk;
+			opcionesBulk.ordered(false);
+
+			std::vector<std::pair<std::string, double>> movimientos;
+			movimientos.reserve(netos.size());
+			for (const auto& par : netos) {
+				double neto = redondearMonto(par.second);
+				if (neto != 0.0) {
+					movimientos.emplace_back(par.first, neto);
+				}
 			}
 
-			// 3. Confirmar transacción
-			session.commit_transaction();
+			for (size_t inicio = 0; inicio < movimientos.size(); inicio += TAMANO_BLOQUE_BULK) {
+				size_t fin = (std::min)(inicio + TAMANO_BLOQUE_BULK, movimientos.size());
+				auto bulk = collection.create_bulk_write(*sesion, opcionesBulk);
+
+				for (size_t k = inicio; k < fin; ++k) {
+					const auto& numero = movimientos[k].first;
+					double neto = movimientos[k].second;
+
+					// Los débitos netos conservan la guarda de fondos del retiro individual
+					bsoncxx::document::value filtro = (neto < 0.0)
+						? make_document(kvp("cuentas", make_document(kvp("$elemMatch", make_document(
+							kvp("numeroCuenta", numero),
+							kvp("saldo", make_document(kvp("$gte", -neto)))
+						)))))
+						: make_document(kvp("cuentas.numeroCuenta", numero));
+
+					bulk.append(mongocxx::model::update_one(
+						std::move(filtro),
+						make_document(kvp("$inc", make_document(kvp("cuentas.$.saldo", neto))))
+					));
+				}
 
-			std::cout << "Transferencia exitosa: $" << std::fixed << std::setprecision(2) << monto
-				<< " de " << cuentaOrigen << " a " << cuentaDestino << std::endl;
+				auto resultadoBulk = bulk.execute();
+				if (!resultadoBulk || resultadoBulk->matched_count() != static_cast<std::int32_t>(fin - inicio)) {
+					throw TransferenciaRechazada("Los saldos cambiaron durante la liquidación del lote");
+				}
+			}
+		}, opcionesTransaccion);
 
-			return true;
-		}
-		catch (const std::exception& e) {
-			std::cerr << "Error en transferencia: " << e.what() << std::endl;
-			session.abort_transaction();
-			throw; // Re-lanzar la excepción
-		}
+		resultados = std::move(resultadosIntento);
 	}
 	catch (const std::exception& e) {
-		std::cerr << "Error en transferencia: " << e.what() << std::endl;
-		return false;
+		std::cerr << "Error en liquidación por lotes: " << e.what() << std::endl;
+		for (size_t i = 0; i < resultados.size(); ++i) {
+			if (valida[i]) {
+				resultados[i].exitosa = false;
+				resultados[i].mensaje = std::string("Lote revertido: ") + e.what();
+			}
+		}
+		return resultados;
 	}
+
+	size_t exitosas = std::count_if(resultados.begin(), resultados.end(),
+		[](const ResultadoTransferencia& r) { return r.exitosa; });
+	std::cout << "Liquidación por lotes: " << exitosas << " de " << resultados.size()
+		<< " transferencias aplicadas" << std::endl;
+
+	return resultados;
 }
 
 /**
@@ -626,19 +1182,15 @@ bool _BaseDatosPersona::realizarTransferencia(const std::string& cuentaOrigen, c
  */
 bsoncxx::document::value _BaseDatosPersona::obtenerInformacionCuenta(const std::string& numeroCuenta) {
 	try {
-		auto db = _client["Banco"];
-		auto collection = db["personas"];
-
-		auto cursor = collection.find({});
+		auto resultado = buscarDocumentoCuenta(numeroCuenta, true);
 
-		for (auto& doc : cursor) {
-			auto &view = doc;
-			int indice = buscarIndiceCuentaEnDocumento(view, numeroCuenta);
+		if (resultado) {
+			auto view = resultado->view();
+			auto cuentasElement = view["cuentas"];
 
-			if (indice >= 0) {
-				auto cuentasArray = view["cuentas"].get_array().value;
+			if (cuentasElement && cuentasElement.type() == bsoncxx::type::k_array) {
+				auto cuentasArray = cuentasElement.get_array().value;
 				auto cuentaIterator = cuentasArray.begin();
-				std::advance(cuentaIterator, indice);
 
 				if (cuentaIterator != cuentasArray.end() && cuentaIterator->type() == bsoncxx::type::k_document) {
 					auto cuentaDoc = cuentaIterator->get_document().value;
@@ -655,7 +1207,7 @@ bsoncxx::document::value _BaseDatosPersona::obtenerInformacionCuenta(const std::
 						kvp("cuenta", cuentaDoc)
 					);
 
-                    return bsoncxx::document::value{infoCompleta.view()};
+					return bsoncxx::document::value{infoCompleta.view()};
 				}
 			}
 		}
@@ -674,7 +1226,8 @@ bsoncxx::document::value _BaseDatosPersona::obtenerInformacionCuenta(const std::
  */
 int _BaseDatosPersona::obtenerUltimoSecuencial(const std::string& sucursal) {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["secuenciales"];
 
 		auto filter = make_document(kvp("sucursal", sucursal));
@@ -703,7 +1256,8 @@ int _BaseDatosPersona::obtenerUltimoSecuencial(const std::string& sucursal) {
 */
 bool _BaseDatosPersona::actualizarSecuencial(const std::string& sucursal, int nuevoSecuencial) {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["secuenciales"];
 
 		auto filter = make_document(kvp("sucursal", sucursal));
@@ -729,6 +1283,126 @@ bool _BaseDatosPersona::actualizarSecuencial(const std::string& sucursal, int nu
 	}
 }
 
+/**
+ * @brief Consulta (una vez por conexión) si el servidor admite transacciones
+ *
+ * Solo los miembros de un replica set (hello devuelve setName) y mongos (msg
+ * "isdbgrid") aceptan transacciones de varios documentos; un mongod independiente
+ * las rechaza.
+ */
+bool _BaseDatosPersona::servidorAdmiteTransacciones(mongocxx::client& cliente) {
+	// Se guarda la generación + 1 para que 0 signifique "aún sin consultar"
+	uint64_t generacion = ConexionMongo::getGeneracionConexion() + 1;
+	if (generacionSoporteTransacciones.load(std::memory_order_acquire) == generacion) {
+		return soporteTransacciones.load(std::memory_order_relaxed);
+	}
+
+	bool admite = false;
+	try {
+		auto respuesta = cliente["admin"].run_command(make_document(kvp("hello", 1)));
+		auto vista = respuesta.view();
+		auto setName = vista["setName"];
+		auto msg = vista["msg"];
+		admite = (setName && setName.type() == bsoncxx::type::k_utf8) ||
+			(msg && msg.type() == bsoncxx::type::k_utf8 && msg.get_string().value == "isdbgrid");
+	}
+	catch (const std::exception& e) {
+		std::cerr << "No se pudo consultar el soporte de transacciones: " << e.what() << std::endl;
+	}
+	soporteTransacciones.store(admite, std::memory_order_relaxed);
+	generacionSoporteTransacciones.store(generacion, std::memory_order_release);
+	return admite;
+}
+
+/**
+ * @brief Escritura de personas seguida del $inc del contador de cambios
+ *
+ * Con transacciones disponibles ambas operaciones se confirman juntas dentro de
+ * with_transaction; en un servidor independiente la escritura es la misma operación
+ * de un solo documento que antes y el $inc se envía después, solo si se aplicó.
+ */
+bool _BaseDatosPersona::escribirConContadorCambios(mongocxx::client& cliente, const std::function<bool(mongocxx::client_session*)>& escritura) {
+	auto metadatos = cliente["Banco"]["metadatos"];
+	mongocxx::options::update opciones;
+	opciones.upsert(true);
+	auto filtro = make_document(kvp("_id", "personas"));
+	auto incremento = make_document(kvp("$inc", make_document(kvp("contadorCambios", static_cast<int64_t>(1)))));
+
+	if (servidorAdmiteTransacciones(cliente)) {
+		auto session = cliente.start_session();
+		try {
+			session.with_transaction([&](mongocxx::client_session* sesion) {
+				if (!escritura(sesion)) {
+					throw EscrituraNoAplicada();
+				}
+				metadatos.update_one(*sesion, filtro.view(), incremento.view(), opciones);
+			});
+		}
+		catch (const EscrituraNoAplicada&) {
+			return false;
+		}
+		return true;
+	}
+
+	if (!escritura(nullptr)) {
+		return false;
+	}
+	try {
+		metadatos.update_one(filtro.view(), incremento.view(), opciones);
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al actualizar el contador de cambios: " << e.what() << std::endl;
+	}
+	return true;
+}
+
+void _BaseDatosPersona::registrarCambioExternoPersonas(mongocxx::database db) {
+	try {
+		mongocxx::options::update opciones;
+		opciones.upsert(true);
+		db["metadatos"].update_one(
+			make_document(kvp("_id", "personas")).view(),
+			make_document(kvp("$inc", make_document(kvp("contadorCambios", static_cast<int64_t>(1))))).view(),
+			opciones
+		);
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al actualizar el contador de cambios: " << e.what() << std::endl;
+	}
+}
+
+/**
+ * @brief Lee el contador de cambios de personas
+ *
+ * Es una lectura simple: asegurarIndices crea el documento con valor 1, de modo que
+ * 0 queda reservado para indicar que no hay contador disponible.
+ */
+uint64_t _BaseDatosPersona::obtenerContadorCambiosPersonas() {
+	try {
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
+		auto collection = db["metadatos"];
+
+		auto resultado = collection.find_one(make_document(kvp("_id", "personas")).view());
+		if (!resultado) {
+			return 0;
+		}
+
+		auto contador = resultado->view()["contadorCambios"];
+		if (contador && contador.type() == bsoncxx::type::k_int64) {
+			return static_cast<uint64_t>(contador.get_int64().value);
+		}
+		if (contador && contador.type() == bsoncxx::type::k_int32) {
+			return static_cast<uint64_t>(contador.get_int32().value);
+		}
+		return 0;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al leer el contador de cambios: " << e.what() << std::endl;
+		return 0;
+	}
+}
+
 /*
  * @brief Obtiene el mayor número de cuenta por sucursal
  *
@@ -737,7 +1411,8 @@ bool _BaseDatosPersona::actualizarSecuencial(const std::string& sucursal, int nu
  */ 
 int _BaseDatosPersona::obtenerMayorNumeroCuentaPorSucursal(const std::string& sucursal) {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		// Pipeline de agregación para buscar el mayor número de cuenta por sucursal
@@ -795,14 +1470,90 @@ int _BaseDatosPersona::obtenerMayorNumeroCuentaPorSucursal(const std::string& su
 	}
 }
 
+/**
+ * @brief Reserva un bloque de secuenciales para una sucursal
+ *
+ * El caso normal es un solo viaje: $inc sobre el contador devuelve el último secuencial
+ * del bloque. Si el contador no existe, se crea con el mayor secuencial de las cuentas
+ * existentes y se repite el $inc.
+ */
+bool _BaseDatosPersona::reservarBloqueSecuencial(const std::string& sucursal, int tamanoBloque, int& primero) {
+	if (tamanoBloque <= 0) {
+		return false;
+	}
+
+	try {
+		auto cliente = arrendarCliente();
+		auto collection = cliente["Banco"]["secuenciales"];
+
+		auto filter = make_document(kvp("sucursal", sucursal));
+		auto update = make_document(
+			kvp("$inc", make_document(kvp("ultimo_secuencial", tamanoBloque))),
+			kvp("$currentDate", make_document(kvp("fecha_actualizacion", true)))
+		);
+
+		mongocxx::options::find_one_and_update opciones;
+		opciones.return_document(mongocxx::options::return_document::k_after);
+		opciones.projection(make_document(kvp("_id", 0), kvp("ultimo_secuencial", 1)));
+
+		for (int intento = 0; intento < 2; ++intento) {
+			auto result = collection.find_one_and_update(filter.view(), update.view(), opciones);
+			if (result) {
+				auto secuencialElement = result->view()["ultimo_secuencial"];
+				long long ultimo;
+				if (secuencialElement && secuencialElement.type() == bsoncxx::type::k_int32) {
+					ultimo = secuencialElement.get_int32().value;
+				}
+				else if (secuencialElement && secuencialElement.type() == bsoncxx::type::k_int64) {
+					ultimo = secuencialElement.get_int64().value;
+				}
+				else {
+					std::cerr << "Error: contador de secuenciales con tipo inesperado para la sucursal " << sucursal << std::endl;
+					return false;
+				}
+				primero = static_cast<int>(ultimo - tamanoBloque + 1);
+				return true;
+			}
+
+			if (intento > 0) {
+				break;
+			}
+
+			// Contador inexistente: inicializarlo una sola vez con las cuentas ya registradas.
+			// $max no retrocede un contador creado en paralelo por otra terminal.
+			int mayorExistente = obtenerMayorNumeroCuentaPorSucursal(sucursal);
+			mongocxx::options::update opcionesInicio;
+			opcionesInicio.upsert(true);
+			try {
+				collection.update_one(filter.view(), make_document(
+					kvp("$max", make_document(kvp("ultimo_secuencial", mayorExistente))),
+					kvp("$currentDate", make_document(kvp("fecha_actualizacion", true)))
+				).view(), opcionesInicio);
+			}
+			catch (const mongocxx::operation_exception&) {
+				// Clave duplicada: otra terminal creó el contador primero; basta con reintentar el $inc
+			}
+		}
+
+		std::cerr << "Error: no se pudo reservar secuenciales para la sucursal " << sucursal << std::endl;
+		return false;
+	}
+	catch (const std::exception& e) {
+		std::cerr << "Error al reservar bloque de secuenciales: " << e.what() << std::endl;
+		return false;
+	}
+}
+
 /**
  * @brief Busca personas por criterio específico en la base de datos
  */
 std::vector<bsoncxx::document::value> _BaseDatosPersona::buscarPersonasPorCriterio(const std::string& criterio, const std::string& valor) {
+	MetricasLatencia::Medidor medidor(MetricasLatencia::BUSQUEDA_CRITERIO);
 	std::vector<bsoncxx::document::value> resultados;
 
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		bsoncxx::builder::basic::document filtro;
@@ -818,6 +1569,15 @@ std::vector<bsoncxx::document::value> _BaseDatosPersona::buscarPersonasPorCriter
 				return resultados;
 			}
 		}
+		else if (criterio == "fechaNacimiento") {
+			// Igualdad exacta sobre el b_date indexado; una fecha no admite búsqueda parcial
+			bsoncxx::types::b_date fecha{ std::chrono::milliseconds{ 0 } };
+			if (!convertirFechaABsonDate(valor, fecha)) {
+				std::cerr << "Error: La fecha debe tener formato DD/MM/AAAA" << std::endl;
+				return resultados;
+			}
+			filtro.append(kvp("fechaNacimientoDate", fecha));
+		}
 		else {
 			// Para campos de texto (usar regex para búsqueda parcial)
 			filtro.append(kvp(criterio, make_document(
@@ -826,11 +1586,13 @@ std::vector<bsoncxx::document::value> _BaseDatosPersona::buscarPersonasPorCriter
 			)));
 		}
 
-		auto cursor = collection.find(filtro.view());
-
-		for (auto&& doc : cursor) {
-			resultados.emplace_back(bsoncxx::document::value(doc));
-		}
+		// El cursor trae los lotes al iterar: el viaje se mide hasta agotar los resultados
+		MetricasLatencia::medir(MetricasLatencia::MONGO_BUSQUEDA, [&]() {
+			auto cursor = collection.find(filtro.view());
+			for (auto&& doc : cursor) {
+				resultados.emplace_back(bsoncxx::document::value(doc));
+			}
+		});
 
 	}
 	catch (const std::exception& e) {
@@ -842,39 +1604,46 @@ std::vector<bsoncxx::document::value> _BaseDatosPersona::buscarPersonasPorCriter
 
 /**
  * @brief Busca cuentas por rango de fechas desde una fecha hasta hoy
+ *
+ * El primer $match recorre el índice multikey cuentas.fechaAperturaDate, de modo que
+ * el $unwind solo se aplica a los titulares con alguna cuenta en el rango; el segundo
+ * $match descarta las demás cuentas de esos titulares.
  */
 std::vector<bsoncxx::document::value> _BaseDatosPersona::buscarCuentasPorRangoFechas(const std::string& fechaInicio) {
 	std::vector<bsoncxx::document::value> resultados;
 
 	try {
-		auto db = _client["Banco"];
-		auto collection = db["personas"];
-
-		// Convertir fecha de inicio a formato ISO
-		std::string fechaInicioISO = convertirFechaAISO(fechaInicio);
+		bsoncxx::types::b_date desde{ std::chrono::milliseconds{ 0 } };
+		if (!convertirFechaABsonDate(fechaInicio, desde)) {
+			std::cerr << "Error: La fecha de inicio debe tener formato DD/MM/AAAA" << std::endl;
+			return resultados;
+		}
 
-		// Obtener fecha actual en formato ISO
+		// Límite superior: fin del día actual, en la misma convención de medianoche UTC
 		auto now = std::chrono::system_clock::now();
 		auto time_t_now = std::chrono::system_clock::to_time_t(now);
 		std::tm tm_now;
 		localtime_s(&tm_now, &time_t_now);
 
-		char fechaActualISO[11];
-		std::strftime(fechaActualISO, sizeof(fechaActualISO), "%d/%m/%Y", &tm_now);
+		char fechaActual[11];
+		std::strftime(fechaActual, sizeof(fechaActual), "%d/%m/%Y", &tm_now);
+		bsoncxx::types::b_date hoy{ std::chrono::milliseconds{ 0 } };
+		convertirFechaABsonDate(fechaActual, hoy);
+		bsoncxx::types::b_date hasta{ hoy.value + std::chrono::hours(24) - std::chrono::milliseconds(1) };
 
-		// Pipeline de agregación para buscar cuentas en el rango de fechas
-		mongocxx::pipeline pipeline;
+		auto rango = [&]() {
+			return make_document(kvp("$gte", desde), kvp("$lte", hasta));
+		};
 
-		// Desenrollar el array de cuentas
-		pipeline.unwind("$cuentas");
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
+		auto collection = db["personas"];
 
-		// Filtrar por rango de fechas
-		pipeline.match(make_document(
-			kvp("cuentas.fechaApertura", make_document(
-				kvp("$gte", fechaInicioISO),
-				kvp("$lte", std::string(fechaActualISO))
-			))
-		));
+		mongocxx::pipeline pipeline;
+		pipeline.match(make_document(kvp("cuentas.fechaAperturaDate", rango())));
+		pipeline.unwind("$cuentas");
+		pipeline.match(make_document(kvp("cuentas.fechaAperturaDate", rango())));
+		pipeline.sort(make_document(kvp("cuentas.fechaAperturaDate", 1)));
 
 		// Proyectar la información necesaria
 		pipeline.project(make_document(
@@ -904,7 +1673,8 @@ std::vector<bsoncxx::document::value> _BaseDatosPersona::buscarCuentasPorRangoFe
  */
 bsoncxx::document::value _BaseDatosPersona::buscarPersonaCompletaPorCedula(const std::string& cedula) {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		auto filtro = make_document(kvp("cedula", cedula));
@@ -923,58 +1693,13 @@ bsoncxx::document::value _BaseDatosPersona::buscarPersonaCompletaPorCedula(const
 	return bsoncxx::document::value(make_document().view());
 }
 
-/**
- * @brief Convierte una fecha de formato DD/MM/AAAA a formato compatible
- */
-std::string _BaseDatosPersona::convertirFechaAISO(const std::string& fecha) {
-	// La fecha ya está en formato DD/MM/AAAA que es compatible con nuestra BD
-	return fecha;
-}
-
-void _BaseDatosPersona::iniciarBaseDatosArbolB()
-{
-	// Obtener referencia a la base de datos desde el banco
-	mongocxx::client& clienteDB = ConexionMongo::obtenerClienteBaseDatos();
-	_BaseDatosPersona baseDatos(clienteDB);
-
-	// Verificar que existan datos en la base de datos
-	if (!baseDatos.existenPersonasEnBaseDatos()) {
-		Utilidades::limpiarPantallaPreservandoMarquesina(1);
-		std::cout << "No hay personas registradas en la base de datos.\n";
-		std::cout << "Por favor, registre personas primero.\n";
-		system("pause");
-		return;
-	}
-
-	// Menú de selección de criterio
-	std::vector<std::string> criterios = {
-		"Ordenar por Cédula",
-		"Ordenar por Nombre (3 chars)",
-		"Ordenar por Apellido (3 chars)",
-		"Ordenar por Fecha de Nacimiento",
-		"Volver al menú principal"
-	};
-
-	Utilidades::limpiarPantallaPreservandoMarquesina(1);
-
-	int seleccion = Utilidades::menuInteractivo(
-		"=== Árbol B+ Gráfico - Seleccione Criterio ===",
-		criterios, 0, 0
-	);
-
-	if (seleccion >= 0 && seleccion <= 3) {
-		// Mostrar árbol B+ gráfico con SFML
-		ArbolBPlusGrafico::mostrarAnimadoSFMLGrado3(baseDatos, "", seleccion);
-	}
-	// Si seleccion == 4 o -1 (ESC), simplemente regresa al menú
-}
-
 /**
  * @brief Verifica si existen personas registradas en la base de datos MongoDB
  */
 bool _BaseDatosPersona::existenPersonasEnBaseDatos() {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		// Contar documentos en la colección personas
@@ -993,7 +1718,8 @@ bool _BaseDatosPersona::existenPersonasEnBaseDatos() {
  */
 long _BaseDatosPersona::obtenerTotalPersonasRegistradas() {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		return static_cast<long>(collection.estimated_document_count());
@@ -1009,7 +1735,8 @@ long _BaseDatosPersona::obtenerTotalPersonasRegistradas() {
  */
 bool _BaseDatosPersona::existenCuentasEnBaseDatos() {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		// Pipeline de agregación para verificar si existen cuentas
@@ -1039,7 +1766,8 @@ bool _BaseDatosPersona::existenCuentasEnBaseDatos() {
  */
 long _BaseDatosPersona::obtenerTotalCuentasRegistradas() {
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		// Pipeline de agregación para contar todas las cuentas
@@ -1079,7 +1807,8 @@ std::vector<bsoncxx::document::value> _BaseDatosPersona::mostrarTodasPersonas()
 	std::vector<bsoncxx::document::value> resultados;
 
 	try {
-		auto db = _client["Banco"];
+		auto cliente = arrendarCliente();
+		auto db = cliente["Banco"];
 		auto collection = db["personas"];
 
 		// Pipeline de agregación optimizado para obtener datos esenciales
@@ -1090,10 +1819,14 @@ std::vector<bsoncxx::document::value> _BaseDatosPersona::mostrarTodasPersonas()
 			kvp("cedula", 1),
 			kvp("nombre", 1),
 			kvp("apellido", 1),
+			kvp("fechaNacimiento", 1),
 			kvp("correo", 1),
+			kvp("direccion", 1),
 			kvp("cuentas.numeroCuenta", 1),
 			kvp("cuentas.tipo", 1),
 			kvp("cuentas.saldo", 1),
+			kvp("numAhorros", 1),
+			kvp("numCorrientes", 1),
 			kvp("totalCuentasExistentes", 1)
 		));
 
@@ -3,8 +3,16 @@
 #define _BASEDATOSPERSONA_H  
 
 #include <mongocxx/client.hpp>
+#include <mongocxx/client_session.hpp>
 #include <bsoncxx/document/value.hpp>
+#include "IRepositorioBanco.h"
+#include "ConexionMongo.h"
 #include <string>
+#include <mutex>
+#include <atomic>
+#include <optional>
+#include <vector>
+#include <functional>
 
 class Persona;
 
@@ -14,18 +22,91 @@ class Persona;
  *
  * Esta clase maneja todas las operaciones CRUD para personas y sus cuentas bancarias
  * en MongoDB, incluyendo operaciones financieras como transferencias, depósitos y retiros.
+ * Es el motor MongoDB de IRepositorioBanco.
  */
-class _BaseDatosPersona {
+class _BaseDatosPersona : public IRepositorioBanco {
 private:
-    mongocxx::client& _client;
+    static std::once_flag banderaIndices;
+
+    // Soporte de transacciones del servidor y generación de conexión + 1 en que se consultó
+    static std::atomic<uint64_t> generacionSoporteTransacciones;
+    static std::atomic<bool> soporteTransacciones;
+
+    // Máximo de operaciones por bulk_write y de números por filtro $in en la liquidación por lotes
+    static constexpr size_t TAMANO_BLOQUE_BULK = 1000;
+
+    /**
+     * @brief Crea (una sola vez por proceso) los índices usados por las búsquedas puntuales
+     */
+    void asegurarIndices();
+
+    /**
+     * @brief Agrega las fechas b_date a los documentos guardados solo con cadenas DD/MM/AAAA
+     */
+    static void migrarFechasABsonDate();
+
+    /**
+     * @brief Arrienda un cliente del pool; la primera vez crea antes los índices
+     *
+     * Todas las operaciones pasan por aquí, de modo que construir el motor no se conecta
+     * a MongoDB y los índices se crean en su primer uso real.
+     */
+    ConexionMongo::ClienteArrendado arrendarCliente();
+
+    /**
+     * @brief Indica si el servidor conectado admite transacciones (replica set o mongos)
+     *
+     * El resultado se guarda hasta que cambia la generación de la conexión.
+     */
+    static bool servidorAdmiteTransacciones(mongocxx::client& cliente);
+
+    /**
+     * @brief Ejecuta una escritura de personas y, si se aplicó, aumenta el contador de cambios
+     *
+     * Si el servidor admite transacciones, el $inc de metadatos viaja en la misma
+     * transacción que la escritura. En un mongod independiente la escritura se hace sin
+     * sesión y el $inc se envía a continuación.
+     * @param cliente Cliente arrendado con el que se escribe
+     * @param escritura Operación sobre personas; recibe la sesión de la transacción o
+     *        nullptr, y si devuelve false no se toca el contador
+     * @return true si la escritura se aplicó, false en caso contrario
+     */
+    bool escribirConContadorCambios(mongocxx::client& cliente, const std::function<bool(mongocxx::client_session*)>& escritura);
+
+    /**
+     * @brief Obtiene el documento del titular proyectando solo la cuenta solicitada (cuentas.$)
+     * @param numeroCuenta Número de cuenta a buscar
+     * @param incluirTitular Si es true, incluye cédula, nombre, apellido y correo en la proyección
+     * @return Documento proyectado, o std::nullopt si la cuenta no existe
+     */
+    std::optional<bsoncxx::document::value> buscarDocumentoCuenta(const std::string& numeroCuenta, bool incluirTitular);
+
+    /**
+     * @brief Aplica un movimiento de saldo en un solo viaje con find_one_and_update
+     *
+     * Para montos negativos el filtro exige saldo >= |delta| en la misma cuenta ($elemMatch),
+     * de modo que la verificación de fondos y el descuento son una sola operación atómica.
+     *
+     * @param sesion Sesión en la que se ejecuta la operación, o nullptr para ejecutarla fuera de transacción
+     * @param numeroCuenta Número de cuenta a modificar
+     * @param delta Monto a sumar (positivo) o restar (negativo), ya redondeado
+     * @param saldoResultante Salida opcional con el saldo posterior al movimiento
+     * @return true si se aplicó el movimiento, false si la cuenta no existe o no tiene fondos
+     */
+    bool aplicarMovimientoSaldo(mongocxx::client_session* sesion, const std::string& numeroCuenta, double delta, double* saldoResultante);
+
+    /**
+     * @brief Convierte el campo saldo (double, int32 o int64) a double
+     * @return Saldo leído, -1.0 si el elemento no es numérico
+     */
+    double leerSaldo(const bsoncxx::document::element& saldoElement);
 
 public:
 
     /**
-     * @brief Constructor que inicializa la conexión a MongoDB
-     * @param client Referencia al cliente de MongoDB
+     * @brief Constructor; no se conecta: las operaciones arriendan clientes del pool de ConexionMongo
      */
-    _BaseDatosPersona(mongocxx::client& client);
+    _BaseDatosPersona();
 
 
 
@@ -35,7 +116,7 @@ public:
      * @param persona La persona a insertar
      * @return true si la inserción fue exitosa, false en caso contrario
      */
-    bool insertarNuevaPersona(const Persona& persona);
+    bool insertarNuevaPersona(const Persona& persona) override;
 
     /**
      * @brief Inserta una nueva persona con una cuenta inicial
@@ -43,21 +124,21 @@ public:
      * @param cuentaInicial Documento BSON de la cuenta inicial (opcional)
      * @return true si la inserción fue exitosa, false en caso contrario
      */
-    bool insertarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial = nullptr);
+    bool insertarPersona(const Persona& persona, const bsoncxx::document::value* cuentaInicial = nullptr) override;
 
     /**
      * @brief Verifica si existe una persona con la cédula dada
      * @param cedula Cédula a buscar
      * @return true si existe, false si no existe
      */
-    bool existePersonaPorCedula(const std::string& cedula);
+    bool existePersonaPorCedula(const std::string& cedula) override;
 
     /**
      * @brief Obtiene una persona por su cédula
      * @param cedula Cédula de la persona a buscar
      * @return Puntero a la Persona encontrada, o nullptr si no se encuentra
      */
-    Persona* obtenerPersonaPorCedula(const std::string& cedula);
+    Persona* obtenerPersonaPorCedula(const std::string& cedula) override;
 
     /**
      * @brief Agrega una cuenta a una persona existente
@@ -65,7 +146,7 @@ public:
      * @param cuentaDoc Documento BSON de la cuenta a agregar
      * @return true si se agregó exitosamente, false en caso contrario
      */
-    bool agregarCuentaPersona(const std::string& cedula, const bsoncxx::document::value& cuentaDoc);
+    bool agregarCuentaPersona(const std::string& cedula, const bsoncxx::document::value& cuentaDoc) override;
 
     /**
      * @brief Busca personas por criterio específico en la base de datos
@@ -73,30 +154,43 @@ public:
      * @param valor Valor a buscar
      * @return Vector de documentos BSON con las personas encontradas
      */
-    std::vector<bsoncxx::document::value> buscarPersonasPorCriterio(const std::string& criterio, const std::string& valor);
+    std::vector<bsoncxx::document::value> buscarPersonasPorCriterio(const std::string& criterio, const std::string& valor) override;
 
     /**
      * @brief Busca cuentas por rango de fechas desde una fecha hasta hoy
+     *
+     * Compara cuentas.fechaAperturaDate (b_date) sobre su índice, no las cadenas DD/MM/AAAA.
      * @param fechaInicio Fecha de inicio en formato DD/MM/AAAA
      * @return Vector de documentos BSON con las cuentas encontradas
      */
-    std::vector<bsoncxx::document::value> buscarCuentasPorRangoFechas(const std::string& fechaInicio);
+    std::vector<bsoncxx::document::value> buscarCuentasPorRangoFechas(const std::string& fechaInicio) override;
 
     /**
      * @brief Busca todas las cuentas de una persona por su cédula
      * @param cedula Cédula de la persona a buscar
      * @return Documento BSON con la información completa de la persona y sus cuentas
      */
-    bsoncxx::document::value buscarPersonaCompletaPorCedula(const std::string& cedula);
+    bsoncxx::document::value buscarPersonaCompletaPorCedula(const std::string& cedula) override;
 
     /**
-     * @brief Convierte una fecha de formato DD/MM/AAAA a ISO para MongoDB
-     * @param fecha Fecha en formato DD/MM/AAAA
-     * @return Fecha en formato ISO string
+     * @brief Copia un documento de persona agregando fechaNacimientoDate y cuentas.N.fechaAperturaDate
+     *
+     * Para documentos que llegan sin pasar por las inserciones de esta clase (p. ej. un
+     * respaldo anterior a la migración), de modo que las búsquedas por fecha los vean.
+     * @param personaDoc Documento de persona tal como se leyó
+     * @return Documento con las fechas b_date que se pudieron convertir
      */
-    std::string convertirFechaAISO(const std::string& fecha);
+    static bsoncxx::document::value personaConFechasBson(const bsoncxx::document::view& personaDoc);
 
-    void iniciarBaseDatosArbolB();
+    /**
+     * @brief Registra un cambio de personas hecho fuera de esta clase (p. ej. una restauración)
+     *
+     * Aumenta el contador de cambios para que las estructuras derivadas de las personas
+     * (instantáneas y árboles de ArbolBPlusGrafico, índices de GestorIndices) dejen de
+     * considerarse vigentes.
+     * @param db Base de datos en la que se escribieron las personas
+     */
+    static void registrarCambioExternoPersonas(mongocxx::database db);
 
 #pragma endregion
 
@@ -105,24 +199,48 @@ public:
      * @brief Realiza un depósito en una cuenta específica
      * @param numeroCuenta Número de cuenta destino
      * @param monto Monto a depositar (formato double: 123.45)
+     * @param saldoResultante Salida opcional con el saldo tras el depósito
      * @return true si el depósito fue exitoso, false en caso contrario
      */
-    bool depositarEnCuenta(const std::string& numeroCuenta, double monto);
+    bool depositarEnCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante = nullptr) override;
 
     /**
      * @brief Realiza un retiro de una cuenta específica
      * @param numeroCuenta Número de cuenta origen
      * @param monto Monto a retirar (formato double: 123.45)
-     * @return true si el retiro fue exitoso, false en caso contrario
+     * @param saldoResultante Salida opcional con el saldo tras el retiro
+     * @return true si el retiro fue exitoso, false si la cuenta no existe o no tiene fondos
      */
-    bool retirarDeCuenta(const std::string& numeroCuenta, double monto);
+    bool retirarDeCuenta(const std::string& numeroCuenta, double monto, double* saldoResultante = nullptr) override;
+
+    /**
+     * @brief Deposita dentro de una sesión/transacción existente
+     *
+     * No captura excepciones del servidor: los errores transitorios deben llegar a
+     * with_transaction para que la transacción se reintente completa.
+     *
+     * @param sesion Sesión con la transacción activa
+     * @param numeroCuenta Número de cuenta destino
+     * @param monto Monto a depositar
+     * @return true si el depósito se aplicó, false si el monto es inválido o la cuenta no existe
+     */
+    bool depositarEnCuenta(mongocxx::client_session& sesion, const std::string& numeroCuenta, double monto);
+
+    /**
+     * @brief Retira dentro de una sesión/transacción existente
+     * @param sesion Sesión con la transacción activa
+     * @param numeroCuenta Número de cuenta origen
+     * @param monto Monto a retirar
+     * @return true si el retiro se aplicó, false si el monto es inválido, la cuenta no existe o no tiene fondos
+     */
+    bool retirarDeCuenta(mongocxx::client_session& sesion, const std::string& numeroCuenta, double monto);
 
     /**
      * @brief Obtiene el saldo actual de una cuenta
      * @param numeroCuenta Número de cuenta a consultar
      * @return Saldo actual como double, -1.0 si la cuenta no existe
      */
-    double obtenerSaldoCuenta(const std::string& numeroCuenta);
+    double obtenerSaldoCuenta(const std::string& numeroCuenta) override;
 
     /**
      * @brief Verifica si una cuenta tiene fondos suficientes
@@ -130,60 +248,83 @@ public:
      * @param monto Monto a verificar
      * @return true si tiene fondos suficientes, false en caso contrario
      */
-    bool verificarFondosSuficientes(const std::string& numeroCuenta, double monto);
+    bool verificarFondosSuficientes(const std::string& numeroCuenta, double monto) override;
 
     /**
      * @brief Realiza una transferencia entre dos cuentas
+     *
+     * Ambos movimientos se ejecutan en la misma sesión mediante with_transaction, que
+     * reintenta ante TransientTransactionError y UnknownTransactionCommitResult.
      * @param cuentaOrigen Número de cuenta origen
      * @param cuentaDestino Número de cuenta destino
      * @param monto Monto a transferir (formato double: 123.45)
      * @return true si la transferencia fue exitosa, false en caso contrario
      */
-    bool realizarTransferencia(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto);
+    bool realizarTransferencia(const std::string& cuentaOrigen, const std::string& cuentaDestino, double monto) override;
+
+    /**
+     * @brief Liquida un lote de transferencias en una sola transacción
+     *
+     * Valida todas las solicitudes, las simula en orden sobre los saldos leídos dentro de
+     * la transacción, agrupa débitos y créditos en un neto por cuenta y los aplica con
+     * bulk_write en bloques de TAMANO_BLOQUE_BULK operaciones.
+     *
+     * @param transferencias Transferencias a liquidar, en orden de aplicación
+     * @return Un resultado por transferencia, en el mismo orden
+     */
+    std::vector<ResultadoTransferencia> realizarTransferenciasLote(const std::vector<Transferencia>& transferencias) override;
 
     /**
      * @brief Obtiene información completa de una cuenta
      * @param numeroCuenta Número de cuenta a consultar
      * @return Documento BSON con la información de la cuenta, o documento vacío si no existe
      */
-    bsoncxx::document::value obtenerInformacionCuenta(const std::string& numeroCuenta);
+    bsoncxx::document::value obtenerInformacionCuenta(const std::string& numeroCuenta) override;
 
     /**
      * @brief Obtiene la cédula del titular de una cuenta
      * @param numeroCuenta Número de cuenta
      * @return Cédula del titular, o cadena vacía si no se encuentra
      */
-    std::string obtenerCedulaPorNumeroCuenta(const std::string& numeroCuenta);
+    std::string obtenerCedulaPorNumeroCuenta(const std::string& numeroCuenta) override;
 
     /**
      * @brief Verifica si existen personas registradas en la base de datos MongoDB
      * @return true si existen personas registradas, false en caso contrario
      */
-    bool existenPersonasEnBaseDatos();
+    bool existenPersonasEnBaseDatos() override;
 
     /**
      * @brief Obtiene el número total de personas registradas en la base de datos
      * @return Número total de personas registradas
      */
-    long obtenerTotalPersonasRegistradas();
+    long obtenerTotalPersonasRegistradas() override;
 
     /**
      * @brief Verifica si existen cuentas en la base de datos MongoDB
      * @return true si existen cuentas registradas, false en caso contrario
      */
-    bool existenCuentasEnBaseDatos();
+    bool existenCuentasEnBaseDatos() override;
 
     /**
      * @brief Obtiene el número total de cuentas registradas en la base de datos
      * @return Número total de cuentas registradas
      */
-    long obtenerTotalCuentasRegistradas();
+    long obtenerTotalCuentasRegistradas() override;
 
     /**
      * @brief Obtiene todas las personas registradas en la base de datos MongoDB
      * @return Vector de documentos BSON con todas las personas encontradas
      */
-    std::vector<bsoncxx::document::value> mostrarTodasPersonas();
+    std::vector<bsoncxx::document::value> mostrarTodasPersonas() override;
+
+    /**
+     * @brief Lee el contador de cambios de personas de la colección metadatos
+     *
+     * Solo lee: el documento se crea con valor 1 en asegurarIndices.
+     * @return Valor actual del contador, o 0 si no se pudo leer
+     */
+    uint64_t obtenerContadorCambiosPersonas() override;
 #pragma endregion
 
 #pragma region === UTILIDADES ===
@@ -200,7 +341,7 @@ public:
      * @param sucursal Código de sucursal (210, 220, 480, 560)
      * @return Último número secuencial usado, 0 si no existe
      */
-    int obtenerUltimoSecuencial(const std::string& sucursal);
+    int obtenerUltimoSecuencial(const std::string& sucursal) override;
 
     /**
      * @brief Actualiza el último número secuencial para una sucursal específica
@@ -208,14 +349,27 @@ public:
      * @param nuevoSecuencial Nuevo número secuencial a guardar
      * @return true si se actualizó correctamente, false en caso contrario
      */
-    bool actualizarSecuencial(const std::string& sucursal, int nuevoSecuencial);
+    bool actualizarSecuencial(const std::string& sucursal, int nuevoSecuencial) override;
 
     /**
      * @brief Obtiene el mayor número de cuenta existente para una sucursal específica
      * @param sucursal Código de sucursal
      * @return Mayor número secuencial encontrado en las cuentas existentes
      */
-    int obtenerMayorNumeroCuentaPorSucursal(const std::string& sucursal);
+    int obtenerMayorNumeroCuentaPorSucursal(const std::string& sucursal) override;
+
+    /**
+     * @brief Reserva un bloque de secuenciales con un solo find_one_and_update ($inc)
+     *
+     * La agregación de obtenerMayorNumeroCuentaPorSucursal solo se ejecuta para crear el
+     * contador de una sucursal que aún no lo tiene; la inicialización usa $max con upsert
+     * y el índice único sobre secuenciales.sucursal, por lo que es segura entre terminales.
+     * @param sucursal Código de sucursal
+     * @param tamanoBloque Cantidad de secuenciales a reservar
+     * @param primero Salida con el primer secuencial del bloque reservado
+     * @return true si se reservó el bloque, false en caso de error
+     */
+    bool reservarBloqueSecuencial(const std::string& sucursal, int tamanoBloque, int& primero) override;
 
     /**
      * @brief Busca una cuenta específica dentro de un documento de persona
@@ -224,20 +378,5 @@ public:
      * @return Índice de la cuenta en el array, -1 si no se encuentra
      */
     int buscarIndiceCuentaEnDocumento(const bsoncxx::document::view& personaDoc, const std::string& numeroCuenta);
-
-    /**
-     * @brief Valida que el monto sea un número válido y positivo
-     * @param monto Monto a validar
-     * @return true si el monto es válido, false en caso contrario
-     */
-    bool validarMonto(double monto);
-
-    /**
-     * @brief Redondea un monto a 2 decimales para operaciones monetarias
-     * @param monto Monto a redondear
-     * @return Monto redondeado a 2 decimales
-     */
-    double redondearMonto(double monto);
-    
 };
 #endif // _BASEDATOSPERSONA_H
\ No newline at end of file
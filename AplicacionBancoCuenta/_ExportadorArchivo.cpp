@@ -2,6 +2,7 @@
 
 #include "_ExportadorArchivo.h"
 #include "Banco.h"
+#include "BancoManejoPersona.h"
 #include "Persona.h"
 #include "Fecha.h"
 #include "CuentaAhorros.h"
@@ -22,6 +23,7 @@
 #include "NodoPersona.h"
 #include "CodigoQR.h"
 #include "_BaseDatosPersona.h"
+#include "FabricaRepositorioBanco.h"
 #include "ConexionMongo.h"
 #include "Utilidades.h"
 #include <functional>
@@ -203,7 +205,7 @@ void ExportadorArchivo::cargarCuentasDesdeArchivo(Banco& banco, const std::strin
  * @param banco Referencia al objeto Banco que se desea limpiar
  */
 void ExportadorArchivo::limpiarBanco(Banco& banco) {
-	banco.setListaPersonas(nullptr);
+	banco.getManejoPersonas().limpiarPersonas();
 }
 
 /**
@@ -446,7 +448,7 @@ std::string ExportadorArchivo::obtenerRutaEscritorio() {
 /**
  * @brief Guarda archivos múltiples desde la base de datos MongoDB con diferentes extensiones
  */
-bool ExportadorArchivo::guardarArchivosVarios(const _BaseDatosPersona& baseDatos, int tipoArchivo,
+bool ExportadorArchivo::guardarArchivosVarios(const IRepositorioBanco& baseDatos, int tipoArchivo,
 	const std::string& nombreArchivo, char claveCifrado) {
 	try {
 		// Aplicando SRP: Separar responsabilidades en métodos específicos
@@ -468,7 +470,7 @@ bool ExportadorArchivo::guardarArchivosVarios(const _BaseDatosPersona& baseDatos
 /**
  * @brief Guarda datos desde la base de datos en formato específico
  */
-bool ExportadorArchivo::guardarDesdeBaseDatos(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo, const std::string& extension) {
+bool ExportadorArchivo::guardarDesdeBaseDatos(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo, const std::string& extension) {
 	std::string rutaEscritorio = obtenerRutaEscritorio();
 	std::string rutaCompleta = rutaEscritorio + nombreArchivo + extension;
 
@@ -481,10 +483,8 @@ bool ExportadorArchivo::guardarDesdeBaseDatos(const _BaseDatosPersona& baseDatos
 	// Escribir cabecera del archivo
 	archivo << "BANCO_BACKUP_V2.0_FROM_MONGODB\n";
 
-	// Crear instancia temporal para llamar al método no estático
-	auto& clienteDB = ConexionMongo::obtenerClienteBaseDatos();
-	_BaseDatosPersona baseDatosTemp(clienteDB);
-	auto todasPersonas = baseDatosTemp.mostrarTodasPersonas();
+	// Se lee del repositorio del motor configurado, no siempre de MongoDB
+	auto todasPersonas = FabricaRepositorioBanco::obtenerRepositorio().mostrarTodasPersonas();
 
 	// Aplicando programación funcional con forEach
 	std::for_each(todasPersonas.begin(), todasPersonas.end(),
@@ -600,7 +600,7 @@ void ExportadorArchivo::procesarCuentasBSON(const bsoncxx::array::view& cuentasA
 /**
  * @brief Guarda archivo con cifrado César
  */
-bool ExportadorArchivo::guardarArchivoConCifrado(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo, char claveCifrado) {
+bool ExportadorArchivo::guardarArchivoConCifrado(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo, char claveCifrado) {
 	// Primero crear archivo temporal .bak
 	std::string archivoTemporal = nombreArchivo + "_temp";
 	if (!guardarDesdeBaseDatos(baseDatos, archivoTemporal, ".bak")) {
@@ -643,7 +643,7 @@ bool ExportadorArchivo::guardarArchivoConCifrado(const _BaseDatosPersona& baseDa
 /**
  * @brief Genera PDF desde la base de datos con códigos QR
  */
-bool ExportadorArchivo::generarPDFDesdeBaseDatos(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) {
+bool ExportadorArchivo::generarPDFDesdeBaseDatos(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) {
 	// Primero crear archivo .bak desde la base de datos
 	if (!guardarDesdeBaseDatos(baseDatos, nombreArchivo, ".bak")) {
 		return false;
@@ -656,7 +656,7 @@ bool ExportadorArchivo::generarPDFDesdeBaseDatos(const _BaseDatosPersona& baseDa
 /**
  * @brief Versión modificada de archivoGuardadoHaciaPDF que incluye códigos QR
  */
-bool ExportadorArchivo::archivoGuardadoHaciaPDFConQR(const std::string& nombreArchivo, const _BaseDatosPersona& baseDatos) {
+bool ExportadorArchivo::archivoGuardadoHaciaPDFConQR(const std::string& nombreArchivo, const IRepositorioBanco& baseDatos) {
 	std::string rutaEscritorio = obtenerRutaEscritorio();
 	std::string rutaBak = rutaEscritorio + nombreArchivo + ".bak";
 	std::string rutaHtml = rutaEscritorio + nombreArchivo + "_temp.html";
@@ -1061,9 +1061,7 @@ void ExportadorArchivo::procesarPersonaTradicional(Banco& banco, std::ifstream&
 	while (enPersona && std::getline(archivo, linea)) {
 		if (linea == "===PERSONA_FIN===") {
 			// Agregar persona al banco
-			NodoPersona* nuevo = new NodoPersona(personaActual.release());
-			nuevo->siguiente = banco.getListaPersonas();
-			banco.setListaPersonas(nuevo);
+			banco.getManejoPersonas().agregarPersona(personaActual.release());
 			enPersona = false;
 			break;
 		}
@@ -1086,15 +1084,10 @@ void ExportadorArchivo::procesarPersonaTradicional(Banco& banco, std::ifstream&
 					cuentaAhorrosTemp->setSaldo(saldo);
 					cuentaAhorrosTemp->setFechaApertura(fechaApertura);
 					cuentaAhorrosTemp->setEstadoCuenta(estado);
-					// Enlazar cuenta
-					if (!personaActual->getCabezaAhorros())
-						personaActual->setCabezaAhorros(cuentaAhorrosTemp);
-					else {
-						CuentaAhorros* actual = personaActual->getCabezaAhorros();
-						while (actual->getSiguiente())
-							actual = actual->getSiguiente();
-						actual->setSiguiente(cuentaAhorrosTemp);
-						cuentaAhorrosTemp->setAnterior(actual);
+					// Asociar cuenta a la persona
+					if (!personaActual->agregarCuenta(cuentaAhorrosTemp)) {
+						std::cerr << "Cuenta " << numCuenta << " omitida: la persona ya tiene el maximo de cuentas" << std::endl;
+						delete cuentaAhorrosTemp;
 					}
 				}
 			}
@@ -1118,15 +1111,10 @@ void ExportadorArchivo::procesarPersonaTradicional(Banco& banco, std::ifstream&
 					cuentaCorrienteTemp->setSaldo(saldo);
 					cuentaCorrienteTemp->setFechaApertura(fechaApertura);
 					cuentaCorrienteTemp->setEstadoCuenta(estado);
-					// Enlazar cuenta
-					if (!personaActual->getCabezaCorriente())
-						personaActual->setCabezaCorriente(cuentaCorrienteTemp);
-					else {
-						CuentaCorriente* actual = personaActual->getCabezaCorriente();
-						while (actual->getSiguiente())
-							actual = actual->getSiguiente();
-						actual->setSiguiente(cuentaCorrienteTemp);
-						cuentaCorrienteTemp->setAnterior(actual);
+					// Asociar cuenta a la persona
+					if (!personaActual->agregarCuenta(cuentaCorrienteTemp)) {
+						std::cerr << "Cuenta " << numCuenta << " omitida: la persona ya tiene el maximo de cuentas" << std::endl;
+						delete cuentaCorrienteTemp;
 					}
 				}
 			}
@@ -1158,7 +1146,7 @@ void ExportadorArchivo::procesarPersonaTradicional(Banco& banco, std::ifstream&
  */
 class ExportadorArchivo::EstrategiaRespaldoBD : public IEstrategiaGuardado {
 public:
-	bool ejecutar(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) override {
+	bool ejecutar(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) override {
 		return ExportadorArchivo::guardarDesdeBaseDatos(baseDatos, nombreArchivo, ".bak");
 	}
 
@@ -1176,7 +1164,7 @@ private:
 public:
 	explicit EstrategiaCifrado(char clave) : claveCifrado(clave) {}
 
-	bool ejecutar(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) override {
+	bool ejecutar(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) override {
 		return ExportadorArchivo::guardarArchivoConCifrado(baseDatos, nombreArchivo, claveCifrado);
 	}
 
@@ -1189,7 +1177,7 @@ public:
  */
 class ExportadorArchivo::EstrategiaPDFConQR : public IEstrategiaGuardado {
 public:
-	bool ejecutar(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) override {
+	bool ejecutar(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) override {
 		return ExportadorArchivo::generarPDFDesdeBaseDatos(baseDatos, nombreArchivo);
 	}
 
@@ -1219,7 +1207,7 @@ std::vector<std::string> FabricaEstrategiasGuardado::obtenerOpcionesDisponibles(
 
 // === IMPLEMENTACIÓN DEL GESTOR ===
 
-GestorGuardadoArchivos::GestorGuardadoArchivos(const _BaseDatosPersona& bd)
+GestorGuardadoArchivos::GestorGuardadoArchivos(const IRepositorioBanco& bd)
 	: baseDatos(bd), estrategia(nullptr) {
 }
 
@@ -1250,13 +1238,13 @@ std::vector<std::string> GestorGuardadoArchivos::obtenerOpcionesGuardado() const
 bool GestorGuardadoArchivos::validarDatosDisponibles() const {
 	// Crear una instancia temporal no-const para llamar al método no estático
 	// Esto es necesario porque existenPersonasEnBaseDatos() no es const ni estático
-	_BaseDatosPersona& baseDatosMutable = const_cast<_BaseDatosPersona&>(baseDatos);
+	IRepositorioBanco& baseDatosMutable = const_cast<IRepositorioBanco&>(baseDatos);
 	return baseDatosMutable.existenPersonasEnBaseDatos();
 }
 
 // === MÉTODOS PRINCIPALES REFACTORIZADOS ===
 
-bool ExportadorArchivo::procesarSolicitudGuardado(const _BaseDatosPersona& baseDatos) {
+bool ExportadorArchivo::procesarSolicitudGuardado(const IRepositorioBanco& baseDatos) {
 	// Aplicando Single Responsibility Principle
 	if (!ExportadorArchivo::validarDatosEnBaseDatos(baseDatos)) {
 		return false;
@@ -1304,9 +1292,9 @@ bool ExportadorArchivo::procesarSolicitudGuardado(const _BaseDatosPersona& baseD
 
 // === MÉTODOS DE INTERFAZ DE USUARIO ===
 
-bool ExportadorArchivo::validarDatosEnBaseDatos(const _BaseDatosPersona& baseDatos) {
+bool ExportadorArchivo::validarDatosEnBaseDatos(const IRepositorioBanco& baseDatos) {
 	// Crear una instancia temporal no-const para llamar al método no estático
-	_BaseDatosPersona& baseDatosMutable = const_cast<_BaseDatosPersona&>(baseDatos);
+	IRepositorioBanco& baseDatosMutable = const_cast<IRepositorioBanco&>(baseDatos);
 
 	if (!baseDatosMutable.existenPersonasEnBaseDatos()) {
 		Utilidades::limpiarPantallaPreservandoMarquesina(1);
@@ -1365,7 +1353,7 @@ void ExportadorArchivo::mostrarResultado(bool exito, const std::string& tipoOper
 class IEstrategiaRecuperacion {
 public:
 	virtual ~IEstrategiaRecuperacion() = default;
-	virtual bool ejecutar(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) = 0;
+	virtual bool ejecutar(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) = 0;
 	virtual std::string obtenerExtension() const = 0;
 	virtual std::string obtenerDescripcion() const = 0;
 };
@@ -1375,7 +1363,7 @@ public:
  */
 class ExportadorArchivo::EstrategiaRecuperacionBAK : public IEstrategiaRecuperacion {
 public:
-	bool ejecutar(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) override {
+	bool ejecutar(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) override {
 		return ExportadorArchivo::recuperarDesdeRespaldo(baseDatos, nombreArchivo);
 	}
 
@@ -1393,7 +1381,7 @@ private:
 public:
 	explicit EstrategiaRecuperacionBIN(char clave) : claveDescifrado(clave) {}
 
-	bool ejecutar(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) override {
+	bool ejecutar(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) override {
 		return ExportadorArchivo::recuperarDesdeCifrado(baseDatos, nombreArchivo, claveDescifrado);
 	}
 
@@ -1429,11 +1417,11 @@ public:
  */
 class GestorRecuperacionArchivos {
 private:
-	const _BaseDatosPersona& baseDatos;
+	const IRepositorioBanco& baseDatos;
 	std::unique_ptr<IEstrategiaRecuperacion> estrategia;
 
 public:
-	explicit GestorRecuperacionArchivos(const _BaseDatosPersona& bd) : baseDatos(bd), estrategia(nullptr) {}
+	explicit GestorRecuperacionArchivos(const IRepositorioBanco& bd) : baseDatos(bd), estrategia(nullptr) {}
 
 	bool configurarEstrategia(int tipoRecuperacion, char claveDescifrado = '\0') {
 		estrategia = FabricaEstrategiasRecuperacion::crear(tipoRecuperacion, claveDescifrado);
@@ -1464,7 +1452,7 @@ public:
  * @brief Procesa solicitud de recuperación de archivos desde MongoDB
  * Similar en estructura a exportarBackupMongoDB
  */
-bool ExportadorArchivo::procesarSolicitudRecuperacion(const _BaseDatosPersona& baseDatos) {
+bool ExportadorArchivo::procesarSolicitudRecuperacion(const IRepositorioBanco& baseDatos) {
 	try {
 		// Crear gestor con Dependency Injection
 		GestorRecuperacionArchivos gestor(baseDatos);
@@ -1515,7 +1503,7 @@ bool ExportadorArchivo::procesarSolicitudRecuperacion(const _BaseDatosPersona& b
  * @brief Recupera datos desde archivo .bak y los carga en MongoDB
  * Siguiendo estructura similar a exportarBackupMongoDB
  */
-bool ExportadorArchivo::recuperarDesdeRespaldo(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) {
+bool ExportadorArchivo::recuperarDesdeRespaldo(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) {
 	// Obtener la ruta del escritorio del usuario (similar a exportarBackupMongoDB)
 	std::string rutaEscritorio = ExportadorArchivo::obtenerRutaEscritorio();
 	std::string rutaCompleta = rutaEscritorio + nombreArchivo + ".bak";
@@ -1537,12 +1525,8 @@ bool ExportadorArchivo::recuperarDesdeRespaldo(const _BaseDatosPersona& baseDato
 	}
 
 	try {
-		// Crear instancia temporal para operaciones (similar a exportarBackupMongoDB)
-		auto& clienteDB = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona baseDatosTemp(clienteDB);
-
-		// Procesar archivo línea por línea y cargar en MongoDB
-		bool resultado = procesarArchivoRecuperacion(archivo, baseDatosTemp);
+		// Procesar archivo línea por línea y cargar en el repositorio del motor configurado
+		bool resultado = procesarArchivoRecuperacion(archivo, FabricaRepositorioBanco::obtenerRepositorio());
 
 		archivo.close();
 
@@ -1566,7 +1550,7 @@ bool ExportadorArchivo::recuperarDesdeRespaldo(const _BaseDatosPersona& baseDato
  * @brief Recupera datos desde archivo cifrado .bin y los carga en MongoDB
  * Usando funciones de Cifrado.cpp
  */
-bool ExportadorArchivo::recuperarDesdeCifrado(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo, char claveDescifrado) {
+bool ExportadorArchivo::recuperarDesdeCifrado(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo, char claveDescifrado) {
 	try {
 		// Primero descifrar el archivo usando las funciones de Cifrado.cpp
 		std::string rutaEscritorio = ExportadorArchivo::obtenerRutaEscritorio();
@@ -1602,10 +1586,7 @@ bool ExportadorArchivo::recuperarDesdeCifrado(const _BaseDatosPersona& baseDatos
 		}
 
 		// Procesar archivo descifrado
-		auto& clienteDB = ConexionMongo::obtenerClienteBaseDatos();
-		_BaseDatosPersona baseDatosTemp(clienteDB);
-
-		bool resultado = procesarArchivoRecuperacion(archivoDescifrado, baseDatosTemp);
+		bool resultado = procesarArchivoRecuperacion(archivoDescifrado, FabricaRepositorioBanco::obtenerRepositorio());
 
 		archivoDescifrado.close();
 
@@ -1633,7 +1614,7 @@ bool ExportadorArchivo::recuperarDesdeCifrado(const _BaseDatosPersona& baseDatos
  * @brief Procesa archivo de respaldo y carga datos en MongoDB
  * Usando funciones de _BaseDatosPersona.cpp
  */
-bool ExportadorArchivo::procesarArchivoRecuperacion(std::ifstream& archivo, _BaseDatosPersona& baseDatos) {
+bool ExportadorArchivo::procesarArchivoRecuperacion(std::ifstream& archivo, IRepositorioBanco& baseDatos) {
 	std::string linea;
 	std::map<std::string, std::string> datosPersona;
 	std::vector<std::map<std::string, std::string>> cuentasAhorro;
@@ -1743,7 +1724,7 @@ bool ExportadorArchivo::procesarArchivoRecuperacion(std::ifstream& archivo, _Bas
 bool ExportadorArchivo::cargarPersonaEnMongoDB(const std::map<std::string, std::string>& datosPersona,
 	const std::vector<std::map<std::string, std::string>>& cuentasAhorro,
 	const std::vector<std::map<std::string, std::string>>& cuentasCorriente,
-	_BaseDatosPersona& baseDatos) {
+	IRepositorioBanco& baseDatos) {
 
 	try {
 		// Verificar datos mínimos de persona
@@ -1810,7 +1791,7 @@ bool ExportadorArchivo::cargarPersonaEnMongoDB(const std::map<std::string, std::
 bool ExportadorArchivo::agregarCuentaDesdeBackup(const std::string& cedula,
 	const std::map<std::string, std::string>& datosCuenta,
 	const std::string& tipoCuenta,
-	_BaseDatosPersona& baseDatos) {
+	IRepositorioBanco& baseDatos) {
 
 	try {
 		// Extraer datos de la cuenta
@@ -12,13 +12,13 @@
 #include <bsoncxx/array/view.hpp>
 #include <bsoncxx/types.hpp>
 #include <bsoncxx/document/element.hpp>
-#include "_BaseDatosPersona.h"
+#include "IRepositorioBanco.h"
 #include <memory>
 
 // Forward declarations
 class Banco;
 class Persona;
-class _BaseDatosPersona;
+class IRepositorioBanco;
 
 /**
  * @brief Interfaz Strategy para diferentes tipos de guardado
@@ -27,7 +27,7 @@ class _BaseDatosPersona;
 class IEstrategiaGuardado {
 public:
 	virtual ~IEstrategiaGuardado() = default;
-	virtual bool ejecutar(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo) = 0;
+	virtual bool ejecutar(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo) = 0;
 	virtual std::string obtenerExtension() const = 0;
 	virtual std::string obtenerDescripcion() const = 0;
 };
@@ -48,11 +48,11 @@ public:
  */
 class GestorGuardadoArchivos {
 private:
-	const _BaseDatosPersona& baseDatos;
+	const IRepositorioBanco& baseDatos;
 	std::unique_ptr<IEstrategiaGuardado> estrategia;
 
 public:
-	explicit GestorGuardadoArchivos(const _BaseDatosPersona& bd);
+	explicit GestorGuardadoArchivos(const IRepositorioBanco& bd);
 
 	bool configurarEstrategia(int tipoGuardado, char claveCifrado = '\0');
 	bool ejecutarGuardado(const std::string& nombreArchivo);
@@ -85,12 +85,12 @@ struct EstadoProcesamiento {
 class ExportadorArchivo {
 private:
 	// === MÉTODOS AUXILIARES PARA MONGODB ===
-	static bool guardarDesdeBaseDatos(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo, const std::string& extension);
+	static bool guardarDesdeBaseDatos(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo, const std::string& extension);
 	static void procesarPersonaRecursivamente(const bsoncxx::document::value& personaDoc, std::ofstream& archivo);
 	static void escribirCampoPersona(std::ofstream& archivo, const std::string& nombreCampo, const bsoncxx::document::element& elemento);
-	static bool guardarArchivoConCifrado(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo, char claveCifrado);
-	static bool generarPDFDesdeBaseDatos(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo);
-	static bool archivoGuardadoHaciaPDFConQR(const std::string& nombreArchivo, const _BaseDatosPersona& baseDatos);
+	static bool guardarArchivoConCifrado(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo, char claveCifrado);
+	static bool generarPDFDesdeBaseDatos(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo);
+	static bool archivoGuardadoHaciaPDFConQR(const std::string& nombreArchivo, const IRepositorioBanco& baseDatos);
 	static void procesarLineasPDFRecursivamente(std::ifstream& archivo, std::ofstream& archivoHtml,
 		std::map<std::string, std::string>& datosPersona, EstadoProcesamiento& estado);
 	static void escribirPersonaConQR(std::ofstream& archivoHtml, const std::map<std::string, std::string>& datosPersona);
@@ -110,18 +110,18 @@ public:
 	class EstrategiaRecuperacionBIN;
 
 	// === MÉTODOS DE RECUPERACIÓN ===
-	static bool procesarSolicitudRecuperacion(const _BaseDatosPersona& baseDatos);
-	static bool recuperarDesdeRespaldo(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo);
-	static bool recuperarDesdeCifrado(const _BaseDatosPersona& baseDatos, const std::string& nombreArchivo, char claveDescifrado);
-	static bool procesarArchivoRecuperacion(std::ifstream& archivo, _BaseDatosPersona& baseDatos);
+	static bool procesarSolicitudRecuperacion(const IRepositorioBanco& baseDatos);
+	static bool recuperarDesdeRespaldo(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo);
+	static bool recuperarDesdeCifrado(const IRepositorioBanco& baseDatos, const std::string& nombreArchivo, char claveDescifrado);
+	static bool procesarArchivoRecuperacion(std::ifstream& archivo, IRepositorioBanco& baseDatos);
 	static bool cargarPersonaEnMongoDB(const std::map<std::string, std::string>& datosPersona,
 		const std::vector<std::map<std::string, std::string>>& cuentasAhorro,
 		const std::vector<std::map<std::string, std::string>>& cuentasCorriente,
-		_BaseDatosPersona& baseDatos);
+		IRepositorioBanco& baseDatos);
 	static bool agregarCuentaDesdeBackup(const std::string& cedula,
 		const std::map<std::string, std::string>& datosCuenta,
 		const std::string& tipoCuenta,
-		_BaseDatosPersona& baseDatos);
+		IRepositorioBanco& baseDatos);
 
 	// === MÉTODOS DE INTERFAZ DE USUARIO PARA RECUPERACIÓN ===
 	static int solicitarTipoRecuperacion();
@@ -134,13 +134,13 @@ public:
 	static std::string solicitarNombreArchivo();
 	static char solicitarClaveParaCifrado();
 	static void mostrarResultado(bool exito, const std::string& tipoOperacion);
-	static bool validarDatosEnBaseDatos(const _BaseDatosPersona& baseDatos);
+	static bool validarDatosEnBaseDatos(const IRepositorioBanco& baseDatos);
 
 	// === MÉTODOS PRINCIPALES REFACTORIZADOS ===
 	/**
 	 * @brief Método principal simplificado que delega a GestorGuardadoArchivos
 	 */
-	static bool procesarSolicitudGuardado(const _BaseDatosPersona& baseDatos);
+	static bool procesarSolicitudGuardado(const IRepositorioBanco& baseDatos);
 
 	// === MÉTODOS EXISTENTES ===
 	static void guardarCuentasEnArchivo(const Banco& banco, const std::string& nombreArchivo);
@@ -153,7 +153,7 @@ public:
 	static std::string obtenerRutaEscritorio();
 
 	// === NUEVOS MÉTODOS PARA MONGODB ===
-	static bool guardarArchivosVarios(const _BaseDatosPersona& baseDatos, int tipoArchivo,
+	static bool guardarArchivosVarios(const IRepositorioBanco& baseDatos, int tipoArchivo,
 		const std::string& nombreArchivo, char claveCifrado = '\0');
 	static bool procesarPersonaDesdeBSON(const bsoncxx::document::value& personaDoc, std::ofstream& archivo);
 	static std::string generarQRPersona(const std::string& cedula, const std::string& nombres,